@@ -28,12 +28,42 @@
 
 #include "xfoil.h"
 
+#include <QMutex>
+#include <QVector>
+
 #define PI 3.141592654
 #define EPSILON 1.e-6
 
 bool XFoil::s_bCancel = false;
 bool XFoil::s_bFullReport = false;
 double XFoil::vaccel = 0.01;
+int XFoil::s_nCirclePoints = ICX;
+
+
+/**
+ * The inviscid factorizations of a paneled foil.
+ * The LU-factored dpsi/dgam matrix, the alpha=0,90 vorticity distributions
+ * and the airfoil part of the dqtan/dsig matrix only depend on the panel nodes,
+ * and are shared by all the XFoil instances which analyze the same foil.
+ */
+struct panelFactors
+{
+    quint64 hash=0;
+    int n=0;
+    double qinf=0;                 /**< the freestream speed of the instance which has computed the factors */
+    QVector<double> x, y;          /**< the panel nodes, to check the hash */
+    QVector<double> aij;           /**< the LU-factored (n+1)x(n+1) matrix */
+    QVector<int> aijpiv;
+    QVector<double> gamu1, gamu2;  /**< the unit vorticity distributions for alpha=0 and 90° */
+    QVector<double> dij;           /**< the nxn airfoil block of the source influence matrix */
+};
+
+static QMutex s_FactorMutex;
+static QList<panelFactors*> s_FactorCache;  /**< most recently used first */
+static int s_MaxFactorEntries = 8;
+static int s_FactorHits = 0;
+static int s_FactorMisses = 0;
+
 
 XFoil::XFoil()
 {
@@ -200,17 +230,16 @@ bool XFoil::initialize()
 
     m_nSide1 = m_nSide2 = 0;
     //mdes
-    memset(wc,     0, sizeof(wc));
-    memset(sc,     0, sizeof(sc));
-    memset(scold,  0, sizeof(scold));
-    memset(xcold,  0, sizeof(xcold));
-    memset(ycold,  0, sizeof(ycold));
-    memset(sspec,  0, sizeof(sspec));
-    memset(xspoc,  0, sizeof(xspoc));
-    memset(yspoc,  0, sizeof(yspoc));
-    memset(qgamm,  0, sizeof(qgamm));
-    memset(qspec,  0, sizeof(qspec));
-    memset(qspecp, 0, sizeof(qspecp));
+    int nspmax = std::max(IBX, ICXMAX)+1;
+    sspec.assign(nspmax, 0.0);
+    xspoc.assign(nspmax, 0.0);
+    yspoc.assign(nspmax, 0.0);
+    qgamm.assign(nspmax, 0.0);
+    for(int k=0; k<=IPX; k++)
+    {
+        qspec[k].assign(nspmax, 0.0);
+        qspecp[k].assign(nspmax, 0.0);
+    }
     memset(alqsp,  0, sizeof(alqsp));
     memset(clqsp,  0, sizeof(clqsp));
     memset(cmqsp,  0, sizeof(cmqsp));
@@ -335,25 +364,9 @@ bool XFoil::initialize()
     yof = 0.0;
 
     //    ncpref = 0;
-    //                                       n
-    //---- circle plane array size (largest 2  + 1 that will fit array size)
-    double ann = log(double((2*IQX)-1))/log(2.0);
-    int nn = int( ann + 0.00001 );
-    int tmp = 1;
-
-    for (int l=0; l<nn; l++){
-        tmp = 2*tmp;
-    }
-    nc1 = tmp + 1;
-    //    nc1 = (int)pow(2,nn) + 1;
-    if(nc1 > ICX) {
-        tmp = 1;
-        for (int l=0; l<nn-1; l++){
-            tmp = 2*tmp;
-        }
-        nc1 = tmp+1;
-        //        nc1 = pow(2,(nn-1)) + 1; //257 instead of ICX in original source code
-    }
+    //---- circle plane array size, 2^n + 1
+    nc1 = s_nCirclePoints;
+    leiw = eiwset(nc1);
 
     //---- default cm reference location
     xcmref = 0.25;
@@ -3462,6 +3475,13 @@ bool XFoil::ggcalc()
     cosa = cos(alfa);
     sina = sin(alfa);
 
+    //---- re-use the factorization if this foil's panels have already been processed
+    if(loadFactors())
+    {
+        writeString("   Using the cached unit vorticity distributions and source influence matrix\n");
+        return true;
+    }
+
     //---- distance of internal control point ahead of sharp TE
     //-    (fraction of smaller panel length adjacent to TE)
     bwt = 0.1;
@@ -3595,6 +3615,161 @@ bool XFoil::ggcalc()
 
 
 
+/**
+ * @return a FNV-1a hash of the current panel nodes and of the freestream speed.
+ */
+quint64 XFoil::panelHash() const
+{
+    quint64 h = 14695981039346656037ULL;
+    unsigned char const *pc = reinterpret_cast<unsigned char const*>(&n);
+    for(uint k=0; k<sizeof(int); k++)   {h ^= pc[k]; h *= 1099511628211ULL;}
+    pc = reinterpret_cast<unsigned char const*>(x+1);
+    for(uint k=0; k<n*sizeof(double); k++) {h ^= pc[k]; h *= 1099511628211ULL;}
+    pc = reinterpret_cast<unsigned char const*>(y+1);
+    for(uint k=0; k<n*sizeof(double); k++) {h ^= pc[k]; h *= 1099511628211ULL;}
+    pc = reinterpret_cast<unsigned char const*>(&qinf);
+    for(uint k=0; k<sizeof(double); k++) {h ^= pc[k]; h *= 1099511628211ULL;}
+    return h;
+}
+
+
+/**
+ * Loads the inviscid factorizations of the current panels from the process-wide cache.
+ * @return true if the panels were found in the cache.
+ */
+bool XFoil::loadFactors()
+{
+    if(s_MaxFactorEntries<=0) return false;
+
+    quint64 hash = panelHash();
+
+    QMutexLocker locker(&s_FactorMutex);
+    for(int ie=0; ie<s_FactorCache.size(); ie++)
+    {
+        panelFactors const *pF = s_FactorCache.at(ie);
+        if(pF->hash!=hash || pF->n!=n || pF->qinf!=qinf) continue;
+        if(memcmp(pF->x.constData(), x+1, n*sizeof(double))!=0) continue;
+        if(memcmp(pF->y.constData(), y+1, n*sizeof(double))!=0) continue;
+
+        int nu = n+1;
+        for(int i=1; i<=nu; i++)
+        {
+            memcpy(aij[i]+1, pF->aij.constData()+(i-1)*nu, nu*sizeof(double));
+            aijpiv[i]   = pF->aijpiv.at(i-1);
+            gamu[i][1]  = pF->gamu1.at(i-1);
+            gamu[i][2]  = pF->gamu2.at(i-1);
+            qinvu[i][1] = gamu[i][1];
+            qinvu[i][2] = gamu[i][2];
+        }
+        for(int i=1; i<=n; i++)
+            memcpy(dij[i]+1, pF->dij.constData()+(i-1)*n, n*sizeof(double));
+
+        lqaij = true;
+        lgamu = true;
+        ladij = true;
+
+        s_FactorCache.move(ie, 0);
+        s_FactorHits++;
+        return true;
+    }
+    s_FactorMisses++;
+    return false;
+}
+
+
+/**
+ * Stores the inviscid factorizations of the current panels in the process-wide cache.
+ * Evicts the least recently used entries if the cache is full.
+ */
+void XFoil::storeFactors()
+{
+    if(s_MaxFactorEntries<=0 || !lqaij || !lgamu || !ladij) return;
+
+    panelFactors *pF = new panelFactors;
+    pF->hash = panelHash();
+    pF->n = n;
+    pF->qinf = qinf;
+    pF->x.resize(n);
+    pF->y.resize(n);
+    memcpy(pF->x.data(), x+1, n*sizeof(double));
+    memcpy(pF->y.data(), y+1, n*sizeof(double));
+
+    int nu = n+1;
+    pF->aij.resize(nu*nu);
+    pF->aijpiv.resize(nu);
+    pF->gamu1.resize(nu);
+    pF->gamu2.resize(nu);
+    for(int i=1; i<=nu; i++)
+    {
+        memcpy(pF->aij.data()+(i-1)*nu, aij[i]+1, nu*sizeof(double));
+        pF->aijpiv[i-1] = aijpiv[i];
+        pF->gamu1[i-1]  = gamu[i][1];
+        pF->gamu2[i-1]  = gamu[i][2];
+    }
+    pF->dij.resize(n*n);
+    for(int i=1; i<=n; i++)
+        memcpy(pF->dij.data()+(i-1)*n, dij[i]+1, n*sizeof(double));
+
+    QMutexLocker locker(&s_FactorMutex);
+    for(int ie=0; ie<s_FactorCache.size(); ie++)
+    {
+        panelFactors const *pOld = s_FactorCache.at(ie);
+        if(pOld->hash==pF->hash && pOld->n==pF->n && pOld->qinf==pF->qinf && pOld->x==pF->x && pOld->y==pF->y)
+        {
+            // stored concurrently by another instance
+            delete pF;
+            return;
+        }
+    }
+    s_FactorCache.prepend(pF);
+    while(s_FactorCache.size()>s_MaxFactorEntries) delete s_FactorCache.takeLast();
+}
+
+
+void XFoil::setFactorCacheSize(int nEntries)
+{
+    QMutexLocker locker(&s_FactorMutex);
+    s_MaxFactorEntries = std::max(0, nEntries);
+    while(s_FactorCache.size()>s_MaxFactorEntries) delete s_FactorCache.takeLast();
+}
+
+
+int XFoil::factorCacheSize()
+{
+    return s_MaxFactorEntries;
+}
+
+
+void XFoil::clearFactorCache()
+{
+    QMutexLocker locker(&s_FactorMutex);
+    qDeleteAll(s_FactorCache);
+    s_FactorCache.clear();
+    s_FactorHits = s_FactorMisses = 0;
+}
+
+
+int XFoil::factorCacheHits()
+{
+    QMutexLocker locker(&s_FactorMutex);
+    return s_FactorHits;
+}
+
+
+int XFoil::factorCacheMisses()
+{
+    QMutexLocker locker(&s_FactorMutex);
+    return s_FactorMisses;
+}
+
+
+void XFoil::resetFactorCacheStats()
+{
+    QMutexLocker locker(&s_FactorMutex);
+    s_FactorHits = s_FactorMisses = 0;
+}
+
+
 bool XFoil::baksub(int n, double a[IQX][IQX], int indx[], double b[])
 {
     double sum=0;
@@ -4069,6 +4244,158 @@ bool XFoil::initXFoilAnalysis(double Re, double alpha, double Mach, double NCrit
 }
 
 
+/**
+ * Copies the current converged viscous solution to the state structure.
+ * The state is only meaningful if lvconv is true.
+ */
+void XFoil::getBLState(blState &state) const
+{
+    state.bValid = lvconv && lblini && lipan;
+    state.alfa  = alfa;
+    state.cl    = cl;
+    state.minf  = minf;
+    state.reinf = reinf;
+
+    state.ist    = ist;
+    state.nsys   = nsys;
+    state.sst    = sst;
+    state.sst_go = sst_go;
+    state.sst_gp = sst_gp;
+
+    memcpy(state.iblte,  iblte,  ISX*sizeof(int));
+    memcpy(state.nbl,    nbl,    ISX*sizeof(int));
+    memcpy(state.itran,  itran,  ISX*sizeof(int));
+    memcpy(state.tforce, tforce, ISX*sizeof(bool));
+    memcpy(state.xssitr, xssitr, ISX*sizeof(double));
+    memcpy(state.xoctr,  xoctr,  ISX*sizeof(double));
+    memcpy(state.yoctr,  yoctr,  ISX*sizeof(double));
+
+    memcpy(state.ipan, ipan, IVX*ISX*sizeof(int));
+    memcpy(state.isys, isys, IVX*ISX*sizeof(int));
+    memcpy(state.vti,  vti,  IVX*ISX*sizeof(double));
+    memcpy(state.xssi, xssi, IVX*ISX*sizeof(double));
+    memcpy(state.thet, thet, IVX*ISX*sizeof(double));
+    memcpy(state.dstr, dstr, IVX*ISX*sizeof(double));
+    memcpy(state.ctau, ctau, IVX*ISX*sizeof(double));
+    memcpy(state.uedg, uedg, IVX*ISX*sizeof(double));
+    memcpy(state.mass, mass, IVX*ISX*sizeof(double));
+
+    memcpy(state.gam,  gam,  IQX*sizeof(double));
+    memcpy(state.qvis, qvis, IZX*sizeof(double));
+}
+
+
+/**
+ * Loads a converged viscous solution computed by another XFoil instance for the same paneled foil,
+ * so that the next viscous iterations start from this BL instead of the inviscid initialization.
+ * The wake is recalculated at the next call to viscal().
+ * @return false if the state is invalid or has been computed for a different paneling.
+ */
+bool XFoil::setBLState(blState const &state)
+{
+    if(!state.bValid) return false;
+    if(state.iblte[1]+state.iblte[2]!=n+2) return false;                 // not the same number of panels
+    if(state.nbl[2]-state.iblte[2]!=std::min(n/8+2, IWX)) return false;  // not the same number of wake nodes
+
+    ist    = state.ist;
+    nsys   = state.nsys;
+    sst    = state.sst;
+    sst_go = state.sst_go;
+    sst_gp = state.sst_gp;
+
+    memcpy(iblte,  state.iblte,  ISX*sizeof(int));
+    memcpy(nbl,    state.nbl,    ISX*sizeof(int));
+    memcpy(itran,  state.itran,  ISX*sizeof(int));
+    memcpy(tforce, state.tforce, ISX*sizeof(bool));
+    memcpy(xssitr, state.xssitr, ISX*sizeof(double));
+    memcpy(xoctr,  state.xoctr,  ISX*sizeof(double));
+    memcpy(yoctr,  state.yoctr,  ISX*sizeof(double));
+
+    memcpy(ipan, state.ipan, IVX*ISX*sizeof(int));
+    memcpy(isys, state.isys, IVX*ISX*sizeof(int));
+    memcpy(vti,  state.vti,  IVX*ISX*sizeof(double));
+    memcpy(xssi, state.xssi, IVX*ISX*sizeof(double));
+    memcpy(thet, state.thet, IVX*ISX*sizeof(double));
+    memcpy(dstr, state.dstr, IVX*ISX*sizeof(double));
+    memcpy(ctau, state.ctau, IVX*ISX*sizeof(double));
+    memcpy(uedg, state.uedg, IVX*ISX*sizeof(double));
+    memcpy(mass, state.mass, IVX*ISX*sizeof(double));
+
+    memcpy(gam,  state.gam,  IQX*sizeof(double));
+    memcpy(qvis, state.qvis, IZX*sizeof(double));
+
+    lblini = true;
+    lipan  = true;
+    lwake  = false;
+
+    return true;
+}
+
+
+/**
+ * Sets the initial BL of the next viscous solution as a weighted combination of converged states,
+ * typically with Lagrange weights to extrapolate the BL variables from the last points of a sequence.
+ * Only the BL variables are loaded: the inviscid solution, the stagnation point and the station layout
+ * are those of the current instance, so that this may be called after specal() or speccl().
+ * The extrapolation is only performed if all states share the current stagnation panel and number of BL stations.
+ * Amplification and shear stress are only combined at stations which are on the same side
+ * of the transition point in all states.
+ * @param pStates the array of converged states, most recent first
+ * @param weight the weights of each state; their sum should be 1
+ * @param nStates the number of states
+ * @return true if the extrapolated BL has been loaded
+ */
+bool XFoil::extrapolateBL(blState const *pStates[], double const *weight, int nStates)
+{
+    if(nStates<1 || !lipan || !lblini) return false;
+    blState const &s0 = *pStates[0];
+    for(int k=0; k<nStates; k++)
+    {
+        blState const &sk = *pStates[k];
+        if(!sk.bValid || sk.ist!=ist) return false;
+        if(sk.iblte[1]!=iblte[1] || sk.iblte[2]!=iblte[2]) return false;
+        if(sk.nbl[1]!=nbl[1]     || sk.nbl[2]!=nbl[2])     return false;
+    }
+
+    for(int is=1; is<=2; is++)
+    {
+        int itrmin = s0.itran[is], itrmax = s0.itran[is];
+        for(int k=1; k<nStates; k++)
+        {
+            itrmin = std::min(itrmin, pStates[k]->itran[is]);
+            itrmax = std::max(itrmax, pStates[k]->itran[is]);
+        }
+
+        for(int ibl=2; ibl<=s0.nbl[is]; ibl++)
+        {
+            double th=0.0, ds=0.0, ue=0.0, ct=0.0;
+            for(int k=0; k<nStates; k++)
+            {
+                th += weight[k]*pStates[k]->thet[ibl][is];
+                ds += weight[k]*pStates[k]->dstr[ibl][is];
+                ue += weight[k]*pStates[k]->uedg[ibl][is];
+                ct += weight[k]*pStates[k]->ctau[ibl][is];
+            }
+
+            //---- keep the last converged values if the extrapolation is not physical
+            if(th<=0.0)       th = s0.thet[ibl][is];
+            if(ds<=1.0001*th) ds = std::max(s0.dstr[ibl][is], 1.0001*th);
+            if(ue<=0.0)       ue = s0.uedg[ibl][is];
+            if(ibl>=itrmin && ibl<itrmax) ct = s0.ctau[ibl][is];
+            else if(ct<0.0)               ct = s0.ctau[ibl][is];
+
+            thet[ibl][is] = th;
+            dstr[ibl][is] = ds;
+            uedg[ibl][is] = ue;
+            ctau[ibl][is] = ct;
+            mass[ibl][is] = ds*ue;
+        }
+    }
+
+    return true;
+}
+
+
 /**     logical function inside(x,y,n, xf,yf)
  *      dimension x(n),y(n)
  *-------------------------------------
@@ -6433,6 +6760,7 @@ bool XFoil::qdcalc()
             }
         }
         ladij = true;
+        storeFactors();
     }
 
     //---- set up coefficient matrix of dpsi/dm on wake
@@ -10573,50 +10901,100 @@ bool XFoil::eiwset(int nc1)
     //----------------------------------------------------
     //     calculates the uniformly-spaced circle-plane
     //     coordinate array wc (omega), and the
-    //     corresponding complex unit numbers exp(inw)
-    //     for slow fourier transform operations.
+    //     corresponding complex unit numbers exp(i.2pi.k/(nc-1))
+    //     for the fast fourier transform operations.
+    //     exp(inw) at point ic is eiw[(m*(ic-1))%(nc-1)], cf. eiwc().
+    //     Also sizes the circle-plane arrays.
     //----------------------------------------------------
     //      include 'circle.inc'
 
     //      PI = 4.0*atan(1.0)
     int ic=0;
-    //---- set requested number of points in circle plane
-    nc  = nc1;
-    mc  = int(nc1/4);
-    mct = int(nc1/16);
 
-    if(nc>ICX)
+    if(nc1<17 || nc1>ICXMAX || ((nc1-1)&(nc1-2))!=0)
     {
-        writeString("eiwset: Array overflow. Increase ICX.");
+        writeString(QString::asprintf("eiwset: the number of circle plane points must be 2^n+1 and less than %d\n", ICXMAX));
         return false;
     }
 
+    //---- set requested number of points in circle plane
+    nc  = nc1;
+    mc  = int(nc1/4);
+    mct = std::min(int(nc1/16), IMX4);
+
+    wc.assign(nc+1, 0.0);
+    sc.assign(nc+1, 0.0);
+    scold.assign(nc+1, 0.0);
+    xcold.assign(nc+1, 0.0);
+    ycold.assign(nc+1, 0.0);
+    piq.assign(nc+1, complex<double>(0.0,0.0));
+    zc.assign(nc+1, complex<double>(0.0,0.0));
+    zcoldw.assign(nc+1, complex<double>(0.0,0.0));
+    zc_cn.resize(nc+1);
+    cn.assign(mc+1, complex<double>(0.0,0.0));
+    cnsav.assign(mc+1, complex<double>(0.0,0.0));
+
     dwc = 2.0*PI / double(nc-1);
 
     for (ic=1; ic<=nc; ic++)  wc[ic] = dwc*double(ic-1);
 
+    //---- set the unit roots; the first one is exactly 1
+    eiw.resize(nc-1);
+    for (int k=0; k<nc-1; k++)
+        eiw[k] = exp(complex<double>(0.0, dwc*double(k)));
+    eiw[0] = complex<double>(1.0, 0.0);
 
-    //---- set  m = 0  numbers
-    for (ic=1; ic<=nc; ic++)
-        eiw[ic][0] = complex<double>(1.0, 0.0);
+    return true;
+}
 
 
-    //---- set  m = 1  numbers
-    for (ic=1; ic<=nc; ic++)
-        eiw[ic][1] = exp(complex<double>( 0.0 , wc[ic] ) );
+/**
+ * Sets the number of circle plane points used by the full-inverse mapping.
+ * The value is rounded to the nearest 2^n+1 in the range [65, ICXMAX].
+ * The change takes effect at the next initialization of the full-inverse design.
+ */
+void XFoil::setCirclePoints(int nPoints)
+{
+    int np = 65;
+    while(np<ICXMAX && nPoints>3*(np-1)/2+1) np = 2*(np-1)+1;
+    s_nCirclePoints = np;
+}
 
 
-    //---- set  m > 1  numbers by indexing appropriately from  m = 1  numbers
-    for(int m=2; m<= mc; m++){
-        for (int ic=1; ic<= nc;ic++){
-            int ic1 = m*(ic-1);
-            ic1 = ic1%(nc-1) +1;
-            eiw[ic][m] = eiw[ic1][1];
-        }
+/**
+ * In-place radix-2 transform of the nfft complex values a[0..nfft-1]
+ *     a[m] <- sum_k a[k] exp( i.2pi.mk/nfft)   if bConjugate is false
+ *     a[m] <- sum_k a[k] exp(-i.2pi.mk/nfft)   if bConjugate is true
+ * nfft must be nc-1, so that the twiddle factors can be read from the eiw table.
+ */
+void XFoil::fftc(complex<double> *a, int nfft, bool bConjugate) const
+{
+    //---- bit reversal permutation
+    for (int i=1, j=0; i<nfft; i++)
+    {
+        int bit = nfft>>1;
+        for (; j&bit; bit>>=1) j ^= bit;
+        j ^= bit;
+        if(i<j) std::swap(a[i], a[j]);
     }
 
-    return true;
-
+    //---- butterflies
+    for (int len=2; len<=nfft; len<<=1)
+    {
+        int stride = nfft/len;
+        int half = len/2;
+        for (int i=0; i<nfft; i+=len)
+        {
+            for (int k=0; k<half; k++)
+            {
+                complex<double> w = bConjugate ? conj(eiw[k*stride]) : eiw[k*stride];
+                complex<double> u = a[i+k];
+                complex<double> v = a[i+k+half]*w;
+                a[i+k]      = u+v;
+                a[i+k+half] = u-v;
+            }
+        }
+    }
 }
 
 
@@ -10722,7 +11100,7 @@ void XFoil::scinit(int n, double x[], double xp[], double y[], double yp[], doub
             zccalc(1);
 
             //------ set current le,te locations
-            zlefind(&zle,zc,wc,nc,piq,agte);
+            zlefind(&zle,zc.data(),wc.data(),nc,piq.data(),agte);
 
             zte = 0.5*(zc[1]+zc[nc]);
 
@@ -10773,18 +11151,19 @@ void XFoil::scinit(int n, double x[], double xp[], double y[], double yp[], doub
 void XFoil::ftp()
 {
     //----------------------------------------------------------------
-    //     slow-fourier-transform p(w) using trapezoidal integration.
+    //     fourier-transform p(w) using trapezoidal integration.
+    //     w=0 and w=2pi are the same point of the periodic fft,
+    //     so the two end points share the first sample.
     //----------------------------------------------------------------
+    int nfft = nc-1;
+    std::vector<complex<double>> a(nfft);
 
-    complex<double> zsum=0;
+    a[0] = 0.5*(piq[1] + piq[nc]);
+    for(int ic=2; ic<= nc-1; ic++) a[ic-1] = piq[ic];
 
-    for (int m=0; m<= mc;m++){
-        zsum = complex<double>(0.0,0.0);
-        for(int ic=2; ic<= nc-1; ic++)
-            zsum = zsum + piq[ic]*eiw[ic][m];
+    fftc(a.data(), nfft, false);
 
-        cn[m] = (0.5*(piq[1]*eiw[1][m] + piq[nc]*eiw[nc][m])+ zsum)*dwc / PI;
-    }
+    for (int m=0; m<= mc;m++) cn[m] = a[m]*dwc / PI;
     cn[0] = 0.5*cn[0];
 
     return;
@@ -10797,15 +11176,15 @@ void XFoil::piqsum()
     //     inverse-transform to get back modified
     //     speed function and its conjugate.
     //---------------------------------------------
-    complex<double> zsum=0;
+    int nfft = nc-1;
+    std::vector<complex<double>> a(nfft, complex<double>(0.0,0.0));
 
-    for(int ic=1; ic <= nc; ic++){
-        zsum = complex<double>(0.0,0.0);
-        for(int m=0; m<= mc; m++){
-            zsum = zsum + cn[m]*conjg(eiw[ic][m]);
-        }
-        piq[ic] = zsum;
-    }
+    for(int m=0; m<= mc; m++) a[m] = cn[m];
+
+    fftc(a.data(), nfft, true);
+
+    for(int ic=1; ic<nc; ic++) piq[ic] = a[ic-1];
+    piq[nc] = piq[1];
 
     return;
 }
@@ -10832,7 +11211,7 @@ void XFoil::zcnorm(int mtest)
     int m=0, ic=0;
 
     //---- find current le location
-    zlefind(&zle,zc,wc,nc,piq,agte);
+    zlefind(&zle,zc.data(),wc.data(),nc,piq.data(),agte);
 
     //---- place leading edge at origin
     for (ic=1; ic <= nc; ic++)   {
@@ -10902,8 +11281,8 @@ void XFoil::zccalc(int mtest)
         dz_piq2 = 0.5*(      dzdw2)*dwc;
 
         for (int m=1; m<= mtest; m++){
-            zc_cn[ic][m] = dz_piq1*conjg(eiw[ic-1][m])
-                    + dz_piq2*conjg(eiw[ic][m])
+            zc_cn[ic][m] = dz_piq1*conjg(eiwc(ic-1,m))
+                    + dz_piq2*conjg(eiwc(ic,m))
                     + zc_cn[ic-1][m];
         }
 
@@ -11077,7 +11456,7 @@ void XFoil::qccalc(int ispec,double *alfa, double *cl, double *cm,
     double sinw, sinwe;
     double cpinc1, cpi_q1, cpcom1,cpc_q1, cpc_a1;
     double cpinc2, cpi_q2, cpcom2,cpc_q2, cpc_a2;
-    double qc_a[ICX+1];
+    std::vector<double> qc_a(nc+1);
     //    double minf;
     //    double aeps = 5.0 *pow(10,-7);
     double aeps = 5.0e-007;
@@ -11182,7 +11561,7 @@ void XFoil::qccalc(int ispec,double *alfa, double *cl, double *cm,
 }
 
 
-void XFoil::mapgen(int n, double x[],double y[])
+void XFoil::mapgen(int &n, double x[],double y[])
 {
     //-------------------------------------------------------
     //     calculates the geometry from the speed function
@@ -11192,7 +11571,6 @@ void XFoil::mapgen(int n, double x[],double y[])
     //      include 'circle.inc'
     //      dimension x(nc), y(nc)
     //
-    Q_UNUSED(n);
     complex<double> qq[IMX4+1][IMX4+1];
     complex<double> dcn[IMX4+1];
     double dx=0, dy=0, qimoff=0, dcnmax=0;
@@ -11257,11 +11635,14 @@ void XFoil::mapgen(int n, double x[],double y[])
 
     // 101 continue
 
-    //--- return new airfoil coordinates
-    n = nc;
-    for(int i=1; i<=nc;i++){
-        x[i] = real(zc[i]);
-        y[i] = imag(zc[i]);
+    //--- return new airfoil coordinates, skipping every other circle plane point
+    //    as many times as necessary to fit in the buffer arrays
+    int istep = 1;
+    while((nc-1)/istep+1 > IBX-1) istep *= 2;
+    n = (nc-1)/istep+1;
+    for(int i=1; i<=n;i++){
+        x[i] = real(zc[(i-1)*istep+1]);
+        y[i] = imag(zc[(i-1)*istep+1]);
     }
 
     //      end ! mapgen
@@ -11411,7 +11792,7 @@ void XFoil::cncalc(double qc[], bool lsymm)
     //----------------------------------------------------------
     //      real qc(nc)
 
-    double qcw[ICX+1];
+    std::vector<double> qcw(nc+1);
     int ic=0,m=0;
     double wcle=0, alfcir=0;
     double cosw=0, sinw=0, sinwe=0, pfun=0, cnr=0;
@@ -11420,7 +11801,7 @@ void XFoil::cncalc(double qc[], bool lsymm)
 
     //c      real wcj(2)
 
-    if(nc > ICX)
+    if(nc > ICXMAX)
     {
         writeString("CNCALC: array overflow.");
         return;
@@ -11437,7 +11818,7 @@ void XFoil::cncalc(double qc[], bool lsymm)
     //      endif
 
     //---- spline q(w)
-    splind(qc,qcw,wc,nc,-999.0,-999.0);
+    splind(qc,qcw.data(),wc.data(),nc,-999.0,-999.0);
 
     //---- get approximate w value at stagnation point
     for (ic=2; ic<=nc; ic++){
@@ -11449,7 +11830,7 @@ void XFoil::cncalc(double qc[], bool lsymm)
 
 
     //---- set exact numerical w value at stagnation point from splined q(w)
-    sinvrt(wcle,0.0,qc,qcw,wc,nc);
+    sinvrt(wcle,0.0,qc,qcw.data(),wc.data(),nc);
 
     //---- set corresponding circle plane alpha
     alfcir = 0.5*(wcle - PI);
@@ -11516,7 +11897,7 @@ void XFoil::qspcir()
     for(int kqsp=1; kqsp<= nqsp;kqsp++)
     {
         qccalc(iacqsp,&alqsp[kqsp],&clqsp[kqsp],&cmqsp[kqsp],minf,qinf,
-               &nsp,w1,w2,w5,qspec[kqsp]);
+               &nsp,w1,w2,w5,qspec[kqsp].data());
         splqsp(kqsp);
     }
     lqspec = true;
@@ -11534,7 +11915,7 @@ void XFoil::splqsp(int kqsp)
 
     //---- usual spline with natural end bcs
     //    splind(qspec[kqsp][2],qspecp[kqsp][2],sspec[2], nsp-2, -999.0,-999.0);
-    splind(qspec[kqsp]+2-1,qspecp[kqsp]+2-1,sspec+2-1, nsp-2, -999.0,-999.0);
+    splind(qspec[kqsp].data()+2-1,qspecp[kqsp].data()+2-1,sspec.data()+2-1, nsp-2, -999.0,-999.0);
 
 
     //c//---- pseudo-monotonic spline with simple secant slope calculation
@@ -11544,10 +11925,10 @@ void XFoil::splqsp(int kqsp)
     //     the trailing edge and matching slopes at the interior points
 
     i = 1;
-    splind(qspec[kqsp]+i-1,qspecp[kqsp]+i-1,sspec+i-1,2,-999.0,qspecp[kqsp][i+1]);
+    splind(qspec[kqsp].data()+i-1,qspecp[kqsp].data()+i-1,sspec.data()+i-1,2,-999.0,qspecp[kqsp][i+1]);
 
     i = nsp-1;
-    splind(qspec[kqsp]+i-1,qspecp[kqsp]+i-1,sspec+i-1,2, qspecp[kqsp][i],-999.0);
+    splind(qspec[kqsp].data()+i-1,qspecp[kqsp].data()+i-1,sspec.data()+i-1,2, qspecp[kqsp][i],-999.0);
 
 }
 
@@ -11559,7 +11940,7 @@ void XFoil::ExecMDES()
     int kqsp = 1;
     int nqsp = 1; // for the present time
     if(!lqspec) {
-        cncalc(qspec[kqsp],lqsym);
+        cncalc(qspec[kqsp].data(),lqsym);
 
         //----- set new qspec(s) for all alphas or cls
         qspcir();
@@ -11707,7 +12088,7 @@ void XFoil::smooq(int kq1,int kq2,int kqsp)
 
     //---- solve for smoothed qspec array
     //      trisol(w2[kq1],w1[kq1],w3[kq1],qspec[kqsp][kq1],(kq2-kq1+1));
-    trisol(w2+kq1-1,w1+kq1-1,w3+kq1-1,qspec[kqsp]+kq1-1,(kq2-kq1+1));
+    trisol(w2+kq1-1,w1+kq1-1,w3+kq1-1,qspec[kqsp].data()+kq1-1,(kq2-kq1+1));
 
 }
 
@@ -11769,7 +12150,7 @@ void XFoil::pert_init(int kqsp)
     double dx=0, dy=0, qimoff=0;
     //---- calculate mapping coefficients for initial airfoil shape
     //      cncalc(qspec,false);
-    cncalc(qspec[kqsp]+1-1,false);
+    cncalc(qspec[kqsp].data()+1-1,false);
 
     //---- preset rotation offset of airfoil so that initial angle is close
     //-    to the old airfoil's angle
@@ -11896,6 +12277,15 @@ void XFoil::InitMDES()
     //    ntqspl = 1;
     //    if(lqslop) ntqspl = 4;
 
+    //---- re-initialize the circle plane if its resolution has been changed
+    if(nc1!=s_nCirclePoints)
+    {
+        nc1 = s_nCirclePoints;
+        leiw = false;
+        lscini = false;
+        lqspec = false;
+    }
+
     //---- see if current qspec, if any, didn't come from mixed-inverse
     if(nsp!=nc1){
         lqspec = false;
@@ -11904,8 +12294,8 @@ void XFoil::InitMDES()
     }
 
     //---- initialize fourier transform arrays if it hasn't been done
-    if(!leiw) eiwset(nc1);
-    leiw = true;
+    if(!leiw) leiw = eiwset(nc1);
+    if(!leiw) return;
 
     //---- if qspec alpha has never been set, set it to current alpha
     if(nqsp == 0) {
@@ -11930,7 +12320,7 @@ void XFoil::InitMDES()
 
     if(!lqspec) {
         //------ set cn coefficients from current q
-        cncalc(qgamm,false);
+        cncalc(qgamm.data(),false);
 
         //------ set qspec from cn coefficients
         qspcir();
@@ -43,7 +43,9 @@ See http://raphael.mit.edu/xfoil for more information.
 
 #include <QTextStream>
 
+#include <array>
 #include <complex>
+#include <vector>
 
 #include <xfoil_params.h>
 
@@ -72,6 +74,28 @@ struct blData
 };
 
 
+/**
+ * @struct blState
+ * The converged viscous solution of an operating point.
+ * Used to warm-start the BL of another XFoil instance which shares the same paneled geometry.
+ */
+struct blState
+{
+    public:
+        bool bValid=false;               /**< true if the state holds a converged solution */
+        double alfa=0, cl=0, minf=0, reinf=0;
+        int ist=0, nsys=0;
+        double sst=0, sst_go=0, sst_gp=0;
+        int iblte[ISX], nbl[ISX], itran[ISX];
+        bool tforce[ISX];
+        double xssitr[ISX], xoctr[ISX], yoctr[ISX];
+        int ipan[IVX][ISX], isys[IVX][ISX];
+        double vti[IVX][ISX], xssi[IVX][ISX];
+        double thet[IVX][ISX], dstr[IVX][ISX], ctau[IVX][ISX], uedg[IVX][ISX], mass[IVX][ISX];
+        double gam[IQX], qvis[IZX];
+};
+
+
 
 class XFOILLIBSHARED_EXPORT XFoil
 {
@@ -128,6 +152,10 @@ public:
     bool isBLInitialized() const {return lblini;}
     void setBLInitialized(bool bInitialized) {lblini = bInitialized;}
 
+    void getBLState(blState &state) const;
+    bool setBLState(blState const &state);
+    bool extrapolateBL(const blState *pStates[], double const *weight, int nStates);
+
     double QInf() const {return qinf;}
     void setQInf(double v) {qinf=v;}
 
@@ -145,6 +173,16 @@ public:
     static double VAccel() {return vaccel;}
     static void setVAccel(double accel) {vaccel=accel;}
 
+    static void setFactorCacheSize(int nEntries);
+    static int factorCacheSize();
+    static void clearFactorCache();
+    static int factorCacheHits();
+    static int factorCacheMisses();
+    static void resetFactorCacheStats();
+
+    static void setCirclePoints(int nPoints);
+    static int circlePoints() {return s_nCirclePoints;}
+
 private:
 
     void inter(double x0[], double xp0[], double y0[], double yp0[], double s0[],int n0,double sle0,
@@ -157,6 +195,8 @@ private:
     void qccalc(int ispec,double *alfa, double *cl, double *cm,double minf, double qinf, int *ncir, double xcir[], double ycir[], double scir[], double qcir[]);
     void mapgam(int iac, double &alg, double &clg, double &cmg);
     bool eiwset(int nc1);
+    void fftc(complex<double> *a, int nfft, bool bConjugate) const;
+    complex<double> eiwc(int ic, int m) const {return eiw[(m*(ic-1))%(nc-1)];}
     void cgauss(int nn,complex <double> z[IMX4+1][IMX4+1],complex <double> r[IMX4+1]);
     void zccalc(int mtest);
     void zcnorm(int mtest);
@@ -164,7 +204,7 @@ private:
     void piqsum();
     void ftp();
     void scinit(int n, double x[], double xp[], double y[], double yp[], double s[], double sle);
-    void mapgen(int n, double x[],double y[]);
+    void mapgen(int &n, double x[],double y[]);
 
     //    int kqtarg,nname,nprefix;
     void gamlin(int i, int j, double coef);
@@ -233,6 +273,9 @@ private:
     void sortol(double tol,int &kk,double s[],double w[]);
     bool getxyf(double x[],double xp[],double y[],double yp[],double s[], int n, double &tops, double &bots,double xf,double &yf);
     bool ggcalc();
+    quint64 panelHash() const;
+    bool loadFactors();
+    void storeFactors();
     bool hct(double hk, double msq, double &hc, double &hc_hk, double &hc_msq);
     bool hkin(double h, double msq, double &hk, double &hk_h, double &hk_msq);
     bool hsl(double hk, double &hs, double &hs_hk, double &hs_rt, double &hs_msq);
@@ -288,17 +331,20 @@ public:
     static double vaccel;
     static bool s_bCancel;
     static bool s_bFullReport;
+    static int s_nCirclePoints;
 
     QTextStream *m_pOutStream;
 
     double agte,ag0,qim0,qimold;
     double ssple, dwc,algam,clgam,cmgam;
     double clspec;
-    double sspec[IBX+1],xspoc[IBX+1],yspoc[IBX+1];
-    double qspec[IPX+1][IBX+1],qspecp[IPX+1][IBX+1];
+    std::vector<double> sspec,xspoc,yspoc;              /**< sized to max(IBX, ICXMAX)+1 */
+    std::vector<double> qspec[IPX+1],qspecp[IPX+1];
     double alqsp[IPX+1],clqsp[IPX+1],cmqsp[IPX+1];
-    complex<double> dzte, chordz, zleold, zcoldw[ICX+1];
-    complex<double> piq[ICX+1], cn[IMX+1], eiw[ICX+1][IMX+1];
+    complex<double> dzte, chordz, zleold;
+    std::vector<complex<double>> zcoldw, piq;          /**< sized to nc+1 by eiwset */
+    std::vector<complex<double>> cn;                    /**< sized to mc+1 by eiwset */
+    std::vector<complex<double>> eiw;                   /**< the nc-1 unit roots exp(i.2pi.k/(nc-1)) */
     double dnTrace[100];//... added techwinder
     double dgTrace[100];//... added techwinder
     int QMax;
@@ -320,7 +366,7 @@ public:
     double cpmn;
     double minf, reinf;
     bool lalfa, lvisc, lvconv, lwake;
-    double qgamm[IBX+1];
+    std::vector<double> qgamm;
     double hmom;
     double hfx,hfy;
     bool lcpxx;
@@ -355,14 +401,15 @@ public:
 
 private:
 
-    double wc[ICX+1],sc[ICX+1];
-    double scold[ICX+1],xcold[ICX+1],ycold[ICX+1];
+    std::vector<double> wc,sc;
+    std::vector<double> scold,xcold,ycold;
     double qf0[IQX+1],qf1[IQX+1],qf2[IQX+1],qf3[IQX+1];
 
     double qdof0,qdof1,qdof2,qdof3,ffilt;
 
-    complex<double> zc[ICX+1], zc_cn[ICX+1][IMX4+1];
-    complex<double> cnsav[IMX+1];
+    std::vector<complex<double>> zc;
+    std::vector<std::array<complex<double>, IMX4+1>> zc_cn;
+    std::vector<complex<double>> cnsav;
 
     int retyp, matyp;
     double rlx;
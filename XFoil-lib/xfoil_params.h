@@ -37,9 +37,10 @@
 
 
 //XFoil INVERSE parameters  - refer to XFoil documentation
-#define ICX 257     /**< number of circle-plane points for complex mapping   ( 2^n  + 1 ) */
-#define IMX 64      /**< number of complex mapping coefficients  Cn */
-#define IMX4 16     /**< = IMX/4 */
+#define ICX 257     /**< default number of circle-plane points for complex mapping   ( 2^n  + 1 ) */
+#define ICXMAX 1025 /**< max. number of circle-plane points; limited by the size of the w1..w8 work arrays */
+#define IMX 64      /**< default number of complex mapping coefficients  Cn = ICX/4 */
+#define IMX4 16     /**< max. number of mapping coefficients with geometry sensitivities dz/dCn */
 
 
 
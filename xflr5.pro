@@ -6,6 +6,13 @@ SUBDIRS = \
     XFoil-lib \
     xflr5v6 \
 
+# the headless benchmark of the solvers, only built with "qmake CONFIG+=bench"
+CONFIG(bench) {
+    SUBDIRS += bench
+    bench.file = xflr5v6/xflr5-bench.pro
+    bench.depends = XFoil-lib
+}
+
 TRANSLATIONS = translations/xflr5 v6.ts \
     translations/xflr5 v6_fr.ts \
     translations/xflr5 v6_de.ts \
@@ -111,6 +111,7 @@
 #include <xflobjects/objects3d/plane.h>
 #include <xflobjects/objects3d/wing.h>
 #include <xflobjects/objects_global.h>
+#include <xflobjects/resultcache.h>
 #include <xflscript/logwt.h>
 #include <xflscript/xflscriptexec.h>
 #include <xflscript/xflscriptreader.h>
@@ -1248,6 +1249,14 @@ void MainFrame::createMiarexActions()
     m_pExporttoSTL->setStatusTip(tr("Export the current wing to a file in the STL format"));
     connect(m_pExporttoSTL, SIGNAL(triggered()), m_pMiarex, SLOT(onExporttoSTL()));
 
+    m_pImportSTLMesh = new QAction(tr("Import STL reference mesh"), this);
+    m_pImportSTLMesh->setStatusTip(tr("Import the triangles of an STL file, to be displayed with the current plane in the 3D view"));
+    connect(m_pImportSTLMesh, SIGNAL(triggered()), m_pMiarex, SLOT(onImportSTLFile()));
+
+    m_pClearSTLMesh = new QAction(tr("Clear STL reference mesh"), this);
+    m_pClearSTLMesh->setStatusTip(tr("Remove the imported STL mesh from the 3D view"));
+    connect(m_pClearSTLMesh, SIGNAL(triggered()), m_pMiarex, SLOT(onClearSTLMesh()));
+
     m_pExportCurWOpp = new QAction(tr("Export"), this);
     m_pExportCurWOpp->setStatusTip(tr("Export the current operating point to a text or csv file"));
     connect(m_pExportCurWOpp, SIGNAL(triggered()), m_pMiarex, SLOT(onExportCurPOpp()));
@@ -1492,6 +1501,9 @@ void MainFrame::createMiarexMenus()
             m_pCurrentPlaneMenu->addAction(m_pExporttoSTL);
             m_pCurrentPlaneMenu->addAction(m_pExportPlaneToXML);
             m_pCurrentPlaneMenu->addSeparator();
+            m_pCurrentPlaneMenu->addAction(m_pImportSTLMesh);
+            m_pCurrentPlaneMenu->addAction(m_pClearSTLMesh);
+            m_pCurrentPlaneMenu->addSeparator();
             m_pCurrentPlaneMenu->addAction(m_pShowPlaneWPlrsOnly);
             m_pCurrentPlaneMenu->addAction(m_pShowPlaneWPlrs);
             m_pCurrentPlaneMenu->addAction(m_pHidePlaneWPlrs);
@@ -2803,6 +2815,7 @@ void MainFrame::deleteProject(bool bClosing)
     m_pXDirect->setCurFoil(nullptr);
     m_pXDirect->setCurPolar(nullptr);
     m_pXDirect->setCurOpp(nullptr);
+    m_pMiarex->stopAnimate();
 
     // clear everything
     Objects3d::deleteObjects();
@@ -3314,6 +3327,10 @@ bool MainFrame::loadSettings()
 
         m_SaveInterval = settings.value("AutoSaveInterval", 10).toInt();
 
+        ResultCache::setEnabled(settings.value("ResultCache", false).toBool());
+        QString cacheDir = settings.value("ResultCacheDir").toString();
+        if(cacheDir.length()) ResultCache::setDirPath(cacheDir);
+
         //        a = settings.value("RecentFileSize").toInt();
         QString RecentF,strange;
         m_RecentFiles.clear();
@@ -4541,6 +4558,8 @@ void MainFrame::saveSettings()
         settings.setValue("AutoLoadLastProject",m_bAutoLoadLast);
         settings.setValue("SaveOpps", m_bSaveOpps);
         settings.setValue("SaveWOpps", m_bSaveWOpps);
+        settings.setValue("ResultCache", ResultCache::isEnabled());
+        settings.setValue("ResultCacheDir", ResultCache::dirPath());
         settings.setValue("RecentFileSize", m_RecentFiles.size());
 
 
@@ -6214,7 +6233,7 @@ void MainFrame::exportGraph(Graph *pGraph)
 void MainFrame::onPreferences()
 {
     PreferencesDlg dlg(this);
-    dlg.m_pSaveOptionsWt->initWidget(m_bAutoLoadLast, m_bSaveOpps, m_bSaveWOpps, m_bAutoSave, m_SaveInterval);
+    dlg.m_pSaveOptionsWt->initWidget(m_bAutoLoadLast, m_bSaveOpps, m_bSaveWOpps, m_bAutoSave, m_SaveInterval, ResultCache::isEnabled());
     dlg.m_pUnitsWt->initWidget();
     dlg.m_pDisplayOptionsWt->initWidget();
     dlg.m_pLanguageWt->initWidget();
@@ -6226,6 +6245,7 @@ void MainFrame::onPreferences()
         m_SaveInterval  = dlg.m_pSaveOptionsWt->m_SaveInterval;
         m_bSaveOpps     = dlg.m_pSaveOptionsWt->m_bOpps;
         m_bSaveWOpps    = dlg.m_pSaveOptionsWt->m_bWOpps;
+        ResultCache::setEnabled(dlg.m_pSaveOptionsWt->m_bResultCache);
 
         if(m_bAutoSave)
         {
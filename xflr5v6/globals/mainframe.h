@@ -325,6 +325,7 @@ class MainFrame : public QMainWindow
         QAction *m_pDefineWPolar, *m_pDefineStabPolar, *m_pDefineWPolarObjectAct, *m_pAadvancedSettings;
         QAction *m_pShowTargetCurve, *m_pShowXCmRefLocation, *m_pShowStabCurve, *m_pShowFinCurve, *m_pShowWing2Curve;
         QAction *m_pExporttoAVL, *m_pExporttoSTL;
+        QAction *m_pImportSTLMesh, *m_pClearSTLMesh;
         QAction *m_pManagePlanesAct, *m_pScaleWingAct;
         QAction *m_pImportWPolars, *m_pExportWPolars, *m_pPlaneInertia;
         QAction *m_pShowFlapMoments;
@@ -44,6 +44,7 @@
 #include <xflgraph/graph.h>
 #include <xflobjects/objects3d/wing.h>
 #include <xflobjects/objects3d/wpolar.h>
+#include <xflobjects/resultcache.h>
 
 QByteArray LLTAnalysisDlg::s_Geometry;
 
@@ -240,6 +241,8 @@ void LLTAnalysisDlg::analyze()
     Curve *pCurve = m_pIterGraph->addCurve();
     m_pTheTask->m_ptheLLTAnalysis->setCurvePointers(&pCurve->m_x, &pCurve->m_y);
 
+    ResultCache::resetStatistics();
+
     //run the instance asynchronously
     disconnect(m_pTheTask, nullptr, nullptr, nullptr);
     connect(m_pTheTask,  SIGNAL(taskFinished()),   this,          SLOT(onTaskFinished()));
@@ -263,9 +266,8 @@ void LLTAnalysisDlg::onTaskFinished()
             }
 
             pPOpp->setVisible(true);
-
-            Objects3d::insertPOpp(pPOpp);
         }
+        Objects3d::insertPOpps(m_pTheTask->m_ptheLLTAnalysis->m_PlaneOppList);
     }
     else
     {
@@ -278,6 +280,13 @@ void LLTAnalysisDlg::onTaskFinished()
     else if(m_pTheTask->m_ptheLLTAnalysis->m_bError)  strange += tr(" ...some points are unconverged");
 
     strange+= "\n";
+    if(ResultCache::isEnabled()) strange += ResultCache::statistics(ResultCache::PLANEOPP);
+
+#ifdef XFL_PERFSTATS
+    PerfStats perfStats = m_pTheTask->perfStats();
+    strange += perfStats.table();
+    perfStats.writeSidecar("llt", m_pTheTask->m_pPlane->name(), m_pTheTask->m_pWPolar->polarName());
+#endif
 
     m_pTheTask->m_ptheLLTAnalysis->traceLog(strange);
     onProgress();
@@ -36,6 +36,7 @@
 #include "panelanalysisdlg.h"
 #include <miarex/miarex.h>
 #include <xflobjects/objects3d/objects3d.h>
+#include <xflobjects/resultcache.h>
 
 #include <xflanalysis/plane_analysis/panelanalysis.h>
 #include <xflanalysis/plane_analysis/planetask.h>
@@ -226,6 +227,8 @@ void PanelAnalysisDlg::analyze()
     m_Timer.setInterval(250);
     m_Timer.start();
 
+    ResultCache::resetStatistics();
+
     //run the instance asynchronously
     disconnect(m_pTheTask, nullptr, nullptr, nullptr);
     connect(m_pTheTask,  SIGNAL(taskFinished()),   this,  SLOT(onTaskFinished()));
@@ -242,6 +245,7 @@ void PanelAnalysisDlg::onTaskFinished()
     //Store the POpps if requested
     if(PlaneOpp::s_bStoreOpps)
     {
+        QVector<PlaneOpp*> POppList;
         for(int iPOpp=0; iPOpp<m_pTheTask->m_pthePanelAnalysis->m_PlaneOppList.size(); iPOpp++)
         {
             //add the data to the polar object
@@ -254,13 +258,14 @@ void PanelAnalysisDlg::onTaskFinished()
 
             pPOpp->setVisible(true);
 
-            if(PlaneOpp::s_bKeepOutOpps || !pPOpp->isOut())    Objects3d::insertPOpp(pPOpp);
+            if(PlaneOpp::s_bKeepOutOpps || !pPOpp->isOut())    POppList.append(pPOpp);
             else
             {
                 delete pPOpp;
                 pPOpp = nullptr;
             }
         }
+        Objects3d::insertPOpps(POppList);
     }
     else
     {
@@ -273,6 +278,13 @@ void PanelAnalysisDlg::onTaskFinished()
         strong = "\n"+tr("Panel Analysis completed successfully")+"\n";
     else if (PanelAnalysis::s_bWarning)
         strong = "\n"+tr("Panel Analysis completed ... Errors encountered")+"\n";
+    if(ResultCache::isEnabled()) strong += ResultCache::statistics(ResultCache::PLANEOPP);
+
+#ifdef XFL_PERFSTATS
+    PerfStats perfStats = m_pTheTask->perfStats();
+    strong += perfStats.table();
+    perfStats.writeSidecar("panel", m_pTheTask->m_pPlane->name(), m_pTheTask->m_pWPolar->polarName());
+#endif
 
     updateOutput(strong);
     onProgress();
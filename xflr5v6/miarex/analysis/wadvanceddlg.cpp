@@ -41,6 +41,8 @@ WAdvancedDlg::WAdvancedDlg(QWidget *pParent) : QDialog(pParent)
     m_NLLTStation  = 20;
     m_AlphaPrec    = 0.01;
     m_Relax        = 20.;
+    m_bLLTNewton   = false;
+    m_bLLTMultiThread = true;
     m_Iter         = 100;
 
     m_MaxWakeIter     = 1;
@@ -53,6 +55,7 @@ WAdvancedDlg::WAdvancedDlg(QWidget *pParent) : QDialog(pParent)
     m_bDirichlet      = true;
     m_bLogFile        = true;
     m_bKeepOutOpps    = false;
+    m_bCompactOpps    = false;
 
     m_ControlPos = 0.75;
     m_VortexPos  = 0.25;
@@ -78,8 +81,12 @@ void WAdvancedDlg::setupLayout()
         {
             m_pchLogFile     = new QCheckBox(tr("View Log File after errors"));
             m_pchKeepOutOpps = new QCheckBox(tr("Store points outside the polar mesh"));
+            m_pchCompactOpps = new QCheckBox(tr("Store panel results in compact form"));
+            m_pchCompactOpps->setToolTip(tr("Reduces the memory used by the operating points of large panel models.\n"
+                                            "The Cp coefficients are held with a reduced precision."));
             pAllLayout->addWidget(m_pchLogFile);
             pAllLayout->addWidget(m_pchKeepOutOpps);
+            pAllLayout->addWidget(m_pchCompactOpps);
         }
         pAllBox->setLayout(pAllLayout);
     }
@@ -167,6 +174,13 @@ void WAdvancedDlg::setupLayout()
             pLLTLayout->addWidget(m_pdeRelax,2,2);
             pLLTLayout->addWidget(m_pdeAlphaPrec,3,2);
             pLLTLayout->addWidget(m_pieIterMax,4,2);
+            m_pchLLTNewton = new QCheckBox(tr("Newton iterations"));
+            m_pchLLTNewton->setToolTip(tr("Solve the non-linear lifting line equations with Newton's method using the local polar slopes.\n"
+                                          "Falls back to the relaxed iterations if the residual increases."));
+            pLLTLayout->addWidget(m_pchLLTNewton,5,2);
+            m_pchLLTMultiThread = new QCheckBox(tr("Multithreaded sweeps"));
+            m_pchLLTMultiThread->setToolTip(tr("Solve the operating points of a sequence concurrently"));
+            pLLTLayout->addWidget(m_pchLLTMultiThread,6,2);
         }
         pLLTBox->setLayout(pLLTLayout);
     }
@@ -287,6 +301,8 @@ void WAdvancedDlg::onOK()
 void WAdvancedDlg::onResetDefaults()
 {
     m_Relax            = 20.0;
+    m_bLLTNewton       = false;
+    m_bLLTMultiThread  = true;
     m_AlphaPrec        = 0.01;
     m_Iter             = 100;
     m_NLLTStation      = 20;
@@ -300,6 +316,7 @@ void WAdvancedDlg::onResetDefaults()
     m_bDirichlet       = true;
     m_bTrefftz         = true;
     m_bKeepOutOpps     = false;
+    m_bCompactOpps     = false;
     setParams();
 }
 
@@ -307,6 +324,8 @@ void WAdvancedDlg::onResetDefaults()
 void WAdvancedDlg::readParams()
 {
     m_Relax           = m_pdeRelax->value();
+    m_bLLTNewton      = m_pchLLTNewton->isChecked();
+    m_bLLTMultiThread = m_pchLLTMultiThread->isChecked();
     m_AlphaPrec       = m_pdeAlphaPrec->value();
     m_CoreSize        = m_pdeCoreSize->value() / Units::mtoUnit();
     m_MinPanelSize    = m_pdeMinPanelSize->value() / Units::mtoUnit();
@@ -317,6 +336,7 @@ void WAdvancedDlg::readParams()
     m_bDirichlet      = m_prbDirichlet->isChecked();
     m_bTrefftz        = true;
     m_bKeepOutOpps    = m_pchKeepOutOpps->isChecked();
+    m_bCompactOpps    = m_pchCompactOpps->isChecked();
     m_bLogFile        = m_pchLogFile->isChecked();
 }
 
@@ -325,6 +345,8 @@ void WAdvancedDlg::setParams()
 {
     m_pieIterMax->setValue(m_Iter);
     m_pdeRelax->setValue(m_Relax);
+    m_pchLLTNewton->setChecked(m_bLLTNewton);
+    m_pchLLTMultiThread->setChecked(m_bLLTMultiThread);
     m_pdeAlphaPrec->setValue(m_AlphaPrec);
     m_pieNStation->setValue(m_NLLTStation);
 
@@ -334,6 +356,7 @@ void WAdvancedDlg::setParams()
 
     m_pchLogFile->setChecked(m_bLogFile);
     m_pchKeepOutOpps->setChecked(m_bKeepOutOpps);
+    m_pchCompactOpps->setChecked(m_bCompactOpps);
 
     m_pdeControlPos->setValue(m_ControlPos*100.0);
     m_pdeVortexPos->setValue(m_VortexPos*100.0);
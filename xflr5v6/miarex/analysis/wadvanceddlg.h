@@ -55,6 +55,9 @@ class WAdvancedDlg : public QDialog
 
         QCheckBox *m_pchLogFile;
         QCheckBox *m_pchKeepOutOpps;
+        QCheckBox *m_pchCompactOpps;
+        QCheckBox *m_pchLLTNewton;
+        QCheckBox *m_pchLLTMultiThread;
         QRadioButton *m_prbDirichlet, *m_prbNeumann;
         DoubleEdit *m_pdeRelax;
         DoubleEdit *m_pdeAlphaPrec;
@@ -69,6 +72,9 @@ class WAdvancedDlg : public QDialog
         bool m_bDirichlet;
         bool m_bTrefftz;
         bool m_bKeepOutOpps;
+        bool m_bCompactOpps;
+        bool m_bLLTNewton;
+        bool m_bLLTMultiThread;
 
         int m_Iter;
         int m_NLLTStation;
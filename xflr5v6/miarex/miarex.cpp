@@ -25,6 +25,7 @@
 #include <QDebug>
 #include <QDesktopServices>
 #include <QDockWidget>
+#include <QElapsedTimer>
 #include <QFileDialog>
 #include <QMenu>
 #include <QStatusBar>
@@ -184,6 +185,8 @@ Miarex::Miarex(QWidget *parent) : QWidget(parent)
     m_LLTMaxIterations          = 100;
     LLTAnalysis::s_CvPrec       =   0.01;
     LLTAnalysis::s_RelaxMax     =  20.0;
+    LLTAnalysis::s_bNewton      = false;
+    LLTAnalysis::s_bMultiThread = true;
     LLTAnalysis::s_NLLTStations = 20;
 
     Panel::s_VortexPos = 0.25;
@@ -226,6 +229,7 @@ Miarex::Miarex(QWidget *parent) : QWidget(parent)
     m_InducedDragPoint = 0;
 
     m_pTimerWOpp= new QTimer(this);
+    m_pTimerWOpp->setTimerType(Qt::PreciseTimer);
     m_posAnimateWOpp         = 0;
 
     m_pTimerMode= new QTimer(this);
@@ -696,6 +700,8 @@ void Miarex::createCpCurves()
 
     if(!m_pCurPlane || !m_pCurPOpp || !m_bShowCp) return;
 
+    m_pCurPOpp->expandResults();
+
     int coef = m_pCurWPolar->bThinSurfaces() ? 1 : 2;
 
     m_CurSpanPos = qMax(-1.0, m_CurSpanPos);
@@ -1863,11 +1869,14 @@ bool Miarex::loadSettings(QSettings &settings)
         pStabView->updateControlModelData();
 
         PlaneOpp::s_bKeepOutOpps  = settings.value("KeepOutOpps").toBool();
+        PlaneOpp::s_bCompactOpps  = settings.value("CompactOpps", PlaneOpp::s_bCompactOpps).toBool();
 
         W3dPrefs::s_MassColor = settings.value("MassColor", W3dPrefs::s_MassColor).value<QColor>();
 
         LLTAnalysis::s_CvPrec       = settings.value("CvPrec").toDouble();
         LLTAnalysis::s_RelaxMax     = settings.value("RelaxMax").toDouble();
+        LLTAnalysis::s_bNewton      = settings.value("LLTNewton", LLTAnalysis::s_bNewton).toBool();
+        LLTAnalysis::s_bMultiThread = settings.value("LLTMultiThread", LLTAnalysis::s_bMultiThread).toBool();
         LLTAnalysis::s_NLLTStations = settings.value("NLLTStations").toInt();
 
         PanelAnalysis::s_bTrefftz   = settings.value("Trefftz", true).toBool();
@@ -2214,20 +2223,14 @@ void Miarex::onAnimateWOpp()
 
     if(m_pchWOppAnimate->isChecked())
     {
-        if(m_pCurPlane && m_pCurPOpp)
-        {
-            for (int l=0; l< Objects3d::planeOppCount(); l++)
-            {
-                PlaneOpp*pPOpp = Objects3d::planeOppAt(l);
+        // the frames of the animation, in the order of the polar
+        m_AnimatePOpps = Objects3d::planeOpps(m_pCurPlane, m_pCurWPolar);
+        m_posAnimateWOpp = std::max(0, m_AnimatePOpps.indexOf(m_pCurPOpp));
 
-                if (pPOpp &&
-                        pPOpp->polarName() == m_pCurWPolar->polarName() &&
-                        pPOpp->planeName() == m_pCurPlane->name())
-                {
-                    if(fabs(m_pCurPOpp->alpha() - pPOpp->alpha())<0.0001)
-                        m_posAnimateWOpp = l;
-                }
-            }
+        if(m_iView==xfl::W3DVIEW)
+        {
+            m_pgl3dMiarexView->setFrameCache(true);
+            m_pgl3dMiarexView->prepareFrames(m_AnimatePOpps);
         }
 
         m_bAnimateWOpp  = true;
@@ -2344,96 +2347,64 @@ void Miarex::onAnimateModeSingle(bool bStep)
 */
 void Miarex::onAnimateWOppSingle()
 {
-    bool bIsValid, bSkipOne;
-    int size=0;
-    PlaneOpp *pPOpp;
-
     //KickIdle
     if(m_iView!=xfl::W3DVIEW && m_iView !=xfl::WOPPVIEW) return; //nothing to animate
     if(!m_pCurPlane || !m_pCurWPolar) return;
 
-    if(m_pCurPlane)    size = Objects3d::planeOppCount();
-    if(size<=1) return;
+    // the snapshot holds raw pointers: stop if operating points have been added or deleted meanwhile
+    QVector<PlaneOpp*> POppList = Objects3d::planeOpps(m_pCurPlane, m_pCurWPolar);
+    if(POppList!=m_AnimatePOpps)
+    {
+        if(!POppList.contains(m_pCurPOpp)) m_pCurPOpp = nullptr;
+        stopAnimate();
+        return;
+    }
 
-    bIsValid = false;
-    bSkipOne = false;
+    int size = m_AnimatePOpps.size();
+    if(size<=1) return;
 
-    while(!bIsValid)
+    // back and forth through the polar's operating points, without repeating the end points
+    if(m_bAnimateWOppPlus)
     {
-        pPOpp = nullptr;
-        //Find the current position to display
-
-        if(m_pCurPlane)
+        m_posAnimateWOpp++;
+        if (m_posAnimateWOpp >= size)
         {
-            pPOpp = Objects3d::planeOppAt(m_posAnimateWOpp);
-            if(!pPOpp) return;
+            m_posAnimateWOpp = size-2;
+            m_bAnimateWOppPlus = false;
         }
-        if(m_pCurPlane)
-            bIsValid =(pPOpp->polarName()==m_pCurWPolar->polarName()  &&  pPOpp->planeName()==m_pCurPlane->name());
-
-        if (bIsValid && !bSkipOne)
+    }
+    else
+    {
+        m_posAnimateWOpp--;
+        if (m_posAnimateWOpp <0)
         {
-            if(m_pCurPlane)
-            {
-                m_pCurPOpp = pPOpp;
-                for(int iw=0; iw<MAXWINGS;iw++)
-                {
-                    if(m_pCurPOpp->m_pWOpp[iw]) m_pWOpp[iw] = m_pCurPOpp->m_pWOpp[iw];
-                    else                             m_pWOpp[iw] = nullptr;
-                }
-
-            }
-            m_pCurPOpp = pPOpp;
-            m_bCurPOppOnly = true;
-
-            if (m_iView==xfl::WOPPVIEW)
-            {
-                m_bResetTextLegend = true;
-                s_bResetCurves = true;
-                updateView();
-            }
-            else if (m_iView==xfl::W3DVIEW)
-            {
-                m_bResetTextLegend = true;
-                gl3dMiarexView::s_bResetglOpp      = true;
-                gl3dMiarexView::s_bResetglDownwash = true;
-                gl3dMiarexView::s_bResetglLift     = true;
-                gl3dMiarexView::s_bResetglDrag     = true;
-                gl3dMiarexView::s_bResetglWake     = true;
-                gl3dMiarexView::s_bResetglLegend   = true;
-                gl3dMiarexView::s_bResetglStream   = true;
-
-                updateView();
-            }
-
-            //select the PlanePOpp in the top listbox
-            //            s_pMainFrame->SelectWOpp(m_pCurPOpp->m_pPlaneWOpp[0]);
+            m_posAnimateWOpp = 1;
+            m_bAnimateWOppPlus = true;
         }
-        else if(bIsValid) bSkipOne = false;
+    }
 
-        if(m_bAnimateWOppPlus)
-        {
-            m_posAnimateWOpp++;
-            if (m_posAnimateWOpp >= size)
-            {
-                m_posAnimateWOpp = size-1;
-                m_bAnimateWOppPlus = false;
-                bSkipOne = true;
-            }
-        }
-        else
-        {
-            m_posAnimateWOpp--;
-            if (m_posAnimateWOpp <0)
-            {
-                m_posAnimateWOpp = 0;
-                m_bAnimateWOppPlus = true;
-                bSkipOne = true;
-            }
-        }
+    m_pCurPOpp = m_AnimatePOpps.at(m_posAnimateWOpp);
+    m_pCurPOpp->expandResults();
+    for(int iw=0; iw<MAXWINGS;iw++)
+    {
+        if(m_pCurPOpp->m_pWOpp[iw]) m_pWOpp[iw] = m_pCurPOpp->m_pWOpp[iw];
+        else                        m_pWOpp[iw] = nullptr;
+    }
+    m_bCurPOppOnly = true;
+    m_bResetTextLegend = true;
 
-        if(m_posAnimateWOpp<0 || m_posAnimateWOpp>=size) return;
+    if (m_iView==xfl::WOPPVIEW)
+    {
+        s_bResetCurves = true;
     }
+    else if (m_iView==xfl::W3DVIEW)
+    {
+        // the lift, drag and downwash buffers are rebuilt or restored from the view's frame cache with the operating point
+        gl3dMiarexView::s_bResetglOpp      = true;
+        gl3dMiarexView::s_bResetglLegend   = true;
+        gl3dMiarexView::s_bResetglStream   = true;
+    }
+    updateView();
 }
 
 
@@ -2478,6 +2449,8 @@ void Miarex::onAdvancedSettings()
     waDlg.m_MinPanelSize    = Wing::s_MinPanelSize;
     waDlg.m_AlphaPrec       = LLTAnalysis::s_CvPrec;
     waDlg.m_Relax           = LLTAnalysis::s_RelaxMax;
+    waDlg.m_bLLTNewton      = LLTAnalysis::s_bNewton;
+    waDlg.m_bLLTMultiThread = LLTAnalysis::s_bMultiThread;
     waDlg.m_NLLTStation     = LLTAnalysis::s_NLLTStations;
 
     waDlg.m_bTrefftz        = PanelAnalysis::s_bTrefftz;
@@ -2490,6 +2463,7 @@ void Miarex::onAdvancedSettings()
     waDlg.m_Iter            = m_LLTMaxIterations;
     waDlg.m_bDirichlet      = m_bDirichlet;
     waDlg.m_bKeepOutOpps    = PlaneOpp::s_bKeepOutOpps;
+    waDlg.m_bCompactOpps    = PlaneOpp::s_bCompactOpps;
     waDlg.m_bLogFile        = s_bLogFile;
     waDlg.m_WakeInterNodes  = m_WakeInterNodes;
 
@@ -2499,6 +2473,8 @@ void Miarex::onAdvancedSettings()
         Wing::s_MinPanelSize         = waDlg.m_MinPanelSize;
         LLTAnalysis::s_CvPrec        = waDlg.m_AlphaPrec;
         LLTAnalysis::s_RelaxMax      = waDlg.m_Relax;
+        LLTAnalysis::s_bNewton       = waDlg.m_bLLTNewton;
+        LLTAnalysis::s_bMultiThread  = waDlg.m_bLLTMultiThread;
         LLTAnalysis::s_NLLTStations  = waDlg.m_NLLTStation;
 
         PanelAnalysis::s_bTrefftz  = waDlg.m_bTrefftz;
@@ -2508,6 +2484,7 @@ void Miarex::onAdvancedSettings()
         Panel::s_VortexPos         = waDlg.m_VortexPos;
 
         PlaneOpp::s_bKeepOutOpps   = waDlg.m_bKeepOutOpps;
+        PlaneOpp::s_bCompactOpps   = waDlg.m_bCompactOpps;
 
         m_LLTMaxIterations     = waDlg.m_Iter;
         m_bDirichlet           = waDlg.m_bDirichlet;
@@ -2993,6 +2970,7 @@ void Miarex::onDeleteAllWPlrOpps()
  */
 void Miarex::onDeleteAllWOpps()
 {
+    stopAnimate();
     emit projectModified();
 
     for (int i = Objects3d::planeOppCount()-1; i>=0; i--)
@@ -3021,7 +2999,7 @@ void Miarex::onDeleteAllWOpps()
 void Miarex::onDeleteCurPlane()
 {
     if(!m_pCurPlane) return;
-    m_bAnimateWOpp = false;
+    stopAnimate();
 
     QString strong;
     if(m_pCurPlane) strong = tr("Are you sure you want to delete the plane :\n") +  m_pCurPlane->name() +"?\n";
@@ -3176,7 +3154,7 @@ void Miarex::onDeletePlaneWPolars()
 void Miarex::onDeleteCurWPolar()
 {
     if(!m_pCurWPolar) return;
-    m_bAnimateWOpp = false;
+    stopAnimate();
 
     QString strong = tr("Are you sure you want to delete the polar :\n") +  m_pCurWPolar->polarName() +"?\n";
     if (QMessageBox::Yes != QMessageBox::question(s_pMainFrame, tr("Question"), strong,
@@ -3861,6 +3839,7 @@ void Miarex::onScaleWing()
 void Miarex::onExportCurPOpp()
 {
     if(!m_pCurPOpp)return ;// is there anything to export ?
+    m_pCurPOpp->expandResults();
 
     int iStrip=0,j=0,k=0,l=0,p=0, coef=0;
     xfl::enumTextFileType exporttype;
@@ -4880,6 +4859,7 @@ void Miarex::onImportWPolars()
 
                 strong = inStream.readLine();// "   alpha      CL          ICd   ..."
 
+                QVector<PlaneOpp*> POppList;
                 bRead = true;
                 while( bRead)
                 {
@@ -4914,13 +4894,17 @@ void Miarex::onImportWPolars()
                             pPOpp->m_QInf   = values.at(11).toDouble();
                             pPOpp->m_CP.x   = values.at(12).toDouble();
 
-                            pWPolar->addPlaneOpPoint(pPOpp);
+                            POppList.append(pPOpp);
                         }
                         else bRead = false;
                     }
                     else bRead = false;
                 }
 
+                // the operating points are only used to transfer the data to the polar
+                pWPolar->addPlaneOpPoints(POppList);
+                qDeleteAll(POppList);
+
                 QColor clr = xfl::randomColor(!DisplayOptions::isLightTheme());
                 pWPolar->setColor(clr);
 
@@ -4982,6 +4966,8 @@ void Miarex::onManagePlanes()
     QString PlaneName = "";
     if(m_pCurPlane)     PlaneName = m_pCurPlane->name();
 
+    stopAnimate();
+
     ManagePlanesDlg uDlg(s_pMainFrame);
     uDlg.initDialog(PlaneName);
     uDlg.exec();
@@ -5216,6 +5202,7 @@ void Miarex::onRenameCurWPolar()
 
         // it's a real overwrite
         // so find and delete the existing WPolar with the new name
+        stopAnimate();
 
         for(int ipb=0; ipb<Objects3d::polarCount(); ipb++)
         {
@@ -5241,14 +5228,7 @@ void Miarex::onRenameCurWPolar()
     }
 
     //set the new name
-    for (int l=Objects3d::planeOppCount()-1;l>=0; l--)
-    {
-        PlaneOpp *pPOpp = Objects3d::planeOppAt(l);
-        if (pPOpp->planeName() == m_pCurPlane->name() && pPOpp->polarName()==m_pCurWPolar->polarName())
-        {
-            pPOpp->setPolarName(dlg.newName());
-        }
-    }
+    Objects3d::renamePOppPolar(m_pCurPlane->name(), m_pCurWPolar->polarName(), dlg.newName());
 
     m_pCurWPolar->setPolarName(dlg.newName());
 
@@ -5325,6 +5305,7 @@ void Miarex::onResetCurWPolar()
     if (QMessageBox::Yes != QMessageBox::question(s_pMainFrame, tr("Question"), strong,
                                                   QMessageBox::Yes|QMessageBox::No,
                                                   QMessageBox::Yes)) return;
+    stopAnimate();
     m_bResetTextLegend = true;
     m_pCurWPolar->clearData();
 
@@ -6287,6 +6268,7 @@ bool Miarex::saveSettings(QSettings &settings)
         settings.setValue("bVLM1", WPolarDlg::s_WPolar.bVLM1());
         settings.setValue("Dirichlet", m_bDirichlet);
         settings.setValue("KeepOutOpps", PlaneOpp::s_bKeepOutOpps);
+        settings.setValue("CompactOpps", PlaneOpp::s_bCompactOpps);
         settings.setValue("ShowWing", m_bShowWingCurve[0]);
         settings.setValue("ShowWing2", m_bShowWingCurve[1]);
         settings.setValue("ShowStab", m_bShowWingCurve[2]);
@@ -6313,6 +6295,8 @@ bool Miarex::saveSettings(QSettings &settings)
 
         settings.setValue("CvPrec", LLTAnalysis::s_CvPrec);
         settings.setValue("RelaxMax", LLTAnalysis::s_RelaxMax);
+        settings.setValue("LLTNewton", LLTAnalysis::s_bNewton);
+        settings.setValue("LLTMultiThread", LLTAnalysis::s_bMultiThread);
         settings.setValue("NLLTStations", LLTAnalysis::s_NLLTStations);
 
         settings.setValue("Trefftz", PanelAnalysis::s_bTrefftz);
@@ -7238,6 +7222,8 @@ void Miarex::stopAnimate()
     m_pchWOppAnimate->setChecked(false);
     m_pTimerWOpp->stop();
     m_pTimerMode->stop();
+    m_AnimatePOpps.clear();
+    if(m_pgl3dMiarexView) m_pgl3dMiarexView->setFrameCache(false);
 
     StabViewDlg *pStabView = s_pMainFrame->m_pStabView;
     m_bAnimateMode = false;
@@ -7426,6 +7412,7 @@ void Miarex::paintPanelForceLegendText(QPainter &painter)
 {
     if(!m_pCurWPolar || !m_pCurPOpp) return;
     if(!m_bPanelForce || m_pCurPOpp->analysisMethod()<xfl::VLMMETHOD) return;
+    m_pCurPOpp->expandResults();
 
     QString strPressure, strong;
     int p, i;
@@ -7557,6 +7544,7 @@ bool Miarex::setPlaneOpp(PlaneOpp *pPOpp)
     m_pCurPOpp = pPOpp;
     if(m_pCurPOpp)
     {
+        m_pCurPOpp->expandResults();
         for(int iw=0; iw<MAXWINGS;iw++)
         {
             if(m_pCurPOpp->m_pWOpp[iw]) m_pWOpp[iw] = m_pCurPOpp->m_pWOpp[iw];
@@ -7827,10 +7815,12 @@ void Miarex::onExporttoSTL()
 
     if(dlg.exec()==QDialog::Rejected) return;
 
+    bool b3dPrint = STLExportDlg::s_iObject>0 && STLExportDlg::s_i3dOutputStyle!=0;
+
     QFileDialog Fdlg(this);
     FileName = Fdlg.getSaveFileName(this, tr("Export to STL File"),
                                     xfl::s_LastDirName + "/"+FileName+".stl",
-                                    tr("STL File (*.stl)"),
+                                    b3dPrint ? tr("STL File (*.stl);;OBJ File (*.obj)") : tr("STL File (*.stl)"),
                                     &filter, QFileDialog::DontConfirmOverwrite);
 
     if(!FileName.length()) return;
@@ -7841,8 +7831,16 @@ void Miarex::onExporttoSTL()
     int pos = FileName.lastIndexOf("/");
     if(pos>0) xfl::s_LastDirName = FileName.left(pos);
 
-    pos = FileName.indexOf(".stl", Qt::CaseInsensitive);
-    if(pos<0) FileName += ".stl";
+    bool bOBJ = b3dPrint && (FileName.endsWith(".obj", Qt::CaseInsensitive) || filter.contains("obj", Qt::CaseInsensitive));
+    if(bOBJ)
+    {
+        if(!FileName.endsWith(".obj", Qt::CaseInsensitive)) FileName += ".obj";
+    }
+    else
+    {
+        pos = FileName.indexOf(".stl", Qt::CaseInsensitive);
+        if(pos<0) FileName += ".stl";
+    }
 
     QFile XFile(FileName);
 
@@ -7870,44 +7868,32 @@ void Miarex::onExporttoSTL()
 
         } else {
             //qDebug() << "b3DPrint";
-            // 3dPrintable does both binary and text output, but requires handles to both format types
+            // the printable mesh is built in memory, then written in one pass in the requested format
             // Although the dlgbox asks for mm, xflr5 uses SI units, so switch them here
             m_pCurPlane->wing()->ribSpacing = STLExportDlg::s_dRibSpacing/1000;
             m_pCurPlane->wing()->ribThickness = STLExportDlg::s_dRibThickness/1000;
             m_pCurPlane->wing()->skinThickness = STLExportDlg::s_dSkinThickness/1000;
 
 
-            if(bBinary)
-            {
-                if (!XFile.open(QIODevice::WriteOnly)) return;
-                QDataStream out(&XFile);
-                out.setByteOrder(QDataStream::LittleEndian);
-                QTextStream outDummy;
+            PrintMesh::enumFormat format = PrintMesh::STLTEXT;
+            if(bOBJ)         format = PrintMesh::OBJ;
+            else if(bBinary) format = PrintMesh::STLBINARY;
 
-                uint32_t iTriangles = pWing(STLExportDlg::s_iObject-1)->exportSTL3dPrintable(out, outDummy, bBinary,
-                      STLExportDlg::s_NChordPanels, STLExportDlg::s_NSpanPanels,
-                      (Wing::printOutputStyle)STLExportDlg::s_i3dOutputStyle, float(Units::mtoUnit()));
+            QIODevice::OpenMode mode = QIODevice::WriteOnly;
+            if(format!=PrintMesh::STLBINARY) mode |= QIODevice::Text;
+            if (!XFile.open(mode)) return;
 
-                // binary version of STL file requires the number of faces to be written directly after the 80 byte header
-                // we didn't know what it was when the file was originally written so seek back and overwrite it now
-                XFile.flush();
-                XFile.close();
-                XFile.open(QIODevice::Append);
-                XFile.seek(80);
-                char buffer[4];
-                memcpy(buffer, &iTriangles, sizeof(uint32_t));
-                out.writeRawData(buffer, sizeof(uint32_t));
-            }
-            else
-            {
-                if (!XFile.open(QIODevice::WriteOnly | QIODevice::Text)) return ;
-                QTextStream out(&XFile);
-                QDataStream outDummy;
-                pWing(STLExportDlg::s_iObject-1)->exportSTL3dPrintable(outDummy, out, bBinary,
-                      STLExportDlg::s_NChordPanels, STLExportDlg::s_NSpanPanels,
-                      (Wing::printOutputStyle)STLExportDlg::s_i3dOutputStyle, float(Units::mtoUnit()));
+            QElapsedTimer t;
+            t.start();
+            uint32_t iTriangles = pWing(STLExportDlg::s_iObject-1)->exportSTL3dPrintable(XFile, format,
+                                          STLExportDlg::s_NChordPanels, STLExportDlg::s_NSpanPanels,
+                                          Wing::printOutputStyle(STLExportDlg::s_i3dOutputStyle), float(Units::mtoUnit()));
+            qint64 size = XFile.size();
+            XFile.close();
 
-            }
+            QString strong = QString::asprintf("Exported %d triangles in %.3f s, %.1f kB", int(iTriangles), double(t.elapsed())/1000.0, double(size)/1024.0);
+            s_pMainFrame->statusBar()->showMessage(strong);
+            return;
         }
     }
     else if(STLExportDlg::s_iObject==0 && m_pCurPlane->body())
@@ -7931,80 +7917,57 @@ void Miarex::onExporttoSTL()
 
 
 
+/**
+ * Imports the triangles of an STL file as a reference mesh, e.g. a 3D scan, which is displayed with the current plane.
+ * The coordinates are expected in the current length unit.
+ */
 void Miarex::onImportSTLFile()
 {
-    if (!m_pCurPlane) return;
-//    QString filter ="STL Binary File (*.stl)";
-    QString FileName;
-
-    FileName = m_pCurPlane->name();
-    FileName.replace("/", " ");
-    /*    QFileDialog dlg(this);
-    FileName = dlg.getOpenFileName(this, tr("Import stl"),
-                                    xfl::s_LastDirName + "/"+FileName+".stl",
-                                    tr("STL Text File (*.stl);;STL Binary File (*.stl)"),
-                                    &filter);
-
+    QString FileName = QFileDialog::getOpenFileName(s_pMainFrame, tr("Import STL File"),
+                                                    xfl::s_LastDirName,
+                                                    tr("STL File (*.stl)"));
     if(!FileName.length()) return;
 
     int pos = FileName.lastIndexOf("/");
     if(pos>0) xfl::s_LastDirName = FileName.left(pos);
 
-    pos = FileName.indexOf(".stl", Qt::CaseInsensitive);
-    if(pos<0) FileName += ".stl";*/
-    FileName = xfl::s_LastDirName + "/" + "0zPlane.stl";
-
     QFile XFile(FileName);
-
-    if (!XFile.open(QIODevice::ReadOnly)) return ;
-    QDataStream inStream(&XFile);
-
-
-
-    inStream.setByteOrder(QDataStream::LittleEndian);
-    //    uint u = inStream.byteOrder();
-    //qDebug()<<in.byteOrder()<<QDataStream::BigEndian<<QDataStream::LittleEndian;
-
-    //80 character header, avoid word "solid"
-    //                       0123456789 123456789 123456789 123456789 123456789 123456789 123456789 123456789
-
-    QString strong;
-    qint8  ch;
-    strong.clear();
-    for(int j=0; j<80;j++)
+    if (!XFile.open(QIODevice::ReadOnly))
     {
-        strong += " ";
-        inStream >> ch;
-        strong[j] = char(ch);
+        QString strange = tr("Could not read the file\n")+FileName;
+        QMessageBox::warning(s_pMainFrame, tr("Warning"), strange);
+        return;
     }
 
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    QElapsedTimer t;
+    t.start();
+    QString logMsg;
+    bool bRead = m_RefMesh.readSTL(XFile, 1.0/Units::mtoUnit(), logMsg);
+    XFile.close();
+    QApplication::restoreOverrideCursor();
 
-    int nTriangles=0;
-    inStream >> nTriangles;
-
-    float f,g,h;
-
-    char buffer[12];
-    for (int j=0; j<nTriangles; j++)
+    if(!bRead)
     {
-        xfl::readFloat(inStream, f);
-        xfl::readFloat(inStream, g);
-        xfl::readFloat(inStream, h);
-        xfl::readFloat(inStream, f);
-        xfl::readFloat(inStream, g);
-        xfl::readFloat(inStream, h);
-        xfl::readFloat(inStream, f);
-        xfl::readFloat(inStream, g);
-        xfl::readFloat(inStream, h);
-        xfl::readFloat(inStream, f);
-        xfl::readFloat(inStream, g);
-        xfl::readFloat(inStream, h);
-        inStream.readRawData(buffer, 2);
-        if(j>2) break;
+        m_RefMesh.clear();
+        QMessageBox::warning(s_pMainFrame, tr("Warning"), tr("Could not import the STL file:\n")+logMsg);
     }
+    else
+    {
+        QString strong = logMsg.trimmed() + QString::asprintf(" in %.3f s", double(t.elapsed())/1000.0);
+        s_pMainFrame->statusBar()->showMessage(strong);
+    }
+
+    gl3dMiarexView::s_bResetglRefMesh = true;
+    updateView();
+}
 
 
-    XFile.close();
+void Miarex::onClearSTLMesh()
+{
+    m_RefMesh.clear();
+    gl3dMiarexView::s_bResetglRefMesh = true;
+    updateView();
 }
 
 
@@ -8300,106 +8263,9 @@ void Miarex::getPolarProperties(const WPolar *pWPolar, QString &polarProps, bool
  */
 void Miarex::exportToTextStream(WPolar const *pWPolar, QTextStream &out, xfl::enumTextFileType FileType, bool bDataOnly)
 {
-    QString Header, strong, str;
-
-    if (FileType==xfl::TXT)
-    {
-        if(!bDataOnly)
-        {
-            strong = VERSIONNAME;
-            strong += "\n\n";
-            out << strong;
-
-            strong ="Plane name :        "+ pWPolar->planeName() + "\n";
-            out << strong;
-
-            strong ="Polar name :        "+ pWPolar->polarName()+ "\n";
-            out << strong;
-
-            Units::getSpeedUnitLabel(str);
-            str +="\n\n";
-
-            if(pWPolar->polarType()==xfl::FIXEDSPEEDPOLAR)
-            {
-                strong = QString("Freestream speed : %1 ").arg(pWPolar->velocity()*Units::mstoUnit(),7,'f',3);
-                strong +=str + "\n";
-            }
-            else if(pWPolar->polarType()==xfl::FIXEDAOAPOLAR)
-            {
-                strong = QString("Alpha = %1").arg(pWPolar->Alpha()) + QChar(0260) + "\n";
-            }
-            else strong = "\n";
-
-            out << strong;
-        }
-
-        Header = "   alpha      Beta       CL          CDi        CDv        CD         CY         Cl         Cm         Cn        Cni       QInf        XCP\n";
-        out << Header;
-        for (int j=0; j<pWPolar->dataSize(); j++)
-        {
-            strong = QString(" %1  %2  %3  %4  %5  %6  %7  %8  %9  %10  %11  %12  %13\n")
-                    .arg(pWPolar->m_Alpha[j],8,'f',3)
-                    .arg(pWPolar->m_Beta[j], 8,'f',3)
-                    .arg(pWPolar->m_CL[j],   9,'f',6)
-                    .arg(pWPolar->m_ICd[j],  9,'f',6)
-                    .arg(pWPolar->m_PCd[j],  9,'f',6)
-                    .arg(pWPolar->m_TCd[j],  9,'f',6)
-                    .arg(pWPolar->m_CY[j] ,  9,'f',6)
-                    .arg(pWPolar->m_GRm[j],  9,'f',6)
-                    .arg(pWPolar->m_GCm[j],  9,'f',6)
-                    .arg(pWPolar->m_GYm[j],  9,'f',6)
-                    .arg(pWPolar->m_IYm[j],  9,'f',6)
-                    .arg(pWPolar->m_QInfinite[j],8,'f',4)
-                    .arg(pWPolar->m_XCP[j],  9,'f',4);
-
-            out << strong;
-        }
-    }
-    else if (FileType==xfl::CSV)
-    {
-        if(!bDataOnly)
-        {
-            strong = VERSIONNAME;
-            strong += "\n\n";
-            out << strong;
-
-            strong ="Plane name :, "+ pWPolar->planeName() + "\n";
-            out << strong;
-
-            strong ="Polar name :, "+ pWPolar->polarName() + "\n";
-            out << strong;
-
-            Units::getSpeedUnitLabel(str);
-            str +="\n\n";
-            strong = QString("Freestream speed :, %1 ").arg(pWPolar->velocity()*Units::mstoUnit(),3,'f',1);
-            strong +=str;
-            out << strong;
-        }
-
-        Header = "alpha, Beta, CL, CDi, CDv, CD, CY, Cl, Cm, Cn, Cni, QInf, XCP\n";
-        out << Header;
-        for (int j=0; j<pWPolar->dataSize(); j++)
-        {
-            //            strong.Format(" %8.3f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %8.4f,  %9.4f\n",
-            strong = QString(" %1,  %2,  %3,  %4,  %5,  %6,  %7,  %8,  %9,  %10,  %11,  %12, %13\n")
-                    .arg(pWPolar->m_Alpha[j],8,'f',3)
-                    .arg(pWPolar->m_Beta[j], 8,'f',3)
-                    .arg(pWPolar->m_CL[j],   9,'f',6)
-                    .arg(pWPolar->m_ICd[j],  9,'f',6)
-                    .arg(pWPolar->m_PCd[j],  9,'f',6)
-                    .arg(pWPolar->m_TCd[j],  9,'f',6)
-                    .arg(pWPolar->m_CY[j] ,  9,'f',6)
-                    .arg(pWPolar->m_GRm[j],  9,'f',6)
-                    .arg(pWPolar->m_GCm[j],  9,'f',6)
-                    .arg(pWPolar->m_GYm[j],  9,'f',6)
-                    .arg(pWPolar->m_IYm[j],  9,'f',6)
-                    .arg(pWPolar->m_QInfinite[j],8,'f',4)
-                    .arg(pWPolar->m_XCP[j],  9,'f',4);
-
-            out << strong;
-        }
-    }
-    out << "\n\n";
+    QString str;
+    Units::getSpeedUnitLabel(str);
+    pWPolar->exportWPolar(out, VERSIONNAME, FileType==xfl::CSV, Units::mstoUnit(), str, bDataOnly);
 }
 
 
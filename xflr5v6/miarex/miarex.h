@@ -43,6 +43,7 @@ class MainFrame;
 #include "./analysis/panelanalysisdlg.h"
 #include "./analysis/lltanalysisdlg.h"
 #include <xflanalysis/plane_analysis/planetask.h>
+#include <xflobjects/objects3d/printmesh.h>
 #include <xflgraph/graph.h>
 #include <xflcore/linestyle.h>
 
@@ -167,6 +168,7 @@ class Miarex : public QWidget
         void onExporttoSTL();
         void onExportAnalysisToXML();
         void onImportSTLFile();
+        void onClearSTLMesh();
         void onExportCurPOpp();
         void onExportCurWPolar();
         void onExportPlanetoXML();
@@ -311,6 +313,8 @@ class Miarex : public QWidget
 
         PlaneTask m_theTask;
 
+        PrintMesh m_RefMesh;                    /**< a reference mesh imported from an STL file, displayed in the 3D view with the current plane */
+
         PlaneTreeView *m_pPlaneTreeView;
 
         // Widget variables ... self explicit, not documented
@@ -419,6 +423,7 @@ class Miarex : public QWidget
         int m_InducedDragPoint;     /**< 0 if downwash is at panel's centroid, 1 if averaged over panel length; used in CWing::VLMTrefftz */
         int m_LLTMaxIterations;     /**< the number of iterations for LLT */
         int m_posAnimateWOpp;       /**< the current animation aoa ind ex for WOpp animation */
+        QVector<PlaneOpp*> m_AnimatePOpps;  /**< the operating points of the current polar, played in sequence by the WOpp animation */
         int m_posAnimateMode;       /**< the current animation aoa index for Mode animation */
         int m_WakeInterNodes;        /**< number of intermediate nodes between wake panels */
 
@@ -8,6 +8,7 @@
 
 #include <QVBoxLayout>
 #include <QHeaderView>
+#include <QSet>
 
 #include "planetreeview.h"
 
@@ -76,6 +77,7 @@ PlaneTreeView::PlaneTreeView(QWidget *pParent) : QWidget(pParent)
     connect(m_pTreeView, SIGNAL(doubleClicked(QModelIndex)),   SLOT(onItemDoubleClicked(QModelIndex)));
     connect(m_pTreeView->selectionModel(), SIGNAL(currentRowChanged(QModelIndex,QModelIndex)), SLOT(onCurrentRowChanged(QModelIndex)));
     connect(m_pTreeView->m_pleFilter, SIGNAL(returnPressed()), SLOT(onSetFilter()));
+    connect(m_pModel, SIGNAL(fetchChildren(ObjectTreeItem*)), SLOT(onFetchChildren(ObjectTreeItem*)));
 }
 
 
@@ -325,22 +327,24 @@ void PlaneTreeView::fillWPolars(ObjectTreeItem *pPlaneItem, const Plane *pPlane)
         {
             LineStyle ls(pWPolar->theStyle());
             ls.m_bIsEnabled = true;
-            m_pModel->appendRow(pPlaneItem, pWPolar->name(), ls, wPolarState(pWPolar));
+            ObjectTreeItem *pWPolarItem = m_pModel->appendRow(pPlaneItem, pWPolar->name(), ls, wPolarState(pWPolar));
 
-            addPOpps(pWPolar);
+            // the operating point rows are built when the polar is first expanded
+            pWPolarItem->setFetched(Objects3d::planeOppCount(pPlane, pWPolar)==0);
         }
     }
 }
 
 
+/**
+ * Updates the operating point rows of the polar after an analysis or a deletion.
+ * Only the rows which have changed are inserted or removed, and nothing is done if the polar has not been expanded yet.
+ */
 void PlaneTreeView::addPOpps(WPolar const *pWPolar)
 {
     if(!pWPolar) pWPolar = s_pMiarex->curWPolar();
     if(!pWPolar) return;
 
-    bool bAdded(false);
-//    m_pModel->blockSignals(true);
-
     //find this polar's plane parent
     for(int ir=0; ir<m_pModel->rowCount(); ir++)
     {
@@ -354,52 +358,111 @@ void PlaneTreeView::addPOpps(WPolar const *pWPolar)
                 ObjectTreeItem *pWPolarItem = pPlaneItem->child(jr);
                 if(pWPolarItem->name().compare(pWPolar->polarName(), Qt::CaseInsensitive)==0)
                 {
-                    QModelIndex polarindex = m_pModel->index(jr, 0, pPlaneItem);
-                    if(pWPolarItem->rowCount())
-                        m_pModel->removeRows(0, pWPolarItem->rowCount(), polarindex);
-
-                    for(int iOpp=0; iOpp<Objects3d::planeOppCount(); iOpp++)
-                    {
-                        PlaneOpp const *pPOpp = Objects3d::planeOppAt(iOpp);
-                        if(pPOpp->planeName().compare(pWPolar->planeName())==0 && pPOpp->polarName().compare(pWPolar->polarName())==0)
-                        {
-                            QString strange = pPOpp->name();
-                            ObjectTreeItem *pPOppItem = nullptr;
-                            if(s_pMiarex->isPOppView())
-                            {
-                                LineStyle ls(pPOpp->theStyle());
-                                ls.m_bIsEnabled = true;
-                                pPOppItem = m_pModel->appendRow(pWPolarItem, strange, ls, pPOpp->isVisible() ? Qt::Checked : Qt::Unchecked);
-                            }
-                            else
-                            {
-                                LineStyle ls(pPOpp->theStyle());
-                                ls.m_bIsEnabled = false;
-                                pPOppItem = m_pModel->appendRow(pWPolarItem, strange, ls, Qt::PartiallyChecked);
-                            }
-                            if(pPOpp->isT7Polar() && pPOppItem)
-                            {
-                                for(int iMode=0; iMode<8; iMode++)
-                                {
-                                    m_pModel->appendRow(pPOppItem, QString::asprintf("Mode %d", iMode+1), LineStyle(), Qt::Unchecked);
-                                }
-                            }
-                        }
-                    }
-                    bAdded = true;
+                    if(pWPolarItem->isFetched())
+                        fillPOpps(pWPolarItem, pWPolar);
                     break;
                 }
             }
+            break;
         }
-        if(bAdded) break;
     }
 
-//    m_pModel->blockSignals(false);
-
     setOverallCheckStatus();
 }
 
 
+/**
+ * Brings the children of the polar item in line with the polar's operating points.
+ * The rows and the operating points are both sorted by the polar's variable,
+ * so that the new rows are inserted in runs in a single pass.
+ */
+void PlaneTreeView::fillPOpps(ObjectTreeItem *pWPolarItem, WPolar const *pWPolar)
+{
+    if(!pWPolarItem || !pWPolar) return;
+
+    Plane const *pPlane = Objects3d::plane(pWPolar->planeName());
+    QVector<PlaneOpp*> POppList = Objects3d::planeOpps(pPlane, pWPolar);
+
+    QSet<QString> names;
+    for(int i=0; i<POppList.size(); i++) names.insert(POppList.at(i)->name());
+
+    QModelIndex polarindex = m_pModel->index(pWPolarItem->parentItem(), pWPolarItem);
+
+    // remove the rows of the deleted operating points
+    for(int ir=pWPolarItem->rowCount()-1; ir>=0; ir--)
+    {
+        if(!names.contains(pWPolarItem->child(ir)->name()))
+            m_pModel->removeRows(ir, 1, polarindex);
+    }
+
+    // insert the rows of the new operating points
+    QList<ObjectTreeItem*> newItems;
+    int ir=0;
+    for(int i=0; i<POppList.size(); i++)
+    {
+        PlaneOpp const *pPOpp = POppList.at(i);
+        if(ir<pWPolarItem->rowCount() && pWPolarItem->child(ir)->name().compare(pPOpp->name())==0)
+        {
+            m_pModel->insertItems(pWPolarItem, ir, newItems);
+            ir += newItems.size()+1;
+            newItems.clear();
+        }
+        else
+            newItems.append(makePOppItem(pPOpp));
+    }
+    m_pModel->insertItems(pWPolarItem, ir, newItems);
+
+    if(pWPolarItem->rowCount()!=POppList.size())
+    {
+        // the existing rows were not in the polar's order, rebuild them
+        m_pModel->removeRows(0, pWPolarItem->rowCount(), polarindex);
+        newItems.clear();
+        for(int i=0; i<POppList.size(); i++) newItems.append(makePOppItem(POppList.at(i)));
+        m_pModel->insertItems(pWPolarItem, 0, newItems);
+    }
+}
+
+
+/** Creates the row of an operating point; the stability modes are built when the row is first expanded */
+ObjectTreeItem *PlaneTreeView::makePOppItem(PlaneOpp const *pPOpp) const
+{
+    LineStyle ls(pPOpp->theStyle());
+    ObjectTreeItem *pPOppItem = nullptr;
+    if(s_pMiarex->isPOppView())
+    {
+        ls.m_bIsEnabled = true;
+        pPOppItem = new ObjectTreeItem(pPOpp->name(), ls, pPOpp->isVisible() ? Qt::Checked : Qt::Unchecked);
+    }
+    else
+    {
+        ls.m_bIsEnabled = false;
+        pPOppItem = new ObjectTreeItem(pPOpp->name(), ls, Qt::PartiallyChecked);
+    }
+    pPOppItem->setFetched(!pPOpp->isT7Polar());
+    return pPOppItem;
+}
+
+
+void PlaneTreeView::onFetchChildren(ObjectTreeItem *pItem)
+{
+    if(!pItem) return;
+
+    if(pItem->isPolarLevel())
+    {
+        Plane const *pPlane = Objects3d::plane(pItem->parentItem()->name());
+        WPolar const *pWPolar = Objects3d::wPolar(pPlane, pItem->name());
+        fillPOpps(pItem, pWPolar);
+    }
+    else if(pItem->isOppLevel())
+    {
+        QList<ObjectTreeItem*> modeItems;
+        for(int iMode=0; iMode<8; iMode++)
+            modeItems.append(new ObjectTreeItem(QString::asprintf("Mode %d", iMode+1), LineStyle(), Qt::Unchecked));
+        m_pModel->insertItems(pItem, 0, modeItems);
+    }
+}
+
+
 void PlaneTreeView::onCurrentRowChanged(QModelIndex currentfilteredidx)
 {
     setObjectFromIndex(currentfilteredidx);
@@ -844,6 +907,7 @@ void PlaneTreeView::selectPlaneOpp(PlaneOpp *pPOpp)
 
                 if(pPolarItem->name().compare(pPOpp->polarName(), Qt::CaseInsensitive)==0)
                 {
+                    m_pModel->fetch(pPolarItem);
                     //find the POpp item
                     for(int jr=0; jr<pPolarItem->rowCount(); jr++)
                     {
@@ -1054,6 +1118,7 @@ void PlaneTreeView::removeWPolarPOpps(WPolar const*pWPolar)
                 {
                     QModelIndex polarindex = m_pModel->index(jr, 0, pPlaneItem);
                     m_pModel->removeRows(0, pPolarItem->rowCount(), polarindex);
+                    pPolarItem->setFetched(true);
                     break;
                 }
             }
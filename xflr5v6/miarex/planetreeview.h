@@ -55,6 +55,7 @@ class PlaneTreeView : public QWidget
         void addPOpps(const WPolar *pWPolar=nullptr);
         void fillModelView();
         void fillWPolars(ObjectTreeItem *pPlaneItem, const Plane *pPlane);
+        void fillPOpps(ObjectTreeItem *pWPolarItem, WPolar const *pWPolar);
         void selectObjects();
         void setCurveParams();
 
@@ -91,12 +92,14 @@ class PlaneTreeView : public QWidget
         void onCurrentRowChanged(QModelIndex currentfilteredidx);
         void onSetFilter();
         void onSplitterMoved() {s_SplitterSizes = m_pMainSplitter->saveState();}
+        void onFetchChildren(ObjectTreeItem *pItem);
 
     public slots:
         void onSwitchAll(bool bChecked);
 
     private:
         void setupLayout();
+        ObjectTreeItem *makePOppItem(PlaneOpp const *pPOpp) const;
 
     private:
         ExpandableTreeView *m_pTreeView;
@@ -24,6 +24,8 @@
 #include <QProgressDialog>
 #include <QOpenGLPaintDevice>
 #include <QContextMenuEvent>
+#include <QImage>
+#include <QTimer>
 
 #include "gl3dmiarexview.h"
 #include <miarex/miarex.h>
@@ -32,7 +34,9 @@
 
 #include <xflcore/displayoptions.h>
 #include <xflcore/xflcore.h>
+#include <xflcore/trace.h>
 #include <miarex/view/gl3dscales.h>
+#include <xflobjects/objects3d/printmesh.h>
 #include <xflobjects/objects3d/surface.h>
 #include <xflobjects/objects3d/wpolar.h>
 #include <xfl3d/controls/w3dprefs.h>
@@ -51,6 +55,7 @@ bool gl3dMiarexView::s_bResetglStream = true;
 bool gl3dMiarexView::s_bResetglLegend = true;
 bool gl3dMiarexView::s_bResetglBody = true;
 bool gl3dMiarexView::s_bResetglSurfVelocities = true;
+bool gl3dMiarexView::s_bResetglRefMesh = true;
 
 double gl3dMiarexView::s_LiftScale     = 1.0;
 double gl3dMiarexView::s_VelocityScale = 1.0;
@@ -60,6 +65,8 @@ double gl3dMiarexView::s_DragScale     = 1.0;
 bool gl3dMiarexView::s_bAutoCpScale = true;
 double gl3dMiarexView::s_LegendMin = -1.0;
 double gl3dMiarexView::s_LegendMax =  1.0;
+int gl3dMiarexView::s_ColorMapSize = 256;
+int gl3dMiarexView::s_FrameCacheSize = 128;
 
 
 gl3dMiarexView::gl3dMiarexView(QWidget *parent) : gl3dXflView(parent)
@@ -69,18 +76,29 @@ gl3dMiarexView::gl3dMiarexView(QWidget *parent) : gl3dXflView(parent)
     m_bStreamlinesDone    = false;
     m_bSurfVelocitiesDone = false;
     m_NStreamLines = 0;
+
+    m_attrCpScalar = m_uCpMin = m_uCpMax = m_uColorMapSize = -1;
+    m_nPanelCp = m_nPanelCpValues = 0;
+    m_pCpColorMap = nullptr;
+
+    m_FrameCacheBytes = 0;
+    m_bFrameCache = false;
 }
 
 
 gl3dMiarexView::~gl3dMiarexView()
 {
+    clearFrameCache();
     m_vboPanelCp.destroy();
+    m_vboPanelCpValues.destroy();
+    delete m_pCpColorMap;
     m_vboPanelForces.destroy();
     m_vboSurfaceVelocities.destroy();
     m_vboLiftForce.destroy();
     m_vboMoments.destroy();
     m_vboMesh.destroy();
     m_vboLegendColor.destroy();
+    m_vboRefMesh.destroy();
     for(int iWing=0; iWing<MAXWINGS; iWing++)
     {
         m_vboLiftStrips[iWing].destroy();
@@ -263,6 +281,9 @@ void gl3dMiarexView::glRenderView()
         }
     }
 
+    if(m_vboRefMesh.isCreated())
+        paintTriangles3Vtx(m_vboRefMesh, QColor(175,175,185), true, true);
+
     if(pPOpp)
     {
         if(s_pMiarex->m_bMoments)
@@ -646,8 +667,7 @@ bool gl3dMiarexView::glMakeStreamLines(Wing const *PlaneWing[MAXWINGS], Vector3d
     Panel::setCoreSize(memcoresize);
     QApplication::restoreOverrideCursor();
 
-    m_vboStreamLines.destroy();
-    m_vboStreamLines.create();
+    recreateOppBuffer(m_vboStreamLines);
     m_vboStreamLines.bind();
     m_vboStreamLines.allocate(StreamVertexArray.data(), streamArraySize*int(sizeof(float)));
     m_vboStreamLines.release();
@@ -886,8 +906,7 @@ void gl3dMiarexView::glMakeTransitions(int iWing, Wing const *pWing, WPolar cons
     Q_ASSERT(iv==m_Ny[iWing]*6);
 
 
-    m_vboTransitions[iWing].destroy();
-    m_vboTransitions[iWing].create();
+    recreateOppBuffer(m_vboTransitions[iWing]);
     m_vboTransitions[iWing].bind();
     m_vboTransitions[iWing].allocate(pTransVertexArray.data(), bufferSize * int(sizeof(GLfloat)));
     m_vboTransitions[iWing].release();
@@ -974,8 +993,7 @@ void gl3dMiarexView::glMakeLiftForce(const WPolar *pWPolar, const PlaneOpp *pPOp
     liftForceVertexArray[iv++] = gly-0.008f;
     liftForceVertexArray[iv++] = glz+forcez-0.012f*sign;
 
-    m_vboLiftForce.destroy();
-    m_vboLiftForce.create();
+    recreateOppBuffer(m_vboLiftForce);
     m_vboLiftForce.bind();
     m_vboLiftForce.allocate(liftForceVertexArray, 18*sizeof(float));
     m_vboLiftForce.release();
@@ -1155,8 +1173,7 @@ void gl3dMiarexView::glMakeMoments(Wing const *pWing, const WPolar *pWPolar, con
 
 
     Q_ASSERT(iv==m_iMomentPoints*3);
-    m_vboMoments.destroy();
-    m_vboMoments.create();
+    recreateOppBuffer(m_vboMoments);
     m_vboMoments.bind();
     m_vboMoments.allocate(momentVertexArray.data(), m_iMomentPoints*3*int(sizeof(float)));
     m_vboMoments.release();
@@ -1279,8 +1296,7 @@ void gl3dMiarexView::glMakeLiftStrip(int iWing, const Wing *pWing, const WPolar
     }
     Q_ASSERT(iv==m_Ny[iWing]*9);
 
-    m_vboLiftStrips[iWing].destroy();
-    m_vboLiftStrips[iWing].create();
+    recreateOppBuffer(m_vboLiftStrips[iWing]);
     m_vboLiftStrips[iWing].bind();
     m_vboLiftStrips[iWing].allocate(pLiftVertexArray.data(), m_Ny[iWing]*9 * int(sizeof(GLfloat)));
     m_vboLiftStrips[iWing].release();
@@ -1473,8 +1489,7 @@ void gl3dMiarexView::glMakeDownwash(int iWing, const Wing *pWing, const WPolar *
 
     Q_ASSERT(iv==bufferSize);
 
-    m_vboDownwash[iWing].destroy();
-    m_vboDownwash[iWing].create();
+    recreateOppBuffer(m_vboDownwash[iWing]);
     m_vboDownwash[iWing].bind();
     m_vboDownwash[iWing].allocate(pDownWashVertexArray.constData(), bufferSize * int(sizeof(GLfloat)));
     m_vboDownwash[iWing].release();
@@ -1718,14 +1733,12 @@ void gl3dMiarexView::glMakeDragStrip(int iWing, const Wing *pWing, const WPolar
     if(s_pMiarex->m_bVCd) Q_ASSERT(iv==bufferSize);
 
 
-    m_vboICd[iWing].destroy();
-    m_vboICd[iWing].create();
+    recreateOppBuffer(m_vboICd[iWing]);
     m_vboICd[iWing].bind();
     m_vboICd[iWing].allocate(pICdVertexArray.data(), bufferSize * int(sizeof(GLfloat)));
     m_vboICd[iWing].release();
 
-    m_vboVCd[iWing].destroy();
-    m_vboVCd[iWing].create();
+    recreateOppBuffer(m_vboVCd[iWing]);
     m_vboVCd[iWing].bind();
     m_vboVCd[iWing].allocate(pVCdVertexArray.data(), bufferSize * int(sizeof(GLfloat)));
     m_vboVCd[iWing].release();
@@ -1922,32 +1935,42 @@ void gl3dMiarexView::paintSurfaceVelocities(int nPanels)
 
 void gl3dMiarexView::paintPanelCp(int nPanels)
 {
-    QOpenGLVertexArrayObject::Binder vaoBinder(&m_vao);
+    if(!m_shadCp.isLinked() || !m_pCpColorMap) return;
+    if(m_nPanelCp!=nPanels || m_nPanelCpValues!=nPanels) return;
 
-    m_shadSurf.bind();
-    {        
-        m_shadSurf.setUniformValue(m_locSurf.m_Light, 0);
-        m_shadSurf.setUniformValue(m_locSurf.m_HasUniColor, 0); // using attribute buffer instead
-        m_shadSurf.setUniformValue(m_locSurf.m_HasTexture, 0);
+    QOpenGLVertexArrayObject::Binder vaoBinder(&m_vao);
 
-        m_shadSurf.enableAttributeArray(m_locSurf.m_attrVertex);
-        m_shadSurf.enableAttributeArray(m_locSurf.m_attrColor);
-        m_vboPanelCp.bind();
-        {
-            m_shadSurf.setAttributeBuffer(m_locSurf.m_attrVertex, GL_FLOAT, 0,                  3, 6 * sizeof(GLfloat));
-            m_shadSurf.setAttributeBuffer(m_locSurf.m_attrColor,  GL_FLOAT, 3* sizeof(GLfloat), 3, 6 * sizeof(GLfloat));
+    m_shadCp.bind();
+    {
+        m_shadCp.setUniformValue(m_locCp.m_vmMatrix,  m_matView*m_matModel);
+        m_shadCp.setUniformValue(m_locCp.m_pvmMatrix, m_matProj*m_matView*m_matModel);
+        m_shadCp.setUniformValue(m_locCp.m_ClipPlane, m_ClipPlanePos);
+        m_shadCp.setUniformValue(m_uCpMin, float(s_LegendMin));
+        m_shadCp.setUniformValue(m_uCpMax, float(s_LegendMax));
 
-            glEnable(GL_POLYGON_OFFSET_FILL);
-            glPolygonOffset(DEPTHFACTOR, DEPTHUNITS);
-            glDrawArrays(GL_TRIANGLES, 0, nPanels*2*3);
-            glDisable(GL_POLYGON_OFFSET_FILL);
+        glActiveTexture(GL_TEXTURE0);
+        m_pCpColorMap->bind();
+        m_shadCp.setUniformValue(m_locCp.m_TexSampler, 0);
 
-        }
+        m_shadCp.enableAttributeArray(m_locCp.m_attrVertex);
+        m_shadCp.enableAttributeArray(m_attrCpScalar);
+        m_vboPanelCp.bind();
+        m_shadCp.setAttributeBuffer(m_locCp.m_attrVertex, GL_FLOAT, 0, 3, 3 * sizeof(GLfloat));
         m_vboPanelCp.release();
-        m_shadSurf.disableAttributeArray(m_locSurf.m_attrColor);
-        m_shadSurf.disableAttributeArray(m_locSurf.m_attrVertex);
+        m_vboPanelCpValues.bind();
+        m_shadCp.setAttributeBuffer(m_attrCpScalar, GL_FLOAT, 0, 1, sizeof(GLfloat));
+        m_vboPanelCpValues.release();
+
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(DEPTHFACTOR, DEPTHUNITS);
+        glDrawArrays(GL_TRIANGLES, 0, nPanels*2*3);
+        glDisable(GL_POLYGON_OFFSET_FILL);
+
+        m_shadCp.disableAttributeArray(m_attrCpScalar);
+        m_shadCp.disableAttributeArray(m_locCp.m_attrVertex);
+        m_pCpColorMap->release();
     }
-    m_shadSurf.release();
+    m_shadCp.release();
 }
 
 
@@ -2242,49 +2265,22 @@ void gl3dMiarexView::glMakePanelForces(int nPanels, Panel const *pPanel, WPolar
     }
     Q_ASSERT(iv==forceVertexSize);
 
-    m_vboPanelForces.destroy();
-    m_vboPanelForces.create();
+    recreateOppBuffer(m_vboPanelForces);
     m_vboPanelForces.bind();
     m_vboPanelForces.allocate(forceVertexArray.data(), forceVertexSize * int(sizeof(GLfloat)));
     m_vboPanelForces.release();
 }
 
 
-void gl3dMiarexView::glMakePanels(QOpenGLBuffer &vbo, int nPanels, int , const Vector3d *pNode, const Panel *pPanel, const PlaneOpp *pPOpp)
+void gl3dMiarexView::glMakePanels(QOpenGLBuffer &vbo, int nPanels, int , const Vector3d *pNode, const Panel *pPanel)
 {
     if(!pPanel || !pNode || !nPanels) return;
 
-    float color(0);
-    float range(0);
-
-    Vector3d TA,LA, TB, LB;
-
-    float lmin =  10000.0;
-    float lmax = -10000.0;
-    // find min and max Cp for scale set
-    if(pPOpp)
-    {
-        for (int pp=0; pp< nPanels; pp++)
-        {
-            lmin = std::min(lmin, float(pPOpp->m_dCp[pp]));
-            lmax = std::max(lmax, float(pPOpp->m_dCp[pp]));
-        }
-
-        if(gl3dMiarexView::s_bAutoCpScale)
-        {
-            gl3dMiarexView::s_LegendMin = double(lmin);
-            gl3dMiarexView::s_LegendMax = double(lmax);
-        }
-        else
-        {
-            lmin = float(gl3dMiarexView::s_LegendMin);
-            lmax = float(gl3dMiarexView::s_LegendMax);
-        }
-    }
-    range = lmax - lmin;
+    float r = float(DisplayOptions::backgroundColor().redF());
+    float g = float(DisplayOptions::backgroundColor().greenF());
+    float b = float(DisplayOptions::backgroundColor().blueF());
 
     // unfortunately we can't just use nodes and colors, because the trailing edges are merged
-    // and the colors would be mixed
     // so write as many nodes as there are triangles.
     //
     // vertices array size:
@@ -2296,130 +2292,170 @@ void gl3dMiarexView::glMakePanels(QOpenGLBuffer &vbo, int nPanels, int , const V
     int nodeVertexSize = nPanels * 2 * 3 * 6;
     QVector<float>nodeVertexArray(nodeVertexSize);
 
-    Q_ASSERT(nPanels==nPanels);
-
     int iv=0;
     for (int p=0; p<nPanels; p++)
     {
-        TA.copy(pNode[pPanel[p].m_iTA]);
-        TB.copy(pNode[pPanel[p].m_iTB]);
-        LA.copy(pNode[pPanel[p].m_iLA]);
-        LB.copy(pNode[pPanel[p].m_iLB]);
-        // each quad is two triangles
-        // write the first one
-        nodeVertexArray[iv++] = TA.xf();
-        nodeVertexArray[iv++] = TA.yf();
-        nodeVertexArray[iv++] = TA.zf();
-        if(pPOpp)
-        {
-            color = (float(pPOpp->m_dCp[p])-lmin)/range;
-            nodeVertexArray[iv++] = xfl::GLGetRed(color);
-            nodeVertexArray[iv++] = xfl::GLGetGreen(color);
-            nodeVertexArray[iv++] = xfl::GLGetBlue(color);
-        }
-        else
+        // each quad is two triangles, TA-LA-LB and LB-TB-TA
+        int const idx[] = {pPanel[p].m_iTA, pPanel[p].m_iLA, pPanel[p].m_iLB, pPanel[p].m_iLB, pPanel[p].m_iTB, pPanel[p].m_iTA};
+        for(int i=0; i<6; i++)
         {
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().redF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().greenF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().blueF());
+            Vector3d const &pt = pNode[idx[i]];
+            nodeVertexArray[iv++] = pt.xf();
+            nodeVertexArray[iv++] = pt.yf();
+            nodeVertexArray[iv++] = pt.zf();
+            nodeVertexArray[iv++] = r;
+            nodeVertexArray[iv++] = g;
+            nodeVertexArray[iv++] = b;
         }
+    }
 
-        nodeVertexArray[iv++] = LA.xf();
-        nodeVertexArray[iv++] = LA.yf();
-        nodeVertexArray[iv++] = LA.zf();
-        if(pPOpp)
-        {
-            color = (float(pPOpp->m_dCp[p])-lmin)/range;
-            nodeVertexArray[iv++] = xfl::GLGetRed(color);
-            nodeVertexArray[iv++] = xfl::GLGetGreen(color);
-            nodeVertexArray[iv++] = xfl::GLGetBlue(color);
-        }
-        else
-        {
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().redF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().greenF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().blueF());
-        }
+    Q_ASSERT(iv==nodeVertexSize);
 
-        nodeVertexArray[iv++] = LB.xf();
-        nodeVertexArray[iv++] = LB.yf();
-        nodeVertexArray[iv++] = LB.zf();
-        if(pPOpp)
-        {
-            color = (float(pPOpp->m_dCp[p])-lmin)/range;
-            nodeVertexArray[iv++] = xfl::GLGetRed(color);
-            nodeVertexArray[iv++] = xfl::GLGetGreen(color);
-            nodeVertexArray[iv++] = xfl::GLGetBlue(color);
-        }
-        else
-        {
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().redF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().greenF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().blueF());
-        }
+    vbo.destroy();
+    vbo.create();
+    vbo.bind();
+    vbo.allocate(nodeVertexArray.data(), nodeVertexSize * int(sizeof(GLfloat)));
+    vbo.release();
+}
 
-        // write the second one
-        nodeVertexArray[iv++] = LB.xf();
-        nodeVertexArray[iv++] = LB.yf();
-        nodeVertexArray[iv++] = LB.zf();
 
-        if(pPOpp)
-        {
-            color = (float(pPOpp->m_dCp[p])-lmin)/range;
-            nodeVertexArray[iv++] = xfl::GLGetRed(color);
-            nodeVertexArray[iv++] = xfl::GLGetGreen(color);
-            nodeVertexArray[iv++] = xfl::GLGetBlue(color);
-        }
-        else
-        {
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().redF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().greenF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().blueF());
-        }
+/**
+ * Makes the static buffer of the panel triangles used to display the Cp colours.
+ * Only needs to be rebuilt when the mesh changes; the Cp values are held in a separate buffer.
+ */
+void gl3dMiarexView::glMakePanelCpGeometry(int nPanels, Vector3d const *pNode, Panel const *pPanel)
+{
+    if(!pPanel || !pNode || !nPanels) return;
 
-        nodeVertexArray[iv++] = TB.xf();
-        nodeVertexArray[iv++] = TB.yf();
-        nodeVertexArray[iv++] = TB.zf();
-        if(pPOpp)
-        {
-            color = (float(pPOpp->m_dCp[p])-lmin)/range;
-            nodeVertexArray[iv++] = xfl::GLGetRed(color);
-            nodeVertexArray[iv++] = xfl::GLGetGreen(color);
-            nodeVertexArray[iv++] = xfl::GLGetBlue(color);
-        }
-        else
-        {
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().redF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().greenF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().blueF());
-         }
+    // 2 triangles per panel x 3 nodes x 3 components
+    QVector<float> vertexArray(nPanels*2*3*3);
 
-        nodeVertexArray[iv++] = TA.xf();
-        nodeVertexArray[iv++] = TA.yf();
-        nodeVertexArray[iv++] = TA.zf();
-        if(pPOpp)
+    int iv=0;
+    for (int p=0; p<nPanels; p++)
+    {
+        int const idx[] = {pPanel[p].m_iTA, pPanel[p].m_iLA, pPanel[p].m_iLB, pPanel[p].m_iLB, pPanel[p].m_iTB, pPanel[p].m_iTA};
+        for(int i=0; i<6; i++)
         {
-            color = (float(pPOpp->m_dCp[p])-lmin)/range;
-            nodeVertexArray[iv++] = xfl::GLGetRed(color);
-            nodeVertexArray[iv++] = xfl::GLGetGreen(color);
-            nodeVertexArray[iv++] = xfl::GLGetBlue(color);
+            Vector3d const &pt = pNode[idx[i]];
+            vertexArray[iv++] = pt.xf();
+            vertexArray[iv++] = pt.yf();
+            vertexArray[iv++] = pt.zf();
         }
-        else
-        {
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().redF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().greenF());
-            nodeVertexArray[iv++] = float(DisplayOptions::backgroundColor().blueF());
-         }
     }
 
-    Q_ASSERT(iv==nodeVertexSize);
-    Q_ASSERT(iv==nPanels*2*3*6);
+    m_vboPanelCp.destroy();
+    m_vboPanelCp.create();
+    m_vboPanelCp.bind();
+    m_vboPanelCp.allocate(vertexArray.data(), vertexArray.size() * int(sizeof(GLfloat)));
+    m_vboPanelCp.release();
+    m_nPanelCp = nPanels;
+}
 
-    vbo.destroy();
-    vbo.create();
-    vbo.bind();
-    vbo.allocate(nodeVertexArray.data(), nodeVertexSize * int(sizeof(GLfloat)));
-    vbo.release();
+
+/**
+ * Streams the operating point's Cp values, one float per vertex of the panel triangles.
+ * The buffer is overwritten in place if its size has not changed.
+ */
+void gl3dMiarexView::glMakePanelCpValues(int nPanels, PlaneOpp const *pPOpp)
+{
+    if(!pPOpp || !pPOpp->m_dCp || !nPanels) return;
+
+    QVector<float> cpArray(nPanels*2*3);
+    int iv=0;
+    for (int p=0; p<nPanels; p++)
+    {
+        float cp = float(pPOpp->m_dCp[p]);
+        for(int i=0; i<6; i++) cpArray[iv++] = cp;
+    }
+
+    int size = cpArray.size() * int(sizeof(GLfloat));
+    if(m_vboPanelCpValues.isCreated() && m_nPanelCpValues==nPanels && !isCachedBuffer(m_vboPanelCpValues))
+    {
+        m_vboPanelCpValues.bind();
+        m_vboPanelCpValues.write(0, cpArray.constData(), size);
+        m_vboPanelCpValues.release();
+    }
+    else
+    {
+        recreateOppBuffer(m_vboPanelCpValues);
+        m_vboPanelCpValues.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+        m_vboPanelCpValues.bind();
+        m_vboPanelCpValues.allocate(cpArray.constData(), size);
+        m_vboPanelCpValues.release();
+        m_nPanelCpValues = nPanels;
+    }
+}
+
+
+/**
+ * Sets the range of the Cp scale from the operating point's values if the scale is automatic.
+ * The range is passed to the shader as uniforms, so that no buffer needs to be rebuilt.
+ */
+void gl3dMiarexView::setCpRange(int nPanels, PlaneOpp const *pPOpp)
+{
+    if(!s_bAutoCpScale || !pPOpp || !pPOpp->m_dCp || !nPanels) return;
+
+    double lmin =  10000.0;
+    double lmax = -10000.0;
+    for (int p=0; p<nPanels; p++)
+    {
+        lmin = std::min(lmin, pPOpp->m_dCp[p]);
+        lmax = std::max(lmax, pPOpp->m_dCp[p]);
+    }
+    s_LegendMin = lmin;
+    s_LegendMax = lmax;
+}
+
+
+/** Makes the texture of the Cp colour scale, sampled by the colormap shader */
+void gl3dMiarexView::glMakeCpColorMap()
+{
+    QImage colorMap(s_ColorMapSize, 1, QImage::Format_RGB888);
+    for(int i=0; i<s_ColorMapSize; i++)
+    {
+        float tau = float(i)/float(s_ColorMapSize-1);
+        QColor clr;
+        clr.setRgbF(double(xfl::GLGetRed(tau)), double(xfl::GLGetGreen(tau)), double(xfl::GLGetBlue(tau)));
+        colorMap.setPixelColor(i, 0, clr);
+    }
+
+    delete m_pCpColorMap;
+    m_pCpColorMap = new QOpenGLTexture(colorMap, QOpenGLTexture::DontGenerateMipMaps);
+    m_pCpColorMap->setMinMagFilters(QOpenGLTexture::Linear, QOpenGLTexture::Linear);
+    m_pCpColorMap->setWrapMode(QOpenGLTexture::ClampToEdge);
+}
+
+
+void gl3dMiarexView::initializeGL()
+{
+    gl3dXflView::initializeGL();
+
+    QString vsrc = bUsing120StyleShaders() ? ":/resources/shaders/colormap/colormap_VS_120.glsl" : ":/resources/shaders/colormap/colormap_VS.glsl";
+    QString fsrc = bUsing120StyleShaders() ? ":/resources/shaders/colormap/colormap_FS_120.glsl" : ":/resources/shaders/colormap/colormap_FS.glsl";
+    m_shadCp.addShaderFromSourceFile(QOpenGLShader::Vertex, vsrc);
+    if(m_shadCp.log().length()) Trace("Colormap vertex shader log:"+m_shadCp.log());
+
+    m_shadCp.addShaderFromSourceFile(QOpenGLShader::Fragment, fsrc);
+    if(m_shadCp.log().length()) Trace("Colormap fragment shader log:"+m_shadCp.log());
+
+    m_shadCp.link();
+    m_shadCp.bind();
+    {
+        m_locCp.m_attrVertex = m_shadCp.attributeLocation("vertexPosition_modelSpace");
+        m_attrCpScalar       = m_shadCp.attributeLocation("vertexScalar");
+
+        m_locCp.m_ClipPlane  = m_shadCp.uniformLocation("clipPlane0");
+        m_locCp.m_pvmMatrix  = m_shadCp.uniformLocation("pvmMatrix");
+        m_locCp.m_vmMatrix   = m_shadCp.uniformLocation("vmMatrix");
+        m_locCp.m_TexSampler = m_shadCp.uniformLocation("ColorMap");
+        m_uCpMin             = m_shadCp.uniformLocation("ScalarMin");
+        m_uCpMax             = m_shadCp.uniformLocation("ScalarMax");
+        m_uColorMapSize      = m_shadCp.uniformLocation("ColorMapSize");
+        m_shadCp.setUniformValue(m_uColorMapSize, float(s_ColorMapSize));
+    }
+    m_shadCp.release();
+
+    glMakeCpColorMap();
 }
 
 
@@ -2433,6 +2469,7 @@ void gl3dMiarexView::glMake3dObjects()
     PlaneOpp *pCurPOpp = s_pMiarex->m_pCurPOpp;
 
     if(!pCurPlane) return;
+    if(pCurPOpp) pCurPOpp->expandResults();
 
     PlaneTask const & theTask = s_pMiarex->m_theTask;
 
@@ -2440,6 +2477,25 @@ void gl3dMiarexView::glMake3dObjects()
 
     if(pCurWPolar) setSpanStations(pCurPlane, pCurWPolar, pCurPOpp);
 
+    bool bFrameRestored = false, bFrameStreamLines = false;
+    if(m_bFrameCache)
+    {
+        // the cached frames are only valid for the current geometry and display settings
+        if(s_bResetglGeom || s_bResetglMesh || s_bResetglLift || s_bResetglDrag || s_bResetglDownwash || s_bResetglPanelForce
+                || (m_bStream && s_bResetglStream && !s_bResetglOpp))
+            clearFrameCache();
+        else if(s_bResetglOpp && pCurPOpp)
+            bFrameRestored = restoreFrame(pCurPOpp, bFrameStreamLines);
+    }
+    bool bOppChanged = s_bResetglOpp && !bFrameRestored;
+    bool bPanelCpGeometry = false;
+
+    if(s_bResetglRefMesh)
+    {
+        glMakeRefMesh(s_pMiarex->m_RefMesh);
+        s_bResetglRefMesh = false;
+    }
+
     if(s_bResetglBody && pCurBody)
     {
         Body translatedBody;
@@ -2447,8 +2503,9 @@ void gl3dMiarexView::glMake3dObjects()
         translatedBody.translate(pCurPlane->bodyPos());
         if(pCurBody->isSplineType())
         {
-            glMakeFuseSplines(&translatedBody);
-            glMakeFuseSplinesOutline(&translatedBody);
+            // use the untranslated body to share its cached tessellation
+            glMakeFuseSplines(pCurBody, pCurPlane->bodyPos());
+            glMakeFuseSplinesOutline(pCurBody, pCurPlane->bodyPos());
         }
         else if(pCurBody->isFlatPanelType())
         {
@@ -2504,23 +2561,35 @@ void gl3dMiarexView::glMake3dObjects()
                 QVector<Panel> panels;
                 QVector<Vector3d> nodes;
                 pCurPlane->body()->makePanels(0, pCurPlane->bodyPos(), panels, nodes);
-                glMakePanels(m_vboEditBodyMesh, panels.size(), nodes.size(), nodes.constData(), panels.constData(), nullptr);
+                glMakePanels(m_vboEditBodyMesh, panels.size(), nodes.size(), nodes.constData(), panels.constData());
             }
         }
         else
-            glMakePanels(m_vboMesh, theTask.matSize(), theTask.nNodes(), theTask.m_Node.constData(), theTask.m_Panel.constData(), nullptr);
+        {
+            glMakePanels(m_vboMesh, theTask.matSize(), theTask.nNodes(), theTask.m_Node.constData(), theTask.m_Panel.constData());
+            glMakePanelCpGeometry(theTask.matSize(), theTask.m_Node.constData(), theTask.m_Panel.constData());
+            bPanelCpGeometry = true;
+        }
         s_bResetglMesh = false;
     }
 
+    // the values must match the panel count of the geometry buffer
+    if(bOppChanged || bPanelCpGeometry)
+    {
+        if(pCurWPolar && pCurWPolar->analysisMethod()!=xfl::LLTMETHOD)
+            glMakePanelCpValues(theTask.matSize(), pCurPOpp);
+    }
+
     if(s_bResetglPanelCp || s_bResetglOpp)
     {
+        // the range is a uniform of the colormap shader, no buffer to rebuild
         if(pCurWPolar && pCurWPolar->analysisMethod()!=xfl::LLTMETHOD)
-            glMakePanels(m_vboPanelCp, theTask.matSize(), theTask.nNodes(), theTask.m_Node.constData(), theTask.m_Panel.constData(), pCurPOpp);
+            setCpRange(theTask.matSize(), pCurPOpp);
         s_bResetglPanelCp = false;
     }
 
 
-    if((s_bResetglPanelForce || s_bResetglOpp)
+    if((s_bResetglPanelForce || bOppChanged)
             && pCurWPolar && pCurWPolar->analysisMethod()!=xfl::LLTMETHOD)
     {
         if (pCurPlane && pCurPOpp)
@@ -2531,7 +2600,7 @@ void gl3dMiarexView::glMake3dObjects()
     }
 
 
-    if((s_bResetglLift || s_bResetglOpp))
+    if((s_bResetglLift || bOppChanged))
     {
         if (pCurPOpp)
         {
@@ -2551,7 +2620,7 @@ void gl3dMiarexView::glMake3dObjects()
         s_bResetglLift = false;
     }
 
-    if((s_bResetglDrag || s_bResetglOpp))
+    if((s_bResetglDrag || bOppChanged))
     {
         if (pCurPOpp)
         {
@@ -2568,7 +2637,7 @@ void gl3dMiarexView::glMake3dObjects()
         s_bResetglDrag = false;
     }
 
-    if(pCurPOpp && (s_bResetglDownwash || s_bResetglOpp))
+    if(pCurPOpp && (s_bResetglDownwash || bOppChanged))
     {
         for(int iw=0; iw<MAXWINGS; iw++)
         {
@@ -2594,7 +2663,13 @@ void gl3dMiarexView::glMake3dObjects()
         s_bResetglLegend = false;
     }
 
-    if (s_bResetglStream &&m_bStream)
+    bool bStreamBuilt = false;
+    if(s_bResetglStream && m_bStream && bFrameStreamLines)
+    {
+        s_bResetglStream = false;
+        update();
+    }
+    else if (s_bResetglStream &&m_bStream)
     {
         m_bStream = false; //Disable temporarily during calculation
         m_bStreamlinesDone = false; // don't render until the vbo is built
@@ -2615,6 +2690,7 @@ void gl3dMiarexView::glMake3dObjects()
             {
                 m_bStream  = true;
                 s_bResetglStream = false;
+                bStreamBuilt = true;
                 update(); // make sure the streamlines are displayed
             }
         }
@@ -2633,5 +2709,328 @@ void gl3dMiarexView::glMake3dObjects()
         }
     }
 
+    if(m_bFrameCache && pCurPOpp && (bOppChanged || bStreamBuilt))
+        storeFrame(pCurPOpp, bStreamBuilt || bFrameStreamLines);
+
     s_bResetglOpp = false;
 }
+
+
+/**
+ * Enables or disables the cache of the operating-point buffers used by the animation.
+ * The cache is emptied in both cases.
+ */
+void gl3dMiarexView::setFrameCache(bool bCache)
+{
+    m_FrameQueue.clear();
+    clearFrameCache();
+    m_bFrameCache = bCache;
+}
+
+
+/**
+ * Destroys the cached buffers, except those currently displayed, which are handed back to the view.
+ */
+void gl3dMiarexView::clearFrameCache()
+{
+    for(QHash<PlaneOpp const*, OppFrame>::iterator it=m_FrameCache.begin(); it!=m_FrameCache.end(); ++it)
+        releaseFrame(it.value());
+    m_FrameCache.clear();
+    m_FrameLRU.clear();
+    m_FrameBufferId.clear();
+    m_FrameCacheBytes = 0;
+}
+
+
+/**
+ * Queues the operating points for which the buffers should be built ahead of their display.
+ * The frames are built one per event loop turn, so that the animation timer is not delayed.
+ */
+void gl3dMiarexView::prepareFrames(QVector<PlaneOpp*> const &POppList)
+{
+    if(!m_bFrameCache) return;
+    m_FrameQueue = POppList;
+    QTimer::singleShot(0, this, [this]{prepareNextFrame();});
+}
+
+
+void gl3dMiarexView::prepareNextFrame()
+{
+    if(!m_bFrameCache || m_FrameQueue.isEmpty()) return;
+
+    if(m_FrameCacheBytes >= qint64(s_FrameCacheSize)*1024*1024)
+    {
+        // the budget is spent, the remaining frames will be built on display
+        m_FrameQueue.clear();
+        return;
+    }
+
+    PlaneOpp *pPOpp = m_FrameQueue.takeFirst();
+    if(!m_FrameCache.contains(pPOpp)) buildFrame(pPOpp);
+
+    if(!m_FrameQueue.isEmpty()) QTimer::singleShot(0, this, [this]{prepareNextFrame();});
+}
+
+
+/**
+ * Builds and caches the buffers of an operating point without changing those on display.
+ * The streamlines are left out, since they take much longer to build than the frame interval.
+ */
+void gl3dMiarexView::buildFrame(PlaneOpp *pPOpp)
+{
+    Plane *pCurPlane = s_pMiarex->m_pCurPlane;
+    WPolar const *pCurWPolar = s_pMiarex->m_pCurWPolar;
+    if(!pCurPlane || !pCurWPolar || !pPOpp || !isValid()) return;
+
+    PlaneTask const & theTask = s_pMiarex->m_theTask;
+
+    makeCurrent();
+
+    // detach the displayed buffers so that the glMake functions allocate new ones
+    OppFrame displayed;
+    QVector<QOpenGLBuffer*> members = oppBuffers();
+    QVector<QOpenGLBuffer*> saved = frameBuffers(displayed);
+    for(int i=0; i<members.size(); i++)
+    {
+        *saved[i] = *members[i];
+        *members[i] = QOpenGLBuffer();
+    }
+    displayed.m_iMomentPoints  = m_iMomentPoints;
+    displayed.m_nPanelCpValues = m_nPanelCpValues;
+    displayed.m_NStreamLines   = m_NStreamLines;
+    displayed.m_bStreamlinesDone = m_bStreamlinesDone;
+
+    pPOpp->expandResults();
+    setSpanStations(pCurPlane, pCurWPolar, pPOpp);
+
+    if(pCurWPolar->analysisMethod()!=xfl::LLTMETHOD)
+    {
+        glMakePanelCpValues(theTask.matSize(), pPOpp);
+        glMakePanelForces(theTask.matSize(), theTask.m_Panel.constData(), pCurWPolar, pPOpp);
+    }
+    for(int iw=0; iw<MAXWINGS; iw++)
+    {
+        Wing const *pWing = pCurPlane->wing(iw);
+        WingOpp const *pWOpp = pPOpp->m_pWOpp[iw];
+        if(pWing && pWOpp)
+        {
+            glMakeLiftStrip(iw, pWing, pCurWPolar, pWOpp);
+            glMakeTransitions(iw, pWing, pCurWPolar, pWOpp);
+            glMakeDragStrip(iw, pWing, pCurWPolar, pWOpp, pPOpp->beta());
+            glMakeDownwash(iw, pWing, pCurWPolar, pWOpp);
+        }
+    }
+    glMakeLiftForce(pCurWPolar, pPOpp);
+    glMakeMoments(pCurPlane->mainWing(), pCurWPolar, pPOpp);
+
+    storeFrame(pPOpp, false);
+
+    // give the display back its buffers, which may belong to the cache or not
+    for(int i=0; i<members.size(); i++) *members[i] = *saved[i];
+    m_iMomentPoints  = displayed.m_iMomentPoints;
+    m_nPanelCpValues = displayed.m_nPanelCpValues;
+    m_NStreamLines   = displayed.m_NStreamLines;
+    m_bStreamlinesDone = displayed.m_bStreamlinesDone;
+
+    PlaneOpp *pCurPOpp = s_pMiarex->m_pCurPOpp;
+    if(pCurPOpp) pCurPOpp->expandResults();
+    setSpanStations(pCurPlane, pCurWPolar, pCurPOpp);
+
+    doneCurrent();
+}
+
+
+/** Returns the buffers of a frame, in the same order as oppBuffers(). */
+QVector<QOpenGLBuffer*> gl3dMiarexView::frameBuffers(OppFrame &frame)
+{
+    QVector<QOpenGLBuffer*> buffers = {&frame.m_vboPanelCpValues, &frame.m_vboPanelForces, &frame.m_vboLiftForce,
+                                       &frame.m_vboMoments, &frame.m_vboStreamLines};
+    for(int iw=0; iw<MAXWINGS; iw++)
+    {
+        buffers.append(&frame.m_vboLiftStrips[iw]);
+        buffers.append(&frame.m_vboTransitions[iw]);
+        buffers.append(&frame.m_vboICd[iw]);
+        buffers.append(&frame.m_vboVCd[iw]);
+        buffers.append(&frame.m_vboDownwash[iw]);
+    }
+    return buffers;
+}
+
+
+/** Returns the view's buffers which depend on the operating point. */
+QVector<QOpenGLBuffer*> gl3dMiarexView::oppBuffers()
+{
+    QVector<QOpenGLBuffer*> buffers = {&m_vboPanelCpValues, &m_vboPanelForces, &m_vboLiftForce,
+                                       &m_vboMoments, &m_vboStreamLines};
+    for(int iw=0; iw<MAXWINGS; iw++)
+    {
+        buffers.append(&m_vboLiftStrips[iw]);
+        buffers.append(&m_vboTransitions[iw]);
+        buffers.append(&m_vboICd[iw]);
+        buffers.append(&m_vboVCd[iw]);
+        buffers.append(&m_vboDownwash[iw]);
+    }
+    return buffers;
+}
+
+
+bool gl3dMiarexView::isCachedBuffer(QOpenGLBuffer const &vbo) const
+{
+    return vbo.isCreated() && m_FrameBufferId.contains(vbo.bufferId());
+}
+
+
+/**
+ * Replaces the buffer with a new one.
+ * The old GL buffer is destroyed, unless it belongs to a cached frame.
+ */
+void gl3dMiarexView::recreateOppBuffer(QOpenGLBuffer &vbo)
+{
+    if(isCachedBuffer(vbo)) vbo = QOpenGLBuffer();
+    else                    vbo.destroy();
+    vbo.create();
+}
+
+
+/**
+ * Stores the buffers currently held by the view as the frame of the operating point.
+ * Buffers which are owned by another frame are not shared, i.e. they were not rebuilt for this operating point.
+ */
+void gl3dMiarexView::storeFrame(PlaneOpp const *pPOpp, bool bStreamLines)
+{
+    if(m_FrameCache.contains(pPOpp))
+    {
+        releaseFrame(m_FrameCache[pPOpp]);
+        m_FrameCache.remove(pPOpp);
+        m_FrameLRU.removeOne(pPOpp);
+    }
+
+    OppFrame frame;
+    QVector<QOpenGLBuffer*> members = oppBuffers();
+    QVector<QOpenGLBuffer*> buffers = frameBuffers(frame);
+    for(int i=0; i<members.size(); i++)
+    {
+        QOpenGLBuffer &vbo = *members[i];
+        if(!vbo.isCreated() || m_FrameBufferId.contains(vbo.bufferId())) continue;
+        if(&vbo==&m_vboStreamLines && !bStreamLines) continue;
+
+        *buffers[i] = vbo;
+        m_FrameBufferId.insert(vbo.bufferId());
+        vbo.bind();
+        frame.m_Bytes += vbo.size();
+        vbo.release();
+    }
+    frame.m_iMomentPoints  = m_iMomentPoints;
+    frame.m_nPanelCpValues = m_nPanelCpValues;
+    frame.m_NStreamLines   = bStreamLines ? m_NStreamLines : 0;
+    frame.m_bStreamlinesDone = bStreamLines && m_bStreamlinesDone;
+
+    m_FrameCache.insert(pPOpp, frame);
+    m_FrameLRU.append(pPOpp);
+    m_FrameCacheBytes += frame.m_Bytes;
+
+    evictFrames();
+}
+
+
+/**
+ * Makes the view display the cached buffers of the operating point.
+ * @param bStreamLines set to true if the frame holds the streamlines
+ * @return true if the operating point's frame was found in the cache
+ */
+bool gl3dMiarexView::restoreFrame(PlaneOpp const *pPOpp, bool &bStreamLines)
+{
+    bStreamLines = false;
+    if(!m_FrameCache.contains(pPOpp)) return false;
+
+    OppFrame &frame = m_FrameCache[pPOpp];
+    QVector<QOpenGLBuffer*> members = oppBuffers();
+    QVector<QOpenGLBuffer*> buffers = frameBuffers(frame);
+    for(int i=0; i<members.size(); i++)
+    {
+        if(!buffers[i]->isCreated()) continue; // keep the view's buffer, e.g. the streamlines of another frame
+        if(members[i]->isCreated() && !isCachedBuffer(*members[i])) members[i]->destroy();
+        *members[i] = *buffers[i];
+    }
+    m_iMomentPoints  = frame.m_iMomentPoints;
+    m_nPanelCpValues = frame.m_nPanelCpValues;
+    if(frame.m_bStreamlinesDone)
+    {
+        m_NStreamLines = frame.m_NStreamLines;
+        m_bStreamlinesDone = true;
+        bStreamLines = true;
+    }
+
+    m_FrameLRU.removeOne(pPOpp);
+    m_FrameLRU.append(pPOpp);
+    return true;
+}
+
+
+/** Destroys the buffers of the frame which are not on display, and hands the others back to the view. */
+void gl3dMiarexView::releaseFrame(OppFrame &frame)
+{
+    QSet<GLuint> displayed;
+    QVector<QOpenGLBuffer*> members = oppBuffers();
+    for(int i=0; i<members.size(); i++)
+        if(members[i]->isCreated()) displayed.insert(members[i]->bufferId());
+
+    QVector<QOpenGLBuffer*> buffers = frameBuffers(frame);
+    for(int i=0; i<buffers.size(); i++)
+    {
+        if(!buffers[i]->isCreated()) continue;
+        GLuint id = buffers[i]->bufferId();
+        m_FrameBufferId.remove(id);
+        if(!displayed.contains(id)) buffers[i]->destroy();
+    }
+    m_FrameCacheBytes -= frame.m_Bytes;
+}
+
+
+/** Drops the least recently displayed frames until the cache fits in its budget; the last frame stored is kept. */
+void gl3dMiarexView::evictFrames()
+{
+    qint64 budget = qint64(s_FrameCacheSize)*1024*1024;
+    while(m_FrameCacheBytes>budget && m_FrameLRU.size()>1)
+    {
+        PlaneOpp const *pPOpp = m_FrameLRU.takeFirst();
+        releaseFrame(m_FrameCache[pPOpp]);
+        m_FrameCache.remove(pPOpp);
+    }
+}
+
+
+/**
+ * Builds the triangles of the mesh imported from an STL file, with flat shading.
+ * The buffer has 3 vertices per triangle, each with 3 position and 3 normal components.
+ */
+void gl3dMiarexView::glMakeRefMesh(PrintMesh const &mesh)
+{
+    m_vboRefMesh.destroy();
+    if(!mesh.nTriangles()) return;
+
+    int buffersize = mesh.nTriangles()*3*6;
+    QVector<float> meshVertexArray(buffersize);
+
+    int iv=0;
+    for(int it=0; it<mesh.nTriangles(); it++)
+    {
+        Vector3d N = mesh.triangleNormal(it);
+        for(int k=0; k<3; k++)
+        {
+            Vector3d const &V = mesh.triangleVertex(it, k);
+            meshVertexArray[iv++] = V.xf();
+            meshVertexArray[iv++] = V.yf();
+            meshVertexArray[iv++] = V.zf();
+            meshVertexArray[iv++] = N.xf();
+            meshVertexArray[iv++] = N.yf();
+            meshVertexArray[iv++] = N.zf();
+        }
+    }
+    Q_ASSERT(iv==buffersize);
+
+    m_vboRefMesh.create();
+    m_vboRefMesh.bind();
+    m_vboRefMesh.allocate(meshVertexArray.data(), buffersize * int(sizeof(GLfloat)));
+    m_vboRefMesh.release();
+}
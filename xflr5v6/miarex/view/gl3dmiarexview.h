@@ -23,8 +23,13 @@
 #pragma once
 
 
+#include <QHash>
+#include <QSet>
+
 #include <xfl3d/views/gl3dxflview.h>
 
+class PrintMesh;
+
 class gl3dMiarexView : public gl3dXflView
 {
     public:
@@ -43,7 +48,11 @@ class gl3dMiarexView : public gl3dXflView
         void glMakeDownwash(int iWing, Wing const *pWing, WPolar const*pWPolar, WingOpp const*pWOpp);
         void glMakeDragStrip(int iWing, Wing const *pWing, WPolar const *pWPolar, WingOpp const *pWOpp, double beta);
         void glMakePanelForces(int nPanels, Panel const*pPanel, WPolar const*pWPolar, PlaneOpp const*pPOpp);
-        void glMakePanels(QOpenGLBuffer &vbo, int nPanels, int nNodes, Vector3d const *pNode, Panel const *pPanel, PlaneOpp const *pPOpp);
+        void glMakePanels(QOpenGLBuffer &vbo, int nPanels, int nNodes, Vector3d const *pNode, Panel const *pPanel);
+        void glMakePanelCpGeometry(int nPanels, Vector3d const *pNode, Panel const *pPanel);
+        void glMakePanelCpValues(int nPanels, PlaneOpp const *pPOpp);
+        void setCpRange(int nPanels, PlaneOpp const *pPOpp);
+        void glMakeRefMesh(PrintMesh const &mesh);
 
         void paintLift(int iWing);
         void paintMoments();
@@ -55,7 +64,36 @@ class gl3dMiarexView : public gl3dXflView
         void paintPanelCp(int nPanels);
         void paintPanelForces(int nPanels);
 
+        void setFrameCache(bool bCache);
+        void clearFrameCache();
+        void prepareFrames(QVector<PlaneOpp*> const &POppList);
+        bool isFrameCacheEnabled() const {return m_bFrameCache;}
+
     private:
+        /** The operating-point buffers of one animation frame. */
+        struct OppFrame
+        {
+            QOpenGLBuffer m_vboPanelCpValues, m_vboPanelForces, m_vboLiftForce, m_vboMoments, m_vboStreamLines;
+            QOpenGLBuffer m_vboLiftStrips[MAXWINGS], m_vboTransitions[MAXWINGS], m_vboICd[MAXWINGS], m_vboVCd[MAXWINGS], m_vboDownwash[MAXWINGS];
+            int m_iMomentPoints=0, m_nPanelCpValues=0, m_NStreamLines=0;
+            bool m_bStreamlinesDone=false;
+            qint64 m_Bytes=0;
+        };
+
+        QVector<QOpenGLBuffer*> frameBuffers(OppFrame &frame);
+        QVector<QOpenGLBuffer*> oppBuffers();
+        bool isCachedBuffer(QOpenGLBuffer const &vbo) const;
+        void recreateOppBuffer(QOpenGLBuffer &vbo);
+        void storeFrame(PlaneOpp const *pPOpp, bool bStreamLines);
+        bool restoreFrame(PlaneOpp const *pPOpp, bool &bStreamLines);
+        void releaseFrame(OppFrame &frame);
+        void evictFrames();
+        void prepareNextFrame();
+        void buildFrame(PlaneOpp *pPOpp);
+
+    private:
+        void initializeGL() override;
+        void glMakeCpColorMap();
         void glRenderView() override;
         void contextMenuEvent(QContextMenuEvent *pEvent) override;
         void paintOverlay() override;
@@ -67,9 +105,23 @@ class gl3dMiarexView : public gl3dXflView
         QOpenGLBuffer m_vboLiftForce, m_vboMoments;
         QOpenGLBuffer m_vboICd[MAXWINGS], m_vboVCd[MAXWINGS], m_vboLiftStrips[MAXWINGS], m_vboTransitions[MAXWINGS], m_vboDownwash[MAXWINGS];
         QOpenGLBuffer m_vboMesh, m_vboLegendColor;
+        QOpenGLBuffer m_vboRefMesh;
+        QOpenGLBuffer m_vboPanelCpValues;       /**< one Cp value per vertex of m_vboPanelCp; the only buffer rewritten when the operating point changes */
+
+        QOpenGLShaderProgram m_shadCp;          /**< the shader which maps the Cp attribute to the colormap */
+        ShaderLocations m_locCp;
+        int m_attrCpScalar, m_uCpMin, m_uCpMax, m_uColorMapSize;
+        int m_nPanelCp, m_nPanelCpValues;       /**< the number of panels held in m_vboPanelCp and in m_vboPanelCpValues */
+        QOpenGLTexture *m_pCpColorMap;          /**< the blue-to-red colour scale, as a single row of texels */
 
         int m_NStreamLines;
 
+        QHash<PlaneOpp const*, OppFrame> m_FrameCache;  /**< the buffers of the operating points already displayed or prepared during the animation */
+        QList<PlaneOpp const*> m_FrameLRU;              /**< the cached frames, least recently displayed first */
+        QSet<GLuint> m_FrameBufferId;                   /**< the ids of the buffers owned by the frame cache */
+        QVector<PlaneOpp*> m_FrameQueue;                /**< the operating points still to prepare */
+        qint64 m_FrameCacheBytes;
+        bool m_bFrameCache;
 
         static bool s_bResetglGeom;               /**< true if the geometry OpenGL list needs to be re-generated */
         static bool s_bResetglMesh;               /**< true if the mesh OpenGL list needs to be re-generated */
@@ -84,6 +136,7 @@ class gl3dMiarexView : public gl3dXflView
         static bool s_bResetglLegend;             /**< true if the legend needs to be reset if the window has been resized */
         static bool s_bResetglBody;               /**< true if the openGL list for the body needs to be re-generated */
         static bool s_bResetglSurfVelocities;     /**< true if the crossflow OpenGL list needs to be refreshed */
+        static bool s_bResetglRefMesh;            /**< true if the imported STL mesh needs to be re-generated */
 
         static double s_LiftScale;                /**< scaling factor for the lift display in 3D view */
         static double s_VelocityScale;            /**< scaling factor for the velocity display in 3D view */
@@ -92,6 +145,8 @@ class gl3dMiarexView : public gl3dXflView
         static bool s_bAutoCpScale;                  /**< true if the Cp scale should be set automatically */
         static double s_LegendMin;                /**< minimum value of the Cp scale in 3D view */
         static double s_LegendMax;                /**< maximum value of the Cp scale in 3D view */
+        static int s_ColorMapSize;                /**< the number of texels in the Cp colormap */
+        static int s_FrameCacheSize;              /**< the GPU memory budget of the animation frame cache, in MB */
 
 
         bool m_bSurfVelocitiesDone;
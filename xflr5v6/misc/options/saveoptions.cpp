@@ -24,10 +24,12 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
+#include <QMessageBox>
 
 
 #include "saveoptions.h"
 #include <xflwidgets/customwts/intedit.h>
+#include <xflobjects/resultcache.h>
 #include "saveoptions.h"
 
 SaveOptions::SaveOptions(QWidget *parent) : QWidget(parent)
@@ -36,6 +38,7 @@ SaveOptions::SaveOptions(QWidget *parent) : QWidget(parent)
     m_bWOpps = true;
     m_bAutoSave = true;
     m_bAutoLoadLast = false;
+    m_bResultCache = false;
     m_SaveInterval = 17;
     setupLayout();
 }
@@ -86,18 +89,35 @@ void SaveOptions::setupLayout()
         pSaveTimerBox->setLayout(pSaveTimerLayout);
     }
 
+    QGroupBox *pResultCacheBox = new QGroupBox(tr("Result cache"));
+    {
+        QHBoxLayout *pResultCacheLayout = new QHBoxLayout;
+        {
+            m_pchResultCache = new QCheckBox(tr("Store and re-use the converged operating points"));
+            m_pchResultCache->setToolTip(tr("The operating points are stored on disk and re-used by any analysis with the same geometry and polar settings"));
+            QPushButton *ppbClearCache = new QPushButton(tr("Clear cache"));
+            pResultCacheLayout->addWidget(m_pchResultCache);
+            pResultCacheLayout->addStretch();
+            pResultCacheLayout->addWidget(ppbClearCache);
+
+            connect(ppbClearCache, SIGNAL(clicked()), SLOT(onClearResultCache()));
+        }
+        pResultCacheBox->setLayout(pResultCacheLayout);
+    }
+
     QVBoxLayout *pMainLayout = new QVBoxLayout;
     {
         pMainLayout->addWidget(pLoadBox);
         pMainLayout->addWidget(pSaveTimerBox);
         pMainLayout->addStretch(1);
         pMainLayout->addWidget(pSaveOppBox);
+        pMainLayout->addWidget(pResultCacheBox);
     }
     setLayout(pMainLayout);
 }
 
 
-void SaveOptions::initWidget(bool bAutoLoadLast, bool bOpps, bool bWOpps, bool bAutoSave, int saveInterval)
+void SaveOptions::initWidget(bool bAutoLoadLast, bool bOpps, bool bWOpps, bool bAutoSave, int saveInterval, bool bResultCache)
 {
     m_bAutoLoadLast = bAutoLoadLast;
     m_bAutoSave = bAutoSave;
@@ -111,6 +131,9 @@ void SaveOptions::initWidget(bool bAutoLoadLast, bool bOpps, bool bWOpps, bool b
     m_pchAutoSave->setChecked(m_bAutoSave);
     m_pieInterval->setValue(m_SaveInterval);
     m_pieInterval->setEnabled(m_bAutoSave);
+
+    m_bResultCache = bResultCache;
+    m_pchResultCache->setChecked(m_bResultCache);
 }
 
 
@@ -121,6 +144,17 @@ void SaveOptions::onOK()
     m_bWOpps = m_pchWOpps->isChecked();
     m_bAutoSave = m_pchAutoSave->isChecked();
     m_SaveInterval = m_pieInterval->value();
+    m_bResultCache = m_pchResultCache->isChecked();
+}
+
+
+void SaveOptions::onClearResultCache()
+{
+    QString strong = tr("Delete all the operating points stored in the result cache?\n")+ResultCache::dirPath();
+    if (QMessageBox::Yes != QMessageBox::question(window(), tr("Question"), strong, QMessageBox::Yes|QMessageBox::Cancel))
+        return;
+
+    ResultCache::clear();
 }
 
 
@@ -34,20 +34,23 @@ class SaveOptions : public QWidget
     public:
         SaveOptions(QWidget *parent = nullptr);
 
-        void initWidget(bool bAutoLoadLast=false, bool bOpps=false, bool bWOpps = true, bool bAutoSave=true, int saveInterval=10);
+        void initWidget(bool bAutoLoadLast=false, bool bOpps=false, bool bWOpps = true, bool bAutoSave=true, int saveInterval=10, bool bResultCache=false);
 
     public slots:
         void onOK();
+        void onClearResultCache();
 
     private:
         void setupLayout();
         void readParams();
 
         bool m_bOpps, m_bWOpps, m_bAutoSave, m_bAutoLoadLast;
+        bool m_bResultCache;
         int m_SaveInterval;
 
         IntEdit *m_pieInterval;
         QCheckBox *m_pchOpps, *m_pchWOpps;
         QCheckBox *m_pchAutoSave, *m_pchAutoLoadLast;
+        QCheckBox *m_pchResultCache;
 };
 
@@ -356,20 +356,20 @@ void FoilDesignWt::dragSelectedPoint(double , double )
     {
         m_pSF->extrados()->m_CtrlPt[n].x = m_MousePos.x;
         m_pSF->extrados()->m_CtrlPt[n].y = m_MousePos.y;
-        m_pSF->extrados()->splineCurve();
+        m_pSF->extrados()->updateSplineCurve(n);
 
         if(m_pSF->isSymetric())
         {
             m_pSF->intrados()->m_CtrlPt[n].x = m_MousePos.x;
             m_pSF->intrados()->m_CtrlPt[n].y = -m_MousePos.y;
-            m_pSF->intrados()->splineCurve();
+            m_pSF->intrados()->updateSplineCurve(n);
         }
         if(m_pSF->bClosedTE())
         {
             if(n==m_pSF->extrados()->m_CtrlPt.size()-1)
             {
                 m_pSF->intrados()->m_CtrlPt.back() = m_pSF->extrados()->m_CtrlPt.back();
-                m_pSF->intrados()->splineCurve();
+                m_pSF->intrados()->updateSplineCurve(m_pSF->intrados()->m_CtrlPt.size()-1);
             }
         }
         if(m_pSF->bClosedLE())
@@ -377,7 +377,7 @@ void FoilDesignWt::dragSelectedPoint(double , double )
             if(n==0)
             {
                 m_pSF->intrados()->m_CtrlPt.front() = m_pSF->extrados()->m_CtrlPt.front();
-                m_pSF->intrados()->splineCurve();
+                m_pSF->intrados()->updateSplineCurve(0);
             }
         }
 
@@ -391,16 +391,15 @@ void FoilDesignWt::dragSelectedPoint(double , double )
         {
             m_pSF->intrados()->m_CtrlPt[n].x = m_MousePos.x;
             m_pSF->intrados()->m_CtrlPt[n].y = m_MousePos.y;
-            m_pSF->intrados()->splineCurve();
-            m_pSF->updateSplineFoil();
+            m_pSF->intrados()->updateSplineCurve(n);
 
             if(m_pSF->isSymetric())
             {
                 m_pSF->extrados()->m_CtrlPt[n].x =  m_MousePos.x;
                 m_pSF->extrados()->m_CtrlPt[n].y = -m_MousePos.y;
-                m_pSF->extrados()->splineCurve();
-                m_pSF->updateSplineFoil();
+                m_pSF->extrados()->updateSplineCurve(n);
             }
+            m_pSF->updateSplineFoil();
             m_pSF->setModified(true);
         }
     }
@@ -307,6 +307,7 @@ void BatchCtrlDlg::startAnalyses()
 
             if(s_bAlpha) pXFoilTask->setSequence(true,  s_AlphaMin, s_AlphaMax, s_AlphaInc);
             else         pXFoilTask->setSequence(false, s_ClMin, s_ClMax, s_ClInc);
+            pXFoilTask->setSubSweeps(s_nThreads/qMax(1, m_nTasks));
             pXFoilTask->initializeXFoilTask(pFoil, pPolar, true, s_bInitBL, s_bFromZero);
 
 //            QFuture<Polar*> future = QtConcurrent::run(pXFoilTask, &XFoilTask::runFuture);
@@ -23,14 +23,15 @@
 #include <QVBoxLayout>
 #include <QGroupBox>
 #include <QCoreApplication>
-#include <QThreadPool>
 #include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QDir>
 
 #include "batchthreaddlg.h"
 
-#include <xdirect/analysis/xfoiltask.h>
+#include <xdirect/analysis/xfoilbatch.h>
 #include <xflobjects/objects2d/objects2d.h>
+#include <xflobjects/resultcache.h>
 #include <xdirect/xdirect.h>
 
 
@@ -42,9 +43,9 @@ BatchThreadDlg::BatchThreadDlg(QWidget *pParent) : BatchAbstractDlg(pParent)
     setWindowTitle(tr("Multi-threaded batch analysis"));
 
     m_pTimer = nullptr;
+    m_pBatch = nullptr;
 
     m_nTaskDone    = 0;
-    m_nTaskStarted = 0;
     m_nAnalysis    = 0;
 
     setupLayout();
@@ -54,13 +55,14 @@ BatchThreadDlg::BatchThreadDlg(QWidget *pParent) : BatchAbstractDlg(pParent)
 
 BatchThreadDlg::~BatchThreadDlg()
 {
-    //clean up the rest of the analysis in case of cancellation
-    for(int ia=m_AnalysisPair.count()-1; ia>=0; ia--)
+    // in case the dialog is destroyed while the batch is running
+    if(!m_BatchFuture.isFinished())
     {
-        FoilAnalysis *pAnalysis = m_AnalysisPair.last();
-        m_AnalysisPair.removeLast();
-        delete pAnalysis;
+        XFoilTask::s_bCancel = true;
+        XFoil::setCancel(true);
+        m_BatchFuture.waitForFinished();
     }
+    delete m_pBatch;
 }
 
 
@@ -126,8 +128,6 @@ void BatchThreadDlg::onAnalyze()
     setFileHeader();
     s_bInitBL = m_pchInitBL->isChecked();
 
-    QThreadPool::globalInstance()->setMaxThreadCount(2);
-
     m_ppbAnalyze->setFocus();
     startAnalysis();
 }
@@ -135,8 +135,8 @@ void BatchThreadDlg::onAnalyze()
 
 /**
  * Starts the multithreaded analysis.
- * First, creates a pool list of all (Foil, pairs) to analyze.
- * Then, starts the threads which will pick the pairs from the pool and remove them once the analayis is finished.
+ * Creates the batch of all (Foil, Polar) pairs to analyze and runs it in the background.
+ * The batch's scheduler splits the polars into chunks and distributes them to the worker threads.
  */
 void BatchThreadDlg::startAnalysis()
 {
@@ -165,12 +165,16 @@ void BatchThreadDlg::startAnalysis()
 
     //    QThreadPool::globalInstance()->setExpiryTimeout(60000);//ms
 
-    //build an array of all analysis pairs to run
+    //build the batch of all analysis pairs to run
     m_nAnalysis = 0;
     m_nTaskDone = 0;
-    m_nTaskStarted = 0;
+    XFoil::resetFactorCacheStats();
+    ResultCache::resetStatistics();
+
+    delete m_pBatch;
+    m_pBatch = new XFoilBatch(this);
+    m_pBatch->setSequenceType(s_bAlpha, s_bInitBL, s_bFromZero);
 
-    FoilAnalysis *pAnalysis=nullptr;
     for(int i=0; i<m_FoilList.count(); i++)
     {
         Foil *pFoil = Objects2d::foil(m_FoilList.at(i));
@@ -178,21 +182,35 @@ void BatchThreadDlg::startAnalysis()
         {
             for (int iRe=0; iRe<nRe; iRe++)
             {
-                pAnalysis = new FoilAnalysis;
-                m_AnalysisPair.append(pAnalysis);
-                pAnalysis->pFoil = pFoil;
+                FoilAnalysis analysis;
+                analysis.pFoil = pFoil;
 
                 if(!s_bFromList)
                 {
-                    pAnalysis->pPolar = Objects2d::createPolar(pFoil, xfl::FIXEDSPEEDPOLAR, s_ReMin + iRe *s_ReInc,
-                                                               s_Mach, s_ACrit, s_XTop, s_XBot);
+                    analysis.pPolar = Objects2d::createPolar(pFoil, xfl::FIXEDSPEEDPOLAR, s_ReMin + iRe *s_ReInc,
+                                                             s_Mach, s_ACrit, s_XTop, s_XBot);
+                }
+                else
+                {
+                    analysis.pPolar = Objects2d::createPolar(pFoil, xfl::FIXEDSPEEDPOLAR,
+                                                             XDirect::s_ReList[iRe], XDirect::s_MachList[iRe], XDirect::s_NCritList[iRe],
+                                                             s_XTop, s_XBot);
+                }
+                analysis.pPolar->setVisible(true);
+
+                if(s_bAlpha)
+                {
+                    analysis.vMin = s_AlphaMin;
+                    analysis.vMax = s_AlphaMax;
+                    analysis.vInc = s_AlphaInc;
                 }
                 else
                 {
-                    pAnalysis->pPolar = Objects2d::createPolar(pFoil, xfl::FIXEDSPEEDPOLAR,
-                                                               XDirect::s_ReList[iRe], XDirect::s_MachList[iRe], XDirect::s_NCritList[iRe],
-                                                               s_XTop, s_XBot);
+                    analysis.vMin = s_ClMin;
+                    analysis.vMax = s_ClMax;
+                    analysis.vInc = s_ClInc;
                 }
+                m_pBatch->addAnalysis(analysis);
 
                 m_nAnalysis++;
             }
@@ -201,15 +219,17 @@ void BatchThreadDlg::startAnalysis()
     strong = QString(tr("Found %1 foil/polar pairs to analyze\n")).arg(m_nAnalysis);
     m_pteTextOutput->insertPlainText(strong);
 
-    // Start as many threads as the user has requested
-    // This is a complex way of doing things; QFuture and QRunnable are simpler
-
     XFoilTask::s_bCancel = false;
+    XFoilTask::s_bSkipOpp = XFoilTask::s_bSkipPolar = false;
+    XFoil::setCancel(false);
 
     strong = QString(tr("Starting with %1 threads\n\n")).arg(s_nThreads);
     m_pteTextOutput->insertPlainText(strong);
     m_pteTextOutput->insertPlainText(tr("\nStarted/Done/Total\n"));
 
+    // the batch blocks until all the polars are done, so run it out of the event loop
+    m_BatchFuture = QtConcurrent::run(m_pBatch, &XFoilBatch::run, s_nThreads);
+
     if(m_pTimer)
     {
         m_pTimer->stop();
@@ -222,78 +242,35 @@ void BatchThreadDlg::startAnalysis()
 
 
 /**
- * A timer event used to check at regular intervals if any threads are inactive
- * in which case it launches a task if any are left.
- * Also checks if the user has pressed the Cancel button
+ * A timer event used to check at regular intervals if the batch is done.
 */
 void BatchThreadDlg::onTimerEvent()
 {
     QString strong;
-    //time to launch another analysis, if any are left
 
-    if(m_AnalysisPair.size()<=0 || m_bCancel)
-    {
-        //nothing left to launch... just wait and enjoy the show
-        if(m_nTaskDone>=m_nAnalysis || m_bCancel)
-        {
-            QThreadPool::globalInstance()->waitForDone();
+    if(!m_pBatch || !m_BatchFuture.isFinished()) return;
 
-            if(m_bCancel) strong = tr("\n_____Analysis cancelled_____\n");
-            else          strong = tr("\n_____Analysis completed_____\n");
-            m_pteTextOutput->insertPlainText(strong);
-            m_pteTextOutput->ensureCursorVisible();
+    m_pTimer->stop();
 
-            m_pTimer->stop();
-            cleanUp();
+    // the task events posted by the last polars are handled first
+    QCoreApplication::sendPostedEvents(this);
 
-            if(s_pXDirect->m_bPolarView && s_bUpdatePolarView)
-            {
-                s_pXDirect->createPolarCurves();
-                s_pXDirect->updateView();
-            }
-        }
-    }
-    else if(m_bIsRunning)
-    {
-        //need to check if we are still running in case a timer event arrives after a cancellation for instance.
-        startThread(); // analyze a new pair
-    }
-}
+    if(m_bCancel) strong = tr("\n_____Analysis cancelled_____\n");
+    else          strong = tr("\n_____Analysis completed_____\n");
+    m_pteTextOutput->insertPlainText(strong);
+    m_pteTextOutput->insertPlainText(m_pBatch->utilisationReport());
+    strong = QString(tr("Inviscid factorizations: %1 computed, %2 re-used from cache\n"))
+                .arg(XFoil::factorCacheMisses()).arg(XFoil::factorCacheHits());
+    m_pteTextOutput->insertPlainText(strong);
+    if(ResultCache::isEnabled()) m_pteTextOutput->insertPlainText(ResultCache::statistics(ResultCache::FOILOPP));
+    m_pteTextOutput->ensureCursorVisible();
 
-/**
- * Starts an individual thread
- */
-void BatchThreadDlg::startThread()
-{
-    FoilAnalysis *pAnalysis;
-    QString strong;
-    //  browse through the array until we find an available thread
+    cleanUp();
 
-    if(QThreadPool::globalInstance()->activeThreadCount()<s_nThreads && m_AnalysisPair.count())
+    if(s_pXDirect->m_bPolarView && s_bUpdatePolarView)
     {
-        XFoilTask *pXFoilTask = new XFoilTask(this);
-
-        //take the last analysis in the array
-        pAnalysis = m_AnalysisPair.at(m_AnalysisPair.size()-1);
-
-        pAnalysis->pPolar->setVisible(true);
-
-        //initiate the task
-        if(s_bAlpha) pXFoilTask->setSequence(true,  s_AlphaMin, s_AlphaMax, s_AlphaInc);
-        else         pXFoilTask->setSequence(false, s_ClMin, s_ClMax, s_ClInc);
-
-        pXFoilTask->initializeXFoilTask(pAnalysis->pFoil, pAnalysis->pPolar, true, s_bInitBL, s_bFromZero);
-
-        //launch it
-        m_nTaskStarted++;
-        strong = tr("Starting ")+pAnalysis->pFoil->name()+" / "+pAnalysis->pPolar->polarName()+"\n";
-        updateOutput(strong);
-        QThreadPool::globalInstance()->start(pXFoilTask);
-
-        //remove it from the array of pairs to analyze
-        pAnalysis = m_AnalysisPair.last();
-        m_AnalysisPair.removeLast();
-        delete pAnalysis;
+        s_pXDirect->createPolarCurves();
+        s_pXDirect->updateView();
     }
 }
 
@@ -305,7 +282,8 @@ void BatchThreadDlg::startThread()
 void BatchThreadDlg::updateOutput(QString const&str)
 {
     QString strong;
-    strong = QString::asprintf("%3d/%3d/%3d  ", m_nTaskStarted, m_nTaskDone, m_nAnalysis);
+    int nStarted = m_pBatch ? m_pBatch->nStarted() : 0;
+    strong = QString::asprintf("%3d/%3d/%3d  ", nStarted, m_nTaskDone, m_nAnalysis);
     m_pteTextOutput->insertPlainText(strong + str);
     m_pteTextOutput->ensureCursorVisible();
 }
@@ -318,13 +296,9 @@ void BatchThreadDlg::cleanUp()
 {
     BatchAbstractDlg::cleanUp();
 
-    //in case we cancelled, delete all Analysis that are left
-    for(int ia=m_AnalysisPair.count()-1; ia>=0; ia--)
-    {
-        FoilAnalysis *pAnalysis = m_AnalysisPair.at(ia);
-        delete pAnalysis;
-        m_AnalysisPair.removeAt(ia);
-    }
+    m_BatchFuture.waitForFinished();
+    delete m_pBatch;
+    m_pBatch = nullptr;
 }
 
 
@@ -339,6 +313,11 @@ void BatchThreadDlg::customEvent(QEvent * pEvent)
         XFoilOppEvent *pOppEvent = dynamic_cast<XFoilOppEvent*>(pEvent);
         delete pOppEvent->theOpPoint();
     }
+    else if(pEvent->type() == MESSAGE_EVENT)
+    {
+        MessageEvent *pMsgEvent = dynamic_cast<MessageEvent*>(pEvent);
+        updateOutput(pMsgEvent->msg());
+    }
 }
 
 
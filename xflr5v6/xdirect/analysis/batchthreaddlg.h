@@ -28,9 +28,13 @@
 */
 
 
+#include <QFuture>
+
 #include "batchabstractdlg.h"
 #include <xflcore/core_enums.h>
 
+class XFoilBatch;
+
 
 /**
  * @brief This class implements an interface to perform a multi-threaded batch foil analysis.
@@ -52,7 +56,6 @@ class BatchThreadDlg : public BatchAbstractDlg
         void handleXFoilTaskEvent(const XFoilTaskEvent *pEvent);
         void setupLayout();
         void startAnalysis();
-        void startThread();
         void updateOutput(const QString &str);
 
     private slots:
@@ -60,13 +63,13 @@ class BatchThreadDlg : public BatchAbstractDlg
         void onTimerEvent();
 
     private:
-        int m_nTaskStarted;         /**< the number of started tasks */
         int m_nTaskDone;            /**< the number of finished tasks */
         int m_nAnalysis;            /**< the number of analysis pairs to run */
 
         QTimer *m_pTimer;
 
-        QVector<FoilAnalysis *> m_AnalysisPair;  /**< the list of all analysis to be performed. Once performed, an analysis is removed from the list. */
+        XFoilBatch *m_pBatch;           /**< the scheduler of the batch's analyses */
+        QFuture<void> m_BatchFuture;    /**< the run of the batch, out of the event loop */
 
 };
 
@@ -352,6 +352,10 @@ void XFoilAnalysisDlg::analyze()
     onProgress();
     m_pXFoilTask->m_OutStream.flush();
 
+#ifdef XFL_PERFSTATS
+    m_pXFoilTask->perfStats().writeSidecar("xfoil", XDirect::curFoil()->name(), XDirect::curPolar()->name());
+#endif
+
     m_bErrors = m_pXFoilTask->m_bErrors;
     if(m_bErrors)
     {
@@ -0,0 +1,368 @@
+/****************************************************************************
+
+    XFoilBatch Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include <QCoreApplication>
+#include <QThreadPool>
+#include <QFutureSynchronizer>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "xfoilbatch.h"
+#include <xflcore/xflevents.h>
+
+
+int XFoilBatch::s_nChunksPerThread = 3;
+
+
+/**
+* The public constructor
+* @param pParent the object to which the operating point and end of polar events are posted; may be null
+*/
+XFoilBatch::XFoilBatch(QObject *pParent)
+{
+    m_pParent = pParent;
+    m_bAlpha    = true;
+    m_bInitBL   = true;
+    m_bFromZero = false;
+    m_nChunks = 0;
+    m_WallNs = 0;
+}
+
+
+XFoilBatch::~XFoilBatch()
+{
+    for(int ij=0; ij<m_Job.size(); ij++)
+    {
+        if(m_Job.at(ij).pMaster)
+        {
+            qDeleteAll(m_Job.at(ij).pMaster->m_SubSweeps);
+            delete m_Job.at(ij).pMaster;
+        }
+    }
+}
+
+
+/**
+* Defines the sequence which is run for all the polars of the batch, except the fixed aoa polars
+* which are run for a range of Reynolds numbers.
+* @param bAlpha true if the sequence is a range of aoa, false if it is a range of lift coefficients
+* @param bInitBL true if the BL is initialized at the start of the sequence
+* @param bFromZero true if the aoa sequence is run from zero up and down to the range's bounds
+*/
+void XFoilBatch::setSequenceType(bool bAlpha, bool bInitBL, bool bFromZero)
+{
+    m_bAlpha    = bAlpha;
+    m_bInitBL   = bInitBL;
+    m_bFromZero = bFromZero;
+}
+
+
+/**
+* Adds a (foil, polar) pair to the batch.
+* The range of the analysis is defined by the vMin, vMax and vInc fields of the FoilAnalysis.
+*/
+void XFoilBatch::addAnalysis(FoilAnalysis const &analysis)
+{
+    Job job;
+    job.analysis = analysis;
+    m_Job.append(job);
+}
+
+
+/**
+* Returns an estimation of the relative cost of a polar's analysis; only the ratios between polars matter.
+* The number of viscous iterations increases at low Reynolds numbers and with the length of the laminar runs.
+* @param analysis the (foil, polar) pair
+* @param nPoints the number of operating points of the sequence
+*/
+double XFoilBatch::expectedCost(FoilAnalysis const &analysis, int nPoints) const
+{
+    Polar const *pPolar = analysis.pPolar;
+
+    double Re = pPolar->Reynolds();
+    if(pPolar->isFixedaoaPolar()) Re = 0.5*(analysis.vMin+analysis.vMax);
+    double logRe = log10(qMax(qAbs(Re), 1000.0));
+
+    double cost = double(nPoints) * double(qMax(analysis.pFoil->m_n, 1));
+    cost *= 1.0 + qMax(0.0, 6.0-logRe);
+    cost *= 1.0 + 0.05*pPolar->NCrit();
+    cost *= 1.0 + pPolar->Mach()*pPolar->Mach();
+    return cost;
+}
+
+
+/**
+* Splits the polars into chunks and deals them to the workers' queues.
+* The polars are only split if they are fewer than the target number of chunks, since each chunk restarts from a cold BL.
+* The chunks are dealt by decreasing cost, each to the worker which has the least expected work.
+*/
+void XFoilBatch::planChunks(int nThreads)
+{
+    m_Worker.clear();
+    m_Worker.resize(nThreads);
+
+    int nTarget = s_nChunksPerThread*nThreads;
+    int nSplit = 1;
+    if(m_Job.size() && m_Job.size()<nTarget) nSplit = (nTarget+m_Job.size()-1)/m_Job.size();
+
+    QVector<Chunk> chunks;
+    for(int ij=0; ij<m_Job.size(); ij++)
+    {
+        Job &job = m_Job[ij];
+        FoilAnalysis const &analysis = job.analysis;
+        bool bFromZero = m_bFromZero && m_bAlpha && !analysis.pPolar->isFixedaoaPolar();
+
+        int n0=0, n1=0;
+        XFoilTask::seriesLength(analysis.vMin, analysis.vMax, analysis.vInc, bFromZero, n0, n1);
+        job.nPoints = n0+n1;
+        job.nChunks = qMin(nSplit, job.nPoints/qMax(1, XFoilTask::s_nMinSubSweepPoints));
+        if(job.nChunks<2) job.nChunks = 1;
+        job.nDone = 0;
+
+        double cost = expectedCost(analysis, job.nPoints)/double(job.nChunks);
+        for(int ic=0; ic<job.nChunks; ic++)
+        {
+            Chunk chunk;
+            chunk.iJob = ij;
+            chunk.iSweep = ic;
+            chunk.cost = cost;
+            chunks.append(chunk);
+        }
+    }
+
+    // longest first; the sub-sweeps of a polar stay in the order of the sequence
+    std::stable_sort(chunks.begin(), chunks.end(), [](Chunk const &c0, Chunk const &c1) {return c0.cost>c1.cost;});
+
+    for(int ic=0; ic<chunks.size(); ic++)
+    {
+        int iw = 0;
+        for(int jw=1; jw<m_Worker.size(); jw++)
+        {
+            if(m_Worker.at(jw).remaining<m_Worker.at(iw).remaining) iw = jw;
+        }
+        m_Worker[iw].queue.append(chunks.at(ic));
+        m_Worker[iw].remaining += chunks.at(ic).cost;
+    }
+    m_nChunks = chunks.size();
+}
+
+
+/**
+* Runs the batch on the requested number of worker threads and returns when all the polars are done,
+* or when the analysis has been cancelled.
+*/
+void XFoilBatch::run(int nThreads)
+{
+    nThreads = qMax(1, nThreads);
+    planChunks(nThreads);
+    m_nStarted.storeRelease(0);
+
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(nThreads);
+    QFutureSynchronizer<void> futureSync;
+    for(int iw=0; iw<nThreads; iw++)
+    {
+        futureSync.addFuture(QtConcurrent::run(&pool, this, &XFoilBatch::runWorker, iw));
+    }
+    futureSync.waitForFinished();
+
+    // after a cancellation, the polars which have been started are closed with the points computed so far
+    for(int ij=0; ij<m_Job.size(); ij++)
+    {
+        if(m_Job.at(ij).pMaster) finishJob(m_Job[ij]);
+    }
+
+    m_WallNs = wallTimer.nsecsElapsed();
+}
+
+
+/**
+* The loop of a worker thread: runs the chunks of its own queue, then steals from the others until none are left.
+*/
+void XFoilBatch::runWorker(int iWorker)
+{
+    Chunk chunk;
+    QElapsedTimer chunkTimer;
+    while(takeChunk(iWorker, chunk))
+    {
+        chunkTimer.start();
+        runChunk(chunk);
+
+        // only written by this worker
+        m_Worker[iWorker].busyNs += chunkTimer.nsecsElapsed();
+        m_Worker[iWorker].nRun++;
+    }
+}
+
+
+/**
+* Takes the next chunk for a worker: the most expensive of its own queue, or else the cheapest of the queue
+* which has the most work left.
+* @return false if there is no chunk left or if the analysis has been cancelled
+*/
+bool XFoilBatch::takeChunk(int iWorker, Chunk &chunk)
+{
+    QMutexLocker locker(&m_QueueMutex);
+    if(XFoilTask::s_bCancel) return false;
+
+    Worker &worker = m_Worker[iWorker];
+    if(worker.queue.size())
+    {
+        chunk = worker.queue.takeFirst();
+        worker.remaining -= chunk.cost;
+        return true;
+    }
+
+    int iVictim = -1;
+    for(int iw=0; iw<m_Worker.size(); iw++)
+    {
+        if(iw==iWorker || m_Worker.at(iw).queue.isEmpty()) continue;
+        if(iVictim<0 || m_Worker.at(iw).remaining>m_Worker.at(iVictim).remaining) iVictim = iw;
+    }
+    if(iVictim<0) return false;
+
+    Worker &victim = m_Worker[iVictim];
+    chunk = victim.queue.takeLast();
+    victim.remaining -= chunk.cost;
+    worker.nStolen++;
+    return true;
+}
+
+
+/**
+* Runs one chunk. The polar's task is created by the first of its chunks to run, and is closed by the last.
+*/
+void XFoilBatch::runChunk(Chunk const &chunk)
+{
+    Job &job = m_Job[chunk.iJob];
+
+    m_JobMutex.lock();
+    if(!job.pMaster) startJob(job);
+    XFoilTask *pMaster = job.pMaster;
+    m_JobMutex.unlock();
+
+    if(job.nChunks<2)
+    {
+        if(pMaster->initXFoilInstance(true))
+        {
+            if(pMaster->m_pPolar->isFixedaoaPolar()) pMaster->ReSequence();
+            else                                     pMaster->alphaSequence();
+        }
+        else pMaster->m_bErrors = true;
+    }
+    else if(chunk.iSweep<pMaster->m_SubSweeps.size())
+    {
+        // a short series may have been split into fewer sub-sweeps than planned
+        pMaster->m_SubSweeps.at(chunk.iSweep)->runSubSweep();
+    }
+
+    QMutexLocker locker(&m_JobMutex);
+    job.nDone++;
+    if(job.nDone>=job.nChunks) finishJob(job);
+}
+
+
+/**
+* Creates the task of a polar and its sub-sweeps, and notifies the parent that the polar has been picked up by a worker.
+* The task is not initialized with XFoilTask::initializeXFoilTask(), which would reset the cancellation flags.
+*/
+void XFoilBatch::startJob(Job &job)
+{
+    FoilAnalysis const &analysis = job.analysis;
+
+    if(m_pParent)
+    {
+        QString strong = QObject::tr("Starting ")+analysis.pFoil->name()+" / "+analysis.pPolar->polarName()+"\n";
+        qApp->postEvent(m_pParent, new MessageEvent(strong));
+    }
+
+    XFoilTask *pMaster = new XFoilTask(m_pParent);
+    pMaster->setAutoDelete(false);
+    pMaster->m_pFoil  = analysis.pFoil;
+    pMaster->m_pPolar = analysis.pPolar;
+    pMaster->m_bInitBL   = m_bInitBL;
+    pMaster->m_bFromZero = m_bFromZero;
+    pMaster->m_bViscous  = true;
+    pMaster->m_bErrors = false;
+    pMaster->m_bIsFinished = false;
+
+    if(analysis.pPolar->isFixedaoaPolar()) pMaster->setReRange(analysis.vMin, analysis.vMax, analysis.vInc);
+    else                                   pMaster->setSequence(m_bAlpha, analysis.vMin, analysis.vMax, analysis.vInc);
+
+    if(job.nChunks>1) pMaster->planSubSweeps(job.nChunks);
+
+    job.pMaster = pMaster;
+    m_nStarted.ref();
+}
+
+
+/**
+* Merges the results of the polar's sub-sweeps, notifies the parent and deletes the task.
+*/
+void XFoilBatch::finishJob(Job &job)
+{
+    XFoilTask *pMaster = job.pMaster;
+    if(!pMaster) return;
+
+    if(job.nChunks>1) pMaster->mergeSubSweeps();
+    pMaster->m_bIsFinished = true;
+
+    if(m_pParent)
+    {
+        qApp->postEvent(m_pParent, new XFoilTaskEvent(pMaster->m_pFoil, pMaster->m_pPolar));
+    }
+
+    delete pMaster;
+    job.pMaster = nullptr;
+}
+
+
+/**
+* Returns the summary of the last run: the number of chunks run and stolen by each worker thread,
+* and the fraction of the batch's duration during which it has been busy.
+*/
+QString XFoilBatch::utilisationReport() const
+{
+    double wall = double(qMax(m_WallNs, qint64(1)));
+
+    QString strange;
+    strange = QString::asprintf("%d polars run in %d chunks on %d threads in %.2f s\n",
+                                int(m_Job.size()), m_nChunks, int(m_Worker.size()), wall/1.e9);
+
+    double totalBusy = 0.0;
+    for(int iw=0; iw<m_Worker.size(); iw++)
+    {
+        Worker const &worker = m_Worker.at(iw);
+        totalBusy += double(worker.busyNs);
+        strange += QString::asprintf("   Thread %2d: %3d chunks, %3d stolen, busy %5.1f%%\n",
+                                     iw+1, worker.nRun, worker.nStolen, 100.0*double(worker.busyNs)/wall);
+    }
+    if(m_Worker.size())
+        strange += QString::asprintf("   Mean utilisation: %5.1f%%\n", 100.0*totalBusy/wall/double(m_Worker.size()));
+
+    return strange;
+}
+
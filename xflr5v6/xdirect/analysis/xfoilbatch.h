@@ -0,0 +1,113 @@
+/****************************************************************************
+
+    XFoilBatch Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+/** @file This file implements the scheduler of the multi-threaded batch foil analyses. */
+
+#pragma once
+
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+#include <xdirect/analysis/xfoiltask.h>
+
+class QObject;
+
+/**
+ * @class XFoilBatch
+ * Runs a batch of (foil, polar) analyses on a fixed number of worker threads.
+ *
+ * The range of each polar may be split into chunks, which are the sub-sweeps of an XFoilTask.
+ * The chunks are sorted by decreasing expected cost and dealt to the workers' queues.
+ * Each worker takes the most expensive chunk of its own queue; once its queue is empty,
+ * it steals the cheapest chunk of the queue which has the most work left.
+ * The operating points and the end of each polar are notified to the parent with the same events as the XFoilTask.
+ * The start of each polar is notified with a MessageEvent.
+ */
+class XFoilBatch
+{
+    public:
+        XFoilBatch(QObject *pParent=nullptr);
+        ~XFoilBatch();
+
+        void setSequenceType(bool bAlpha, bool bInitBL, bool bFromZero);
+        void addAnalysis(FoilAnalysis const &analysis);
+        int nAnalyses() const {return m_Job.size();}
+        int nStarted()  const {return m_nStarted.loadAcquire();}
+        int nChunks()   const {return m_nChunks;}
+
+        void run(int nThreads);
+        QString utilisationReport() const;
+
+        static int s_nChunksPerThread;  /**< the target number of chunks per worker thread; the polars are only split if they are fewer */
+
+    private:
+        struct Job
+        {
+            FoilAnalysis analysis;
+            XFoilTask *pMaster=nullptr;  /**< the task which owns the sub-sweeps; created when the first chunk is run */
+            int nPoints=0;
+            int nChunks=1;
+            int nDone=0;
+        };
+
+        struct Chunk
+        {
+            int iJob=-1;
+            int iSweep=0;                /**< the index of the sub-sweep; 0 if the polar is not split */
+            double cost=0.0;
+        };
+
+        struct Worker
+        {
+            QVector<Chunk> queue;        /**< sorted by decreasing cost; the owner takes from the front, the thieves from the back */
+            double remaining=0.0;        /**< the expected cost of the queued chunks */
+            qint64 busyNs=0;
+            int nRun=0;
+            int nStolen=0;
+        };
+
+    private:
+        void planChunks(int nThreads);
+        bool takeChunk(int iWorker, Chunk &chunk);
+        void runWorker(int iWorker);
+        void runChunk(Chunk const &chunk);
+        void startJob(Job &job);
+        void finishJob(Job &job);
+
+        double expectedCost(FoilAnalysis const &analysis, int nPoints) const;
+
+    private:
+        QObject *m_pParent;
+        bool m_bAlpha, m_bInitBL, m_bFromZero;
+
+        QVector<Job> m_Job;
+        QVector<Worker> m_Worker;
+        int m_nChunks;
+        QAtomicInt m_nStarted;       /**< the number of polars of which the analysis has been started */
+
+        QMutex m_QueueMutex;         /**< protects the workers' queues */
+        QMutex m_JobMutex;           /**< protects the creation and the completion of the jobs */
+
+        qint64 m_WallNs;             /**< the duration of the last run */
+};
+
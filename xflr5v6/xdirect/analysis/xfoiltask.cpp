@@ -23,12 +23,17 @@
 #include "xfoiltask.h"
 #include <xflcore/xflevents.h>
 #include <xflcore/constants.h>
+#include <xflobjects/resultcache.h>
 
 
 
 #include <QThread>
+#include <QThreadPool>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QFutureSynchronizer>
+#include <QDataStream>
 
 
 int XFoilTask::s_IterLim=100;
@@ -36,6 +41,9 @@ bool XFoilTask::s_bAutoInitBL = true;
 bool XFoilTask::s_bCancel = false;
 bool XFoilTask::s_bSkipOpp = false;
 bool XFoilTask::s_bSkipPolar = false;
+int XFoilTask::s_nMinSubSweepPoints = 6;
+int XFoilTask::s_PredictorOrder = 1;
+int XFoilTask::s_MaxStepHalvings = 2;
 
 /**
 * The public constructor
@@ -45,6 +53,7 @@ XFoilTask::XFoilTask(QObject *pParent)
     setAutoDelete(true);
 
     m_pParent = pParent;
+    m_Iterations = 0;
     m_pFoil  = nullptr;
     m_pPolar = nullptr;
     m_bIsFinished = true;
@@ -61,6 +70,20 @@ XFoilTask::XFoilTask(QObject *pParent)
     m_OutStream.setDevice(nullptr);
 
     m_bErrors = false;
+
+    m_nSubSweeps = 1;
+    m_pMasterTask = nullptr;
+    m_pSeedTask = nullptr;
+    m_bSeedFromFirst = false;
+    m_nSubSweepPoints = 0;
+    m_bSubSweepStarted = false;
+    m_bSubSweepDone = false;
+    m_bFirstCached = false;
+    m_bViscous = true;
+
+    m_nBLHistory = 0;
+    m_bLastConverged = false;
+    m_BLHistoryParam[0] = m_BLHistoryParam[1] = m_BLHistoryParam[2] = 0.0;
 }
 
 
@@ -76,8 +99,14 @@ void XFoilTask::run()
         return;
     }
 
-    if(m_pPolar->polarType()!=xfl::FIXEDAOAPOLAR) alphaSequence();
-    else                                          ReSequence();
+    if(m_nSubSweeps>1)                                 splitSequence();
+    else if(m_pPolar->polarType()!=xfl::FIXEDAOAPOLAR) alphaSequence();
+    else                                               ReSequence();
+
+#ifdef XFL_PERFSTATS
+    m_PerfStats.stop();
+    traceLog(m_PerfStats.table());
+#endif
 
     m_bIsFinished = true;
 
@@ -121,6 +150,27 @@ bool XFoilTask::initializeXFoilTask(Foil const*pFoil, Polar *pPolar, bool bVisco
     m_bFromZero = bFromZero;
 
     m_bIsFinished = false;
+    m_bViscous = bViscous;
+
+#ifdef XFL_PERFSTATS
+    // the run's wall clock includes the initialization of the XFoil instance
+    m_PerfStats.start();
+#endif
+
+    // the sub-sweeps use their own instances; the master's is only initialized if the range cannot be split
+    if(m_nSubSweeps>1) return true;
+
+    return initXFoilInstance(bViscous);
+}
+
+
+/**
+* Loads the foil and the polar's analysis parameters in this task's instance of XFoil.
+* @return true if the initialization of the Foil in XFoil has been successful, false otherwise
+*/
+bool XFoilTask::initXFoilInstance(bool bViscous)
+{
+    PERF_SCOPE(m_PerfStats, "initialization");
 
     m_XFoilStream.setString(&m_XFoilLog);
     double nx[IBX], ny[IBX];     //needed because XFoil requires a const Foil
@@ -130,6 +180,84 @@ bool XFoilTask::initializeXFoilTask(Foil const*pFoil, Polar *pPolar, bool bVisco
                                           m_pPolar->ReType(), m_pPolar->MaType(),
                                           bViscous, m_XFoilStream)) return false;
 
+    m_CacheKey.clear();
+    if(ResultCache::isEnabled()) m_CacheKey = cacheKey(bViscous);
+
+    return true;
+}
+
+
+/**
+* Returns the key of this task's results in the ResultCache.
+* The key is built from the coordinates which are loaded in XFoil, from the polar's specification
+* and from the solver settings which change the converged results,
+* but not from the names, so that the points of duplicated foils and polars are found in the cache.
+*/
+QByteArray XFoilTask::cacheKey(bool bViscous) const
+{
+    QByteArray spec;
+    QDataStream ar(&spec, QIODevice::WriteOnly);
+    ar.setVersion(QDataStream::Qt_4_5);
+    ar.setByteOrder(QDataStream::LittleEndian);
+
+    ar << QString("XFoil");
+    ar << m_pFoil->m_n;
+    for(int i=0; i<m_pFoil->m_n; i++) ar << m_pFoil->m_x[i] << m_pFoil->m_y[i];
+
+    ar << int(m_pPolar->polarType()) << m_pPolar->ReType() << m_pPolar->MaType();
+    ar << m_pPolar->Reynolds() << m_pPolar->Mach() << m_pPolar->NCrit();
+    ar << m_pPolar->XtrTop() << m_pPolar->XtrBot() << m_pPolar->aoa();
+    ar << bViscous;
+    ar << (m_pPolar->polarType()==xfl::FIXEDAOAPOLAR || m_bAlpha); // the sequence's parameter is an aoa or a Cl
+    ar << XFoil::VAccel() << s_IterLim << m_bInitBL << s_bAutoInitBL;
+
+    return ResultCache::makeKey(spec);
+}
+
+
+/**
+* Looks for the point in the ResultCache. If found, the point is stored as if it had been computed,
+* and the next point which is computed is started from a fresh BL.
+* @param SpValue the aoa, the lift coefficient or the Reynolds number of the point
+* @return true if the point has been read from the cache
+*/
+bool XFoilTask::loadCachedOpp(double SpValue)
+{
+    PERF_SCOPE(m_PerfStats, "result cache");
+
+    if(m_CacheKey.isEmpty() || !(m_pMasterTask || m_pParent)) return false;
+
+    OpPoint *pOpPoint = ResultCache::loadOpp(m_CacheKey, SpValue);
+    if(!pOpPoint) return false;
+    PERF_COUNT(m_PerfStats, "cached points", 1);
+
+    pOpPoint->setFoilName(m_pFoil->name());
+    pOpPoint->setPolarName(m_pPolar->name());
+    pOpPoint->setTheStyle(m_pPolar->theStyle());
+
+    if(m_pMasterTask)
+    {
+        if(m_SubSweepOpps.isEmpty())
+        {
+            // the boundary point has no BL to publish, so the adjacent sub-sweep should not wait for it
+            QMutexLocker locker(&m_pMasterTask->m_SubSweepMutex);
+            m_bFirstCached = true;
+            m_pMasterTask->m_SubSweepCondition.wakeAll();
+        }
+        m_SubSweepOpps.append(pOpPoint);
+    }
+    else
+    {
+        if(m_pPolar->polarType()!=xfl::FIXEDAOAPOLAR) m_pPolar->addOpPointData(pOpPoint);
+        qApp->postEvent(m_pParent, new XFoilOppEvent(pOpPoint));
+    }
+
+    // the BL in the XFoil instance is the one of the last computed point, which may be far from the next one
+    m_XFoilInstance.setBLInitialized(false);
+    m_XFoilInstance.lipan = false;
+    m_nBLHistory = 0;
+    m_bLastConverged = false;
+
     return true;
 }
 
@@ -202,13 +330,16 @@ bool XFoilTask::alphaSequence()
 
     if(SpMin>SpMax) SpInc = -qAbs(SpInc);
 
+    m_PointIterations.clear();
+
     for (int iSeries=0; iSeries<MaxSeries; iSeries++)
     {
         if(s_bCancel) break;
 
         int total = 0;
 
-        if(fabs(SpInc)<1.0e-6) total = 0;
+        if(m_pMasterTask)      total = m_nSubSweepPoints-1;
+        else if(fabs(SpInc)<1.0e-6) total = 0;
         else                   total = int(qAbs((SpMax*1.0001-SpMin)/SpInc));//*1.0001 to make sure upper limit is included
 
         if(m_bInitBL)
@@ -217,6 +348,10 @@ bool XFoilTask::alphaSequence()
             m_XFoilInstance.lipan = false;
         }
 
+        // the predictor only uses the points of the current series
+        m_nBLHistory = 0;
+        m_bLastConverged = false;
+
         for (int ia=0; ia<=total; ia++)
         {
             if(s_bCancel) break;
@@ -225,78 +360,97 @@ bool XFoilTask::alphaSequence()
 
                 m_XFoilInstance.setBLInitialized(false);
                 m_XFoilInstance.lipan = false;
-                s_bSkipPolar = false;
+                if(!m_pMasterTask) s_bSkipPolar = false; // the other sub-sweeps need to see it too
                 traceLog("    .......skipping polar \n");
                 return false;
             }
 
-            if(m_bAlpha)
+            double SpValue = SpMin+ia*SpInc;
+            if(m_bAlpha) str = QString("Alpha = %1").arg(SpValue,9,'f',3);
+            else         str = QString(QObject::tr("Cl = %1")).arg(SpValue,9,'f',3);
+            traceLog(str);
+
+            if(loadCachedOpp(SpValue))
             {
-                double alphadeg = SpMin+ia*SpInc;
+                traceLog(QObject::tr("   ...read from the result cache\n"));
+                continue;
+            }
 
-                m_XFoilInstance.setAlpha(alphadeg * PI/180.0);
-                m_XFoilInstance.lalfa = true;
-                m_XFoilInstance.setQInf(1.0);
-                str = QString("Alpha = %1").arg(alphadeg,9,'f',3);
-                traceLog(str);
+            int nPointIter = 0;
 
+            m_Seed.bValid = false;
+            bool bRetry = false;
+            do
+            {
+                if(bRetry)
+                {
+                    m_XFoilInstance.setBLState(m_Seed);
+                    traceLog(QObject::tr("   ...restarting from the converged BL of the adjacent sub-sweep\n"));
+                }
 
                 // here we go !
-                if (!m_XFoilInstance.specal())
+                if(!solvePoint(SpValue))
                 {
                     str = QObject::tr("Invalid Analysis Settings\nCpCalc: local speed too large\n Compressibility corrections invalid ");
                     traceLog(str);
                     m_bErrors = true;
                     return false;
                 }
+                nPointIter += m_Iterations;
+
+                // a sub-sweep which fails to converge its first point from a cold start
+                // is re-started from the adjacent sub-sweep's converged BL
+                bRetry = !bRetry && ia==0 && !m_XFoilInstance.lvconv && !s_bCancel && waitForSeed(m_Seed);
             }
-            else
+            while(bRetry);
+
+            if(!m_XFoilInstance.lvconv && m_bLastConverged && s_MaxStepHalvings>0 && !s_bCancel)
             {
-                m_XFoilInstance.lalfa = false;
-                m_XFoilInstance.setAlpha(0.0);
-                m_XFoilInstance.setQInf(1.0);
-                m_XFoilInstance.setClSpec(SpMin+ia*SpInc);
-                str = QString(QObject::tr("Cl = %1")).arg(m_XFoilInstance.ClSpec(),9,'f',3);
-                traceLog(str);
-                if(!m_XFoilInstance.speccl())
-                {
-                    str = QObject::tr("Invalid Analysis Settings\nCpCalc: local speed too large\n Compressibility corrections invalid ");
-                    traceLog(str);
-                    m_bErrors = true;
-                    return false;
-                }
+                if(!halveStep(SpValue, nPointIter)) return false;
             }
 
-            m_XFoilInstance.lwake = false;
-            m_XFoilInstance.lvconv = false;
-
-            m_Iterations = 0;
-
-            while(!iterate()){}
+            m_Iterations = nPointIter;
+            m_PointIterations.append(nPointIter);
 
             if(m_XFoilInstance.lvconv)
             {
+                pushBLHistory(SpValue);
+
                 str = QString(QObject::tr("   ...converged after %1 iterations\n")).arg(m_Iterations);
                 traceLog(str);
-                if(m_pParent)
+                PERF_COUNT(m_PerfStats, "converged points", 1);
+                if(m_pMasterTask || m_pParent)
                 {
+                    PERF_SCOPE(m_PerfStats, "operating point storage");
                     OpPoint *pOpPoint = new OpPoint;
                     pOpPoint->setFoilName(m_pFoil->name());
                     pOpPoint->setPolarName(m_pPolar->name());
                     pOpPoint->setTheStyle(m_pPolar->theStyle());
                     addXFoilData(pOpPoint, &m_XFoilInstance, m_pFoil);
-                    m_pPolar->addOpPointData(pOpPoint); // store the data on the fly; a polar is only used by one task at a time
-
-                    // need to do this asynchronously in the main thread to keep the task thread safe
-                    qApp->postEvent(m_pParent, new XFoilOppEvent(pOpPoint));
+                    if(!m_CacheKey.isEmpty()) ResultCache::storeOpp(m_CacheKey, SpValue, pOpPoint);
+                    if(m_pMasterTask)
+                    {
+                        storeSubSweepOpp(pOpPoint); // merged in the polar by the master task
+                    }
+                    else
+                    {
+                        m_pPolar->addOpPointData(pOpPoint); // store the data on the fly; a polar is only used by one task at a time
+
+                        // need to do this asynchronously in the main thread to keep the task thread safe
+                        qApp->postEvent(m_pParent, new XFoilOppEvent(pOpPoint));
+                    }
                 }
             }
             else
             {
+                m_bLastConverged = false;
+                PERF_COUNT(m_PerfStats, "unconverged points", 1);
+
                 str = QString(QObject::tr("   ...unconverged after %1 iterations\n")).arg(m_Iterations);
                 traceLog(str);
                 m_bErrors = true;
-                qApp->postEvent(m_pParent, new XFoilOppEvent(nullptr));
+                if(m_pMasterTask)  storeSubSweepOpp(nullptr);
+                else if(m_pParent) qApp->postEvent(m_pParent, new XFoilOppEvent(nullptr));
             }
 
             if(XFoil::fullReport())
@@ -314,11 +468,162 @@ bool XFoilTask::alphaSequence()
 
         qApp->processEvents();
     }
+
+    traceLog(iterationSummary());
     //        strong+="\n";
     return true;
 }
 
 
+/**
+* Sets the aoa or the lift coefficient and runs the viscous iterations for this operating point.
+* If enough converged points are available, the BL is first extrapolated to the new value.
+* @param SpValue the aoa in degrees or the lift coefficient
+* @return false if the inviscid solution has failed, true otherwise; convergence is given by XFoil::lvconv
+*/
+bool XFoilTask::solvePoint(double SpValue)
+{
+    {
+        PERF_SCOPE(m_PerfStats, "inviscid solution");
+        if(m_bAlpha)
+        {
+            m_XFoilInstance.setAlpha(SpValue * PI/180.0);
+            m_XFoilInstance.lalfa = true;
+            m_XFoilInstance.setQInf(1.0);
+            if (!m_XFoilInstance.specal()) return false;
+        }
+        else
+        {
+            m_XFoilInstance.lalfa = false;
+            m_XFoilInstance.setAlpha(0.0);
+            m_XFoilInstance.setQInf(1.0);
+            m_XFoilInstance.setClSpec(SpValue);
+            if(!m_XFoilInstance.speccl()) return false;
+        }
+    }
+
+    predictBL(SpValue);
+
+    m_XFoilInstance.lwake = false;
+    m_XFoilInstance.lvconv = false;
+
+    m_Iterations = 0;
+
+    while(!iterate()){}
+
+    return true;
+}
+
+
+/**
+* Loads in XFoil the BL extrapolated from the last converged points of the sequence.
+* Linear with two points, quadratic with three, depending on s_PredictorOrder.
+* Does nothing if the previous point is unconverged, in which case XFoil restarts from its current BL.
+* @param SpValue the aoa in degrees or the lift coefficient of the new point
+*/
+void XFoilTask::predictBL(double SpValue)
+{
+    if(s_PredictorOrder<=0 || !m_bLastConverged) return;
+
+    PERF_SCOPE(m_PerfStats, "BL prediction");
+
+    int nStates = qMin(m_nBLHistory, s_PredictorOrder+1);
+    if(nStates<2) return;
+
+    // Lagrange interpolation weights
+    blState const *pStates[3];
+    double weight[3];
+    for(int k=0; k<nStates; k++)
+    {
+        pStates[k] = m_BLHistory+k;
+        weight[k] = 1.0;
+        for(int j=0; j<nStates; j++)
+        {
+            if(j==k) continue;
+            double dp = m_BLHistoryParam[k]-m_BLHistoryParam[j];
+            if(fabs(dp)<1.0e-10) return;
+            weight[k] *= (SpValue-m_BLHistoryParam[j])/dp;
+        }
+    }
+
+    m_XFoilInstance.extrapolateBL(pStates, weight, nStates);
+}
+
+
+/**
+* Re-converges a failed point from the last converged one, by marching with successively halved steps.
+* The intermediate converged points are added to the predictor's history but not to the polar.
+* @param SpValue the aoa in degrees or the lift coefficient of the failed point
+* @param nPointIter the number of iterations for this point, incremented with those of the intermediate points
+* @return false if the inviscid solution has failed, true otherwise; convergence is given by XFoil::lvconv
+*/
+bool XFoilTask::halveStep(double SpValue, int &nPointIter)
+{
+    for(int ih=1; ih<=s_MaxStepHalvings; ih++)
+    {
+        PERF_COUNT(m_PerfStats, "step halvings", 1);
+        int nSteps = 1<<ih;
+        double v0 = m_BLHistoryParam[0];
+        double dv = (SpValue-v0)/double(nSteps);
+        traceLog(QString(QObject::tr("   ...marching from %1 in %2 sub-steps\n")).arg(v0,0,'f',3).arg(nSteps));
+
+        m_XFoilInstance.setBLState(m_BLHistory[0]);
+
+        for(int is=1; is<=nSteps; is++)
+        {
+            if(s_bCancel) return true;
+
+            double v = v0 + double(is)*dv;
+            if(!solvePoint(v)) return false;
+            nPointIter += m_Iterations;
+
+            if(!m_XFoilInstance.lvconv) break;
+            if(is==nSteps) return true;
+
+            pushBLHistory(v);
+        }
+        // restart from the last converged sub-step with a finer step
+    }
+    return true;
+}
+
+
+/**
+* Stores the BL of the point which has just converged as the most recent state of the predictor's history.
+* The most recent state is also the seed of the sub-sweep which follows this one.
+*/
+void XFoilTask::pushBLHistory(double SpValue)
+{
+    for(int k=2; k>0; k--)
+    {
+        m_BLHistory[k] = m_BLHistory[k-1];
+        m_BLHistoryParam[k] = m_BLHistoryParam[k-1];
+    }
+    m_XFoilInstance.getBLState(m_BLHistory[0]);
+    m_BLHistoryParam[0] = SpValue;
+    m_nBLHistory = qMin(m_nBLHistory+1, 3);
+    m_bLastConverged = true;
+}
+
+
+/**
+* @return a summary of the Newton iteration counts of the last sequence, for benchmarking purposes.
+*/
+QString XFoilTask::iterationSummary() const
+{
+    if(!m_PointIterations.size()) return QString();
+
+    int total=0, maxiter=0;
+    for(int i=0; i<m_PointIterations.size(); i++)
+    {
+        total += m_PointIterations.at(i);
+        maxiter = qMax(maxiter, m_PointIterations.at(i));
+    }
+    return QString::asprintf("   Newton iterations: %d total for %d points, %.1f per point, %d max\n",
+                             total, m_PointIterations.size(), double(total)/double(m_PointIterations.size()), maxiter);
+}
+
+
 
 
 /** 
@@ -336,9 +641,14 @@ bool XFoilTask::ReSequence()
     int total=int((m_ReMax*1.0001-m_ReMin)/m_ReInc);//*1.0001 to make sure upper limit is included
 
     total = abs(total);
+    if(m_pMasterTask) total = m_nSubSweepPoints-1;
 
     QString strange;
 
+    // the history is not used to predict the BL of the Re series, only to seed the adjacent sub-sweep
+    m_nBLHistory = 0;
+    m_bLastConverged = false;
+
     for (ia=0; ia<=total; ia++)
     {
         if(s_bCancel) break;
@@ -346,39 +656,70 @@ bool XFoilTask::ReSequence()
         {
             m_XFoilInstance.setBLInitialized(false);
             m_XFoilInstance.lipan = false;
-            s_bSkipPolar = false;
+            if(!m_pMasterTask) s_bSkipPolar = false; // the other sub-sweeps need to see it too
             traceLog("    .......skipping polar \n");
             return false;
         }
 
         Re = m_ReMin+ia*m_ReInc;
-        strange =QString("Re = %1 ........ ").arg(Re,0,'f',0);
-        traceLog(strange);
-        m_XFoilInstance.reinf1 = Re;
-        m_XFoilInstance.lalfa = true;
-        m_XFoilInstance.setQInf(1.0);
-
-        // here we go !
-        if (!m_XFoilInstance.specal())
+
+        if(loadCachedOpp(Re))
         {
-            QString str;
-            str = "Invalid Analysis Settings\nCpCalc: local speed too large\n Compressibility corrections invalid ";
-            traceLog(str);
-            m_bErrors = true;
-            return false;
+            traceLog(QString("Re = %1 ........ ").arg(Re,0,'f',0) + QObject::tr("   ...read from the result cache\n"));
+            continue;
         }
 
-        m_XFoilInstance.lwake = false;
-        m_XFoilInstance.lvconv = false;
+        m_Seed.bValid = false;
+        bool bRetry = false;
+        do
+        {
+            if(bRetry)
+            {
+                m_XFoilInstance.setBLState(m_Seed);
+                traceLog(QObject::tr("   ...restarting from the converged BL of the adjacent sub-sweep\n"));
+            }
+
+            strange =QString("Re = %1 ........ ").arg(Re,0,'f',0);
+            traceLog(strange);
+            m_XFoilInstance.reinf1 = Re;
+            m_XFoilInstance.lalfa = true;
+            m_XFoilInstance.setQInf(1.0);
+
+            // here we go !
+            bool bSpecal = false;
+            {
+                PERF_SCOPE(m_PerfStats, "inviscid solution");
+                bSpecal = m_XFoilInstance.specal();
+            }
+            if (!bSpecal)
+            {
+                QString str;
+                str = "Invalid Analysis Settings\nCpCalc: local speed too large\n Compressibility corrections invalid ";
+                traceLog(str);
+                m_bErrors = true;
+                return false;
+            }
+
+            m_XFoilInstance.lwake = false;
+            m_XFoilInstance.lvconv = false;
+
+            while(!iterate()){}
+
+            bRetry = !bRetry && ia==0 && !m_XFoilInstance.lvconv && !s_bCancel && waitForSeed(m_Seed);
+            if(bRetry) m_Iterations = 0;
+        }
+        while(bRetry);
 
-        while(!iterate()){}
         if(m_XFoilInstance.lvconv)
         {
+            pushBLHistory(Re);
+            PERF_COUNT(m_PerfStats, "converged points", 1);
             str = QString(QObject::tr("   ...converged after %1 iterations\n")).arg(m_Iterations);
             traceLog(str);
         }
         else
         {
+            PERF_COUNT(m_PerfStats, "unconverged points", 1);
             str = QString(QObject::tr("   ...unconverged after %1 iterations\n")).arg(m_Iterations);
             traceLog(str);
             m_bErrors = true;
@@ -386,14 +727,17 @@ bool XFoilTask::ReSequence()
 
         m_Iterations = 0;
 
-        if(m_pParent)
+        if(m_pMasterTask || m_pParent)
         {
+            PERF_SCOPE(m_PerfStats, "operating point storage");
             OpPoint *pOpPoint = new OpPoint;
             pOpPoint->setFoilName(m_pFoil->name());
             pOpPoint->setPolarName(m_pPolar->name());
             pOpPoint->setTheStyle(m_pPolar->theStyle());
             addXFoilData(pOpPoint, &m_XFoilInstance, m_pFoil);
-            qApp->postEvent(m_pParent, new XFoilOppEvent(pOpPoint));
+            if(!m_CacheKey.isEmpty() && m_XFoilInstance.lvconv) ResultCache::storeOpp(m_CacheKey, Re, pOpPoint);
+            if(m_pMasterTask) storeSubSweepOpp(pOpPoint);
+            else              qApp->postEvent(m_pParent, new XFoilOppEvent(pOpPoint));
         }
 
         if(XFoil::fullReport())
@@ -408,12 +752,298 @@ bool XFoilTask::ReSequence()
 
 
 
+/**
+* Splits the range of the polar into sub-sweeps which are run concurrently on separate XFoil instances.
+* Each sub-sweep starts from a cold BL. If its first point does not converge, the BL is seeded
+* from the adjacent sub-sweep's converged solution at the segment boundary.
+* The results are merged into the polar in the order of the serial sequence.
+* Falls back on the serial sequence if the range is too short to be split.
+* @return true if the calculation was successful
+*/
+bool XFoilTask::splitSequence()
+{
+    if(planSubSweeps(m_nSubSweeps)<2)
+    {
+        if(!initXFoilInstance(m_bViscous))
+        {
+            m_bErrors = true;
+            return false;
+        }
+        if(m_pPolar->polarType()!=xfl::FIXEDAOAPOLAR) return alphaSequence();
+        else                                          return ReSequence();
+    }
+
+    traceLog(QString(QObject::tr("Splitting the sequence into %1 sub-sweeps\n")).arg(m_SubSweeps.size()));
+
+    // one thread per sub-sweep, so that a sub-sweep waiting for its seed never blocks the one which computes it
+    QThreadPool pool;
+    pool.setMaxThreadCount(m_SubSweeps.size());
+    QFutureSynchronizer<void> futureSync;
+    for(int is=0; is<m_SubSweeps.size(); is++)
+    {
+        futureSync.addFuture(QtConcurrent::run(&pool, m_SubSweeps[is], &XFoilTask::runSubSweep));
+    }
+    futureSync.waitForFinished();
+
+    return mergeSubSweeps();
+}
+
+
+/**
+* Computes the number of points of the sequence defined by the range.
+* If the sequence starts from zero, the points are counted in two series which both start at zero,
+* since the serial sequence computes zero again at the start of the second series.
+* @param SpMin the start value of the range
+* @param SpMax the end value of the range
+* @param SpInc the increment of the range
+* @param bFromZero true if the aoa sequence is run from zero up and down to the range's bounds
+* @param n0 the number of points in the first series
+* @param n1 the number of points in the second series, from zero down to SpMin
+*/
+void XFoilTask::seriesLength(double SpMin, double SpMax, double SpInc, bool bFromZero, int &n0, int &n1)
+{
+    SpInc = qAbs(SpInc);
+    n1 = 0;
+    if(bFromZero && SpMin*SpMax<0)
+    {
+        n1 = 1;
+        if(SpInc>=1.0e-6) n1 = int(qAbs((SpMin*1.0001)/SpInc)) + 1;
+        SpMin = 0.0;
+    }
+    n0 = 1;
+    if(SpInc>=1.0e-6) n0 = int(qAbs((SpMax*1.0001-SpMin)/SpInc)) + 1;//*1.0001 to make sure upper limit is included
+}
+
+
+/**
+* Creates the sub-sweeps of the sequence without running them.
+* The series are the same as those of the serial sequence; each series is divided into contiguous segments.
+* @param nSubSweeps the requested number of sub-sweeps
+* @return the number of sub-sweeps created; 0 if the range is too short to be split
+*/
+int XFoilTask::planSubSweeps(int nSubSweeps)
+{
+    bool bAlphaSeq = m_pPolar->polarType()!=xfl::FIXEDAOAPOLAR;
+
+    double SpMin=0, SpMax=0, SpInc=0;
+    bool bFromZero = false;
+    if(!bAlphaSeq)
+    {
+        SpMin = m_ReMin;
+        SpMax = m_ReMax;
+        SpInc = qAbs(m_ReInc);
+    }
+    else if(m_bAlpha)
+    {
+        SpMin = m_AlphaMin;
+        SpMax = m_AlphaMax;
+        SpInc = qAbs(m_AlphaInc);
+        bFromZero = m_bFromZero && SpMin*SpMax<0;
+    }
+    else
+    {
+        SpMin = m_ClMin;
+        SpMax = m_ClMax;
+        SpInc = qAbs(m_ClInc);
+    }
+
+    int n0=0, n1=0;
+    seriesLength(SpMin, SpMax, SpInc, bFromZero, n0, n1);
+    if(bFromZero) SpMin = 0.0;
+    if(SpMin>SpMax) SpInc = -SpInc;
+
+    m_SubSweeps.clear();
+
+    int nSweeps = qMin(nSubSweeps, (n0+n1)/qMax(1, s_nMinSubSweepPoints));
+    if(nSweeps<2 || fabs(SpInc)<1.0e-6) return 0;
+
+    // the second series gets its share of the segments, at least one, and leaves one to the first
+    int nSweeps1 = 0;
+    if(n1>0) nSweeps1 = qBound(1, int(double(nSweeps*n1)/double(n0+n1)+0.5), nSweeps-1);
+    int nSweeps0 = nSweeps-nSweeps1;
+
+    makeSubSweeps(SpMin, SpInc, n0, nSweeps0);
+    if(n1>0)
+    {
+        int iFirst = m_SubSweeps.size();
+        makeSubSweeps(0.0, -SpInc, n1, nSweeps1);
+        // the first segment of the negative series starts at the first point of the positive series
+        m_SubSweeps[iFirst]->m_pSeedTask = m_SubSweeps.first();
+        m_SubSweeps[iFirst]->m_bSeedFromFirst = true;
+    }
+    return m_SubSweeps.size();
+}
+
+
+/**
+* Merges the results of the sub-sweeps in the polar, in the order of the serial sequence, and deletes the sub-sweeps.
+* The sub-sweeps which have not been run, e.g. after a cancellation, have no results.
+* @return false if the polar has been skipped, true otherwise
+*/
+bool XFoilTask::mergeSubSweeps()
+{
+    bool bAlphaSeq = m_pPolar->polarType()!=xfl::FIXEDAOAPOLAR;
+
+    bool bSkipped = s_bSkipPolar;
+    s_bSkipPolar = false;
+
+    for(int is=0; is<m_SubSweeps.size(); is++)
+    {
+        XFoilTask *pSubSweep = m_SubSweeps.at(is);
+        traceLog(pSubSweep->m_OutMessage);
+        m_bErrors = m_bErrors || pSubSweep->m_bErrors;
+#ifdef XFL_PERFSTATS
+        m_PerfStats.merge(pSubSweep->m_PerfStats);
+#endif
+        for(int io=0; io<pSubSweep->m_SubSweepOpps.size(); io++)
+        {
+            OpPoint *pOpPoint = pSubSweep->m_SubSweepOpps.at(io);
+            if(m_pParent)
+            {
+                if(pOpPoint && bAlphaSeq) m_pPolar->addOpPointData(pOpPoint);
+                qApp->postEvent(m_pParent, new XFoilOppEvent(pOpPoint));
+            }
+            else delete pOpPoint;
+        }
+        delete pSubSweep;
+    }
+    m_SubSweeps.clear();
+
+    return !bSkipped;
+}
+
+
+/**
+* Creates the sub-sweeps for one series of the sequence.
+* Each sub-sweep is seeded from the last converged point of the previous segment in the series.
+* @param SpMin the first value of the series
+* @param SpInc the increment of the series
+* @param nPoints the number of points in the series
+* @param nSweeps the number of segments into which the series is split
+*/
+void XFoilTask::makeSubSweeps(double SpMin, double SpInc, int nPoints, int nSweeps)
+{
+    bool bAlphaSeq = m_pPolar->polarType()!=xfl::FIXEDAOAPOLAR;
+    nSweeps = qMin(nSweeps, nPoints);
+
+    for(int iw=0; iw<nSweeps; iw++)
+    {
+        int i0 = (iw*nPoints)/nSweeps;
+        int i1 = ((iw+1)*nPoints)/nSweeps; // excluded
+
+        XFoilTask *pSubSweep = new XFoilTask(nullptr);
+        pSubSweep->setAutoDelete(false); // owned by this task
+        pSubSweep->m_pMasterTask = this;
+        pSubSweep->m_pFoil  = m_pFoil;
+        pSubSweep->m_pPolar = m_pPolar;
+        pSubSweep->m_bFromZero = false;
+        pSubSweep->m_bInitBL = true;
+        pSubSweep->m_bIsFinished = false;
+        pSubSweep->m_nSubSweepPoints = i1-i0;
+
+        double v0 = SpMin +  i0   *SpInc;
+        double v1 = SpMin + (i1-1)*SpInc;
+        if(bAlphaSeq) pSubSweep->setSequence(m_bAlpha, v0, v1, SpInc);
+        else          pSubSweep->setReRange(v0, v1, SpInc);
+
+        if(iw>0)
+        {
+            pSubSweep->m_pSeedTask = m_SubSweeps.last();
+            pSubSweep->m_bSeedFromFirst = false;
+        }
+        m_SubSweeps.append(pSubSweep);
+    }
+}
+
+
+/**
+* Runs one sub-sweep in a worker thread.
+*/
+void XFoilTask::runSubSweep()
+{
+    m_OutStream.setString(&m_SubSweepLog);
+
+    {
+        QMutexLocker locker(&m_pMasterTask->m_SubSweepMutex);
+        m_bSubSweepStarted = true;
+    }
+
+    if(initXFoilInstance(m_pMasterTask->m_bViscous))
+    {
+        if(m_pPolar->polarType()!=xfl::FIXEDAOAPOLAR) alphaSequence();
+        else                                          ReSequence();
+    }
+    else m_bErrors = true;
+
+    m_bIsFinished = true;
+
+    QMutexLocker locker(&m_pMasterTask->m_SubSweepMutex);
+    m_bSubSweepDone = true;
+    m_pMasterTask->m_SubSweepCondition.wakeAll();
+}
+
+
+/**
+* Stores the result of a sub-sweep's operating point and publishes its BL for the adjacent sub-sweeps.
+* @param pOpp a pointer to the OpPoint, or nullptr if the point is unconverged
+*/
+void XFoilTask::storeSubSweepOpp(OpPoint *pOpp)
+{
+    m_SubSweepOpps.append(pOpp);
+    if(!m_XFoilInstance.lvconv) return;
+
+    if(!m_FirstBL.bValid)
+    {
+        QMutexLocker locker(&m_pMasterTask->m_SubSweepMutex);
+        m_XFoilInstance.getBLState(m_FirstBL);
+        m_pMasterTask->m_SubSweepCondition.wakeAll();
+    }
+}
+
+
+/**
+* Waits until the adjacent sub-sweep has converged the point at the segment boundary.
+* The seed is only requested once per sub-sweep, and only if the adjacent sub-sweep has already been started:
+* when the sub-sweeps outnumber the worker threads, a sub-sweep never waits for one which is still queued.
+* @param seed the BL state in which the converged solution is returned
+* @return true if a converged BL is available
+*/
+bool XFoilTask::waitForSeed(blState &seed)
+{
+    if(!m_pMasterTask || !m_pSeedTask) return false;
+
+    XFoilTask *pSeedTask = m_pSeedTask;
+    m_pSeedTask = nullptr;
+
+    QMutexLocker locker(&m_pMasterTask->m_SubSweepMutex);
+    if(!pSeedTask->m_bSubSweepStarted) return false;
+
+    if(m_bSeedFromFirst)
+    {
+        while(!pSeedTask->m_FirstBL.bValid && !pSeedTask->m_bFirstCached && !pSeedTask->m_bSubSweepDone && !s_bCancel)
+            m_pMasterTask->m_SubSweepCondition.wait(&m_pMasterTask->m_SubSweepMutex, 100);
+        seed = pSeedTask->m_FirstBL;
+    }
+    else
+    {
+        while(!pSeedTask->m_bSubSweepDone && !s_bCancel)
+            m_pMasterTask->m_SubSweepCondition.wait(&m_pMasterTask->m_SubSweepMutex, 100);
+        // the history is only written by the seed task, which is done
+        if(pSeedTask->m_nBLHistory>0) seed = pSeedTask->m_BLHistory[0];
+    }
+
+    return seed.bValid && !s_bCancel;
+}
+
+
 /**
 * Manages the viscous iterations of the XFoil calculation.
 * @return true if the analysis has been successful.
 */
 bool XFoilTask::iterate()
 {
+    PERF_SCOPE(m_PerfStats, "viscous iterations");
+
     if(!m_XFoilInstance.viscal())
     {
         m_XFoilInstance.lvconv = false;
@@ -432,6 +1062,7 @@ bool XFoilTask::iterate()
             }
 
             m_Iterations++;
+            PERF_COUNT(m_PerfStats, "Newton iterations", 1);
         }
         else m_Iterations = s_IterLim;
 
@@ -24,11 +24,14 @@
 #pragma once
 
 #include <QRunnable>
+#include <QMutex>
+#include <QWaitCondition>
 
 #include "xfoil.h"
 
 #include <xflobjects/objects2d/polar.h>
 #include <xflobjects/objects2d/foil.h>
+#include <xflcore/perfstats.h>
 
 
 
@@ -50,6 +53,8 @@ struct FoilAnalysis
 */
 class XFoilTask : public QRunnable
 {
+    friend class XFoilBatch;
+
     public:
         XFoilTask(QObject *pParent=nullptr);
 
@@ -58,18 +63,27 @@ class XFoilTask : public QRunnable
 
         bool alphaSequence();
         bool ReSequence();
+        bool splitSequence();
         bool isFinished() const {return m_bIsFinished;}
 
         bool initializeTask(FoilAnalysis &pFoilAnalysis, bool bViscous, bool bInitBL, bool bFromZero);
         bool initializeXFoilTask(const Foil *pFoil, Polar *pPolar, bool bViscous, bool bInitBL, bool bFromZero);
         bool iterate();
+        bool solvePoint(double SpValue);
+        QString iterationSummary() const;
+#ifdef XFL_PERFSTATS
+        PerfStats const &perfStats() const {return m_PerfStats;}
+#endif
 
         void setSequence(bool bAlpha, double SpMin, double SpMax, double SpInc);
         void setReRange(double ReMin, double ReMax, double ReInc);
+        void setSubSweeps(int nSubSweeps) {m_nSubSweeps=qMax(1, nSubSweeps);}
         void traceLog(QString const &str);
 
         void addXFoilData(OpPoint *pOpp, XFoil *pXFoil, const Foil *pFoil);
 
+        static void seriesLength(double SpMin, double SpMax, double SpInc, bool bFromZero, int &n0, int &n1);
+
         static void cancelTask() {s_bCancel=true;}
         static void setCancelled(bool bCancelled) {s_bCancel=bCancelled;}
 
@@ -78,9 +92,13 @@ class XFoilTask : public QRunnable
         static bool s_bAutoInitBL;      /**< true if the BL initialization is left to the code's decision */
         static int  s_IterLim;
         static bool s_bSkipOpp;
+        static int  s_nMinSubSweepPoints;  /**< the minimal number of operating points in a sub-sweep when a polar's range is split */
+        static int  s_PredictorOrder;      /**< the order of the BL extrapolation between successive points of a sequence; 0 = no predictor */
+        static int  s_MaxStepHalvings;     /**< the max. number of times the step is halved when a point fails to converge */
 
     public:
         int m_Iterations;          /**< The number of iterations already performed */
+        QVector<int> m_PointIterations;  /**< The number of Newton iterations of each point of the last sequence */
         bool m_bIsFinished;        /**< true if the calculation is over */
         XFoil m_XFoilInstance;     /**< An instance of the XFoil class specific for this object */
 
@@ -98,8 +116,50 @@ class XFoilTask : public QRunnable
 
         QObject *m_pParent;
 
+    private:
+        bool initXFoilInstance(bool bViscous);
+        QByteArray cacheKey(bool bViscous) const;
+        bool loadCachedOpp(double SpValue);
+        int planSubSweeps(int nSubSweeps);
+        bool mergeSubSweeps();
+        void runSubSweep();
+        void storeSubSweepOpp(OpPoint *pOpp);
+        bool waitForSeed(blState &seed);
+        void predictBL(double SpValue);
+        bool halveStep(double SpValue, int &nPointIter);
+        void pushBLHistory(double SpValue);
+        void makeSubSweeps(double SpMin, double SpInc, int nPoints, int nSweeps);
+
     private:
         Foil const*m_pFoil;       /**< A pointer to the instance of the Foil object for which the calculation is performed */
         Polar *m_pPolar;         /**< A pointer to the instance of the Polar object for which the calculation is performed */
+
+        int m_nSubSweeps;                 /**< the max. number of concurrent sub-sweeps into which the range may be split; 1 = serial sequence */
+        QVector<XFoilTask*> m_SubSweeps;  /**< the sub-sweeps of this task, in the order of the serial sequence */
+        QMutex m_SubSweepMutex;           /**< protects the publication of the sub-sweeps' BL states */
+        QWaitCondition m_SubSweepCondition;
+
+        XFoilTask *m_pMasterTask;         /**< the task which has split its range, if this task is a sub-sweep */
+        XFoilTask *m_pSeedTask;           /**< the adjacent sub-sweep from which the BL may be seeded if the first point fails */
+        bool m_bSeedFromFirst;            /**< true if the seed is the first converged point of the seed task, false if it is its last */
+        int m_nSubSweepPoints;            /**< the number of operating points of this sub-sweep */
+        bool m_bSubSweepStarted;
+        bool m_bSubSweepDone;
+        bool m_bFirstCached;              /**< true if the first point of the sub-sweep has been read from the cache, so that no BL is published for it */
+        bool m_bViscous;                  /**< true if the analysis is viscous; read by the sub-sweeps when they initialize their XFoil instance */
+        blState m_FirstBL;                /**< the first converged BL state of the sub-sweep */
+        blState m_Seed;                   /**< the BL state received from the adjacent sub-sweep; a member because of its size */
+
+        blState m_BLHistory[3];           /**< the BL states of the last converged points of the series, most recent first */
+        double m_BLHistoryParam[3];       /**< the aoa or Cl at which the history states have been converged */
+        int m_nBLHistory;                 /**< the number of valid states in the history */
+        bool m_bLastConverged;            /**< true if the previous point of the series has converged */
+        QVector<OpPoint*> m_SubSweepOpps; /**< the operating points of the sub-sweep, nullptr if unconverged */
+        QByteArray m_CacheKey;            /**< the key of the task's results in the ResultCache; empty if the cache is disabled */
+        QString m_SubSweepLog;
+
+#ifdef XFL_PERFSTATS
+        PerfStats m_PerfStats;            /**< the timings and counters of the last run, including those of the sub-sweeps */
+#endif
 };
 
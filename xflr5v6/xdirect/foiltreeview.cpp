@@ -81,6 +81,7 @@ FoilTreeView::FoilTreeView(QWidget *pParent) : QWidget(pParent)
     connect(m_pStruct, SIGNAL(pressed(QModelIndex)), SLOT(onItemClicked(QModelIndex)));
     //	connect(m_pStruct, SIGNAL(doubleClicked(QModelIndex)), this, SLOT(onItemDoubleClicked(QModelIndex)));
     connect(m_pStruct->selectionModel(), SIGNAL(currentRowChanged(QModelIndex,QModelIndex)), SLOT(onCurrentRowChanged(QModelIndex, QModelIndex)));
+    connect(m_pModel, SIGNAL(fetchChildren(ObjectTreeItem*)), SLOT(onFetchChildren(ObjectTreeItem*)));
 }
 
 
@@ -240,25 +241,37 @@ void FoilTreeView::fillPolars(ObjectTreeItem *pFoilItem, Foil const *pFoil)
 {
     if(!pFoil || !pFoilItem) return;
 
+    QSet<QString> oppPolars = oppPolarNames(pFoil);
+
     for(int iPolar=0; iPolar<Objects2d::polarCount(); iPolar++)
     {
         Polar *pPolar = Objects2d::polarAt(iPolar);
         if(pPolar && pPolar->foilName().compare(pFoil->name())==0)
         {
-            Polar *pPolar = Objects2d::polarAt(iPolar);
-            if(!pPolar) continue;
-            if(pPolar && pPolar->foilName().compare(pFoil->name())==0)
-            {
-                LineStyle ls(pPolar->theStyle());
-                ls.m_bIsEnabled = true;
-                m_pModel->appendRow(pFoilItem, pPolar->name(), ls, polarState(pPolar));
-            }
-            addOpps(pPolar);
+            LineStyle ls(pPolar->theStyle());
+            ls.m_bIsEnabled = true;
+            ObjectTreeItem *pPolarItem = m_pModel->appendRow(pFoilItem, pPolar->name(), ls, polarState(pPolar));
+
+            // the operating point rows are built when the polar is first expanded
+            pPolarItem->setFetched(!oppPolars.contains(pPolar->polarName()));
         }
     }
 }
 
 
+/** Returns the names of the foil's polars which have operating points, in a single pass over the operating points */
+QSet<QString> FoilTreeView::oppPolarNames(Foil const *pFoil) const
+{
+    QSet<QString> names;
+    for(int iopp=0; iopp<Objects2d::oppCount(); iopp++)
+    {
+        OpPoint const *pOpp = Objects2d::oppAt(iopp);
+        if(pOpp->foilName().compare(pFoil->name())==0) names.insert(pOpp->polarName());
+    }
+    return names;
+}
+
+
 Qt::CheckState FoilTreeView::foilState(Foil const *pFoil) const
 {
     bool bAll = true;
@@ -606,6 +619,7 @@ void FoilTreeView::selectOpPoint(OpPoint *pOpp)
                     // is it the correct polar name?
                     if(pPolarItem && pPolarItem->name().compare(pOpp->polarName())==0)
                     {
+                        m_pModel->fetch(pPolarItem);
                         //browse the opps
                         for(int kr=0; kr<pPolarItem->rowCount(); kr++)
                         {
@@ -653,10 +667,13 @@ void FoilTreeView::selectOpPoint(OpPoint *pOpp)
 }
 
 
+/**
+ * Updates the operating point rows of the polar after an analysis or a deletion.
+ * Only the rows which have changed are inserted or removed, and nothing is done if the polar has not been expanded yet.
+ */
 void FoilTreeView::addOpps(Polar *pPolar)
 {
     if(!pPolar) return;
-    QString format = xfl::g_bLocalize ? "%L1" : "%1";
     for(int ir=0; ir<m_pModel->rowCount(); ir++)
     {
         ObjectTreeItem *pFoilItem = m_pModel->item(ir);
@@ -666,40 +683,105 @@ void FoilTreeView::addOpps(Polar *pPolar)
             //find the WPolar item
             for(int jr=0; jr<pFoilItem->rowCount(); jr++)
             {
-                ObjectTreeItem *pOldPolarItem = pFoilItem->child(jr);
-                if(pOldPolarItem)
+                ObjectTreeItem *pPolarItem = pFoilItem->child(jr);
+                if(pPolarItem && pPolarItem->name().compare(pPolar->polarName(), Qt::CaseInsensitive)==0)
                 {
-                    const QModelIndex &oldPolarChild = m_pModel->index(pFoilItem, pOldPolarItem);
-                    if(pOldPolarItem->name().compare(pPolar->polarName(), Qt::CaseInsensitive)==0)
-                    {
-                        //clear the children
-                        m_pModel->removeRows(0, pOldPolarItem->rowCount(), oldPolarChild);
-                        //insert POpps
-                        for(int kr=0; kr<Objects2d::oppCount(); kr++)
-                        {
-                            OpPoint * pOpp = Objects2d::oppAt(kr);
-                            if(pOpp->foilName().compare(pPolar->foilName())==0 && pOpp->polarName().compare(pPolar->polarName())==0)
-                            {
-                                QString strange;
-
-                                if   (pPolar->isFixedaoaPolar()) strange = QString(format).arg(pOpp->Reynolds(), 0, 'f', 0);
-                                else                             strange = QString(format).arg(pOpp->aoa(),      0, 'f', 3);
-
-                                LineStyle ls(pOpp->theStyle());
-                                ls.m_bIsEnabled = !s_pXDirect->isPolarView();
-                                m_pModel->appendRow(pOldPolarItem, strange, ls, Qt::PartiallyChecked);
-                            }
-                        }
-                        return;
-                    }
+                    if(pPolarItem->isFetched())
+                        fillOpps(pPolarItem, pPolar);
+                    break;
                 }
             }
+            break;
         }
     }
     setOverallCheckStatus();
 }
 
 
+/**
+ * Brings the children of the polar item in line with the polar's operating points.
+ * The new rows are inserted in runs, and the rows of the deleted operating points are removed.
+ */
+void FoilTreeView::fillOpps(ObjectTreeItem *pPolarItem, Polar const *pPolar)
+{
+    if(!pPolarItem || !pPolar) return;
+
+    QVector<OpPoint const*> oppList;
+    QSet<QString> names;
+    for(int kr=0; kr<Objects2d::oppCount(); kr++)
+    {
+        OpPoint const *pOpp = Objects2d::oppAt(kr);
+        if(pOpp->foilName().compare(pPolar->foilName())==0 && pOpp->polarName().compare(pPolar->polarName())==0)
+        {
+            oppList.append(pOpp);
+            names.insert(oppName(pPolar, pOpp));
+        }
+    }
+
+    QModelIndex polarindex = m_pModel->index(pPolarItem->parentItem(), pPolarItem);
+
+    // remove the rows of the deleted operating points
+    for(int ir=pPolarItem->rowCount()-1; ir>=0; ir--)
+    {
+        if(!names.contains(pPolarItem->child(ir)->name()))
+            m_pModel->removeRows(ir, 1, polarindex);
+    }
+
+    // insert the rows of the new operating points
+    QList<ObjectTreeItem*> newItems;
+    int ir=0;
+    for(int i=0; i<oppList.size(); i++)
+    {
+        QString strange = oppName(pPolar, oppList.at(i));
+        if(ir<pPolarItem->rowCount() && pPolarItem->child(ir)->name().compare(strange)==0)
+        {
+            m_pModel->insertItems(pPolarItem, ir, newItems);
+            ir += newItems.size()+1;
+            newItems.clear();
+        }
+        else
+        {
+            LineStyle ls(oppList.at(i)->theStyle());
+            ls.m_bIsEnabled = !s_pXDirect->isPolarView();
+            newItems.append(new ObjectTreeItem(strange, ls, Qt::PartiallyChecked));
+        }
+    }
+    m_pModel->insertItems(pPolarItem, ir, newItems);
+
+    if(pPolarItem->rowCount()!=oppList.size())
+    {
+        // the existing rows were not in the order of the array, rebuild them
+        m_pModel->removeRows(0, pPolarItem->rowCount(), polarindex);
+        newItems.clear();
+        for(int i=0; i<oppList.size(); i++)
+        {
+            LineStyle ls(oppList.at(i)->theStyle());
+            ls.m_bIsEnabled = !s_pXDirect->isPolarView();
+            newItems.append(new ObjectTreeItem(oppName(pPolar, oppList.at(i)), ls, Qt::PartiallyChecked));
+        }
+        m_pModel->insertItems(pPolarItem, 0, newItems);
+    }
+}
+
+
+QString FoilTreeView::oppName(Polar const *pPolar, OpPoint const *pOpp) const
+{
+    QString format = xfl::g_bLocalize ? "%L1" : "%1";
+    if(pPolar->isFixedaoaPolar()) return QString(format).arg(pOpp->Reynolds(), 0, 'f', 0);
+    else                          return QString(format).arg(pOpp->aoa(),      0, 'f', 3);
+}
+
+
+void FoilTreeView::onFetchChildren(ObjectTreeItem *pItem)
+{
+    if(!pItem || !pItem->isPolarLevel()) return;
+
+    Foil *pFoil = Objects2d::foil(pItem->parentItem()->name());
+    Polar const *pPolar = Objects2d::getPolar(pFoil, pItem->name());
+    fillOpps(pItem, pPolar);
+}
+
+
 void FoilTreeView::insertFoil(Foil *pFoil)
 {
     if(!pFoil) pFoil = XDirect::curFoil();
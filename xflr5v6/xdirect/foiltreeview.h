@@ -15,6 +15,7 @@
 #include <QWidget>
 #include <QCheckBox>
 #include <QGroupBox>
+#include <QSet>
 
 #include <xflcore/core_enums.h>
 #include <xflcore/linestyle.h>
@@ -59,6 +60,7 @@ class FoilTreeView : public QWidget
         void fillModelView();
         void fillPolars(ObjectTreeItem *pFoilItem, Foil const*pFoil);
         void addOpps(Polar *pPolar);
+        void fillOpps(ObjectTreeItem *pPolarItem, Polar const *pPolar);
 
         Qt::CheckState checkState(Foil *pFoil);
         Qt::CheckState checkState(Polar *pPolar);
@@ -85,6 +87,8 @@ class FoilTreeView : public QWidget
     private:
         Qt::CheckState foilState(const Foil *pFoil) const;
         Qt::CheckState polarState(const Polar *pPolar) const;
+        QString oppName(Polar const *pPolar, OpPoint const *pOpp) const;
+        QSet<QString> oppPolarNames(Foil const *pFoil) const;
 
     public slots:
         void onItemClicked(const QModelIndex &index);
@@ -97,6 +101,7 @@ class FoilTreeView : public QWidget
 
         void onSwitchAll(bool bChecked);
         void onSetFilter();
+        void onFetchChildren(ObjectTreeItem *pItem);
 
     protected:
         static MainFrame *s_pMainFrame;
@@ -395,13 +395,14 @@ void XDirect::createOppCurves(OpPoint *pOpp)
 */
 void XDirect::createPolarCurves()
 {
-    // curves must be entirely reconstructed each time from the
-    // operating points database, since user may have added
-    // or deleted points & polars
+    // the curves are rebuilt each time from the operating points database,
+    // since user may have added or deleted points & polars;
+    // the existing curves are reused in order, and their cached screen
+    // polylines are kept if the data has not changed
 
     Polar *pPolar = nullptr;
-
-    for(int ig=0; ig<MAXPOLARGRAPHS; ig++) m_PlrGraph[ig]->deleteCurves();
+    int nCurves = 0;
+    Curve tmpCurve;
 
     for (int k=0; k<m_poaPolar->size(); k++)
     {
@@ -414,34 +415,24 @@ void XDirect::createPolarCurves()
                     (pPolar->polarType()==xfl::RUBBERCHORDPOLAR && m_bType3) ||
                     (pPolar->polarType()==xfl::FIXEDAOAPOLAR    && m_bType4))
             {
-
-                Curve* pCurve[MAXPOLARGRAPHS];
-                for(int ic=0; ic<MAXPOLARGRAPHS; ic++) pCurve[ic]=nullptr;
-                //                Curve* pTr2Curve = nullptr;
                 for(int ig=0; ig<MAXPOLARGRAPHS; ig++)
                 {
-                    pCurve[ig] = m_PlrGraph[ig]->addCurve();
-                    pCurve[ig]->setLineStyle(pPolar->theStyle());
-
-                    fillPolarCurve(pCurve[ig], pPolar, m_PlrGraph[ig]->xVariable(), m_PlrGraph[ig]->yVariable());
-                    pCurve[ig]->setName(pPolar->polarName());
-
-                    /*                    if(m_PlrGraph[ig]->yVariable() == 6)    pTr2Curve = m_PlrGraph[ig]->addCurve();
-                    else                                    pTr2Curve = nullptr;
-                    if(pTr2Curve)
-                    {
-                        pTr2Curve->setLineStyle(pPolar->polarStyle(), pPolar->polarWidth(), pPolar->color(), pPolar->pointStyle(), pPolar->isVisible());
-                        fillPolarCurve(pTr2Curve, pPolar, m_PlrGraph[ig]->xVariable(), 7);
-
-                        str = pPolar->polarName() + " / Xtr1";
-                        pCurve[ig]->setCurveName(str);
-                        str = pPolar->polarName() + " / Xtr2";
-                        pTr2Curve->setCurveName(str);
-                    }*/
+                    Curve *pCurve = m_PlrGraph[ig]->curve(nCurves);
+                    if(!pCurve) pCurve = m_PlrGraph[ig]->addCurve();
+                    pCurve->setLineStyle(pPolar->theStyle());
+
+                    tmpCurve.clear();
+                    fillPolarCurve(&tmpCurve, pPolar, m_PlrGraph[ig]->xVariable(), m_PlrGraph[ig]->yVariable());
+                    pCurve->setPoints(tmpCurve.m_x, tmpCurve.m_y);
+                    pCurve->setSelected(tmpCurve.selected());
+                    pCurve->setName(pPolar->polarName());
                 }
+                nCurves++;
             }
         }
     }
+
+    for(int ig=0; ig<MAXPOLARGRAPHS; ig++) m_PlrGraph[ig]->truncateCurves(nCurves);
 }
 
 
@@ -1111,6 +1102,8 @@ void XDirect::loadSettings(QSettings &settings)
 
         XFoilTask::s_bAutoInitBL    = settings.value("AutoInitBL").toBool();
         XFoilTask::s_IterLim        = settings.value("IterLim", 100).toInt();
+        XFoilTask::s_PredictorOrder = settings.value("PredictorOrder", 1).toInt();
+        XFoilTask::s_MaxStepHalvings= settings.value("MaxStepHalvings", 2).toInt();
 
         XFoil::setFullReport(settings.value("FullReport").toBool());
 
@@ -3882,6 +3875,8 @@ void XDirect::saveSettings(QSettings &settings)
 
         settings.setValue("AutoInitBL", XFoilTask::s_bAutoInitBL);
         settings.setValue("IterLim", XFoilTask::s_IterLim);
+        settings.setValue("PredictorOrder", XFoilTask::s_PredictorOrder);
+        settings.setValue("MaxStepHalvings", XFoilTask::s_MaxStepHalvings);
         settings.setValue("FullReport", XFoil::fullReport());
 
         settings.setValue("BatchUpdatePolarView", BatchThreadDlg::s_bUpdatePolarView);
@@ -0,0 +1,32 @@
+/****************************************************************************
+
+    xfl5 v6
+    Copyright (C) André Deperrois
+    GNU General Public License v3
+
+*****************************************************************************/
+
+#version 330
+// The fragment shader for surfaces coloured by a scalar attribute
+
+in vec3 Position_viewSpace;
+in float ScalarRatio;
+
+uniform sampler2D ColorMap; // a single row of texels
+uniform float ColorMapSize;
+uniform float clipPlane0; // defined in view-space
+
+layout(location=0) out vec4 fragColor;
+
+void main()
+{
+    if (Position_viewSpace.z > clipPlane0)
+    {
+        discard;
+        return;
+    }
+
+    // sample between the centres of the first and last texels
+    float u = (0.5 + clamp(ScalarRatio, 0.0, 1.0)*(ColorMapSize-1.0))/ColorMapSize;
+    fragColor = vec4(texture(ColorMap, vec2(u, 0.5)).rgb, 1.0);
+}
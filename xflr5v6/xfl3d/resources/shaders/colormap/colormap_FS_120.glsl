@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * 	xfl5 v6
+ * 	Copyright (C) André Deperrois
+ * 	GNU General Public License v3
+ *
+ *****************************************************************************/
+
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+varying vec3 Position_viewSpace;
+varying float ScalarRatio;
+
+uniform sampler2D ColorMap;
+uniform float ColorMapSize;
+uniform float clipPlane0; // defined in view-space
+
+void main()
+{
+    if (Position_viewSpace.z > clipPlane0)
+    {
+        discard;
+        return;
+    }
+
+    float u = (0.5 + clamp(ScalarRatio, 0.0, 1.0)*(ColorMapSize-1.0))/ColorMapSize;
+    gl_FragColor = vec4(texture2D(ColorMap, vec2(u, 0.5)).rgb, 1.0);
+}
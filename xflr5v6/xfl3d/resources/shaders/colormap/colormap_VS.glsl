@@ -0,0 +1,32 @@
+/****************************************************************************
+
+    xfl5 v6
+    Copyright (C) André Deperrois
+    GNU General Public License v3
+
+*****************************************************************************/
+
+#version 330
+// The vertex shader for surfaces coloured by a scalar attribute
+
+in vec4 vertexPosition_modelSpace;
+in float vertexScalar;
+
+uniform mat4 pvmMatrix;
+uniform mat4 vmMatrix;
+uniform float ScalarMin;
+uniform float ScalarMax;
+
+out vec3 Position_viewSpace;
+out float ScalarRatio;
+
+void main()
+{
+    gl_Position =  pvmMatrix * vertexPosition_modelSpace;
+    Position_viewSpace = (vmMatrix * vertexPosition_modelSpace).xyz;
+
+    // map the scalar to the colormap's range
+    float range = ScalarMax - ScalarMin;
+    if(range>0.0) ScalarRatio = (vertexScalar-ScalarMin)/range;
+    else          ScalarRatio = 0.5;
+}
@@ -0,0 +1,32 @@
+/****************************************************************************
+ *
+ * 	xfl5 v6
+ * 	Copyright (C) André Deperrois
+ * 	GNU General Public License v3
+ *
+ *****************************************************************************/
+
+#ifdef GL_ES
+precision mediump float;
+#endif
+
+attribute vec4 vertexPosition_modelSpace;
+attribute float vertexScalar;
+
+uniform mat4 pvmMatrix;
+uniform mat4 vmMatrix;
+uniform float ScalarMin;
+uniform float ScalarMax;
+
+varying vec3 Position_viewSpace;
+varying float ScalarRatio;
+
+void main()
+{
+    gl_Position =  pvmMatrix * vertexPosition_modelSpace;
+    Position_viewSpace = (vmMatrix * vertexPosition_modelSpace).xyz;
+
+    float range = ScalarMax - ScalarMin;
+    if(range>0.0) ScalarRatio = (vertexScalar-ScalarMin)/range;
+    else          ScalarRatio = 0.5;
+}
@@ -159,8 +159,9 @@ void gl3dPlaneView::glMake3dObjects()
             {
                 if(TranslatedBody.isSplineType())
                 {
-                    glMakeFuseSplines(&TranslatedBody);
-                    glMakeFuseSplinesOutline(&TranslatedBody);
+                    // use the untranslated body to share its cached tessellation
+                    glMakeFuseSplines(m_pPlane->body(), m_pPlane->bodyPos());
+                    glMakeFuseSplinesOutline(m_pPlane->body(), m_pPlane->bodyPos());
                 }
                 else if(TranslatedBody.isFlatPanelType())
                 {
@@ -26,6 +26,7 @@
 #include "gl3dwingview.h"
 #include <xflobjects/editors/wingdlg.h>
 #include <xfl3d/controls/w3dprefs.h>
+#include <xflcore/displayoptions.h>
 #include <xflobjects/objects3d/wing.h>
 #include <xflobjects/objects3d/surface.h>
 
@@ -38,6 +39,24 @@ gl3dWingView::gl3dWingView(QWidget *pParent) : gl3dXflView(pParent)
 
     m_bResetglSectionHighlight = true;
     m_bResetglWing             = true;
+    m_bResetglMesh             = true;
+
+    m_EditLatency = -1.0;
+}
+
+
+/**
+ * Flags the surfaces which have been modified, so that only their part of the vertex buffers is rewritten at the next frame.
+ * The panel mesh is rebuilt as a whole since its size depends on the panel numbers.
+ */
+void gl3dWingView::resetglWingSurfaces(QVector<int> const &surfaces)
+{
+    for(int i=0; i<surfaces.size(); i++)
+    {
+        if(!m_ModifiedSurface.contains(surfaces.at(i))) m_ModifiedSurface.append(surfaces.at(i));
+    }
+    m_bResetglMesh = true;
+    m_bResetglSectionHighlight = true;
 }
 
 
@@ -190,12 +209,27 @@ void gl3dWingView::glMake3dObjects()
         }
     }
 
+    if(!m_bResetglWing && m_ModifiedSurface.size())
+    {
+        // rewrite only the sub-ranges of the modified surfaces, unless the layout of the buffers has changed
+        if(!glUpdateWingSurface(m_pWing, nullptr, m_ModifiedSurface, m_vboSurface) ||
+           !glUpdateWingOutline(m_pWing, nullptr, m_ModifiedSurface, m_vboOutline))
+            m_bResetglWing = true;
+    }
+    m_ModifiedSurface.clear();
+
     if(m_bResetglWing)
     {
         m_bResetglWing = false;
         glMakeWingSurface(m_pWing, nullptr, m_vboSurface);
         glMakeWingOutline(m_pWing, nullptr, m_vboOutline);
 //        glMakeWingGeometry(0, m_pWing, nullptr);
+        m_bResetglMesh = true;
+    }
+
+    if(m_bResetglMesh)
+    {
+        m_bResetglMesh = false;
         glMakeWingEditMesh(m_vboEditWingMesh[0], m_pWing);
     }
 }
@@ -231,5 +265,15 @@ void gl3dWingView::glRenderView()
         if(m_bShowMasses)
             paintMasses(m_pWing->volumeMass(), Vector3d(0.0,0.0,0.0), "Structural mass", m_pWing->m_PointMass);
         if(m_pGL3dWingDlg->iSection()>=0) paintSectionHighlight();
+
+        if(m_EditTimer.isValid())
+        {
+            m_EditLatency = double(m_EditTimer.nsecsElapsed())/1.e6;
+            m_EditTimer.invalidate();
+        }
+        if(m_EditLatency>=0.0)
+        {
+            glRenderText(10, 15, QString::asprintf("Edit to frame: %.1f ms", m_EditLatency), DisplayOptions::backgroundColor(), DisplayOptions::textColor());
+        }
     }
 }
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <QElapsedTimer>
+
 #include <xfl3d/views/gl3dxflview.h>
 
 class Wing;
@@ -34,7 +36,9 @@ class gl3dWingView : public gl3dXflView
         void glMakeWingSectionHighlight(Wing const *pWing, int iSectionHighLight, bool bRightSide);
 
         void resetglWing() {m_bResetglWing=true;}
+        void resetglWingSurfaces(QVector<int> const &surfaces);
         void resetglHighlight() {m_bResetglSectionHighlight=true;}
+        void startEditTimer() {m_EditTimer.start();}
 
     private:
         void glRenderView() override;
@@ -52,5 +56,11 @@ class gl3dWingView : public gl3dXflView
         bool m_bResetglWing;
         bool m_bResetglSectionHighlight;
 
+        QVector<int> m_ModifiedSurface;   /**< the surfaces to rewrite in the buffers at the next frame, if the whole wing is not reset */
+        bool m_bResetglMesh;              /**< true if the panel mesh needs to be rebuilt */
+
+        QElapsedTimer m_EditTimer;        /**< started when an edit is made in the dialog, read when the resulting frame has been rendered */
+        double m_EditLatency;             /**< the last measured time in ms between an edit and its frame, or <0 if none */
+
 };
 
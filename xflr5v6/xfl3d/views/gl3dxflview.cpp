@@ -392,17 +392,26 @@ void gl3dXflView::glMakeFuseFlatPanelsOutline(const Body *pBody)
 }
 
 
-void gl3dXflView::glMakeFuseSplines(Body const *pBody)
+/**
+ * Builds the surface buffers of a NURBS body from its cached tessellation.
+ * @param pBody a pointer to the body
+ * @param pos the position of the body; only the x and z components are used, as in Body::translate()
+ */
+void gl3dXflView::glMakeFuseSplines(Body const *pBody, Vector3d const &pos)
 {
     int NXXXX = W3dPrefs::bodyAxialRes();
     int NHOOOP = W3dPrefs::bodyHoopRes();
-    QVector<Vector3d> T((NXXXX+1)*(NHOOOP+1)), N((NXXXX+1)*(NHOOOP+1));
-    Vector3d TALB, LATB;
 
     if(!pBody)return;
 
-    Vector3d Point;
-    Vector3d Normal;
+    BodyTessellation const &tess = pBody->tessellation(NXXXX, NHOOOP, true);
+    QVector<Vector3d> T(tess.m_Pt);
+    QVector<Vector3d> const &N = tess.m_N;
+    for(int p=0; p<T.size(); p++)
+    {
+        T[p].x += pos.x;
+        T[p].z += pos.z;
+    }
 
     //vertices array size:
     // surface:
@@ -422,26 +431,11 @@ void gl3dXflView::glMakeFuseSplines(Body const *pBody)
 
     QVector<float> FuseVertexArray(FuseVertexSize);
 
-    int p = 0;
-    double ud(0), vd(0);
-    for (int k=0; k<=NXXXX; k++)
-    {
-        ud = double(k) / double(NXXXX);
-        for (int l=0; l<=NHOOOP; l++)
-        {
-            vd = double(l) / double(NHOOOP);
-            pBody->getPoint(ud,  vd, true, T[p]);
-            pBody->nurbs().getNormal(ud, vd, N[p]);
-
-            p++;
-        }
-    }
-
     int nla(0), nlb(0), nta(0), ntb(0);
 
     int iv=0;
     //right side first;
-    p=0;
+    int p=0;
     for (int k=0; k<NXXXX; k++)
     {
         for (int l=0; l<NHOOOP; l++)
@@ -602,17 +596,18 @@ void gl3dXflView::glMakeFuseSplines(Body const *pBody)
 }
 
 
-void gl3dXflView::glMakeFuseSplinesOutline(Body const*pBody)
+/**
+ * Builds the outline buffer of a NURBS body from its cached tessellations.
+ * @param pBody a pointer to the body
+ * @param pos the position of the body; only the x and z components are used, as in Body::translate()
+ */
+void gl3dXflView::glMakeFuseSplinesOutline(Body const*pBody, Vector3d const &pos)
 {
     if(!pBody) return;
 
     int NXXXX = W3dPrefs::bodyAxialRes();
     int NHOOOP = W3dPrefs::bodyHoopRes();
 
-
-    Vector3d Point;
-    double hinc(0), u(0), v(0);
-
     //OUTLINE
     // outline:
     //     frameSize()*(NH+1)*2 : frames
@@ -625,50 +620,50 @@ void gl3dXflView::glMakeFuseSplinesOutline(Body const*pBody)
 
     std::vector<float> OutlineVertexArray(outlinesize);
 
-    hinc=1./(double)NHOOOP;
+    QVector<double> uFrame(pBody->frameCount());
+    for (int iFr=0; iFr<pBody->frameCount(); iFr++) uFrame[iFr] = pBody->getu(pBody->frameAt(iFr)->position().x);
+    BodyTessellation const &frames = pBody->tessellation(uFrame, NHOOOP);
 
     int iv=0;
     // frames : frameCount() x (NH+1)
     for (int iFr=0; iFr<pBody->frameCount(); iFr++)
     {
-        u = pBody->getu(pBody->frameAt(iFr)->position().x);
         for (int j=0; j<=NHOOOP; j++)
         {
-            v = (double)j*hinc;
-            pBody->getPoint(u,v,true, Point);
-            OutlineVertexArray[iv++] = Point.x;
+            Vector3d const &Point = frames.point(iFr, j);
+            OutlineVertexArray[iv++] = Point.x + pos.x;
             OutlineVertexArray[iv++] = Point.y;
-            OutlineVertexArray[iv++] = Point.z;
+            OutlineVertexArray[iv++] = Point.z + pos.z;
         }
 
         for (int j=NHOOOP; j>=0; j--)
         {
-            v = (double)j*hinc;
-            pBody->getPoint(u,v,false, Point);
-            OutlineVertexArray[iv++] = Point.x;
-            OutlineVertexArray[iv++] = Point.y ;
-            OutlineVertexArray[iv++] = Point.z;
+            Vector3d const &Point = frames.point(iFr, j);
+            OutlineVertexArray[iv++] =  Point.x + pos.x;
+            OutlineVertexArray[iv++] = -Point.y;
+            OutlineVertexArray[iv++] =  Point.z + pos.z;
         }
     }
 
+    // the top and bottom lines are the first and last hoop stations of the surface tessellation
+    BodyTessellation const &surface = pBody->tessellation(NXXXX, NHOOOP, true);
+
     //top line: NX+1
-    v = 0.0;
     for (int iu=0; iu<=NXXXX; iu++)
     {
-        pBody->getPoint((double)iu/(double)NXXXX,v, true, Point);
-        OutlineVertexArray[iv++] = Point.x;
+        Vector3d const &Point = surface.point(iu, 0);
+        OutlineVertexArray[iv++] = Point.x + pos.x;
         OutlineVertexArray[iv++] = Point.y;
-        OutlineVertexArray[iv++] = Point.z;
+        OutlineVertexArray[iv++] = Point.z + pos.z;
     }
 
     //bottom line: NX+1
-    v = 1.0;
     for (int iu=0; iu<=NXXXX; iu++)
     {
-        pBody->getPoint((double)iu/(double)NXXXX,v, true, Point);
-        OutlineVertexArray[iv++] = Point.x;
+        Vector3d const &Point = surface.point(iu, NHOOOP);
+        OutlineVertexArray[iv++] = Point.x + pos.x;
         OutlineVertexArray[iv++] = Point.y;
-        OutlineVertexArray[iv++] = Point.z;
+        OutlineVertexArray[iv++] = Point.z + pos.z;
     }
     Q_ASSERT(iv==outlinesize);
 
@@ -1320,7 +1315,27 @@ void gl3dXflView::paintMesh(QOpenGLBuffer &vbo, bool bBackGround)
 }
 
 
-void gl3dXflView::glMakeWingOutline(Wing const *pWing, Body const *pBody, QOpenGLBuffer &vboOutline) const
+/** Returns the number of floats written by glMakeWingOutlineVertices() for the surface */
+int gl3dXflView::wingOutlineVertexSize(Surface const &surf) const
+{
+    int CHORDPOINTS = W3dPrefs::chordwiseRes();
+    int nSegs = (CHORDPOINTS-1)*2*2; // top and bottom, left and right
+    nSegs += 2;                      // LE and TE
+
+    Foil const *pFoilA = surf.m_pFoilA;
+    Foil const *pFoilB = surf.m_pFoilB;
+    if(pFoilA && pFoilB && pFoilA->m_bTEFlap && pFoilB->m_bTEFlap) nSegs +=2;
+    if(pFoilA && pFoilB && pFoilA->m_bLEFlap && pFoilB->m_bLEFlap) nSegs +=2;
+
+    return nSegs*2*3; // 2 vertices/segment, 3 components/vertex
+}
+
+
+/**
+ * Writes the outline segments of one of the wing's surfaces.
+ * @return the number of floats written to pVA
+ */
+int gl3dXflView::glMakeWingOutlineVertices(Wing const *pWing, Body const *pBody, int jSurf, float *pVA) const
 {
     int CHORDPOINTS = W3dPrefs::chordwiseRes();
     QVector<Vector3d>NA(CHORDPOINTS), NB(CHORDPOINTS);
@@ -1329,174 +1344,148 @@ void gl3dXflView::glMakeWingOutline(Wing const *pWing, Body const *pBody, QOpenG
 
     Vector3d Pt, N;
 
-    int stride = 3;
-    int nSegs = pWing->surfaceCount()
-                *(CHORDPOINTS-1)
-                *2                 // top and bottom
-                *2;                // left and right
-    nSegs += pWing->surfaceCount()
-             *2;                     //LE and TE
+    int iv=0;
+    Surface const &surf = pWing->m_Surface.at(jSurf);
 
+    surf.getSidePoints(xfl::TOPSURFACE, pBody, PtTopLeft, PtTopRight, NA, NB, CHORDPOINTS);
+    surf.getSidePoints(xfl::BOTSURFACE, pBody, PtBotLeft, PtBotRight, NA, NB, CHORDPOINTS);
 
-    //TE flap outline
-    for (int j=0; j<pWing->m_Surface.size(); j++)
+    //OUTLINE
+    for(int l=0; l<CHORDPOINTS-1; l++)
     {
-        Foil const *pFoilA = pWing->surface(j)->m_pFoilA;
-        Foil const *pFoilB = pWing->surface(j)->m_pFoilB;
-        if(pFoilA && pFoilB && pFoilA->m_bTEFlap && pFoilB->m_bTEFlap)
-        {
-            nSegs +=2;
-        }
+        pVA[iv++] = PtBotLeft.at(l).xf();
+        pVA[iv++] = PtBotLeft.at(l).yf();
+        pVA[iv++] = PtBotLeft.at(l).zf();
+        pVA[iv++] = PtBotLeft.at(l+1).xf();
+        pVA[iv++] = PtBotLeft.at(l+1).yf();
+        pVA[iv++] = PtBotLeft.at(l+1).zf();
+
+        pVA[iv++] = PtTopLeft.at(l).xf();
+        pVA[iv++] = PtTopLeft.at(l).yf();
+        pVA[iv++] = PtTopLeft.at(l).zf();
+        pVA[iv++] = PtTopLeft.at(l+1).xf();
+        pVA[iv++] = PtTopLeft.at(l+1).yf();
+        pVA[iv++] = PtTopLeft.at(l+1).zf();
+
+        pVA[iv++] = PtBotRight.at(l).xf();
+        pVA[iv++] = PtBotRight.at(l).yf();
+        pVA[iv++] = PtBotRight.at(l).zf();
+        pVA[iv++] = PtBotRight.at(l+1).xf();
+        pVA[iv++] = PtBotRight.at(l+1).yf();
+        pVA[iv++] = PtBotRight.at(l+1).zf();
+
+        pVA[iv++] = PtTopRight.at(l).xf();
+        pVA[iv++] = PtTopRight.at(l).yf();
+        pVA[iv++] = PtTopRight.at(l).zf();
+        pVA[iv++] = PtTopRight.at(l+1).xf();
+        pVA[iv++] = PtTopRight.at(l+1).yf();
+        pVA[iv++] = PtTopRight.at(l+1).zf();
     }
-    //LE flap outline
-    for (int j=0; j<pWing->m_Surface.size(); j++)
+    //LE & TE
+    surf.getSidePoint(0.0, false, xfl::TOPSURFACE, Pt, N);
+    pVA[iv++] = Pt.xf();
+    pVA[iv++] = Pt.yf();
+    pVA[iv++] = Pt.zf();
+    surf.getSidePoint(0.0, true, xfl::TOPSURFACE, Pt, N);
+    pVA[iv++] = Pt.xf();
+    pVA[iv++] = Pt.yf();
+    pVA[iv++] = Pt.zf();
+
+    surf.getSidePoint(1.0, false, xfl::TOPSURFACE, Pt, N);
+    pVA[iv++] = Pt.xf();
+    pVA[iv++] = Pt.yf();
+    pVA[iv++] = Pt.zf();
+    surf.getSidePoint(1.0, true, xfl::TOPSURFACE, Pt, N);
+    pVA[iv++] = Pt.xf();
+    pVA[iv++] = Pt.yf();
+    pVA[iv++] = Pt.zf();
+
+
+    Foil const *pFoilA = pWing->surface(jSurf)->m_pFoilA;
+    Foil const *pFoilB = pWing->surface(jSurf)->m_pFoilB;
+    if(pFoilA && pFoilB && pFoilA->m_bTEFlap && pFoilB->m_bTEFlap)
     {
-        Foil const *pFoilA = pWing->surface(j)->m_pFoilA;
-        Foil const *pFoilB = pWing->surface(j)->m_pFoilB;
-        if(pFoilA && pFoilB && pFoilA->m_bLEFlap && pFoilB->m_bLEFlap)
-        {
-            nSegs +=2;
-        }
+        surf.getSurfacePoint(surf.m_pFoilA->m_TEXHinge/100.0,
+                               pFoilA->m_TEXHinge/100.0,
+                               0.0, xfl::TOPSURFACE, Pt, N);
+        pVA[iv++] = Pt.xf();
+        pVA[iv++] = Pt.yf();
+        pVA[iv++] = Pt.zf();
+
+        surf.getSurfacePoint(surf.m_pFoilB->m_TEXHinge/100.0,
+                               pFoilB->m_TEXHinge/100.0,
+                               1.0, xfl::TOPSURFACE, Pt, N);
+        pVA[iv++] = Pt.xf();
+        pVA[iv++] = Pt.yf();
+        pVA[iv++] = Pt.zf();
+
+
+        surf.getSurfacePoint(surf.m_pFoilA->m_TEXHinge/100.0,
+                               pFoilA->m_TEXHinge/100.0,
+                               0.0, xfl::BOTSURFACE, Pt, N);
+        pVA[iv++] = Pt.xf();
+        pVA[iv++] = Pt.yf();
+        pVA[iv++] = Pt.zf();
+
+
+        surf.getSurfacePoint(surf.m_pFoilB->m_TEXHinge/100.0,
+                               pFoilB->m_TEXHinge/100.0,
+                               1.0, xfl::BOTSURFACE, Pt, N);
+        pVA[iv++] = Pt.xf();
+        pVA[iv++] = Pt.yf();
+        pVA[iv++] = Pt.zf();
+    }
+    if(pFoilA && pFoilB && pFoilA->m_bLEFlap && pFoilB->m_bLEFlap)
+    {
+        surf.getSurfacePoint(surf.m_pFoilA->m_LEXHinge/100.0,
+                               pFoilA->m_TEXHinge/100.0,
+                               0.0, xfl::TOPSURFACE, Pt, N);
+        pVA[iv++] = Pt.xf();
+        pVA[iv++] = Pt.yf();
+        pVA[iv++] = Pt.zf();
+
+        surf.getSurfacePoint(surf.m_pFoilB->m_LEXHinge/100.0,
+                               pFoilB->m_TEXHinge/100.0,
+                               1.0, xfl::TOPSURFACE, Pt, N);
+        pVA[iv++] = Pt.xf();
+        pVA[iv++] = Pt.yf();
+        pVA[iv++] = Pt.zf();
+
+
+        surf.getSurfacePoint(surf.m_pFoilA->m_LEXHinge/100.0,
+                               pFoilA->m_TEXHinge/100.0,
+                               0.0, xfl::BOTSURFACE, Pt, N);
+        pVA[iv++] = Pt.xf();
+        pVA[iv++] = Pt.yf();
+        pVA[iv++] = Pt.zf();
+
+
+        surf.getSurfacePoint(surf.m_pFoilB->m_LEXHinge/100.0,
+                               pFoilB->m_TEXHinge/100.0,
+                               1.0, xfl::BOTSURFACE, Pt, N);
+        pVA[iv++] = Pt.xf();
+        pVA[iv++] = Pt.yf();
+        pVA[iv++] = Pt.zf();
     }
+    return iv;
+}
+
 
+void gl3dXflView::glMakeWingOutline(Wing const *pWing, Body const *pBody, QOpenGLBuffer &vboOutline) const
+{
+    int buffersize = 0;
+    for (int j=0; j<pWing->m_Surface.size(); j++)
+        buffersize += wingOutlineVertexSize(pWing->m_Surface.at(j));
 
-    int buffersize = nSegs
-                *2                   // 2 vertices / segment
-                *stride;
     QVector<float>OutlineVA(buffersize);
 
     int iv=0; //index of outline vertex components
-
-
-    //SURFACE
     for (int j=0; j<pWing->m_Surface.size(); j++)
     {
-        Surface const &surf = pWing->m_Surface.at(j);
-
-        surf.getSidePoints(xfl::TOPSURFACE, pBody, PtTopLeft, PtTopRight, NA, NB, CHORDPOINTS);
-        surf.getSidePoints(xfl::BOTSURFACE, pBody, PtBotLeft, PtBotRight, NA, NB, CHORDPOINTS);
-
-        //OUTLINE
-        for(int l=0; l<CHORDPOINTS-1; l++)
-        {
-            OutlineVA[iv++] = PtBotLeft.at(l).xf();
-            OutlineVA[iv++] = PtBotLeft.at(l).yf();
-            OutlineVA[iv++] = PtBotLeft.at(l).zf();
-            OutlineVA[iv++] = PtBotLeft.at(l+1).xf();
-            OutlineVA[iv++] = PtBotLeft.at(l+1).yf();
-            OutlineVA[iv++] = PtBotLeft.at(l+1).zf();
-
-            OutlineVA[iv++] = PtTopLeft.at(l).xf();
-            OutlineVA[iv++] = PtTopLeft.at(l).yf();
-            OutlineVA[iv++] = PtTopLeft.at(l).zf();
-            OutlineVA[iv++] = PtTopLeft.at(l+1).xf();
-            OutlineVA[iv++] = PtTopLeft.at(l+1).yf();
-            OutlineVA[iv++] = PtTopLeft.at(l+1).zf();
-
-            OutlineVA[iv++] = PtBotRight.at(l).xf();
-            OutlineVA[iv++] = PtBotRight.at(l).yf();
-            OutlineVA[iv++] = PtBotRight.at(l).zf();
-            OutlineVA[iv++] = PtBotRight.at(l+1).xf();
-            OutlineVA[iv++] = PtBotRight.at(l+1).yf();
-            OutlineVA[iv++] = PtBotRight.at(l+1).zf();
-
-            OutlineVA[iv++] = PtTopRight.at(l).xf();
-            OutlineVA[iv++] = PtTopRight.at(l).yf();
-            OutlineVA[iv++] = PtTopRight.at(l).zf();
-            OutlineVA[iv++] = PtTopRight.at(l+1).xf();
-            OutlineVA[iv++] = PtTopRight.at(l+1).yf();
-            OutlineVA[iv++] = PtTopRight.at(l+1).zf();
-        }
-        //LE & TE
-        surf.getSidePoint(0.0, false, xfl::TOPSURFACE, Pt, N);
-        OutlineVA[iv++] = Pt.xf();
-        OutlineVA[iv++] = Pt.yf();
-        OutlineVA[iv++] = Pt.zf();
-        surf.getSidePoint(0.0, true, xfl::TOPSURFACE, Pt, N);
-        OutlineVA[iv++] = Pt.xf();
-        OutlineVA[iv++] = Pt.yf();
-        OutlineVA[iv++] = Pt.zf();
-
-        surf.getSidePoint(1.0, false, xfl::TOPSURFACE, Pt, N);
-        OutlineVA[iv++] = Pt.xf();
-        OutlineVA[iv++] = Pt.yf();
-        OutlineVA[iv++] = Pt.zf();
-        surf.getSidePoint(1.0, true, xfl::TOPSURFACE, Pt, N);
-        OutlineVA[iv++] = Pt.xf();
-        OutlineVA[iv++] = Pt.yf();
-        OutlineVA[iv++] = Pt.zf();
-
-
-        Foil const *pFoilA = pWing->surface(j)->m_pFoilA;
-        Foil const *pFoilB = pWing->surface(j)->m_pFoilB;
-        if(pFoilA && pFoilB && pFoilA->m_bTEFlap && pFoilB->m_bTEFlap)
-        {
-            surf.getSurfacePoint(surf.m_pFoilA->m_TEXHinge/100.0,
-                                   pFoilA->m_TEXHinge/100.0,
-                                   0.0, xfl::TOPSURFACE, Pt, N);
-            OutlineVA[iv++] = Pt.xf();
-            OutlineVA[iv++] = Pt.yf();
-            OutlineVA[iv++] = Pt.zf();
-
-            surf.getSurfacePoint(surf.m_pFoilB->m_TEXHinge/100.0,
-                                   pFoilB->m_TEXHinge/100.0,
-                                   1.0, xfl::TOPSURFACE, Pt, N);
-            OutlineVA[iv++] = Pt.xf();
-            OutlineVA[iv++] = Pt.yf();
-            OutlineVA[iv++] = Pt.zf();
-
-
-            surf.getSurfacePoint(surf.m_pFoilA->m_TEXHinge/100.0,
-                                   pFoilA->m_TEXHinge/100.0,
-                                   0.0, xfl::BOTSURFACE, Pt, N);
-            OutlineVA[iv++] = Pt.xf();
-            OutlineVA[iv++] = Pt.yf();
-            OutlineVA[iv++] = Pt.zf();
-
-
-            surf.getSurfacePoint(surf.m_pFoilB->m_TEXHinge/100.0,
-                                   pFoilB->m_TEXHinge/100.0,
-                                   1.0, xfl::BOTSURFACE, Pt, N);
-            OutlineVA[iv++] = Pt.xf();
-            OutlineVA[iv++] = Pt.yf();
-            OutlineVA[iv++] = Pt.zf();
-        }
-        if(pFoilA && pFoilB && pFoilA->m_bLEFlap && pFoilB->m_bLEFlap)
-        {
-            surf.getSurfacePoint(surf.m_pFoilA->m_LEXHinge/100.0,
-                                   pFoilA->m_TEXHinge/100.0,
-                                   0.0, xfl::TOPSURFACE, Pt, N);
-            OutlineVA[iv++] = Pt.xf();
-            OutlineVA[iv++] = Pt.yf();
-            OutlineVA[iv++] = Pt.zf();
-
-            surf.getSurfacePoint(surf.m_pFoilB->m_LEXHinge/100.0,
-                                   pFoilB->m_TEXHinge/100.0,
-                                   1.0, xfl::TOPSURFACE, Pt, N);
-            OutlineVA[iv++] = Pt.xf();
-            OutlineVA[iv++] = Pt.yf();
-            OutlineVA[iv++] = Pt.zf();
-
-
-            surf.getSurfacePoint(surf.m_pFoilA->m_LEXHinge/100.0,
-                                   pFoilA->m_TEXHinge/100.0,
-                                   0.0, xfl::BOTSURFACE, Pt, N);
-            OutlineVA[iv++] = Pt.xf();
-            OutlineVA[iv++] = Pt.yf();
-            OutlineVA[iv++] = Pt.zf();
-
-
-            surf.getSurfacePoint(surf.m_pFoilB->m_LEXHinge/100.0,
-                                   pFoilB->m_TEXHinge/100.0,
-                                   1.0, xfl::BOTSURFACE, Pt, N);
-            OutlineVA[iv++] = Pt.xf();
-            OutlineVA[iv++] = Pt.yf();
-            OutlineVA[iv++] = Pt.zf();
-        }
+        iv += glMakeWingOutlineVertices(pWing, pBody, j, OutlineVA.data()+iv);
     }
     Q_ASSERT(iv==buffersize);
 
-
     vboOutline.destroy();
     vboOutline.create();
     vboOutline.bind();
@@ -1505,11 +1494,59 @@ void gl3dXflView::glMakeWingOutline(Wing const *pWing, Body const *pBody, QOpenG
 }
 
 
-void gl3dXflView::glMakeWingSurface(Wing const *pWing, Body const *pBody, QOpenGLBuffer &vboSurf) const
+/**
+ * Rewrites in place the sub-ranges of the outline buffer which belong to the listed surfaces.
+ * @return false if the layout of the buffer does not match the wing's surfaces anymore, in which case the buffer needs to be rebuilt
+ */
+bool gl3dXflView::glUpdateWingOutline(Wing const *pWing, Body const *pBody, QVector<int> const &surfaces, QOpenGLBuffer &vboOutline) const
+{
+    if(!vboOutline.isCreated()) return false;
+
+    QVector<int> offset(pWing->m_Surface.size()+1);
+    offset[0] = 0;
+    for (int j=0; j<pWing->m_Surface.size(); j++)
+        offset[j+1] = offset.at(j) + wingOutlineVertexSize(pWing->m_Surface.at(j));
+
+    vboOutline.bind();
+    if(vboOutline.size() != offset.last()*int(sizeof(GLfloat)))
+    {
+        vboOutline.release();
+        return false;
+    }
+
+    QVector<float> OutlineVA;
+    for(int i=0; i<surfaces.size(); i++)
+    {
+        int j = surfaces.at(i);
+        if(j<0 || j>=pWing->m_Surface.size()) continue;
+        OutlineVA.resize(offset.at(j+1)-offset.at(j));
+        glMakeWingOutlineVertices(pWing, pBody, j, OutlineVA.data());
+        vboOutline.write(offset.at(j)*int(sizeof(GLfloat)), OutlineVA.constData(), OutlineVA.size()*int(sizeof(GLfloat)));
+    }
+    vboOutline.release();
+    return true;
+}
+
+
+/** Returns the number of floats written by glMakeWingSurfaceVertices() for the surface */
+int gl3dXflView::wingSurfaceVertexSize(Surface const &surf) const
+{
+    int CHORDPOINTS = W3dPrefs::chordwiseRes();
+    int nTriangles = 2*(CHORDPOINTS-1)*2; // top and bottom, 2 triangles/quad
+    if(surf.isTipLeft())  nTriangles += (CHORDPOINTS-1)*2;
+    if(surf.isTipRight()) nTriangles += (CHORDPOINTS-1)*2;
+    return nTriangles*3*8; // 3 vertices/triangle, 8 components/vertex
+}
+
+
+/**
+ * Writes the triangles of one of the wing's surfaces, including the tip patch if it is a tip surface.
+ * @return the number of floats written to pVA
+ */
+int gl3dXflView::glMakeWingSurfaceVertices(Wing const *pWing, Body const *pBody, int jSurf, float *pVA) const
 {
     int CHORDPOINTS = W3dPrefs::chordwiseRes();
 
-    Vector3d N, Pt;
     QVector<Vector3d>NormalA(CHORDPOINTS);
     QVector<Vector3d>NormalB(CHORDPOINTS);
     QVector<Vector3d>PtBotLeft( CHORDPOINTS);
@@ -1522,277 +1559,275 @@ void gl3dXflView::glMakeWingSurface(Wing const *pWing, Body const *pBody, QOpenG
 
     double leftU(0), rightU(1);
 
-    int stride = 8; //3 vertex components, 3 normal components, 2 texture components
-    int nTriangles = pWing->m_Surface.count()
-            *2                          // top and bottom
-            *(CHORDPOINTS-1)            // quad count
-            *2;                         // 2 triangles/quad
-    //tip patches
-    nTriangles += 2* (CHORDPOINTS-1) * 2; // four triangles are null, but who cares? Not OpenGL
-    int buffersize = nTriangles
-                    *3                          // 3 vertices /triangle
-                    *stride;
-    QVector<float>SurfaceVA(buffersize);
-
+    int iv=0;
+    Surface const &surf = pWing->m_Surface.at(jSurf);
 
-    N.set(0.0, 0.0, 0.0);
-    int ivs=0; //index of surface vertex components
+    //top surface
+    surf.getSidePoints(xfl::TOPSURFACE, pBody, PtTopLeft, PtTopRight, NormalA, NormalB, CHORDPOINTS);
+    pWing->getTextureUV(jSurf, leftV.data(), rightV.data(), leftU, rightU, CHORDPOINTS);
 
-    //SURFACE
-    for (int j=0; j<pWing->m_Surface.size(); j++)
+    for(int l=0; l<CHORDPOINTS-1; l++)
     {
-        Surface const &surf = pWing->m_Surface.at(j);
+        // first triangle
+        pVA[iv++] = PtTopLeft.at(l).xf();
+        pVA[iv++] = PtTopLeft.at(l).yf();
+        pVA[iv++] = PtTopLeft.at(l).zf();
+        pVA[iv++] = NormalA.at(l).xf();
+        pVA[iv++] = NormalA.at(l).yf();
+        pVA[iv++] = NormalA.at(l).zf();
+        pVA[iv++] = leftU;
+        pVA[iv++] = leftV.at(l);
+
+        pVA[iv++] = PtTopLeft.at(l+1).xf();
+        pVA[iv++] = PtTopLeft.at(l+1).yf();
+        pVA[iv++] = PtTopLeft.at(l+1).zf();
+        pVA[iv++] = NormalA.at(l+1).xf();
+        pVA[iv++] = NormalA.at(l+1).yf();
+        pVA[iv++] = NormalA.at(l+1).zf();
+        pVA[iv++] = leftU;
+        pVA[iv++] = leftV.at(l+1);
+
+        pVA[iv++] = PtTopRight.at(l).xf();
+        pVA[iv++] = PtTopRight.at(l).yf();
+        pVA[iv++] = PtTopRight.at(l).zf();
+        pVA[iv++] = NormalB.at(l).xf();
+        pVA[iv++] = NormalA.at(l).yf();
+        pVA[iv++] = NormalB.at(l).zf();
+        pVA[iv++] = rightU;
+        pVA[iv++] = rightV.at(l);
+
+        // second triangle
+        pVA[iv++] = PtTopLeft.at(l+1).xf();
+        pVA[iv++] = PtTopLeft.at(l+1).yf();
+        pVA[iv++] = PtTopLeft.at(l+1).zf();
+        pVA[iv++] = NormalA.at(l+1).xf();
+        pVA[iv++] = NormalA.at(l+1).yf();
+        pVA[iv++] = NormalA.at(l+1).zf();
+        pVA[iv++] = leftU;
+        pVA[iv++] = leftV.at(l+1);
+
+        pVA[iv++] = PtTopRight.at(l+1).xf();
+        pVA[iv++] = PtTopRight.at(l+1).yf();
+        pVA[iv++] = PtTopRight.at(l+1).zf();
+        pVA[iv++] = NormalB.at(l+1).xf();
+        pVA[iv++] = NormalB.at(l+1).yf();
+        pVA[iv++] = NormalB.at(l+1).zf();
+        pVA[iv++] = rightU;
+        pVA[iv++] = rightV.at(l+1);
+
+        pVA[iv++] = PtTopRight.at(l).xf();
+        pVA[iv++] = PtTopRight.at(l).yf();
+        pVA[iv++] = PtTopRight.at(l).zf();
+        pVA[iv++] = NormalB.at(l).xf();
+        pVA[iv++] = NormalA.at(l).yf();
+        pVA[iv++] = NormalB.at(l).zf();
+        pVA[iv++] = rightU;
+        pVA[iv++] = rightV.at(l);
+    }
 
-        //top surface
-        surf.getSidePoints(xfl::TOPSURFACE, pBody, PtTopLeft, PtTopRight, NormalA, NormalB, CHORDPOINTS);
-        pWing->getTextureUV(j, leftV.data(), rightV.data(), leftU, rightU, CHORDPOINTS);
+    //bottom surface
+    surf.getSidePoints(xfl::BOTSURFACE, pBody, PtBotLeft, PtBotRight, NormalA, NormalB, CHORDPOINTS);
+    pWing->getTextureUV(jSurf, leftV.data(), rightV.data(), leftU, rightU, CHORDPOINTS);
+
+    for(int l=0; l<CHORDPOINTS-1; l++)
+    {
+        // first triangle
+        pVA[iv++] = PtBotLeft.at(l).xf();
+        pVA[iv++] = PtBotLeft.at(l).yf();
+        pVA[iv++] = PtBotLeft.at(l).zf();
+        pVA[iv++] = NormalA.at(l).xf();
+        pVA[iv++] = NormalA.at(l).yf();
+        pVA[iv++] = NormalA.at(l).zf();
+        pVA[iv++] = leftU;
+        pVA[iv++] = leftV.at(l);
+
+        pVA[iv++] = PtBotRight.at(l).xf();
+        pVA[iv++] = PtBotRight.at(l).yf();
+        pVA[iv++] = PtBotRight.at(l).zf();
+        pVA[iv++] = NormalB.at(l).xf();
+        pVA[iv++] = NormalA.at(l).yf();
+        pVA[iv++] = NormalB.at(l).zf();
+        pVA[iv++] = rightU;
+        pVA[iv++] = rightV.at(l);
+
+        pVA[iv++] = PtBotLeft.at(l+1).xf();
+        pVA[iv++] = PtBotLeft.at(l+1).yf();
+        pVA[iv++] = PtBotLeft.at(l+1).zf();
+        pVA[iv++] = NormalA.at(l+1).xf();
+        pVA[iv++] = NormalA.at(l+1).yf();
+        pVA[iv++] = NormalA.at(l+1).zf();
+        pVA[iv++] = leftU;
+        pVA[iv++] = leftV.at(l+1);
+
+        // second triangle
+        pVA[iv++] = PtBotLeft.at(l+1).xf();
+        pVA[iv++] = PtBotLeft.at(l+1).yf();
+        pVA[iv++] = PtBotLeft.at(l+1).zf();
+        pVA[iv++] = NormalA.at(l+1).xf();
+        pVA[iv++] = NormalA.at(l+1).yf();
+        pVA[iv++] = NormalA.at(l+1).zf();
+        pVA[iv++] = leftU;
+        pVA[iv++] = leftV.at(l+1);
+
+        pVA[iv++] = PtBotRight.at(l).xf();
+        pVA[iv++] = PtBotRight.at(l).yf();
+        pVA[iv++] = PtBotRight.at(l).zf();
+        pVA[iv++] = NormalB.at(l).xf();
+        pVA[iv++] = NormalA.at(l).yf();
+        pVA[iv++] = NormalB.at(l).zf();
+        pVA[iv++] = rightU;
+        pVA[iv++] = rightV.at(l);
+
+        pVA[iv++] = PtBotRight.at(l+1).xf();
+        pVA[iv++] = PtBotRight.at(l+1).yf();
+        pVA[iv++] = PtBotRight.at(l+1).zf();
+        pVA[iv++] = NormalB.at(l+1).xf();
+        pVA[iv++] = NormalB.at(l+1).yf();
+        pVA[iv++] = NormalB.at(l+1).zf();
+        pVA[iv++] = rightU;
+        pVA[iv++] = rightV.at(l+1);
+    }
 
+    if(surf.isTipLeft())
+    {
         for(int l=0; l<CHORDPOINTS-1; l++)
         {
             // first triangle
-            SurfaceVA[ivs++] = PtTopLeft.at(l).xf();
-            SurfaceVA[ivs++] = PtTopLeft.at(l).yf();
-            SurfaceVA[ivs++] = PtTopLeft.at(l).zf();
-            SurfaceVA[ivs++] = NormalA.at(l).xf();
-            SurfaceVA[ivs++] = NormalA.at(l).yf();
-            SurfaceVA[ivs++] = NormalA.at(l).zf();
-            SurfaceVA[ivs++] = leftU;
-            SurfaceVA[ivs++] = leftV.at(l);
-
-            SurfaceVA[ivs++] = PtTopLeft.at(l+1).xf();
-            SurfaceVA[ivs++] = PtTopLeft.at(l+1).yf();
-            SurfaceVA[ivs++] = PtTopLeft.at(l+1).zf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).xf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).yf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).zf();
-            SurfaceVA[ivs++] = leftU;
-            SurfaceVA[ivs++] = leftV.at(l+1);
-
-            SurfaceVA[ivs++] = PtTopRight.at(l).xf();
-            SurfaceVA[ivs++] = PtTopRight.at(l).yf();
-            SurfaceVA[ivs++] = PtTopRight.at(l).zf();
-            SurfaceVA[ivs++] = NormalB.at(l).xf();
-            SurfaceVA[ivs++] = NormalA.at(l).yf();
-            SurfaceVA[ivs++] = NormalB.at(l).zf();
-            SurfaceVA[ivs++] = rightU;
-            SurfaceVA[ivs++] = rightV.at(l);
+            pVA[iv++] = PtBotLeft.at(l).xf();
+            pVA[iv++] = PtBotLeft.at(l).yf();
+            pVA[iv++] = PtBotLeft.at(l).zf();
+            pVA[iv++] = NormalA.at(l).xf();
+            pVA[iv++] = NormalA.at(l).yf();
+            pVA[iv++] = NormalA.at(l).zf();
+            pVA[iv++] = leftU;
+            pVA[iv++] = leftV.at(l);
+
+            pVA[iv++] = PtBotLeft.at(l+1).xf();
+            pVA[iv++] = PtBotLeft.at(l+1).yf();
+            pVA[iv++] = PtBotLeft.at(l+1).zf();
+            pVA[iv++] = NormalA.at(l).xf();
+            pVA[iv++] = NormalA.at(l).yf();
+            pVA[iv++] = NormalA.at(l).zf();
+            pVA[iv++] = leftU;
+            pVA[iv++] = leftV.at(l);
+
+            pVA[iv++] = PtTopLeft.at(l).xf();
+            pVA[iv++] = PtTopLeft.at(l).yf();
+            pVA[iv++] = PtTopLeft.at(l).zf();
+            pVA[iv++] = -NormalA.at(l).xf();
+            pVA[iv++] = -NormalA.at(l).yf();
+            pVA[iv++] = -NormalA.at(l).zf();
+            pVA[iv++] = leftU;
+            pVA[iv++] = leftV.at(l);
 
             // second triangle
-            SurfaceVA[ivs++] = PtTopLeft.at(l+1).xf();
-            SurfaceVA[ivs++] = PtTopLeft.at(l+1).yf();
-            SurfaceVA[ivs++] = PtTopLeft.at(l+1).zf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).xf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).yf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).zf();
-            SurfaceVA[ivs++] = leftU;
-            SurfaceVA[ivs++] = leftV.at(l+1);
-
-            SurfaceVA[ivs++] = PtTopRight.at(l+1).xf();
-            SurfaceVA[ivs++] = PtTopRight.at(l+1).yf();
-            SurfaceVA[ivs++] = PtTopRight.at(l+1).zf();
-            SurfaceVA[ivs++] = NormalB.at(l+1).xf();
-            SurfaceVA[ivs++] = NormalB.at(l+1).yf();
-            SurfaceVA[ivs++] = NormalB.at(l+1).zf();
-            SurfaceVA[ivs++] = rightU;
-            SurfaceVA[ivs++] = rightV.at(l+1);
-
-            SurfaceVA[ivs++] = PtTopRight.at(l).xf();
-            SurfaceVA[ivs++] = PtTopRight.at(l).yf();
-            SurfaceVA[ivs++] = PtTopRight.at(l).zf();
-            SurfaceVA[ivs++] = NormalB.at(l).xf();
-            SurfaceVA[ivs++] = NormalA.at(l).yf();
-            SurfaceVA[ivs++] = NormalB.at(l).zf();
-            SurfaceVA[ivs++] = rightU;
-            SurfaceVA[ivs++] = rightV.at(l);
+            pVA[iv++] = PtTopLeft.at(l).xf();
+            pVA[iv++] = PtTopLeft.at(l).yf();
+            pVA[iv++] = PtTopLeft.at(l).zf();
+            pVA[iv++] = -NormalA.at(l).xf();
+            pVA[iv++] = -NormalA.at(l).yf();
+            pVA[iv++] = -NormalA.at(l).zf();
+            pVA[iv++] = leftU;
+            pVA[iv++] = leftV.at(l);
+
+            pVA[iv++] = PtBotLeft.at(l+1).xf();
+            pVA[iv++] = PtBotLeft.at(l+1).yf();
+            pVA[iv++] = PtBotLeft.at(l+1).zf();
+            pVA[iv++] = NormalA.at(l).xf();
+            pVA[iv++] = NormalA.at(l).yf();
+            pVA[iv++] = NormalA.at(l).zf();
+            pVA[iv++] = leftU;
+            pVA[iv++] = leftV.at(l);
+
+            pVA[iv++] = PtTopLeft.at(l+1).xf();
+            pVA[iv++] = PtTopLeft.at(l+1).yf();
+            pVA[iv++] = PtTopLeft.at(l+1).zf();
+            pVA[iv++] = -NormalA.at(l).xf();
+            pVA[iv++] = -NormalA.at(l).yf();
+            pVA[iv++] = -NormalA.at(l).zf();
+            pVA[iv++] = leftU;
+            pVA[iv++] = leftV.at(l);
         }
+    }
 
-        //bottom surface
-        surf.getSidePoints(xfl::BOTSURFACE, pBody, PtBotLeft, PtBotRight, NormalA, NormalB, CHORDPOINTS);
-        pWing->getTextureUV(j, leftV.data(), rightV.data(), leftU, rightU, CHORDPOINTS);
-
+    if(surf.isTipRight())
+    {
         for(int l=0; l<CHORDPOINTS-1; l++)
         {
             // first triangle
-            SurfaceVA[ivs++] = PtBotLeft.at(l).xf();
-            SurfaceVA[ivs++] = PtBotLeft.at(l).yf();
-            SurfaceVA[ivs++] = PtBotLeft.at(l).zf();
-            SurfaceVA[ivs++] = NormalA.at(l).xf();
-            SurfaceVA[ivs++] = NormalA.at(l).yf();
-            SurfaceVA[ivs++] = NormalA.at(l).zf();
-            SurfaceVA[ivs++] = leftU;
-            SurfaceVA[ivs++] = leftV.at(l);
-
-            SurfaceVA[ivs++] = PtBotRight.at(l).xf();
-            SurfaceVA[ivs++] = PtBotRight.at(l).yf();
-            SurfaceVA[ivs++] = PtBotRight.at(l).zf();
-            SurfaceVA[ivs++] = NormalB.at(l).xf();
-            SurfaceVA[ivs++] = NormalA.at(l).yf();
-            SurfaceVA[ivs++] = NormalB.at(l).zf();
-            SurfaceVA[ivs++] = rightU;
-            SurfaceVA[ivs++] = rightV.at(l);
-
-            SurfaceVA[ivs++] = PtBotLeft.at(l+1).xf();
-            SurfaceVA[ivs++] = PtBotLeft.at(l+1).yf();
-            SurfaceVA[ivs++] = PtBotLeft.at(l+1).zf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).xf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).yf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).zf();
-            SurfaceVA[ivs++] = leftU;
-            SurfaceVA[ivs++] = leftV.at(l+1);
+            pVA[iv++] = PtBotRight.at(l).xf();
+            pVA[iv++] = PtBotRight.at(l).yf();
+            pVA[iv++] = PtBotRight.at(l).zf();
+            pVA[iv++] = NormalB.at(l).xf();
+            pVA[iv++] = NormalB.at(l).yf();
+            pVA[iv++] = NormalB.at(l).zf();
+            pVA[iv++] = rightU;
+            pVA[iv++] = rightV.at(l);
+
+            pVA[iv++] = PtTopRight.at(l).xf();
+            pVA[iv++] = PtTopRight.at(l).yf();
+            pVA[iv++] = PtTopRight.at(l).zf();
+            pVA[iv++] = -NormalB.at(l).xf();
+            pVA[iv++] = -NormalB.at(l).yf();
+            pVA[iv++] = -NormalB.at(l).zf();
+            pVA[iv++] = rightU;
+            pVA[iv++] = rightV.at(l);
+
+            pVA[iv++] = PtBotRight.at(l+1).xf();
+            pVA[iv++] = PtBotRight.at(l+1).yf();
+            pVA[iv++] = PtBotRight.at(l+1).zf();
+            pVA[iv++] = NormalB.at(l).xf();
+            pVA[iv++] = NormalB.at(l).yf();
+            pVA[iv++] = NormalB.at(l).zf();
+            pVA[iv++] = rightU;
+            pVA[iv++] = rightV.at(l);
 
             // second triangle
-            SurfaceVA[ivs++] = PtBotLeft.at(l+1).xf();
-            SurfaceVA[ivs++] = PtBotLeft.at(l+1).yf();
-            SurfaceVA[ivs++] = PtBotLeft.at(l+1).zf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).xf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).yf();
-            SurfaceVA[ivs++] = NormalA.at(l+1).zf();
-            SurfaceVA[ivs++] = leftU;
-            SurfaceVA[ivs++] = leftV.at(l+1);
-
-            SurfaceVA[ivs++] = PtBotRight.at(l).xf();
-            SurfaceVA[ivs++] = PtBotRight.at(l).yf();
-            SurfaceVA[ivs++] = PtBotRight.at(l).zf();
-            SurfaceVA[ivs++] = NormalB.at(l).xf();
-            SurfaceVA[ivs++] = NormalA.at(l).yf();
-            SurfaceVA[ivs++] = NormalB.at(l).zf();
-            SurfaceVA[ivs++] = rightU;
-            SurfaceVA[ivs++] = rightV.at(l);
-
-            SurfaceVA[ivs++] = PtBotRight.at(l+1).xf();
-            SurfaceVA[ivs++] = PtBotRight.at(l+1).yf();
-            SurfaceVA[ivs++] = PtBotRight.at(l+1).zf();
-            SurfaceVA[ivs++] = NormalB.at(l+1).xf();
-            SurfaceVA[ivs++] = NormalB.at(l+1).yf();
-            SurfaceVA[ivs++] = NormalB.at(l+1).zf();
-            SurfaceVA[ivs++] = rightU;
-            SurfaceVA[ivs++] = rightV.at(l+1);
+            pVA[iv++] = PtTopRight.at(l).xf();
+            pVA[iv++] = PtTopRight.at(l).yf();
+            pVA[iv++] = PtTopRight.at(l).zf();
+            pVA[iv++] = -NormalB.at(l).xf();
+            pVA[iv++] = -NormalB.at(l).yf();
+            pVA[iv++] = -NormalB.at(l).zf();
+            pVA[iv++] = rightU;
+            pVA[iv++] = rightV.at(l);
+
+            pVA[iv++] = PtTopRight.at(l+1).xf();
+            pVA[iv++] = PtTopRight.at(l+1).yf();
+            pVA[iv++] = PtTopRight.at(l+1).zf();
+            pVA[iv++] = -NormalB.at(l).xf();
+            pVA[iv++] = -NormalB.at(l).yf();
+            pVA[iv++] = -NormalB.at(l).zf();
+            pVA[iv++] = rightU;
+            pVA[iv++] = rightV.at(l);
+
+            pVA[iv++] = PtBotRight.at(l+1).xf();
+            pVA[iv++] = PtBotRight.at(l+1).yf();
+            pVA[iv++] = PtBotRight.at(l+1).zf();
+            pVA[iv++] = NormalB.at(l).xf();
+            pVA[iv++] = NormalB.at(l).yf();
+            pVA[iv++] = NormalB.at(l).zf();
+            pVA[iv++] = rightU;
+            pVA[iv++] = rightV.at(l);
         }
+    }
 
-        if(surf.isTipLeft())
-        {
-            for(int l=0; l<CHORDPOINTS-1; l++)
-            {
-                // first triangle
-                SurfaceVA[ivs++] = PtBotLeft.at(l).xf();
-                SurfaceVA[ivs++] = PtBotLeft.at(l).yf();
-                SurfaceVA[ivs++] = PtBotLeft.at(l).zf();
-                SurfaceVA[ivs++] = NormalA.at(l).xf();
-                SurfaceVA[ivs++] = NormalA.at(l).yf();
-                SurfaceVA[ivs++] = NormalA.at(l).zf();
-                SurfaceVA[ivs++] = leftU;
-                SurfaceVA[ivs++] = leftV.at(l);
-
-                SurfaceVA[ivs++] = PtBotLeft.at(l+1).xf();
-                SurfaceVA[ivs++] = PtBotLeft.at(l+1).yf();
-                SurfaceVA[ivs++] = PtBotLeft.at(l+1).zf();
-                SurfaceVA[ivs++] = NormalA.at(l).xf();
-                SurfaceVA[ivs++] = NormalA.at(l).yf();
-                SurfaceVA[ivs++] = NormalA.at(l).zf();
-                SurfaceVA[ivs++] = leftU;
-                SurfaceVA[ivs++] = leftV.at(l);
-
-                SurfaceVA[ivs++] = PtTopLeft.at(l).xf();
-                SurfaceVA[ivs++] = PtTopLeft.at(l).yf();
-                SurfaceVA[ivs++] = PtTopLeft.at(l).zf();
-                SurfaceVA[ivs++] = -NormalA.at(l).xf();
-                SurfaceVA[ivs++] = -NormalA.at(l).yf();
-                SurfaceVA[ivs++] = -NormalA.at(l).zf();
-                SurfaceVA[ivs++] = leftU;
-                SurfaceVA[ivs++] = leftV.at(l);
-
-                // second triangle
-                SurfaceVA[ivs++] = PtTopLeft.at(l).xf();
-                SurfaceVA[ivs++] = PtTopLeft.at(l).yf();
-                SurfaceVA[ivs++] = PtTopLeft.at(l).zf();
-                SurfaceVA[ivs++] = -NormalA.at(l).xf();
-                SurfaceVA[ivs++] = -NormalA.at(l).yf();
-                SurfaceVA[ivs++] = -NormalA.at(l).zf();
-                SurfaceVA[ivs++] = leftU;
-                SurfaceVA[ivs++] = leftV.at(l);
-
-                SurfaceVA[ivs++] = PtBotLeft.at(l+1).xf();
-                SurfaceVA[ivs++] = PtBotLeft.at(l+1).yf();
-                SurfaceVA[ivs++] = PtBotLeft.at(l+1).zf();
-                SurfaceVA[ivs++] = NormalA.at(l).xf();
-                SurfaceVA[ivs++] = NormalA.at(l).yf();
-                SurfaceVA[ivs++] = NormalA.at(l).zf();
-                SurfaceVA[ivs++] = leftU;
-                SurfaceVA[ivs++] = leftV.at(l);
-
-                SurfaceVA[ivs++] = PtTopLeft.at(l+1).xf();
-                SurfaceVA[ivs++] = PtTopLeft.at(l+1).yf();
-                SurfaceVA[ivs++] = PtTopLeft.at(l+1).zf();
-                SurfaceVA[ivs++] = -NormalA.at(l).xf();
-                SurfaceVA[ivs++] = -NormalA.at(l).yf();
-                SurfaceVA[ivs++] = -NormalA.at(l).zf();
-                SurfaceVA[ivs++] = leftU;
-                SurfaceVA[ivs++] = leftV.at(l);
-            }
-        }
+    return iv;
+}
 
-        if(surf.isTipRight())
-        {
-            for(int l=0; l<CHORDPOINTS-1; l++)
-            {
-                // first triangle
-                SurfaceVA[ivs++] = PtBotRight.at(l).xf();
-                SurfaceVA[ivs++] = PtBotRight.at(l).yf();
-                SurfaceVA[ivs++] = PtBotRight.at(l).zf();
-                SurfaceVA[ivs++] = NormalB.at(l).xf();
-                SurfaceVA[ivs++] = NormalB.at(l).yf();
-                SurfaceVA[ivs++] = NormalB.at(l).zf();
-                SurfaceVA[ivs++] = rightU;
-                SurfaceVA[ivs++] = rightV.at(l);
-
-                SurfaceVA[ivs++] = PtTopRight.at(l).xf();
-                SurfaceVA[ivs++] = PtTopRight.at(l).yf();
-                SurfaceVA[ivs++] = PtTopRight.at(l).zf();
-                SurfaceVA[ivs++] = -NormalB.at(l).xf();
-                SurfaceVA[ivs++] = -NormalB.at(l).yf();
-                SurfaceVA[ivs++] = -NormalB.at(l).zf();
-                SurfaceVA[ivs++] = rightU;
-                SurfaceVA[ivs++] = rightV.at(l);
-
-                SurfaceVA[ivs++] = PtBotRight.at(l+1).xf();
-                SurfaceVA[ivs++] = PtBotRight.at(l+1).yf();
-                SurfaceVA[ivs++] = PtBotRight.at(l+1).zf();
-                SurfaceVA[ivs++] = NormalB.at(l).xf();
-                SurfaceVA[ivs++] = NormalB.at(l).yf();
-                SurfaceVA[ivs++] = NormalB.at(l).zf();
-                SurfaceVA[ivs++] = rightU;
-                SurfaceVA[ivs++] = rightV.at(l);
-
-                // second triangle
-                SurfaceVA[ivs++] = PtTopRight.at(l).xf();
-                SurfaceVA[ivs++] = PtTopRight.at(l).yf();
-                SurfaceVA[ivs++] = PtTopRight.at(l).zf();
-                SurfaceVA[ivs++] = -NormalB.at(l).xf();
-                SurfaceVA[ivs++] = -NormalB.at(l).yf();
-                SurfaceVA[ivs++] = -NormalB.at(l).zf();
-                SurfaceVA[ivs++] = rightU;
-                SurfaceVA[ivs++] = rightV.at(l);
-
-                SurfaceVA[ivs++] = PtTopRight.at(l+1).xf();
-                SurfaceVA[ivs++] = PtTopRight.at(l+1).yf();
-                SurfaceVA[ivs++] = PtTopRight.at(l+1).zf();
-                SurfaceVA[ivs++] = -NormalB.at(l).xf();
-                SurfaceVA[ivs++] = -NormalB.at(l).yf();
-                SurfaceVA[ivs++] = -NormalB.at(l).zf();
-                SurfaceVA[ivs++] = rightU;
-                SurfaceVA[ivs++] = rightV.at(l);
-
-                SurfaceVA[ivs++] = PtBotRight.at(l+1).xf();
-                SurfaceVA[ivs++] = PtBotRight.at(l+1).yf();
-                SurfaceVA[ivs++] = PtBotRight.at(l+1).zf();
-                SurfaceVA[ivs++] = NormalB.at(l).xf();
-                SurfaceVA[ivs++] = NormalB.at(l).yf();
-                SurfaceVA[ivs++] = NormalB.at(l).zf();
-                SurfaceVA[ivs++] = rightU;
-                SurfaceVA[ivs++] = rightV.at(l);
-            }
-        }
 
+void gl3dXflView::glMakeWingSurface(Wing const *pWing, Body const *pBody, QOpenGLBuffer &vboSurf) const
+{
+    int buffersize = 0;
+    for (int j=0; j<pWing->m_Surface.size(); j++)
+        buffersize += wingSurfaceVertexSize(pWing->m_Surface.at(j));
+
+    QVector<float>SurfaceVA(buffersize);
+
+    int ivs=0; //index of surface vertex components
+    for (int j=0; j<pWing->m_Surface.size(); j++)
+    {
+        ivs += glMakeWingSurfaceVertices(pWing, pBody, j, SurfaceVA.data()+ivs);
     }
     Q_ASSERT(ivs==buffersize);
 
@@ -1804,3 +1839,37 @@ void gl3dXflView::glMakeWingSurface(Wing const *pWing, Body const *pBody, QOpenG
 }
 
 
+/**
+ * Rewrites in place the sub-ranges of the surface buffer which belong to the listed surfaces.
+ * @return false if the layout of the buffer does not match the wing's surfaces anymore, in which case the buffer needs to be rebuilt
+ */
+bool gl3dXflView::glUpdateWingSurface(Wing const *pWing, Body const *pBody, QVector<int> const &surfaces, QOpenGLBuffer &vboSurf) const
+{
+    if(!vboSurf.isCreated()) return false;
+
+    QVector<int> offset(pWing->m_Surface.size()+1);
+    offset[0] = 0;
+    for (int j=0; j<pWing->m_Surface.size(); j++)
+        offset[j+1] = offset.at(j) + wingSurfaceVertexSize(pWing->m_Surface.at(j));
+
+    vboSurf.bind();
+    if(vboSurf.size() != offset.last()*int(sizeof(GLfloat)))
+    {
+        vboSurf.release();
+        return false;
+    }
+
+    QVector<float> SurfaceVA;
+    for(int i=0; i<surfaces.size(); i++)
+    {
+        int j = surfaces.at(i);
+        if(j<0 || j>=pWing->m_Surface.size()) continue;
+        SurfaceVA.resize(offset.at(j+1)-offset.at(j));
+        glMakeWingSurfaceVertices(pWing, pBody, j, SurfaceVA.data());
+        vboSurf.write(offset.at(j)*int(sizeof(GLfloat)), SurfaceVA.constData(), SurfaceVA.size()*int(sizeof(GLfloat)));
+    }
+    vboSurf.release();
+    return true;
+}
+
+
@@ -34,6 +34,7 @@ class WingOpp;
 class WPolar;
 class PlaneOpp;
 class Panel;
+class Surface;
 class PointMass;
 
 class gl3dXflView : public gl3dView
@@ -56,13 +57,15 @@ class gl3dXflView : public gl3dView
         void glMakeWingEditMesh(QOpenGLBuffer &vbo, const Wing *pWing);
         void glMakeFuseFlatPanels(const Body *pBody);
         void glMakeFuseFlatPanelsOutline(const Body *pBody);
-        void glMakeFuseSplines(Body const *pBody);
-        void glMakeFuseSplinesOutline(const Body *pBody);
+        void glMakeFuseSplines(Body const *pBody, Vector3d const &pos=Vector3d());
+        void glMakeFuseSplinesOutline(const Body *pBody, Vector3d const &pos=Vector3d());
         void glMakeBodyFrameHighlight(Body const *pBody, Vector3d const&bodyPos, int iFrame);
         void glMakeEditBodyMesh(Body *pBody, const Vector3d &pos);
 
         void glMakeWingSurface(Wing const *pWing, Body const *pBody, QOpenGLBuffer &vboSurf) const;
         void glMakeWingOutline(Wing const *pWing, Body const *pBody, QOpenGLBuffer &vboOutline) const;
+        bool glUpdateWingSurface(Wing const *pWing, Body const *pBody, QVector<int> const &surfaces, QOpenGLBuffer &vboSurf) const;
+        bool glUpdateWingOutline(Wing const *pWing, Body const *pBody, QVector<int> const &surfaces, QOpenGLBuffer &vboOutline) const;
 
         void paintMasses(double volumeMass, const Vector3d &pos, const QString &tag, const QVector<PointMass> &ptMasses);
         void paintMasses(double volumeMass, Vector3d const&pos, QString const&tag, QVector<PointMass *> const &ptMasses);
@@ -77,6 +80,11 @@ class gl3dXflView : public gl3dView
     private:
         void enterEvent(QEvent *pEvent) override;
 
+        int wingSurfaceVertexSize(Surface const &surf) const;
+        int wingOutlineVertexSize(Surface const &surf) const;
+        int glMakeWingSurfaceVertices(Wing const *pWing, Body const *pBody, int jSurf, float *pVA) const;
+        int glMakeWingOutlineVertices(Wing const *pWing, Body const *pBody, int jSurf, float *pVA) const;
+
     protected slots:
         void onSurfaces(  bool bChecked);
         void onPanels(    bool bChecked);
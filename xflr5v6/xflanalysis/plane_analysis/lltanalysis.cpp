@@ -20,6 +20,10 @@
 *****************************************************************************/
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFutureSynchronizer>
+#include <QThread>
+#include <QtConcurrent/QtConcurrent>
 
 #include <QtDebug>
 #include <QString>
@@ -36,6 +40,10 @@ int LLTAnalysis::s_NLLTStations = 20;
 double LLTAnalysis::s_RelaxMax = 20.0;
 double LLTAnalysis::s_CvPrec = 0.01;
 bool LLTAnalysis::s_bInitCalc = true;
+bool LLTAnalysis::s_bMultiThread = true;
+bool LLTAnalysis::s_bNewton = false;
+double LLTAnalysis::s_NewtonDelta = 0.5;
+double LLTAnalysis::s_NewtonMaxStep = 5.0;
 
 
 /** The public constructor */
@@ -46,6 +54,8 @@ LLTAnalysis::LLTAnalysis()
     m_pX = m_pY = nullptr;
 
     m_poaPolar = nullptr;
+    m_pParent = nullptr;
+    m_bInitCalc = true;
     resetVariables();
 }
 
@@ -56,6 +66,7 @@ LLTAnalysis::LLTAnalysis()
 void LLTAnalysis::resetVariables()
 {
     m_nPoints = 1;
+    m_nIterations = 0;
     m_bSequence = false;
     m_vMin = m_vMax = m_vDelta = 0.0;
 
@@ -87,6 +98,7 @@ void LLTAnalysis::resetVariables()
     m_mtoUnit = 0.0;
 
     m_QInf0 = 0.0;
+    m_QInfLast = 0.0;
     m_Maxa  = 0.0;
 
     m_CL = 0.0;
@@ -210,6 +222,8 @@ void LLTAnalysis::computeWing(double QInf, double Alpha, QString &ErrorMessage)
     double eta=0, sigma=0;
     double Cm0=0;
 
+    PERF_SCOPE(m_PerfStats, "wing results");
+
     bool bOutRe=false, bError=false;
     bool bPointOutRe=false, bPointOutAlpha=false;
     m_bWingOut = false;
@@ -404,6 +418,8 @@ void LLTAnalysis::setBending(double QInf)
  */
 bool LLTAnalysis::setLinearSolution(double Alpha)
 {
+    PERF_SCOPE(m_PerfStats, "linear solution");
+
     QString strange;
     traceLog("Setting initial linear solution\n");
 
@@ -479,6 +495,26 @@ bool LLTAnalysis::setLinearSolution(double Alpha)
 }
 
 
+/**
+ * Fills the matrix of the Beta factors for the current number of stations.
+ * The factors depend only on the number of stations, and are computed once per geometry
+ * rather than at each iteration.
+ */
+void LLTAnalysis::makeBetaMatrix()
+{
+    int n = m_pWing->m_NStation;
+    m_Beta.resize((n+1)*(n+1));
+    m_Beta.fill(0.0);
+    for (int k=1; k<n; k++)
+    {
+        for (int m=1; m<n; m++)
+        {
+            m_Beta[k*(n+1)+m] = Beta(m,k);
+        }
+    }
+}
+
+
 /** 
  * Calculates the induced angle from the lift coefficient and from the Beta factor
  * @param k
@@ -487,12 +523,59 @@ bool LLTAnalysis::setLinearSolution(double Alpha)
 double LLTAnalysis::AlphaInduced(int k)
 {
     double ai = 0.0;
+    int n = m_pWing->m_NStation;
+    double const *beta = m_Beta.constData() + k*(n+1);
 
-    for (int m=1; m<m_pWing->m_NStation; m++)
+    for (int m=1; m<n; m++)
     {
-        ai += Beta(m,k) * m_Cl[m] * m_Chord[m]/m_pWing->m_PlanformSpan;
+        ai += beta[m] * m_Cl[m] * m_Chord[m];
     }
-    return ai;
+    return ai/m_pWing->m_PlanformSpan;
+}
+
+
+/**
+ * Updates the lift coefficients at the span stations from the current induced angles.
+ * For type 2 polars, updates the freestream velocity and the Reynolds numbers from the total lift.
+ * @return false if the lift is negative in a type 2 polar, true otherwise
+ */
+bool LLTAnalysis::updateCl(double &QInf, double const Alpha)
+{
+    PERF_SCOPE(m_PerfStats, "polar interpolation");
+
+    Foil* pFoil0  = nullptr;
+    Foil* pFoil1  = nullptr;
+    double  yob=0, tau=0;
+    bool bOutRe=false, bError=false;
+
+    double Lift=0.0;// required for Type 2
+    for (int k=1; k<s_NLLTStations; k++)
+    {
+        yob     = cos(k*PI/s_NLLTStations);
+        m_pWing->getFoils(&pFoil0, &pFoil1, yob*m_pWing->m_PlanformSpan/2.0, tau);
+        m_Cl[k] = getCl( pFoil0, pFoil1, m_Re[k], Alpha + m_Ai[k]+ m_Twist[k], tau, bOutRe, bError);
+        if (m_pWPolar->polarType()==xfl::FIXEDLIFTPOLAR)
+        {
+            Lift += Eta(k) * m_Cl[k] * m_Chord[k];
+        }
+    }
+
+    if(m_pWPolar->polarType()==xfl::FIXEDLIFTPOLAR)
+    {
+        Lift *= m_pWing->m_AR / m_pWing->m_PlanformSpan;
+        if(Lift<=0.0)  return false;
+
+        QInf  = m_QInf0 / sqrt(Lift);
+
+        for (int k=1; k<s_NLLTStations; k++)
+        {
+            m_Re[k] = m_Chord[k] * QInf /m_pWPolar->m_Viscosity;
+            yob     = cos(k*PI/s_NLLTStations);
+            m_pWing->getFoils(&pFoil0, &pFoil1, yob*m_pWing->m_PlanformSpan/2.0, tau);
+            m_Cl[k] = getCl(pFoil0, pFoil1, m_Re[k], Alpha + m_Ai[k]+ m_Twist[k], tau, bOutRe, bError);
+        }
+    }
+    return true;
 }
 
 
@@ -504,50 +587,84 @@ double LLTAnalysis::AlphaInduced(int k)
 */
 int LLTAnalysis::iterate(double &QInf, double Alpha)
 {
-    Foil* pFoil0  = nullptr;
-    Foil* pFoil1  = nullptr;
-    double  yob=0, tau=0, anext=0;
-    bool bOutRe=false, bError=false;
+    if(s_bNewton) return iterateNewton(QInf, Alpha);
+
+    double anext=0;
     int iter = 0;
 
     while(iter<s_IterLim)
     {
-        if(m_bCancel) return -1;
+        if(isCancelled()) return -1;
         m_Maxa = 0.0;
 
-        for (int k=1; k<s_NLLTStations; k++)
         {
-            double a = m_Ai[k];
-            anext    = -AlphaInduced(k);
-            m_Ai[k]  = a +(anext-a)/s_RelaxMax;
-            m_Maxa   = qMax(m_Maxa, qAbs(a-anext));
+            PERF_SCOPE(m_PerfStats, "induced angles");
+            for (int k=1; k<s_NLLTStations; k++)
+            {
+                double a = m_Ai[k];
+                anext    = -AlphaInduced(k);
+                m_Ai[k]  = a +(anext-a)/s_RelaxMax;
+                m_Maxa   = qMax(m_Maxa, qAbs(a-anext));
+            }
         }
 
-        double Lift=0.0;// required for Type 2
-        for (int k=1; k<s_NLLTStations; k++)
+        if(!updateCl(QInf, Alpha)) return -1;
+
+        if (m_Maxa<s_CvPrec)
         {
-            yob     = cos(k*PI/s_NLLTStations);
-            m_pWing->getFoils(&pFoil0, &pFoil1, yob*m_pWing->m_PlanformSpan/2.0, tau);
-            m_Cl[k] = getCl( pFoil0, pFoil1, m_Re[k], Alpha + m_Ai[k]+ m_Twist[k], tau, bOutRe, bError);
-            if (m_pWPolar->polarType()==xfl::FIXEDLIFTPOLAR)
-            {
-                Lift += Eta(k) * m_Cl[k] * m_Chord[k];
-            }
+            m_bConverged = true;
+            break;
         }
 
-        if(m_pWPolar->polarType()==xfl::FIXEDLIFTPOLAR)
+        //        if(m_pCurve) m_pCurve->appendPoint(iter, m_Maxa);
+        if(m_pX && m_pY)
         {
-            Lift *= m_pWing->m_AR / m_pWing->m_PlanformSpan;
-            if(Lift<=0.0)  return -1;
+            m_pX->append(double(iter));
+            m_pY->append(m_Maxa);
+        }
+        iter++;
+    }
+    return iter;
+}
 
-            QInf  = m_QInf0 / sqrt(Lift);
 
-            for (int k=1; k<s_NLLTStations; k++)
+/**
+ * Performs the iterations of the non-linear LLT analysis with Newton's method.
+ * The unknowns are the induced angles, and the residual at station k is Ai[k] + AlphaInduced(k).
+ * The jacobian is built from the Beta matrix and from the local slopes of the foil polars,
+ * evaluated by finite difference. The coupling through the Reynolds numbers in type 2 polars is ignored.
+ * If the residual increases, the remaining iterations fall back to the relaxed fixed-point update,
+ * which is slower but more robust beyond the stall.
+ * @param QInf the freestream velocity, in m/s
+ * @param Alpha the angle of attack, in degrees
+ * @return the number of iterations performed, or -1 if the analysis has been user-cancelled
+*/
+int LLTAnalysis::iterateNewton(double &QInf, double Alpha)
+{
+    Foil* pFoil0  = nullptr;
+    Foil* pFoil1  = nullptr;
+    double yob=0, tau=0;
+    bool bOutRe=false, bError=false, bCancel=false;
+
+    int n = s_NLLTStations-1; // the unknowns are m_Ai[1] to m_Ai[n]
+    double span = m_pWing->m_PlanformSpan;
+    QVector<double> jac(n*n), rhs(n), slope(n+1);
+
+    bool bNewtonStep = true;
+    double maxaPrev = 1.e10;
+    int iter = 0;
+
+    while(iter<s_IterLim)
+    {
+        if(isCancelled()) return -1;
+
+        m_Maxa = 0.0;
+        {
+            PERF_SCOPE(m_PerfStats, "induced angles");
+            for (int k=1; k<=n; k++)
             {
-                m_Re[k] = m_Chord[k] * QInf /m_pWPolar->m_Viscosity;
-                yob     = cos(k*PI/s_NLLTStations);
-                m_pWing->getFoils(&pFoil0, &pFoil1, yob*m_pWing->m_PlanformSpan/2.0, tau);
-                m_Cl[k] = getCl(pFoil0, pFoil1, m_Re[k], Alpha + m_Ai[k]+ m_Twist[k], tau, bOutRe, bError);
+                rhs[k-1] = -(m_Ai[k] + AlphaInduced(k));
+                m_Maxa   = qMax(m_Maxa, qAbs(rhs.at(k-1)));
             }
         }
 
@@ -557,7 +674,62 @@ int LLTAnalysis::iterate(double &QInf, double Alpha)
             break;
         }
 
-        //        if(m_pCurve) m_pCurve->appendPoint(iter, m_Maxa);
+        if(bNewtonStep && m_Maxa>maxaPrev)
+        {
+            traceLog("    Newton iterations diverging, switching to relaxed iterations\n");
+            bNewtonStep = false;
+        }
+        maxaPrev = m_Maxa;
+
+        if(bNewtonStep)
+        {
+            PERF_SCOPE(m_PerfStats, "Newton jacobian");
+            // local polar slopes
+            for (int m=1; m<=n; m++)
+            {
+                yob = cos(m*PI/s_NLLTStations);
+                m_pWing->getFoils(&pFoil0, &pFoil1, yob*span/2.0, tau);
+                double cl1 = getCl(pFoil0, pFoil1, m_Re[m], Alpha + m_Ai[m] + m_Twist[m] + s_NewtonDelta, tau, bOutRe, bError);
+                slope[m] = (cl1-m_Cl[m])/s_NewtonDelta;
+            }
+
+            for (int k=1; k<=n; k++)
+            {
+                double const *beta = m_Beta.constData() + k*(m_pWing->m_NStation+1);
+                for (int m=1; m<=n; m++)
+                {
+                    jac[(k-1)*n+(m-1)] = beta[m] * m_Chord[m]/span * slope.at(m);
+                }
+                jac[(k-1)*n+(k-1)] += 1.0;
+            }
+
+            if(!Gauss(jac.data(), n, rhs.data(), 1, &bCancel))
+            {
+                traceLog("    Singular Newton matrix, switching to relaxed iterations\n");
+                bNewtonStep = false;
+            }
+            else
+            {
+                for (int k=1; k<=n; k++)
+                {
+                    m_Ai[k] += std::max(-s_NewtonMaxStep, std::min(rhs.at(k-1), s_NewtonMaxStep));
+                }
+            }
+        }
+
+        if(!bNewtonStep)
+        {
+            PERF_SCOPE(m_PerfStats, "induced angles");
+            for (int k=1; k<=n; k++)
+            {
+                double a = m_Ai[k];
+                double anext = -AlphaInduced(k);
+                m_Ai[k]  = a +(anext-a)/s_RelaxMax;
+            }
+        }
+
+        if(!updateCl(QInf, Alpha)) return -1;
+
         if(m_pX && m_pY)
         {
             m_pX->append(double(iter));
@@ -574,6 +746,8 @@ int LLTAnalysis::iterate(double &QInf, double Alpha)
 */
 void LLTAnalysis::initializeGeom()
 {    
+    PERF_SCOPE(m_PerfStats, "geometry");
+
     m_bWingOut = false;
     m_bConverged = false;
 
@@ -581,6 +755,7 @@ void LLTAnalysis::initializeGeom()
     else                              m_QInf0 = 0.0;
 
     m_pWing->computeChords(s_NLLTStations, m_Chord, m_Offset, m_Twist);
+    makeBetaMatrix();
 
     for (int k=0; k<=s_NLLTStations; k++)
     {
@@ -602,24 +777,118 @@ void LLTAnalysis::initializeGeom()
 
 
 bool LLTAnalysis::loop()
+{
+    m_bInitCalc = s_bInitCalc;
+    m_QInfLast = m_pWPolar->m_QInfSpec;
+
+    int nBlocks = std::min(m_nPoints+1, QThread::idealThreadCount());
+    bool bResult = (s_bMultiThread && nBlocks>1) ? parallelLoop(nBlocks) : loopRange(0, m_nPoints);
+
+    // the velocity of a type 2 polar is kept for the next sweep
+    m_pWPolar->m_QInfSpec = m_QInfLast;
+    return bResult;
+}
+
+
+bool LLTAnalysis::loopRange(int i0, int i1)
 {
     if (m_pWPolar->polarType()!=xfl::FIXEDAOAPOLAR)
     {
-        return alphaLoop();
+        return alphaLoop(i0, i1);
     }
     else
     {
-        return QInfLoop();
+        return QInfLoop(i0, i1);
     }
 }
 
 
+/**
+ * Splits the sweep in contiguous blocks of operating points, and solves the blocks concurrently.
+ * Each block is solved by a worker instance with its own working arrays. Within a block, each point is
+ * initialized with the solution of the previous converged point, as in the sequential loop.
+ * The first block starts from the current solution; the others start from the linear solution.
+ * Only the first block feeds the iteration curve, since the others would overwrite it concurrently.
+ * Once all blocks have been solved, the operating points are stored in sequence order.
+ */
+bool LLTAnalysis::parallelLoop(int nBlocks)
+{
+    QVector<LLTAnalysis*> workers(nBlocks);
+    QFutureSynchronizer<bool> futureSync;
+    for(int ib=0; ib<nBlocks; ib++)
+    {
+        int i0 = (ib*(m_nPoints+1))/nBlocks;
+        int i1 = ((ib+1)*(m_nPoints+1))/nBlocks - 1;
+
+        workers[ib] = new LLTAnalysis;
+        workers[ib]->initializeWorker(this);
+        if(ib==0) workers[ib]->setCurvePointers(m_pX, m_pY);
+        else      workers[ib]->m_bInitCalc = true;
+        futureSync.addFuture(QtConcurrent::run(workers[ib], &LLTAnalysis::loopRange, i0, i1));
+    }
+    futureSync.waitForFinished();
+
+    for(int ib=0; ib<nBlocks; ib++)
+    {
+        LLTAnalysis *pWorker = workers.at(ib);
+        traceLog(pWorker->m_Log);
+        for(int ip=0; ip<pWorker->m_PlaneOppList.size(); ip++)
+        {
+            PlaneOpp *pPOpp = pWorker->m_PlaneOppList.at(ip);
+            storeInPolar(pPOpp);
+            m_PlaneOppList.append(pPOpp);
+        }
+        m_bError   = m_bError   || pWorker->m_bError;
+        m_bWarning = m_bWarning || pWorker->m_bWarning;
+        m_nIterations += pWorker->m_nIterations;
+        if(pWorker->m_PlaneOppList.size()) m_QInfLast = pWorker->m_QInfLast;
+#ifdef XFL_PERFSTATS
+        m_PerfStats.merge(pWorker->m_PerfStats);
+#endif
+    }
+
+    qDeleteAll(workers);
+    return true;
+}
+
+
+/**
+ * Copies the analysis data and the geometry from the parent analysis, so that this instance can solve a block of the parent's sweep.
+ * The wing is only read during the iterations, so that it can be shared by the workers.
+ */
+void LLTAnalysis::initializeWorker(LLTAnalysis const *pParent)
+{
+    m_pParent   = pParent;
+    m_pPlane    = pParent->m_pPlane;
+    m_pWing     = pParent->m_pWing;
+    m_pWPolar   = pParent->m_pWPolar;
+    m_poaPolar  = pParent->m_poaPolar;
+
+    m_vMin      = pParent->m_vMin;
+    m_vMax      = pParent->m_vMax;
+    m_vDelta    = pParent->m_vDelta;
+    m_nPoints   = pParent->m_nPoints;
+    m_bSequence = pParent->m_bSequence;
+    m_bInitCalc = pParent->m_bInitCalc;
+
+    m_QInf0     = pParent->m_QInf0;
+    m_QInfLast  = pParent->m_QInfLast;
+    m_Beta      = pParent->m_Beta;
+    memcpy(m_Chord,     pParent->m_Chord,     sizeof(m_Chord));
+    memcpy(m_Offset,    pParent->m_Offset,    sizeof(m_Offset));
+    memcpy(m_Twist,     pParent->m_Twist,     sizeof(m_Twist));
+    memcpy(m_SpanPos,   pParent->m_SpanPos,   sizeof(m_SpanPos));
+    memcpy(m_StripArea, pParent->m_StripArea, sizeof(m_StripArea));
+    memcpy(m_Ai,        pParent->m_Ai,        sizeof(m_Ai));
+}
+
+
 /**
 * Launches a type 1 or 2 analysis.
-* Loops over the range of specified aoa.
+* Loops over the specified range of aoa indexes, from i0 to i1 included.
 * For each successful aoa, stores the data in the WPolar and Operating Point objects.
 */
-bool LLTAnalysis::alphaLoop()
+bool LLTAnalysis::alphaLoop(int i0, int i1)
 {
     QString str;
 
@@ -627,62 +896,75 @@ bool LLTAnalysis::alphaLoop()
     bool bOutRe=false, bError=false;
     double tau = 0.0;
 
-    for (int i=0; i<=m_nPoints; i++)
+    // local copy, since the polar's velocity is shared by the parallel workers
+    double QInf = m_QInfLast;
+
+    for (int i=i0; i<=i1; i++)
     {
         if(m_pX) m_pX->clear();
         if(m_pY) m_pY->clear();
 
         double Alpha = m_vMin + double(i) * m_vDelta;
-        if(m_bCancel)
+        if(isCancelled())
         {
             str = "Analysis cancelled on user request....\n";
             traceLog(str);
             break;
         }
 
-        setVelocity(m_pWPolar->m_QInfSpec);
-        if(s_bInitCalc) setLinearSolution(Alpha);
+        setVelocity(QInf);
+        if(m_bInitCalc) setLinearSolution(Alpha);
 
         //initialize first iteration
-        for (int k=1; k<s_NLLTStations; k++)
         {
-            double yob   = cos(double(k)*PI/double(s_NLLTStations));
-            m_pWing->getFoils(&pFoil0, &pFoil1, yob*m_pWing->m_PlanformSpan/2.0, tau);
-            m_Cl[k] = getCl(pFoil0, pFoil1, m_Re[k], Alpha + m_Ai[k] + m_Twist[k], tau, bOutRe, bError);
+            PERF_SCOPE(m_PerfStats, "polar interpolation");
+            for (int k=1; k<s_NLLTStations; k++)
+            {
+                double yob   = cos(double(k)*PI/double(s_NLLTStations));
+                m_pWing->getFoils(&pFoil0, &pFoil1, yob*m_pWing->m_PlanformSpan/2.0, tau);
+                m_Cl[k] = getCl(pFoil0, pFoil1, m_Re[k], Alpha + m_Ai[k] + m_Twist[k], tau, bOutRe, bError);
+            }
         }
 
 
         str= QString("Calculating Alpha = %1... ").arg(Alpha,5,'f',2);
         traceLog(str);
 
-        int iter = iterate(m_pWPolar->m_QInfSpec, Alpha);
+        QElapsedTimer t;
+        t.start();
+        int iter = iterate(QInf, Alpha);
+        if(iter>0) m_nIterations += iter;
+        PERF_COUNT(m_PerfStats, "iterations", qMax(iter, 0));
 
-        if (iter==-1 && !m_bCancel)
+        if (iter==-1 && !isCancelled())
         {
             str= QString("    ...negative Lift... Aborting\n");
             m_bError = true;
-            s_bInitCalc = true;
+            m_bInitCalc = true;
             traceLog(str);
         }
-        else if (iter<s_IterLim && !m_bCancel)
+        else if (iter<s_IterLim && !isCancelled())
         {
             //converged,
-            str= QString("    ...converged after %1 iterations\n").arg(iter);
+            str= QString("    ...converged after %1 iterations in %2 ms\n").arg(iter).arg(t.elapsed());
             traceLog(str);
-            computeWing(m_pWPolar->m_QInfSpec, Alpha, str);// generates wing results,
+            computeWing(QInf, Alpha, str);// generates wing results,
             traceLog(str);
             if (m_bWingOut) m_bWarning = true;
-            PlaneOpp *pPOpp = createPlaneOpp(m_pWPolar->m_QInfSpec, Alpha, m_bWingOut);// Adds WOpp point and adds result to polar
+            PlaneOpp *pPOpp = createPlaneOpp(QInf, Alpha, m_bWingOut);// Adds WOpp point and adds result to polar
             if(pPOpp) m_PlaneOppList.append(pPOpp);
-            s_bInitCalc = false;
+            PERF_COUNT(m_PerfStats, "converged points", 1);
+            m_QInfLast = QInf;
+            m_bInitCalc = false;
         }
         else
         {
             if (m_bWingOut) m_bWarning = true;
             m_bError = true;
+            PERF_COUNT(m_PerfStats, "unconverged points", 1);
             str= QString("    ...unconverged after %1 iterations out of %2\n").arg(iter).arg(s_IterLim);
             traceLog(str);
-            s_bInitCalc = true;
+            m_bInitCalc = true;
         }
     }
     return true;
@@ -691,10 +973,10 @@ bool LLTAnalysis::alphaLoop()
 
 /**
 * Launches a type 4 analysis.
-* Loops over the range of specified velocities.
+* Loops over the specified range of velocity indexes, from i0 to i1 included.
 * For each successful aoa, stores the data in the WPolar and Operating Point objects.
 */
-bool LLTAnalysis::QInfLoop()
+bool LLTAnalysis::QInfLoop(int i0, int i1)
 {
     QString str;
     double tau=0.0;
@@ -707,10 +989,10 @@ bool LLTAnalysis::QInfLoop()
     double QInf = 0.0;
     double Alpha = m_pWPolar->m_AlphaSpec;
 
-    for (int i=0; i<=m_nPoints; i++)
+    for (int i=i0; i<=i1; i++)
     {
         QInf = m_vMin + double(i) * m_vDelta;
-        if(m_bCancel)
+        if(isCancelled())
         {
             str = "Analysis cancelled on user request....\n";
             traceLog(str);
@@ -718,19 +1000,26 @@ bool LLTAnalysis::QInfLoop()
         }
 
         setVelocity(QInf);
-        if(s_bInitCalc) setLinearSolution(m_pWPolar->m_AlphaSpec);
+        if(m_bInitCalc) setLinearSolution(m_pWPolar->m_AlphaSpec);
 
         //initialize first iteration
-        for (int k=1; k<s_NLLTStations; k++)
         {
-            double yob   = cos(k*PI/s_NLLTStations);
-            m_pWing->getFoils(&pFoil0, &pFoil1, yob*m_pWing->m_PlanformSpan/2.0, tau);
-            m_Cl[k] = getCl(pFoil0, pFoil1, m_Re[k], Alpha + m_Ai[k] + m_Twist[k], tau, bOutRe, bError);
+            PERF_SCOPE(m_PerfStats, "polar interpolation");
+            for (int k=1; k<s_NLLTStations; k++)
+            {
+                double yob   = cos(k*PI/s_NLLTStations);
+                m_pWing->getFoils(&pFoil0, &pFoil1, yob*m_pWing->m_PlanformSpan/2.0, tau);
+                m_Cl[k] = getCl(pFoil0, pFoil1, m_Re[k], Alpha + m_Ai[k] + m_Twist[k], tau, bOutRe, bError);
+            }
         }
 
         str = QString("Calculating QInf = %1... ").arg(QInf,6,'f',2);
         traceLog(str);
+        QElapsedTimer t;
+        t.start();
         int iter = iterate(QInf, m_pWPolar->m_AlphaSpec);
+        if(iter>0) m_nIterations += iter;
+        PERF_COUNT(m_PerfStats, "iterations", qMax(iter, 0));
 
         if(iter<0)
         {
@@ -739,33 +1028,35 @@ bool LLTAnalysis::QInfLoop()
             m_bWarning = true;
             str = QString("\n");
             traceLog(str);
-            s_bInitCalc = true;
+            m_bInitCalc = true;
         }
-        else if (iter<s_IterLim  && !m_bCancel)
+        else if (iter<s_IterLim  && !isCancelled())
         {
             //converged,
-            str = QString("    ...converged after %1 iterations\n").arg(iter);
+            str = QString("    ...converged after %1 iterations in %2 ms\n").arg(iter).arg(t.elapsed());
             traceLog(str);
             computeWing(QInf, m_pWPolar->m_AlphaSpec,str);// generates wing results,
             traceLog(str);
             if (m_bWingOut) m_bWarning = true;
             PlaneOpp *pPOpp = createPlaneOpp(QInf, m_pWPolar->m_AlphaSpec, m_bWingOut);// Adds WOpp point and adds result to polar
             if(pPOpp) m_PlaneOppList.append(pPOpp);
+            PERF_COUNT(m_PerfStats, "converged points", 1);
 
             /*            if(m_bWingOut)
             {
                 str = QString("\n");
                 traceLog(str);
             }*/
-            s_bInitCalc = false;
+            m_bInitCalc = false;
         }
         else
         {
             if (m_bWingOut) m_bWarning = true;
             m_bError = true;
+            PERF_COUNT(m_PerfStats, "unconverged points", 1);
             str = QString("    ...unconverged after %1 iterations\n").arg(iter);
             traceLog(str);
-            s_bInitCalc = true;
+            m_bInitCalc = true;
         }
 
         if(m_pX) m_pX->clear();
@@ -805,6 +1096,7 @@ void LLTAnalysis::setLLTData(Plane *pPlane, WPolar *pWPolar)
 void LLTAnalysis::initializeAnalysis()
 {
     m_bWarning = m_bError = false;
+    m_nIterations = 0;
     m_PlaneOppList.clear();
 
     traceLog("\nLaunching the LLT Analysis....\n");
@@ -814,10 +1106,11 @@ void LLTAnalysis::initializeAnalysis()
 
 
 
-/** emits the analysis messages to the world */
+/** emits the analysis messages to the world; the workers buffer them until the sweep is complete, to keep the log in sequence order */
 void LLTAnalysis::traceLog(QString str)
 {
-    emit outputMsg(str);
+    if(m_pParent) m_Log.append(str);
+    else          emit outputMsg(str);
 }
 
 
@@ -834,6 +1127,8 @@ void LLTAnalysis::traceLog(QString str)
 */
 PlaneOpp* LLTAnalysis::createPlaneOpp(double QInf, double Alpha, bool bWingOut)
 {
+    PERF_SCOPE(m_PerfStats, "operating points");
+
     PlaneOpp *pNewPOpp = new PlaneOpp(m_pPlane, m_pWPolar, 0);
 
     if(!pNewPOpp)
@@ -916,15 +1211,21 @@ PlaneOpp* LLTAnalysis::createPlaneOpp(double QInf, double Alpha, bool bWingOut)
         }
     }
 
-    //add the data to the polar object
-    if(PlaneOpp::s_bKeepOutOpps || !pNewPOpp->m_bOut)
-        m_pWPolar->addPlaneOpPoint(pNewPOpp);
+    //add the data to the polar object; the workers' results are added in sequence order once the sweep is complete
+    if(!m_pParent) storeInPolar(pNewPOpp);
 
     return pNewPOpp;
 }
 
 
 
+void LLTAnalysis::storeInPolar(PlaneOpp *pPOpp)
+{
+    if(PlaneOpp::s_bKeepOutOpps || !pPOpp->m_bOut)
+        m_pWPolar->addPlaneOpPoint(pPOpp);
+}
+
+
 void LLTAnalysis::setPlane(Plane *pPlane)
 {
     m_pPlane   = pPlane;
@@ -957,6 +1258,7 @@ void LLTAnalysis::onCancel()
 
 bool LLTAnalysis::isCancelled() const
 {
+    if(m_pParent) return m_bCancel || m_pParent->m_bCancel;
     return m_bCancel;
 }
 
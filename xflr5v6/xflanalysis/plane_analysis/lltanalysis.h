@@ -36,6 +36,7 @@
 
 #include <xflanalysis/analysis3d_params.h>
 #include <xflanalysis/analysis3d_globals.h>
+#include <xflcore/perfstats.h>
 
 #include <QVector>
 
@@ -63,6 +64,7 @@ class LLTAnalysis : QObject
     friend class MainFrame;
     friend class LLTAnalysisDlg;
     friend class XflScriptExec;
+    friend class XflBench;
 
 public:
     LLTAnalysis();
@@ -81,16 +83,26 @@ public:
 
     bool isCancelled() const;
     bool hasWarnings() const;
+    int iterationCount() const {return m_nIterations;}
+
+#ifdef XFL_PERFSTATS
+    PerfStats &perfStats() {return m_PerfStats;}
+    PerfStats const &perfStats() const {return m_PerfStats;}
+#endif
 
     static void setMaxIter(int maxIter){s_IterLim = maxIter;}
     static void setConvergencePrecision(double precision) {s_CvPrec = precision;}
     static void setNSpanStations(int nStations){s_NLLTStations=nStations;}
     static void setRelaxationFactor(double relax){s_RelaxMax = relax;}
+    static void setNewtonSolver(bool bNewton){s_bNewton = bNewton;}
+    static void setMultiThreaded(bool bMultiThread){s_bMultiThread = bMultiThread;}
 
     static int maxIter(){return s_IterLim;}
     static double convergencePrecision() {return s_CvPrec;}
     static int nSpanStations(){return s_NLLTStations;}
     static double relaxationFactor(){return s_RelaxMax;}
+    static bool isNewtonSolver(){return s_bNewton;}
+    static bool isMultiThreaded(){return s_bMultiThread;}
 
 
 private:
@@ -101,6 +113,9 @@ private:
     void setVelocity(double &QInf);
     void initializeGeom();
     int iterate(double &QInf, double const Alpha);
+    int iterateNewton(double &QInf, double const Alpha);
+    bool updateCl(double &QInf, double const Alpha);
+    void makeBetaMatrix();
     void setBending(double QInf);
     bool setLinearSolution(double Alpha);
     void resetVariables();
@@ -108,8 +123,12 @@ private:
 
     PlaneOpp *createPlaneOpp(double QInf, double Alpha, bool bWingOut);
     bool loop();
-    bool alphaLoop();
-    bool QInfLoop();
+    bool loopRange(int i0, int i1);
+    bool parallelLoop(int nBlocks);
+    bool alphaLoop(int i0, int i1);
+    bool QInfLoop(int i0, int i1);
+    void initializeWorker(LLTAnalysis const *pParent);
+    void storeInPolar(PlaneOpp *pPOpp);
     void traceLog(QString str);
 
     double getCl(Foil const*pFoil0, Foil const*pFoil1, double Re, double Alpha, double Tau, bool &bOutRe, bool &bError);
@@ -146,6 +165,10 @@ private:
     bool m_bCancel;                             /**< true if the user has cancelled the analysis */
     bool m_bConverged;                          /**< true if the analysis has converged  */
     bool m_bWingOut;                            /**< true if the interpolation of viscous properties falls outside the polar mesh */
+    bool m_bInitCalc;                           /**< true if the next point should be initialized with the linear solution, false if it should start from the last converged point */
+
+    LLTAnalysis const *m_pParent;               /**< the analysis which owns the sweep if this instance is a worker solving a block of points, nullptr otherwise */
+    QString m_Log;                              /**< the worker's messages, output by the parent in sequence order */
 
     double m_Ai[MAXSPANSTATIONS+1];                /**< Induced Angle coefficient at the span stations */
     double m_BendingMoment[MAXSPANSTATIONS+1];    /**< bending moment at the span stations */
@@ -181,7 +204,15 @@ private:
 
     Vector3d m_CP;                               /**< The position of the center of pressure */
 
+    QVector<double> m_Beta;                      /**< The Beta factors, computed once per geometry; row k holds the coefficients of the induced angle at station k */
+
     int m_nPoints;                              /**< the number of points to calculate in the sequence */
+    int m_nIterations;                          /**< the total number of iterations of the last sweep */
+    double m_QInfLast;                          /**< the freestream velocity of the last converged point of the sweep */
+
+#ifdef XFL_PERFSTATS
+    PerfStats m_PerfStats;                      /**< the timings and counters of the last sweep */
+#endif
 
     //    Curve Data
     QVector<double> *m_pX, *m_pY;
@@ -190,8 +221,12 @@ private:
     static int s_IterLim;                       /**< The maximum number of iterations in the calculation */
     static int s_NLLTStations;                  /**< The number of LLT stations in the spanwise direction */
     static double s_RelaxMax;                   /**< The relaxation factor for the iterations */
+    static bool s_bNewton;                      /**< true if the iterations should use Newton's method with the local polar slopes rather than the relaxed fixed-point update */
+    static double s_NewtonDelta;                /**< The aoa increment used to evaluate the local polar slopes, in degrees */
+    static double s_NewtonMaxStep;              /**< The max change of induced angle at any station in one Newton step, in degrees */
     static double s_CvPrec;                     /**< Precision criterion to stop the iterations. The difference in induced angle at any span point between two iterations should be less than the criterion */
     static bool s_bInitCalc;                    /**< true if the iterations analysis should be initialized with the linear solution at each new a.o.a. calculation, false otherwise */
+    static bool s_bMultiThread;                 /**< true if the operating points of a sweep should be solved concurrently */
 
     QVector<PlaneOpp*> m_PlaneOppList;
     QVector<Polar*> const *m_poaPolar;
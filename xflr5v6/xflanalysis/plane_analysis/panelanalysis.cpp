@@ -660,6 +660,7 @@ bool PanelAnalysis::alphaLoop()
         //        display_vec(m_aijWake+17*m_MatSize, m_MatSize);
 
         //add wake contribution to matrix and RHS
+        PERF_SCOPE(m_PerfStats, "wake matrix update");
         for(int p=0; p<m_MatSize; p++)
         {
             m_uRHS[p]+= m_uWake[p];
@@ -713,6 +714,9 @@ bool PanelAnalysis::alphaLoop()
 */
 void PanelAnalysis::buildInfluenceMatrix()
 {
+    PERF_SCOPE(m_PerfStats, "influence matrix");
+    PERF_COUNT(m_PerfStats, "influence coefficients", qint64(m_MatSize)*qint64(m_MatSize));
+
     Vector3d C, CC, V;
     int m, mm, p, pp;
     double phi;
@@ -788,6 +792,8 @@ void PanelAnalysis::buildInfluenceMatrix()
 */
 void PanelAnalysis::createSourceStrength(double Alpha0, double AlphaDelta, int nval)
 {
+    PERF_SCOPE(m_PerfStats, "source strengths");
+
     int p, pp, q;
     double alpha;
     Vector3d WindDirection;
@@ -887,6 +893,8 @@ void PanelAnalysis::createRHS(double *RHS, Vector3d VInf, double *VField)
 */
 void PanelAnalysis::createUnitRHS()
 {
+    PERF_SCOPE(m_PerfStats, "unit RHS");
+
     traceLog("      Creating the unit RHS vectors...\n");
 
     Vector3d VInf;
@@ -909,6 +917,8 @@ void PanelAnalysis::createUnitRHS()
 */
 void PanelAnalysis::createWakeContribution()
 {
+    PERF_SCOPE(m_PerfStats, "wake contribution");
+
     int kw=0, lw=0, pw=0, p=0, pp=0, Size=0;
 
     Vector3d V, C, CC, TrPt;
@@ -1174,6 +1184,8 @@ void PanelAnalysis::createWakeContribution(double *pWakeContrib, const Vector3d
 */
 void PanelAnalysis::computeFarField(double QInf, double Alpha0, double AlphaDelta, int nval)
 {
+    PERF_SCOPE(m_PerfStats, "far field");
+
     QString strong;
 
     double alpha=0, IDrag=0;
@@ -1244,6 +1256,8 @@ void PanelAnalysis::computeFarField(double QInf, double Alpha0, double AlphaDelt
 */
 void PanelAnalysis::computeBalanceSpeeds(double Alpha, int q)
 {
+    PERF_SCOPE(m_PerfStats, "balance speeds");
+
     QString strong;
     Vector3d Force, WindNormal;
     WindNormal.set(-sin(Alpha*PI/180.0),   0.0, cos(Alpha*PI/180.0));
@@ -1289,6 +1303,8 @@ void PanelAnalysis::computeBalanceSpeeds(double Alpha, int q)
 */
 void PanelAnalysis::scaleResultstoSpeed(int nval)
 {
+    PERF_SCOPE(m_PerfStats, "scaling to speed");
+
     //______________________________________________________________________________________
     // Scale RHS and Sigma i.a.w. speeds (so far we have unit doublet and source strengths)
 
@@ -1501,7 +1517,10 @@ void PanelAnalysis::computePlane(double Alpha, double QInf, int qrhs)
                 IDrag += m_WingIDrag[qrhs*MAXWINGS+iw];
 
                 //Get viscous interpolations
-                m_pWingList[iw]->panelComputeViscous(QInf, m_pWPolar, WingVDrag, m_pWPolar->bViscous(), OutString);
+                {
+                    PERF_SCOPE(m_PerfStats, "viscous interpolation");
+                    m_pWingList[iw]->panelComputeViscous(QInf, m_pWPolar, WingVDrag, m_pWPolar->bViscous(), OutString);
+                }
                 VDrag += WingVDrag;
 
                 traceLog(OutString);
@@ -1509,12 +1528,15 @@ void PanelAnalysis::computePlane(double Alpha, double QInf, int qrhs)
 
 
                 //Compute moment coefficients
-                m_pWingList[iw]->panelComputeOnBody(QInf, Alpha, m_Cp+qrhs*m_MatSize+pos, m_Mu+qrhs*m_MatSize+pos,
-                                                    XCP, YCP, ZCP, m_GCm, m_VCm, m_ICm, m_GRm, m_GYm, m_VYm, m_IYm,
-                                                    m_pWPolar, m_CoG, m_pPanel);
+                {
+                    PERF_SCOPE(m_PerfStats, "on-body forces");
+                    m_pWingList[iw]->panelComputeOnBody(QInf, Alpha, m_Cp+qrhs*m_MatSize+pos, m_Mu+qrhs*m_MatSize+pos,
+                                                        XCP, YCP, ZCP, m_GCm, m_VCm, m_ICm, m_GRm, m_GYm, m_VYm, m_IYm,
+                                                        m_pWPolar, m_CoG, m_pPanel);
 
 
-                m_pWingList[iw]->panelComputeBending(m_pPanel, m_pWPolar->bThinSurfaces());
+                    m_pWingList[iw]->panelComputeBending(m_pPanel, m_pWPolar->bThinSurfaces());
+                }
 
                 pos += m_pWingList[iw]->m_nPanels;
             }
@@ -1522,6 +1544,7 @@ void PanelAnalysis::computePlane(double Alpha, double QInf, int qrhs)
 
         if(m_pPlane->body() && m_pWPolar->analysisMethod()==xfl::PANEL4METHOD && !m_pWPolar->bIgnoreBodyPanels())
         {
+            PERF_SCOPE(m_PerfStats, "on-body forces");
             double ICm = 0.0;
             traceLog("       Calculating body...\n");
             m_pPlane->body()->computeAero(m_Cp+qrhs*m_MatSize+pos, XCP, YCP, ZCP, ICm, m_GRm, m_GYm, Alpha, m_CoG, m_pPanel);
@@ -1570,8 +1593,12 @@ void PanelAnalysis::computePlane(double Alpha, double QInf, int qrhs)
 
         if(m_pWPolar->isStabilityPolar()) m_Alpha = m_AlphaEq; // so it is set by default at the end of the analysis
 
-        PlaneOpp *pPOpp = createPlaneOpp(m_Cp+qrhs*m_MatSize, Mu, Sigma);
-        m_PlaneOppList.append(pPOpp);
+        {
+            PERF_SCOPE(m_PerfStats, "operating points");
+            PERF_COUNT(m_PerfStats, "operating points", 1);
+            PlaneOpp *pPOpp = createPlaneOpp(m_Cp+qrhs*m_MatSize, Mu, Sigma);
+            m_PlaneOppList.append(pPOpp);
+        }
 
         traceLog("\n");
     }
@@ -1779,6 +1806,8 @@ void PanelAnalysis::getDoubletDerivative(const int &p, double const*Mu, double &
 */
 void PanelAnalysis::computeOnBodyCp(double V0, double VDelta, int nval)
 {
+    PERF_SCOPE(m_PerfStats, "on-body speeds");
+
     //following VSAERO theory manual
     //the on-body tangential perturbation speed is the derivative of the doublet strength
 
@@ -2031,6 +2060,7 @@ bool PanelAnalysis::QInfLoop()
         createWakeContribution();
 
         //add wake contribution to matrix and RHS
+        PERF_SCOPE(m_PerfStats, "wake matrix update");
         for(int p=0; p<m_MatSize; p++)
         {
             m_uRHS[p]+= m_uWake[p];
@@ -2092,15 +2122,22 @@ bool PanelAnalysis::solveUnitRHS()
 
     traceLog("      Performing LU Matrix decomposition...\n");
 
-    if(!Crout_LU_Decomposition_with_Pivoting(m_aij, m_Index, Size, &s_bCancel, taskTime*double(m_MatSize)/400.0, m_Progress))
     {
-        traceLog("      Singular Matrix.... Aborting calculation...\n");
-        return false;
+        PERF_SCOPE(m_PerfStats, "LU decomposition");
+        PERF_COUNT(m_PerfStats, "LU decompositions", 1);
+        if(!Crout_LU_Decomposition_with_Pivoting(m_aij, m_Index, Size, &s_bCancel, taskTime*double(m_MatSize)/400.0, m_Progress))
+        {
+            traceLog("      Singular Matrix.... Aborting calculation...\n");
+            return false;
+        }
     }
 
     traceLog("      Solving the LU system...\n");
-    Crout_LU_with_Pivoting_Solve(m_aij, m_uRHS, m_Index, m_RHS,      Size, &s_bCancel);
-    Crout_LU_with_Pivoting_Solve(m_aij, m_wRHS, m_Index, m_RHS+Size, Size, &s_bCancel);
+    {
+        PERF_SCOPE(m_PerfStats, "LU solve");
+        Crout_LU_with_Pivoting_Solve(m_aij, m_uRHS, m_Index, m_RHS,      Size, &s_bCancel);
+        Crout_LU_with_Pivoting_Solve(m_aij, m_wRHS, m_Index, m_RHS+Size, Size, &s_bCancel);
+    }
 
     QString strange;
     strange = QString::asprintf("      Time for linear system solve: %.3f s\n", double(t.elapsed())/1000.0);
@@ -2110,6 +2147,8 @@ bool PanelAnalysis::solveUnitRHS()
     memcpy(m_uRHS, m_RHS,           uint(m_MatSize)*sizeof(double));
     memcpy(m_wRHS, m_RHS+m_MatSize, uint(m_MatSize)*sizeof(double));
 
+    PERF_SCOPE(m_PerfStats, "on-panel velocities");
+
     //   Define unit local velocity vector, necessary for moment calculations in stability analysis of 3D panels
     Vector3d u(1.0, 0.0, 0.0);
     Vector3d w(0.0, 0.0, 1.0);
@@ -2146,6 +2185,8 @@ bool PanelAnalysis::solveUnitRHS()
 */
 void PanelAnalysis::createDoubletStrength(double Alpha0, double AlphaDelta, int nval)
 {
+    PERF_SCOPE(m_PerfStats, "doublet strengths");
+
     traceLog("      Calculating doublet strength...\n");
 
     //______________________________________________________________________________________
@@ -2283,6 +2324,7 @@ bool PanelAnalysis::unitLoop()
                 //compute wake contribution
                 createWakeContribution();
                 //add wake contribution to matrix and RHS
+                PERF_SCOPE(m_PerfStats, "wake matrix update");
                 for(int p=0; p<m_MatSize; p++)
                 {
                     m_uRHS[p]+= m_uWake[p];
@@ -2564,7 +2606,10 @@ bool PanelAnalysis::controlLoop()
 
         setInertia(m_Ctrl, 0.0, 0.0);
 
-        setControlPositions(m_Ctrl, m_NCtrls, outString, true);
+        {
+            PERF_SCOPE(m_PerfStats, "control positions");
+            setControlPositions(m_Ctrl, m_NCtrls, outString, true);
+        }
 
         traceLog(outString);
         if(s_bCancel) break;
@@ -2585,13 +2630,16 @@ bool PanelAnalysis::controlLoop()
 
             if (s_bCancel) return true;
 
-            //Build the rotation matrix from body axes to stability axes
-            buildRotationMatrix();
-            if(s_bCancel) break;
+            {
+                PERF_SCOPE(m_PerfStats, "stability derivatives");
+                //Build the rotation matrix from body axes to stability axes
+                buildRotationMatrix();
+                if(s_bCancel) break;
 
-            // Compute inertia in stability axes
-            computeStabilityInertia();
-            if(s_bCancel) break;
+                // Compute inertia in stability axes
+                computeStabilityInertia();
+                if(s_bCancel) break;
+            }
 
             str = "\n      ___Inertia - Stability Axis - CoG Origin____\n";
             traceLog(str);
@@ -2604,21 +2652,30 @@ bool PanelAnalysis::controlLoop()
             str = QString("      Isxz=%1 ").arg(m_Is[0][2], 12,'g',4);
             traceLog(str+"\n\n");
 
-            // Compute stability and control derivatives in stability axes
-            // viscous or not viscous ?
-            computeStabilityDerivatives();
-            if(s_bCancel) break;
+            {
+                PERF_SCOPE(m_PerfStats, "stability derivatives");
+                // Compute stability and control derivatives in stability axes
+                // viscous or not viscous ?
+                computeStabilityDerivatives();
+                if(s_bCancel) break;
 
-            computeControlDerivatives(); //single derivative, wrt the polar's control variable
-            if(s_bCancel) break;
+                computeControlDerivatives(); //single derivative, wrt the polar's control variable
+                if(s_bCancel) break;
 
-            computeNDStabDerivatives();
+                computeNDStabDerivatives();
+
+                // Construct the state matrices - longitudinal and lateral
+                buildStateMatrices();
+            }
 
-            // Construct the state matrices - longitudinal and lateral
-            buildStateMatrices();
+            bool bEigen = false;
+            {
+                PERF_SCOPE(m_PerfStats, "eigenvalues");
+                bEigen = solveEigenvalues();
+            }
 
             // Solve for eigenvalues
-            if(!solveEigenvalues())
+            if(!bEigen)
             {
                 str = QString("      Unsuccessful attempt to compute eigenvalues for Control=%1 - skipping.\n\n\n").arg(m_Ctrl,10,'f',3);
                 traceLog(str);
@@ -3111,6 +3168,8 @@ void PanelAnalysis::forces(double *Mu, double *Sigma, double alpha, Vector3d Vin
 */
 bool PanelAnalysis::getZeroMomentAngle()
 {
+    PERF_SCOPE(m_PerfStats, "zero-moment angle");
+
     double tmp=0;
     double eps = 1.e-7;
 
@@ -3368,6 +3427,7 @@ bool PanelAnalysis::computeTrimmedConditions()
         //compute wake contribution
         createWakeContribution();
         //add wake contribution to matrix and RHS
+        PERF_SCOPE(m_PerfStats, "wake matrix update");
         for(int p=0; p<m_MatSize; p++)
         {
             m_uRHS[p]+= m_uWake[p];
@@ -4459,6 +4519,8 @@ void PanelAnalysis::computePhillipsFormulae()
  */
 void PanelAnalysis::rotateGeomY(double Alpha, Vector3d const &P, int NXWakePanels)
 {
+    PERF_SCOPE(m_PerfStats, "geometry rotation");
+
     Vector3d LATB, TALB, Pt, Trans;
 
     for (int n=0; n<m_nNodes; n++)
@@ -4539,6 +4601,8 @@ void PanelAnalysis::rotateGeomY(double Alpha, Vector3d const &P, int NXWakePanel
  */
 void PanelAnalysis::rotateGeomZ(double Beta, Vector3d const &P, int NXWakePanels)
 {
+    PERF_SCOPE(m_PerfStats, "geometry rotation");
+
     int iLA(0), iLB(0), iTA(0), iTB(0);
     Vector3d Pt, Trans;
 
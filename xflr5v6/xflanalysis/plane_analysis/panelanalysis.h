@@ -29,6 +29,7 @@
 #include <QObject>
 #include <QVector>
 
+#include <xflcore/perfstats.h>
 #include <xflgeom/geom3d/vector3d.h>
 #include <xflobjects/objects3d/panel.h>
 #include <xflanalysis/analysis3d_params.h>
@@ -132,6 +133,11 @@ class PanelAnalysis : QObject
 
         void clearPOppList();
 
+#ifdef XFL_PERFSTATS
+        PerfStats &perfStats() {return m_PerfStats;}
+        PerfStats const &perfStats() const {return m_PerfStats;}
+#endif
+
         static bool s_bCancel;      /**< true if the user has cancelled the analysis */
         static bool s_bWarning;     /**< true if one the OpPoints could not be properly interpolated */
         static void setMaxWakeIter(int nMaxWakeIter) {s_MaxWakeIter = nMaxWakeIter;}
@@ -154,6 +160,10 @@ class PanelAnalysis : QObject
         double m_Progress;   /**< A measure of the progress of the analysis, used to provide feedback to the user */
         double m_TotalTime;     /**< the esimated total time of the analysis, used to set the progress bar. No specific unit. */
 
+#ifdef XFL_PERFSTATS
+        PerfStats m_PerfStats;      /**< the timings and counters of the last run */
+#endif
+
         bool m_bPointOut;           /**< true if an interpolation was outside the min or max Cl */
         bool m_bSequence;           /**< true if the calculation is should be performed for a range of aoa */
 
@@ -22,12 +22,17 @@
 
 
 #include <QDebug>
+#include <QDataStream>
 
 
 #include "planetask.h"
+#include <xflobjects/objects2d/objects2d.h>
+#include <xflobjects/objects2d/polar.h>
 #include <xflobjects/objects3d/plane.h>
+#include <xflobjects/objects3d/planeopp.h>
 #include <xflobjects/objects3d/wpolar.h>
 #include <xflobjects/objects3d/surface.h>
+#include <xflobjects/resultcache.h>
 
 
 bool PlaneTask::s_bCancel = false;
@@ -86,21 +91,229 @@ void PlaneTask::run()
         return;
     }
 
-    if(m_pWPolar->isLLTMethod())
+#ifdef XFL_PERFSTATS
+    // the points may all be read from the cache, in which case the solver's statistics are not relevant
+    if(m_ptheLLTAnalysis)   m_ptheLLTAnalysis->perfStats().clear();
+    if(m_pthePanelAnalysis) m_pthePanelAnalysis->perfStats().clear();
+#endif
+
+    QByteArray key;
+    QVector<PlaneOpp*> cachedPOpps;
+    double vMin = m_vMin;
+    double vMax = m_vMax;
+    bool bCompute = true;
+
+    if(ResultCache::isEnabled() && pPOppList())
     {
-        LLTAnalyze();
+        key = cacheKey();
+        bCompute = loadCachedPOpps(key, cachedPOpps);
+    }
+
+    if(bCompute)
+    {
+        if(m_pWPolar->isLLTMethod())
+        {
+            LLTAnalyze();
+        }
+        else if(m_pWPolar->isQuadMethod())
+        {
+            PanelAnalyze();
+        }
+
+        if(!key.isEmpty())
+        {
+            QVector<PlaneOpp*> const &newPOpps = *pPOppList();
+            for(int i=0; i<newPOpps.size(); i++)
+                ResultCache::storePOpp(key, sequenceValue(newPOpps.at(i)), newPOpps.at(i));
+        }
     }
-    else if(m_pWPolar->isQuadMethod())
+    else if(pPOppList())
     {
-        PanelAnalyze();
+        // the analysis has not been initialized, so discard the points of the previous run which are owned by the polars
+        pPOppList()->clear();
     }
 
+    for(int i=0; i<cachedPOpps.size(); i++)
+    {
+        PlaneOpp *pPOpp = cachedPOpps.at(i);
+        pPOpp->setPlaneName(m_pPlane->name());
+        pPOpp->setPolarName(m_pWPolar->polarName());
+        pPOppList()->append(pPOpp);
+        if(PlaneOpp::keepOutPOpps() || !pPOpp->isOut())
+            m_pWPolar->addPlaneOpPoint(pPOpp);
+    }
+
+    m_vMin = vMin;
+    m_vMax = vMax;
+
     m_bIsFinished = true;
 
     emit taskFinished();
 }
 
 
+/**
+ * Returns the list of operating points of the analysis used by the polar, or nullptr if it has not been set.
+ */
+QVector<PlaneOpp*> *PlaneTask::pPOppList()
+{
+    if(m_pWPolar->isLLTMethod()) return m_ptheLLTAnalysis   ? &m_ptheLLTAnalysis->m_PlaneOppList   : nullptr;
+    else                         return m_pthePanelAnalysis ? &m_pthePanelAnalysis->m_PlaneOppList : nullptr;
+}
+
+
+/**
+ * Returns the value of the sequence's parameter of an operating point, which identifies it in the result cache.
+ */
+double PlaneTask::sequenceValue(PlaneOpp const *pPOpp) const
+{
+    switch(m_pWPolar->polarType())
+    {
+        case xfl::FIXEDAOAPOLAR:  return pPOpp->QInf();
+        case xfl::BETAPOLAR:      return pPOpp->beta();
+        case xfl::STABILITYPOLAR: return pPOpp->ctrl();
+        default:                  return pPOpp->alpha();
+    }
+}
+
+
+/**
+ * Returns the result cache's key of the analysis, built from the mesh, the polar's specification,
+ * the solver's settings and, if the analysis interpolates the viscous properties, the foils' polars.
+ * The names of the plane and of the polar are left out.
+ * Must be called after setWPolarObject(), which sets the automatic inertia.
+ */
+QByteArray PlaneTask::cacheKey() const
+{
+    QByteArray spec;
+    QDataStream ar(&spec, QIODevice::WriteOnly);
+    ar.setVersion(QDataStream::Qt_4_5);
+    ar.setByteOrder(QDataStream::LittleEndian);
+
+    ar << QString("PlaneTask");
+
+    ar << m_Node.size();
+    for(int i=0; i<m_Node.size(); i++) ar << m_Node.at(i).x << m_Node.at(i).y << m_Node.at(i).z;
+    ar << m_Panel.size();
+    for(int i=0; i<m_Panel.size(); i++)
+    {
+        Panel const &panel = m_Panel.at(i);
+        ar << panel.m_iLA << panel.m_iLB << panel.m_iTA << panel.m_iTB << int(panel.m_Pos) << panel.m_bIsTrailing << panel.m_iWake;
+    }
+    ar << m_WakeNode.size() << m_NWakeColumn;
+    for(int i=0; i<m_WakeNode.size(); i++) ar << m_WakeNode.at(i).x << m_WakeNode.at(i).y << m_WakeNode.at(i).z;
+
+    WPolar wpolar;
+    wpolar.duplicateSpec(m_pWPolar);
+    wpolar.setPlaneName(QString());
+    wpolar.setPolarName(QString());
+    wpolar.setTheStyle(LineStyle());
+    wpolar.serializeWPlrXFL(ar, true);
+
+    if(m_pWPolar->isLLTMethod())
+    {
+        ar << LLTAnalysis::nSpanStations() << LLTAnalysis::maxIter() << LLTAnalysis::convergencePrecision()
+           << LLTAnalysis::relaxationFactor() << LLTAnalysis::isNewtonSolver();
+    }
+    else
+    {
+        ar << PanelAnalysis::s_bTrefftz << PanelAnalysis::s_MaxWakeIter;
+    }
+
+    if(m_pWPolar->isLLTMethod() || m_pWPolar->bViscous())
+    {
+        QStringList foilNames;
+        for(int iw=0; iw<MAXWINGS; iw++)
+        {
+            Wing const *pWing = m_pPlane->wingAt(iw);
+            if(!pWing) continue;
+            for(int is=0; is<pWing->NWingSection(); is++)
+                foilNames << pWing->rightFoilName(is) << pWing->leftFoilName(is);
+        }
+        foilNames.removeDuplicates();
+
+        for(int ip=0; ip<Objects2d::polarCount(); ip++)
+        {
+            Polar const *pPolar = Objects2d::polarAt(ip);
+            if(!foilNames.contains(pPolar->foilName())) continue;
+            ar << pPolar->foilName() << int(pPolar->polarType()) << pPolar->ReType() << pPolar->MaType();
+            ar << pPolar->Reynolds() << pPolar->Mach() << pPolar->NCrit() << pPolar->XtrTop() << pPolar->XtrBot();
+            ar << pPolar->m_Alpha << pPolar->m_Cl << pPolar->m_Cd << pPolar->m_Cdp << pPolar->m_Cm;
+            ar << pPolar->m_XCp << pPolar->m_XTr1 << pPolar->m_XTr2 << pPolar->m_HMom << pPolar->m_Re;
+        }
+    }
+
+    return ResultCache::makeKey(spec);
+}
+
+
+/**
+ * Reads the points of the sequence from the result cache.
+ * The cached points outside the span of the missing points are returned in cachedPOpps,
+ * and the range of the task is narrowed to this span.
+ * @return true if some points need to be computed
+ */
+bool PlaneTask::loadCachedPOpps(QByteArray const &key, QVector<PlaneOpp*> &cachedPOpps)
+{
+    double vDelta = m_vMax<m_vMin ? -qAbs(m_vInc) : qAbs(m_vInc);
+    int nPoints = 1;
+    if(m_bSequence && qAbs(vDelta)>0.0) nPoints = int(qAbs((m_vMax-m_vMin)*1.0001/vDelta)) + 1;
+
+    QVector<PlaneOpp*> POpps(nPoints, nullptr);
+    int iFirstMiss = -1, iLastMiss = -1;
+    for(int i=0; i<nPoints; i++)
+    {
+        POpps[i] = ResultCache::loadPOpp(key, m_vMin+double(i)*vDelta);
+        if(!POpps.at(i))
+        {
+            if(iFirstMiss<0) iFirstMiss = i;
+            iLastMiss = i;
+        }
+    }
+
+    int nRecomputed = 0;
+    for(int i=0; i<nPoints; i++)
+    {
+        if(!POpps.at(i)) continue;
+        if(iFirstMiss>=0 && i>iFirstMiss && i<iLastMiss)
+        {
+            delete POpps.at(i); // recomputed with the missing points
+            nRecomputed++;
+        }
+        else cachedPOpps.append(POpps.at(i));
+    }
+    if(nRecomputed) ResultCache::countRecomputed(ResultCache::PLANEOPP, nRecomputed);
+
+    if(iFirstMiss<0) return false;
+
+    double vMin = m_vMin;
+    m_vMin = vMin + double(iFirstMiss)*vDelta;
+    m_vMax = vMin + double(iLastMiss) *vDelta;
+    return true;
+}
+
+
+#ifdef XFL_PERFSTATS
+/**
+ * Returns the statistics of the last run, including those of the generation of the mesh which the run has used.
+ */
+PerfStats PlaneTask::perfStats() const
+{
+    PerfStats stats;
+    if(isPanelTask()) stats.merge(m_MeshStats, true);
+    if(isLLTTask())
+    {
+        if(m_ptheLLTAnalysis) stats.merge(m_ptheLLTAnalysis->perfStats(), true);
+    }
+    else
+    {
+        if(m_pthePanelAnalysis) stats.merge(m_pthePanelAnalysis->perfStats(), true);
+    }
+    return stats;
+}
+#endif
+
+
 bool PlaneTask::isLLTTask() const
 {
     return (m_pWPolar && m_pWPolar->isLLTMethod());
@@ -186,6 +399,10 @@ WPolar* PlaneTask::setWPolarObject(Plane *pCurPlane, WPolar *pCurWPolar)
         return nullptr;
     }
 
+#ifdef XFL_PERFSTATS
+    m_MeshStats.start();
+#endif
+
     Wing *pWingList[MAXWINGS];
     pWingList[0] = pCurPlane->wing();
     pWingList[1] = pCurPlane->wing2();
@@ -194,6 +411,7 @@ WPolar* PlaneTask::setWPolarObject(Plane *pCurPlane, WPolar *pCurWPolar)
 
     if(!m_pWPolar || m_pWPolar->analysisMethod()>xfl::LLTMETHOD)
     {
+        PERF_SCOPE(m_MeshStats, "mesh: span stations");
         for(int iw=0; iw<MAXWINGS; iw++)
         {
             if(pWingList[iw])
@@ -235,7 +453,10 @@ WPolar* PlaneTask::setWPolarObject(Plane *pCurPlane, WPolar *pCurWPolar)
 
     if(!m_pWPolar) return nullptr;
 
-    stitchSurfaces();
+    {
+        PERF_SCOPE(m_MeshStats, "mesh: stitching");
+        stitchSurfaces();
+    }
 
     //initialize the analysis pointers.
     //do it now, in case the user asks for streamlines from an existing file
@@ -275,6 +496,13 @@ WPolar* PlaneTask::setWPolarObject(Plane *pCurPlane, WPolar *pCurWPolar)
         }
     }
 
+    PERF_COUNT(m_MeshStats, "mesh: panels", m_Panel.size());
+    PERF_COUNT(m_MeshStats, "mesh: nodes",  m_Node.size());
+    PERF_COUNT(m_MeshStats, "mesh: wake panels", m_WakeSize);
+#ifdef XFL_PERFSTATS
+    m_MeshStats.stop();
+#endif
+
     return m_pWPolar;
 }
 
@@ -305,6 +533,7 @@ bool PlaneTask::initializePanels()
 
     //    if(PanelArraySize>m_MaxPanelSize)
     {
+        PERF_SCOPE(m_MeshStats, "mesh: allocation");
 //        Trace(QString("PlaneTask::Requesting additional memory for %1 panels").arg(PanelArraySize));
 
         // allocate 10% more than needed to avoid repeating the operation if the user requirement increases slightly again.
@@ -321,6 +550,7 @@ bool PlaneTask::initializePanels()
     //if a WPolar is defined, allocate the matrix
     if(m_pWPolar)
     {
+        PERF_SCOPE(m_MeshStats, "mesh: allocation");
         int MatrixSize=0;
 
         if(!m_pthePanelAnalysis->allocateMatrix(m_MaxPanelSize, MatrixSize))
@@ -350,6 +580,7 @@ bool PlaneTask::initializePanels()
         Wing *pWing = pWingList[iw];
         if(!pWing) continue;
 
+        PERF_SCOPE(m_MeshStats, "mesh: wing panels");
         int Nel = 0;
         pWing->setFirstPanelIndex(m_Panel.size());
         for(int jSurf=0; jSurf<pWing->surfaceCount(); jSurf++)
@@ -377,6 +608,7 @@ bool PlaneTask::initializePanels()
     {
         if(m_pPlane && m_pPlane->body())
         {
+            PERF_SCOPE(m_MeshStats, "mesh: body panels");
             m_pPlane->body()->setFirstPanelIndex(m_Panel.size());
             createBodyElements(m_pPlane);
 //            qDebug()<<m_pPlane->body()->name()<<m_pPlane->body()->firstPanelIndex()<<m_pPlane->body()->nPanels();
@@ -1341,6 +1573,7 @@ int PlaneTask::isWakeNode(Vector3d &Pt)
 */
 int PlaneTask::isNode(Vector3d &Pt)
 {
+    PERF_COUNT(m_MeshStats, "mesh: node lookups", 1);
     for (int in=m_Node.size()-1; in>=0; in--)
     {
         if(Pt.isSame(m_Node.at(in))) return in;
@@ -1610,9 +1843,17 @@ void PlaneTask::LLTAnalyze()
     m_ptheLLTAnalysis->setWPolar(m_pWPolar);
     m_ptheLLTAnalysis->setLLTRange(m_vMin, m_vMax, m_vInc, m_bSequence);
 
+#ifdef XFL_PERFSTATS
+    m_ptheLLTAnalysis->perfStats().start();
+#endif
+
     m_ptheLLTAnalysis->initializeAnalysis();
     m_ptheLLTAnalysis->loop();
 
+#ifdef XFL_PERFSTATS
+    m_ptheLLTAnalysis->perfStats().stop();
+#endif
+
     m_bIsFinished = true;
 }
 
@@ -1640,9 +1881,17 @@ void PlaneTask::PanelAnalyze()
         m_pthePanelAnalysis->m_QInf   = m_pWPolar->velocity();
     }
 
+#ifdef XFL_PERFSTATS
+    m_pthePanelAnalysis->perfStats().start();
+#endif
+
     m_pthePanelAnalysis->initializeAnalysis();
     m_pthePanelAnalysis->loop();
 
+#ifdef XFL_PERFSTATS
+    m_pthePanelAnalysis->perfStats().stop();
+#endif
+
     m_bIsFinished = true;
 }
 
@@ -28,6 +28,7 @@
 
 #include <xflanalysis/plane_analysis/lltanalysis.h>
 #include <xflanalysis/plane_analysis/panelanalysis.h>
+#include <xflcore/perfstats.h>
 
 class Plane;
 class WPolar;
@@ -90,6 +91,7 @@ class PlaneTask : public QObject
         void PanelAnalyze();
 
         static void cancelTask(){s_bCancel=true;}
+        static void setCancelled(bool bCancelled) {s_bCancel=bCancelled;}
 
         PanelAnalysis *m_pthePanelAnalysis;
         LLTAnalysis *m_ptheLLTAnalysis;
@@ -100,12 +102,22 @@ class PlaneTask : public QObject
         int nNodes() const {return m_Node.size();}
         int matSize() const {return m_Panel.size();}
 
+#ifdef XFL_PERFSTATS
+        PerfStats perfStats() const;
+#endif
+
     public slots:
         void run();
 
     signals:
         void taskFinished();
 
+    private:
+        QVector<PlaneOpp*> *pPOppList();
+        double sequenceValue(PlaneOpp const *pPOpp) const;
+        QByteArray cacheKey() const;
+        bool loadCachedPOpps(QByteArray const &key, QVector<PlaneOpp *> &cachedPOpps);
+
     private:
         Plane *m_pPlane;
         WPolar *m_pWPolar;
@@ -135,6 +147,10 @@ class PlaneTask : public QObject
         bool m_bIsFinished;       /**< true if the calculation is over */
         static bool s_bCancel;    /**< true if all analysis should be cancelled */
 
+#ifdef XFL_PERFSTATS
+        PerfStats m_MeshStats;    /**< the timings and counters of the last mesh generation */
+#endif
+
 };
 
 
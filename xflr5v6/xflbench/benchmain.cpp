@@ -0,0 +1,96 @@
+/****************************************************************************
+
+    xflr5-bench Application
+
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+
+#include "xflbench.h"
+#include <xflcore/gui_params.h>
+
+
+/**
+ * Runs the reference cases and writes the JSON report to the output file, or to stdout.
+ * The progress and the summary table are written to stderr.
+ * Returns 1 if a case has failed.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("xflr5-bench");
+    QCoreApplication::setApplicationVersion(VERSIONNAME);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs the reference cases of the solvers and reports their timings");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption outputOption(QStringList() << "o" << "output", "Writes the JSON report to <file> instead of stdout.", "file");
+    QCommandLineOption casesOption(QStringList() << "c" << "cases", "Runs only the cases whose name matches <regexp>.", "regexp");
+    QCommandLineOption repeatOption(QStringList() << "r" << "repeat", "Runs each case <n> times and keeps the fastest run.", "n", "1");
+    QCommandLineOption listOption(QStringList() << "l" << "list", "Lists the cases and exits.");
+    parser.addOption(outputOption);
+    parser.addOption(casesOption);
+    parser.addOption(repeatOption);
+    parser.addOption(listOption);
+    parser.process(app);
+
+    XflBench bench;
+    bench.setFilter(parser.value(casesOption));
+    bench.setRepeat(parser.value(repeatOption).toInt());
+
+    QTextStream err(stderr);
+
+    if(parser.isSet(listOption))
+    {
+        QTextStream out(stdout);
+        QStringList names = bench.caseNames();
+        for(int i=0; i<names.size(); i++) out << names.at(i) << "\n";
+        return 0;
+    }
+
+    bench.run();
+
+    QByteArray json = bench.report().toJson(QJsonDocument::Indented);
+    if(parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+        if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            err << "Could not open the file " << file.fileName() << "\n";
+            return 1;
+        }
+        file.write(json);
+    }
+    else
+    {
+        QFile out;
+        out.open(stdout, QIODevice::WriteOnly);
+        out.write(json);
+    }
+
+    err << "\n" << bench.summary();
+
+    return bench.hasErrors() ? 1 : 0;
+}
+
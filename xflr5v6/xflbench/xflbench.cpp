@@ -0,0 +1,667 @@
+/****************************************************************************
+
+    XflBench Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QBuffer>
+#include <QFile>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QThread>
+#include <QRegularExpression>
+#include <QTextStream>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+#include "xflbench.h"
+#include <xfoil.h>
+#include <xdirect/analysis/xfoiltask.h>
+#include <xflanalysis/plane_analysis/planetask.h>
+#include <xflcore/gui_params.h>
+#include <xflcore/xflevents.h>
+#include <xflobjects/objects2d/foil.h>
+#include <xflobjects/objects2d/objects2d.h>
+#include <xflobjects/objects2d/oppoint.h>
+#include <xflobjects/objects2d/polar.h>
+#include <xflobjects/objects3d/plane.h>
+#include <xflobjects/objects3d/wing.h>
+#include <xflobjects/objects3d/wpolar.h>
+#include <xflobjects/resultcache.h>
+
+
+int XflBench::s_WingNACA = 2412;
+int XflBench::s_TailNACA = 12;
+
+double XflBench::s_AlphaMin = -4.0;
+double XflBench::s_AlphaMax = 10.0;
+double XflBench::s_AlphaInc =  0.5;
+
+double XflBench::s_PlaneAlphaMin = -2.0;
+double XflBench::s_PlaneAlphaMax =  8.0;
+double XflBench::s_PlaneAlphaInc =  1.0;
+
+double XflBench::s_PlaneVelocity = 20.0;
+
+
+XflBench::XflBench() : QObject()
+{
+    m_nRepeat = 1;
+    m_bErrors = false;
+    m_bPeakPerCase = resetPeakMemory();
+
+    // the timings should only depend on the solvers
+    ResultCache::setEnabled(false);
+    LLTAnalysis::setMultiThreaded(false);
+
+    Wing::s_poaFoil  = Objects2d::pOAFoil();
+    Wing::s_poaPolar = Objects2d::pOAPolar();
+
+    int const digits[] = {12, 2412, 4415};
+    for(int i=0; i<3; i++)
+    {
+        Foil *pFoil = makeNacaFoil(digits[i]);
+        Objects2d::appendFoil(pFoil);
+        m_Foil.insert(digits[i], pFoil);
+    }
+
+    makeCases();
+}
+
+
+XflBench::~XflBench()
+{
+    Objects2d::deleteAllFoils();
+}
+
+
+/**
+ * The XFoilTask posts its operating points to the parent, which is responsible for their deletion.
+ */
+void XflBench::customEvent(QEvent *pEvent)
+{
+    if(pEvent->type()==XFOIL_END_OPP_EVENT)
+    {
+        XFoilOppEvent *pOppEvent = static_cast<XFoilOppEvent*>(pEvent);
+        delete pOppEvent->theOpPoint();
+    }
+}
+
+
+/**
+ * Defines the reference cases. The names are stable, so that the results of successive versions can be compared.
+ */
+void XflBench::makeCases()
+{
+    m_Case.clear();
+
+    int const digits[] = {12, 2412, 4415};
+    double const Re[] = {1.0e5, 2.0e5, 5.0e5, 1.0e6};
+    for(int i=0; i<3; i++)
+    {
+        for(int j=0; j<4; j++)
+        {
+            BenchCase bc;
+            bc.name  = QString::asprintf("xfoil/naca%04d/Re%dk", digits[i], int(Re[j]/1000.0));
+            bc.group = XFOIL;
+            bc.naca  = digits[i];
+            bc.Re    = Re[j];
+            m_Case.append(bc);
+        }
+    }
+
+    BenchCase llt;
+    llt.name   = "llt/reference";
+    llt.group  = LLT;
+    llt.method = xfl::LLTMETHOD;
+    m_Case.append(llt);
+
+    double const vlmDensity[] = {1.0, 1.5, 2.0};
+    for(int i=0; i<3; i++)
+    {
+        BenchCase bc;
+        bc.name    = QString::asprintf("vlm2/reference/x%.1f", vlmDensity[i]);
+        bc.group   = PANEL;
+        bc.method  = xfl::VLMMETHOD;
+        bc.density = vlmDensity[i];
+        m_Case.append(bc);
+    }
+
+    double const panelDensity[] = {1.0, 1.5};
+    for(int i=0; i<2; i++)
+    {
+        BenchCase bc;
+        bc.name          = QString::asprintf("panel/reference/x%.1f", panelDensity[i]);
+        bc.group         = PANEL;
+        bc.method        = xfl::PANEL4METHOD;
+        bc.bThinSurfaces = false;
+        bc.bWingOnly     = true;
+        bc.density       = panelDensity[i];
+        m_Case.append(bc);
+    }
+
+    int const resolution[][2] = {{13,17}, {40,50}};
+    for(int i=0; i<2; i++)
+    {
+        BenchCase bc;
+        bc.name  = QString::asprintf("export/printable-wing/%dx%d", resolution[i][0], resolution[i][1]);
+        bc.group = EXPORT;
+        bc.nChordPanels = resolution[i][0];
+        bc.nSpanPanels  = resolution[i][1];
+        m_Case.append(bc);
+    }
+}
+
+
+bool XflBench::isSelected(BenchCase const &bc) const
+{
+    if(m_Filter.isEmpty()) return true;
+    QRegularExpression re(m_Filter);
+    return re.match(bc.name).hasMatch();
+}
+
+
+QStringList XflBench::caseNames() const
+{
+    QStringList names;
+    for(int i=0; i<m_Case.size(); i++)
+    {
+        if(isSelected(m_Case.at(i))) names.append(m_Case.at(i).name);
+    }
+    return names;
+}
+
+
+void XflBench::run()
+{
+    m_Result.clear();
+    m_bErrors = false;
+
+    if(!m_Filter.isEmpty() && !QRegularExpression(m_Filter).isValid())
+    {
+        QTextStream(stderr) << "Invalid case filter: " << m_Filter << "\n";
+        m_bErrors = true;
+        return;
+    }
+
+    for(int i=0; i<m_Case.size(); i++)
+    {
+        if(isSelected(m_Case.at(i))) runCase(m_Case.at(i));
+    }
+}
+
+
+/**
+ * Runs a case m_nRepeat times, and keeps the fastest run and the highest memory mark.
+ */
+void XflBench::runCase(BenchCase const &bc)
+{
+    BenchResult best;
+    best.name  = bc.name;
+    best.group = bc.group;
+    qint64 peak = 0;
+    bool bError = false;
+
+    for(int ir=0; ir<m_nRepeat; ir++)
+    {
+        BenchResult result;
+        result.name  = bc.name;
+        result.group = bc.group;
+
+        if(m_bPeakPerCase) resetPeakMemory();
+
+        bool bOK = false;
+        switch(bc.group)
+        {
+            case XFOIL:  bOK = runXFoilCase(bc, result);  break;
+            case LLT:
+            case PANEL:  bOK = runPlaneCase(bc, result);  break;
+            case EXPORT: bOK = runExportCase(bc, result); break;
+        }
+        result.bError = !bOK;
+        result.peakMemory = peakMemory();
+
+        peak   = qMax(peak, result.peakMemory);
+        bError = bError || result.bError;
+        if(ir==0 || result.wallTime<best.wallTime) best = result;
+    }
+    best.peakMemory = peak;
+    best.bError     = bError;
+
+    if(best.bError) m_bErrors = true;
+    m_Result.append(best);
+
+    QTextStream(stderr) << QString::asprintf("%-32s %10.4f s %s\n", best.name.toStdString().c_str(), best.wallTime,
+                                             best.bError ? "  ERROR" : "");
+}
+
+
+/**
+ * Computes a viscous polar of a NACA foil as a single serial sequence.
+ * The XFoil factor cache is cleared first, so that the timing does not depend on the order of the cases.
+ */
+bool XflBench::runXFoilCase(BenchCase const &bc, BenchResult &result)
+{
+    Foil *pFoil = m_Foil.value(bc.naca);
+    Polar *pPolar = foilPolar(bc.naca, bc.Re);
+    if(!pFoil || !pPolar) return false;
+
+    pPolar->resetPolar();
+    XFoil::clearFactorCache();
+    XFoilTask::setCancelled(false);
+
+    XFoilTask *pTask = new XFoilTask(this);
+    pTask->setAutoDelete(false);
+
+    QElapsedTimer t;
+    t.start();
+
+    bool bOK = pTask->initializeXFoilTask(pFoil, pPolar, true, true, false);
+    if(bOK)
+    {
+        pTask->setSequence(true, s_AlphaMin, s_AlphaMax, s_AlphaInc);
+        pTask->run();
+    }
+    result.wallTime = double(t.nsecsElapsed())/1.0e9;
+
+    int iterations = 0;
+    for(int i=0; i<pTask->m_PointIterations.size(); i++) iterations += pTask->m_PointIterations.at(i);
+    int nPoints = int(qRound((s_AlphaMax-s_AlphaMin)/s_AlphaInc))+1;
+
+    result.iterations = iterations;
+    result.nItems     = pPolar->m_Alpha.size();
+    result.unit       = "points";
+    result.details["converged"] = pPolar->m_Alpha.size();
+    result.details["requested"] = nPoints;
+#ifdef XFL_PERFSTATS
+    result.details["timings"] = pTask->perfStats().toJson();
+#endif
+    delete pTask;
+
+    // delete the operating points posted by the task
+    QCoreApplication::sendPostedEvents(this);
+
+    return bOK && pPolar->m_Alpha.size()>0;
+}
+
+
+/**
+ * Runs a plane analysis, and for the VLM and panel methods, repeats the build of the influence matrix
+ * and the LU decomposition in isolation on the same mesh.
+ */
+bool XflBench::runPlaneCase(BenchCase const &bc, BenchResult &result)
+{
+    if(bc.method==xfl::LLTMETHOD)
+    {
+        // the LLT interpolates the viscous characteristics in the foil polars; compute those which are missing
+        int const naca[] = {s_WingNACA, s_TailNACA};
+        double const Re[] = {1.0e5, 2.0e5, 5.0e5, 1.0e6};
+        for(int i=0; i<2; i++)
+        {
+            for(int j=0; j<4; j++)
+            {
+                Polar *pPolar = foilPolar(naca[i], Re[j]);
+                if(pPolar && pPolar->m_Alpha.size()==0)
+                {
+                    BenchCase polarCase;
+                    polarCase.naca = naca[i];
+                    polarCase.Re   = Re[j];
+                    BenchResult dummy;
+                    runXFoilCase(polarCase, dummy);
+                }
+            }
+        }
+        if(m_bPeakPerCase) resetPeakMemory();
+    }
+
+    Plane *pPlane = makeReferencePlane(bc.density, bc.bWingOnly);
+    WPolar *pWPolar = makeWPolar(pPlane, bc);
+
+    PanelAnalysis::s_bCancel = false;
+
+    LLTAnalysis lltAnalysis;
+    lltAnalysis.m_poaPolar = Objects2d::pOAPolar();
+    PanelAnalysis panelAnalysis;
+
+    PlaneTask task;
+    task.setLLTAnalysis(lltAnalysis);
+    task.setPanelAnalysis(panelAnalysis);
+
+    QElapsedTimer t;
+    t.start();
+
+    task.setPlaneObject(pPlane);
+    bool bOK = task.setWPolarObject(pPlane, pWPolar)!=nullptr;
+    double meshTime = double(t.nsecsElapsed())/1.0e9;
+
+    if(bOK)
+    {
+        task.initializeTask(pPlane, pWPolar, s_PlaneAlphaMin, s_PlaneAlphaMax, s_PlaneAlphaInc);
+        task.run();
+    }
+    result.wallTime = double(t.nsecsElapsed())/1.0e9;
+    result.unit     = "points";
+    result.details["mesh_s"] = meshTime;
+#ifdef XFL_PERFSTATS
+    if(bOK) result.details["timings"] = task.perfStats().toJson();
+#endif
+
+    if(bc.method==xfl::LLTMETHOD)
+    {
+        result.iterations = lltAnalysis.iterationCount();
+        result.nItems     = lltAnalysis.m_PlaneOppList.size();
+        result.details["stations"] = LLTAnalysis::nSpanStations();
+        bOK = bOK && !lltAnalysis.m_bError;
+        lltAnalysis.clearPOppList();
+    }
+    else
+    {
+        result.nItems = panelAnalysis.m_PlaneOppList.size();
+        result.details["panels"] = task.matSize();
+        result.details["nodes"]  = task.nNodes();
+        panelAnalysis.clearPOppList();
+
+        if(bOK)
+        {
+            panelAnalysis.setRange(s_PlaneAlphaMin, s_PlaneAlphaMin, s_PlaneAlphaInc, false);
+            panelAnalysis.initializeAnalysis();
+
+            QElapsedTimer tPhase;
+            tPhase.start();
+            panelAnalysis.buildInfluenceMatrix();
+            result.details["influence_matrix_s"] = double(tPhase.nsecsElapsed())/1.0e9;
+
+            panelAnalysis.createUnitRHS();
+
+            tPhase.restart();
+            bOK = panelAnalysis.solveUnitRHS();
+            result.details["lu_solve_s"] = double(tPhase.nsecsElapsed())/1.0e9;
+            panelAnalysis.clearPOppList();
+        }
+    }
+    bOK = bOK && result.nItems>0;
+
+    delete pWPolar;
+    delete pPlane;
+    return bOK;
+}
+
+
+/**
+ * Builds the printable mesh of the reference wing and writes it as binary STL in memory,
+ * with the default settings of the export dialog.
+ */
+bool XflBench::runExportCase(BenchCase const &bc, BenchResult &result)
+{
+    Plane *pPlane = makeReferencePlane(1.0, true);
+    Wing *pWing = pPlane->wing();
+    pWing->skinThickness = 0.5/1000.0;
+    pWing->ribSpacing    = 50.0/1000.0;
+    pWing->ribThickness  = 2.0/1000.0;
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    QElapsedTimer t;
+    t.start();
+    uint32_t nTriangles = pWing->exportSTL3dPrintable(buffer, PrintMesh::STLBINARY, bc.nChordPanels, bc.nSpanPanels,
+                                                      Wing::PRINTABLE, 1000.f);
+    result.wallTime = double(t.nsecsElapsed())/1.0e9;
+
+    result.nItems = int(nTriangles);
+    result.unit   = "triangles";
+    result.details["bytes"] = buffer.size();
+
+    delete pPlane;
+    return nTriangles>0;
+}
+
+
+Foil *XflBench::makeNacaFoil(int digits)
+{
+    XFoil *pXFoil = new XFoil; // too large for the stack
+    pXFoil->lflap  = false;
+    pXFoil->lbflap = false;
+    pXFoil->naca4(digits, 50);
+
+    Foil *pFoil = new Foil;
+    pFoil->setName(nacaName(digits));
+    for (int j=0; j<pXFoil->nb; j++)
+    {
+        pFoil->m_xb[j] = pXFoil->xb[j+1];
+        pFoil->m_yb[j] = pXFoil->yb[j+1];
+        pFoil->m_x[j]  = pXFoil->xb[j+1];
+        pFoil->m_y[j]  = pXFoil->yb[j+1];
+    }
+    pFoil->m_nb = pXFoil->nb;
+    pFoil->m_n  = pXFoil->nb;
+    pFoil->initFoil();
+
+    delete pXFoil;
+    return pFoil;
+}
+
+
+/**
+ * Returns the type 1 polar of a foil at the given Reynolds number, creating it if necessary.
+ */
+Polar *XflBench::foilPolar(int naca, double Re)
+{
+    Foil *pFoil = m_Foil.value(naca);
+    if(!pFoil) return nullptr;
+    return Objects2d::createPolar(pFoil, xfl::FIXEDSPEEDPOLAR, Re, 0.0, 9.0, 1.0, 1.0);
+}
+
+
+/**
+ * Returns a new instance of the default plane, with the reference foils,
+ * and with the numbers of panels of each section multiplied by the density.
+ */
+Plane *XflBench::makeReferencePlane(double density, bool bWingOnly)
+{
+    Plane *pPlane = new Plane;
+    pPlane->setName(bWingOnly ? "Reference wing" : "Reference plane");
+    if(bWingOnly)
+    {
+        pPlane->setElevator(false);
+        pPlane->setFin(false);
+    }
+
+    for(int iw=0; iw<MAXWINGS; iw++)
+    {
+        Wing *pWing = pPlane->wing(iw);
+        if(!pWing) continue;
+
+        QString foilName = nacaName(iw==0 ? s_WingNACA : s_TailNACA);
+        for(int is=0; is<pWing->NWingSection(); is++)
+        {
+            pWing->setRightFoilName(is, foilName);
+            pWing->setLeftFoilName(is, foilName);
+            pWing->setNXPanels(is, qMax(1, int(qRound(double(pWing->NXPanels(is))*density))));
+            pWing->setNYPanels(is, qMax(1, int(qRound(double(pWing->NYPanels(is))*density))));
+        }
+        pWing->computeGeometry();
+    }
+    pPlane->computePlane();
+    return pPlane;
+}
+
+
+WPolar *XflBench::makeWPolar(Plane const *pPlane, BenchCase const &bc) const
+{
+    WPolar *pWPolar = new WPolar;
+    pWPolar->setPlaneName(pPlane->name());
+    pWPolar->setPolarName(bc.name);
+    pWPolar->setPolarType(xfl::FIXEDSPEEDPOLAR);
+    pWPolar->setAnalysisMethod(bc.method);
+    pWPolar->setThinSurfaces(bc.bThinSurfaces);
+    pWPolar->setVLM1(false);
+    pWPolar->setViscous(bc.method==xfl::LLTMETHOD);
+    pWPolar->setVelocity(s_PlaneVelocity);
+    pWPolar->setReferenceDim(xfl::PROJECTEDREFDIM);
+    pWPolar->setReferenceArea(pPlane->projectedArea());
+    pWPolar->setReferenceSpanLength(pPlane->projectedSpan());
+    pWPolar->setReferenceChordLength(pPlane->mac());
+    return pWPolar;
+}
+
+
+QString XflBench::nacaName(int digits)
+{
+    return QString::asprintf("NACA %04d", digits);
+}
+
+
+QString XflBench::groupName(enumGroup group)
+{
+    switch(group)
+    {
+        case XFOIL:  return "xfoil";
+        case LLT:    return "llt";
+        case PANEL:  return "panel";
+        case EXPORT: return "export";
+    }
+    return QString();
+}
+
+
+/**
+ * Returns the memory high-water mark of the process, in kB, or 0 if it cannot be read.
+ */
+qint64 XflBench::peakMemory()
+{
+#if defined(Q_OS_LINUX)
+    QFile file("/proc/self/status");
+    if(file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QTextStream in(&file);
+        QString line;
+        while(in.readLineInto(&line))
+        {
+            if(line.startsWith("VmHWM:"))
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+        }
+    }
+    return 0;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return qint64(pmc.PeakWorkingSetSize)/1024;
+    return 0;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage)!=0) return 0;
+#if defined(Q_OS_MACOS)
+    return qint64(usage.ru_maxrss)/1024; // bytes
+#else
+    return qint64(usage.ru_maxrss);      // kB
+#endif
+#else
+    return 0;
+#endif
+}
+
+
+/**
+ * Resets the high-water mark to the current resident size, so that it can be measured for each case.
+ * Only possible on Linux; returns false elsewhere, in which case the mark is the process'.
+ */
+bool XflBench::resetPeakMemory()
+{
+#if defined(Q_OS_LINUX)
+    QFile file("/proc/self/clear_refs");
+    if(!file.open(QIODevice::WriteOnly)) return false;
+    return file.write("5")==1;
+#else
+    return false;
+#endif
+}
+
+
+QJsonDocument XflBench::report() const
+{
+    QJsonObject root;
+    root["benchmark"] = "xflr5-bench";
+    root["version"]   = VERSIONNAME;
+    root["qt"]        = qVersion();
+    root["date"]      = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["cpu_threads"] = QThread::idealThreadCount();
+    root["repeat"]    = m_nRepeat;
+    root["peak_memory_scope"] = m_bPeakPerCase ? "case" : "process";
+
+    QJsonObject settings;
+    settings["xfoil_alpha"]  = QJsonArray({s_AlphaMin, s_AlphaMax, s_AlphaInc});
+    settings["plane_alpha"]  = QJsonArray({s_PlaneAlphaMin, s_PlaneAlphaMax, s_PlaneAlphaInc});
+    settings["plane_velocity"] = s_PlaneVelocity;
+    settings["ncrit"]        = 9.0;
+    settings["llt_stations"] = LLTAnalysis::nSpanStations();
+    settings["llt_max_iter"] = LLTAnalysis::maxIter();
+    settings["llt_precision"] = LLTAnalysis::convergencePrecision();
+    settings["llt_relaxation"] = LLTAnalysis::relaxationFactor();
+    settings["llt_newton"]   = LLTAnalysis::isNewtonSolver();
+    root["settings"] = settings;
+
+    QJsonArray cases;
+    for(int i=0; i<m_Result.size(); i++)
+    {
+        BenchResult const &r = m_Result.at(i);
+        QJsonObject c;
+        c["name"]   = r.name;
+        c["group"]  = groupName(r.group);
+        c["status"] = r.bError ? "error" : "ok";
+        c["wall_s"] = r.wallTime;
+        if(r.iterations>=0) c["iterations"] = r.iterations;
+        else                c["iterations"] = QJsonValue();
+        c["items"]  = r.nItems;
+        c["unit"]   = r.unit;
+        c["throughput"] = r.wallTime>0.0 ? double(r.nItems)/r.wallTime : 0.0;
+        c["peak_memory_kB"] = r.peakMemory;
+        c["details"] = r.details;
+        cases.append(c);
+    }
+    root["cases"] = cases;
+
+    return QJsonDocument(root);
+}
+
+
+/**
+ * Returns a human-readable table of the results.
+ */
+QString XflBench::summary() const
+{
+    QString strange;
+    strange += QString::asprintf("%-32s %10s %8s %10s %14s %12s\n", "case", "wall (s)", "iter", "items", "items/s", "peak (kB)");
+    for(int i=0; i<m_Result.size(); i++)
+    {
+        BenchResult const &r = m_Result.at(i);
+        QString iter = r.iterations>=0 ? QString::number(r.iterations) : "-";
+        double throughput = r.wallTime>0.0 ? double(r.nItems)/r.wallTime : 0.0;
+        strange += QString::asprintf("%-32s %10.4f %8s %10d %14.1f %12lld%s\n",
+                                     r.name.toStdString().c_str(), r.wallTime, iter.toStdString().c_str(),
+                                     r.nItems, throughput, (long long)r.peakMemory, r.bError ? "  ERROR" : "");
+    }
+    return strange;
+}
+
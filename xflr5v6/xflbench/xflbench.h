@@ -0,0 +1,133 @@
+/****************************************************************************
+
+    XflBench Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+/** @file This file implements the reference cases of the xflr5-bench executable. */
+
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <QMap>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include <xflcore/core_enums.h>
+
+class Foil;
+class Polar;
+class Plane;
+class WPolar;
+
+
+/**
+ * @class XflBench
+ * Runs the solvers' hot paths on reproducible reference cases, without any GUI:
+ *   - XFoil viscous polars of NACA foils at several Reynolds numbers,
+ *   - LLT, VLM and 3D panel polars of a reference plane at several mesh densities,
+ *   - the export of the 3d-printable wing.
+ *
+ * The analyses are run serially in the calling thread, and the result cache is disabled,
+ * so that the timings only depend on the solvers.
+ * Each case reports its wall time, its number of iterations, its memory high-water mark and its throughput.
+ */
+class XflBench : public QObject
+{
+    public:
+        enum enumGroup {XFOIL, LLT, PANEL, EXPORT};
+
+    public:
+        XflBench();
+        ~XflBench();
+
+        void setFilter(QString const &filter) {m_Filter=filter;}
+        void setRepeat(int nRepeat) {m_nRepeat=qMax(1, nRepeat);}
+
+        QStringList caseNames() const;
+        void run();
+        bool hasErrors() const {return m_bErrors;}
+
+        QJsonDocument report() const;
+        QString summary() const;
+
+    protected:
+        void customEvent(QEvent *pEvent) override;
+
+    private:
+        struct BenchCase
+        {
+            QString name;
+            enumGroup group=XFOIL;
+            int naca=0;                          /**< the foil of the XFoil cases */
+            double Re=0.0;
+            xfl::enumAnalysisMethod method=xfl::LLTMETHOD;
+            bool bThinSurfaces=true;
+            double density=1.0;                  /**< the factor applied to the numbers of panels of the reference plane */
+            bool bWingOnly=false;                /**< true if the plane has no elevator nor fin, so that the panel method can model its wing as a thick surface */
+            int nChordPanels=0, nSpanPanels=0;   /**< the resolution of the printable wing */
+        };
+
+        struct BenchResult
+        {
+            QString name;
+            enumGroup group=XFOIL;
+            double wallTime=0.0;                 /**< the fastest of the repetitions, in s */
+            int iterations=-1;                   /**< the total number of solver iterations; -1 if not applicable */
+            int nItems=0;                        /**< the number of items processed: operating points, triangles */
+            QString unit;                        /**< the name of the items */
+            qint64 peakMemory=0;                 /**< the memory high-water mark, in kB */
+            bool bError=false;
+            QJsonObject details;                 /**< the case-specific values: mesh size, phase times... */
+        };
+
+    private:
+        void makeCases();
+        bool isSelected(BenchCase const &bc) const;
+        void runCase(BenchCase const &bc);
+        bool runXFoilCase(BenchCase const &bc, BenchResult &result);
+        bool runPlaneCase(BenchCase const &bc, BenchResult &result);
+        bool runExportCase(BenchCase const &bc, BenchResult &result);
+
+        Foil *makeNacaFoil(int digits);
+        Polar *foilPolar(int naca, double Re);
+        Plane *makeReferencePlane(double density, bool bWingOnly);
+        WPolar *makeWPolar(Plane const *pPlane, BenchCase const &bc) const;
+
+        static QString nacaName(int digits);
+        static QString groupName(enumGroup group);
+        static qint64 peakMemory();
+        static bool resetPeakMemory();
+
+    private:
+        QVector<BenchCase> m_Case;
+        QVector<BenchResult> m_Result;
+        QMap<int, Foil*> m_Foil;                 /**< the NACA foils, registered in Objects2d so that the wings can use them */
+
+        QString m_Filter;
+        int m_nRepeat;
+        bool m_bPeakPerCase;                     /**< true if the high-water mark can be reset before each case, false if it is the process' */
+        bool m_bErrors;
+
+        static int s_WingNACA, s_TailNACA;                  /**< the foils of the reference plane */
+        static double s_AlphaMin, s_AlphaMax, s_AlphaInc;   /**< the sequence of the foil polars */
+        static double s_PlaneAlphaMin, s_PlaneAlphaMax, s_PlaneAlphaInc;
+        static double s_PlaneVelocity;
+};
+
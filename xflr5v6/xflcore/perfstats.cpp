@@ -0,0 +1,240 @@
+/****************************************************************************
+
+    PerfStats Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+#include "perfstats.h"
+
+#ifdef XFL_PERFSTATS
+
+#include <cstring>
+
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <xflcore/gui_params.h>
+
+
+PerfStats::PerfStats()
+{
+    m_WallNs = 0;
+}
+
+
+/**
+ * Clears the statistics and starts the wall clock of the run.
+ */
+void PerfStats::start()
+{
+    clear();
+    m_WallTimer.start();
+}
+
+
+void PerfStats::stop()
+{
+    if(m_WallTimer.isValid()) m_WallNs = m_WallTimer.nsecsElapsed();
+}
+
+
+void PerfStats::clear()
+{
+    m_Section.clear();
+    m_Counter.clear();
+    m_WallTimer.invalidate();
+    m_WallNs = 0;
+}
+
+
+/**
+ * The names are literals, so the pointers are compared first;
+ * the strings are compared for the literals of other translation units.
+ */
+int PerfStats::sectionIndex(char const *name)
+{
+    for(int i=0; i<m_Section.size(); i++)
+    {
+        if(m_Section.at(i).name==name) return i;
+    }
+    for(int i=0; i<m_Section.size(); i++)
+    {
+        if(strcmp(m_Section.at(i).name, name)==0) return i;
+    }
+    Section section;
+    section.name = name;
+    m_Section.append(section);
+    return m_Section.size()-1;
+}
+
+
+int PerfStats::counterIndex(char const *name)
+{
+    for(int i=0; i<m_Counter.size(); i++)
+    {
+        if(m_Counter.at(i).name==name) return i;
+    }
+    for(int i=0; i<m_Counter.size(); i++)
+    {
+        if(strcmp(m_Counter.at(i).name, name)==0) return i;
+    }
+    Counter counter;
+    counter.name = name;
+    m_Counter.append(counter);
+    return m_Counter.size()-1;
+}
+
+
+void PerfStats::addTime(char const *section, qint64 ns)
+{
+    Section &s = m_Section[sectionIndex(section)];
+    s.ns += ns;
+    s.nCalls++;
+}
+
+
+void PerfStats::addCount(char const *counter, qint64 n)
+{
+    m_Counter[counterIndex(counter)].count += n;
+}
+
+
+/**
+ * Adds the sections and the counters of another instance, e.g. of a worker thread.
+ * @param bWallTime if true, the wall time of the other instance is added too, e.g. for a run which is split in sequential stages.
+ * Otherwise the wall time is left unchanged.
+ */
+void PerfStats::merge(PerfStats const &stats, bool bWallTime)
+{
+    if(bWallTime) m_WallNs += stats.m_WallNs;
+
+    for(int i=0; i<stats.m_Section.size(); i++)
+    {
+        Section const &s = stats.m_Section.at(i);
+        Section &t = m_Section[sectionIndex(s.name)];
+        t.ns     += s.ns;
+        t.nCalls += s.nCalls;
+    }
+    for(int i=0; i<stats.m_Counter.size(); i++)
+    {
+        Counter const &c = stats.m_Counter.at(i);
+        m_Counter[counterIndex(c.name)].count += c.count;
+    }
+}
+
+
+/**
+ * Returns the timing table of the run, formatted for the analysis logs.
+ * The share is relative to the wall time; it may exceed 100% if the sections have been run by several threads.
+ */
+QString PerfStats::table() const
+{
+    QString strange;
+    if(isEmpty()) return strange;
+
+    strange += "\n   Timings\n";
+    strange += QString::asprintf("   %-28s %8s %11s %11s %8s\n", "section", "calls", "total (s)", "mean (ms)", "share");
+
+    qint64 totalNs = 0;
+    for(int i=0; i<m_Section.size(); i++)
+    {
+        Section const &s = m_Section.at(i);
+        totalNs += s.ns;
+        double mean  = s.nCalls>0 ? double(s.ns)/double(s.nCalls)/1.0e6 : 0.0;
+        double share = m_WallNs>0 ? 100.0*double(s.ns)/double(m_WallNs) : 0.0;
+        strange += QString::asprintf("   %-28s %8d %11.4f %11.3f %7.1f%%\n", s.name, s.nCalls, double(s.ns)/1.0e9, mean, share);
+    }
+
+    if(m_WallNs>0)
+    {
+        if(m_WallNs>totalNs)
+        {
+            strange += QString::asprintf("   %-28s %8s %11.4f %11s %7.1f%%\n", "untimed", "", double(m_WallNs-totalNs)/1.0e9, "",
+                                         100.0*double(m_WallNs-totalNs)/double(m_WallNs));
+        }
+        strange += QString::asprintf("   %-28s %8s %11.4f\n", "wall time", "", double(m_WallNs)/1.0e9);
+    }
+
+    if(m_Counter.size())
+    {
+        strange += "   Counters\n";
+        for(int i=0; i<m_Counter.size(); i++)
+            strange += QString::asprintf("   %-28s %12lld\n", m_Counter.at(i).name, static_cast<long long>(m_Counter.at(i).count));
+    }
+    strange += "\n";
+    return strange;
+}
+
+
+QJsonObject PerfStats::toJson() const
+{
+    QJsonObject root;
+    root["wall_s"] = wallTime();
+
+    QJsonArray sections;
+    for(int i=0; i<m_Section.size(); i++)
+    {
+        Section const &s = m_Section.at(i);
+        QJsonObject section;
+        section["name"]    = QString::fromLatin1(s.name);
+        section["calls"]   = s.nCalls;
+        section["total_s"] = double(s.ns)/1.0e9;
+        sections.append(section);
+    }
+    root["sections"] = sections;
+
+    QJsonObject counters;
+    for(int i=0; i<m_Counter.size(); i++)
+        counters[QString::fromLatin1(m_Counter.at(i).name)] = double(m_Counter.at(i).count);
+    root["counters"] = counters;
+
+    return root;
+}
+
+
+/**
+ * Returns the path of the JSON file written next to the analysis log.
+ */
+QString PerfStats::sidecarPath()
+{
+    return QDir::tempPath() + "/XFLR5.timings.json";
+}
+
+
+/**
+ * Writes the statistics of the run in the sidecar file of the analysis log, which is overwritten at each run as the log.
+ */
+bool PerfStats::writeSidecar(QString const &analysis, QString const &objectName, QString const &polarName) const
+{
+    QJsonObject root = toJson();
+    root["version"]  = VERSIONNAME;
+    root["date"]     = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["analysis"] = analysis;
+    root["object"]   = objectName;
+    root["polar"]    = polarName;
+
+    QFile file(sidecarPath());
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+#endif
@@ -0,0 +1,128 @@
+/****************************************************************************
+
+    PerfStats Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+/**
+ * @file This file implements the timers and counters of the solvers' hot paths.
+ *
+ * The instrumentation is compiled only if XFL_PERFSTATS is defined, which is the default in the .pro files.
+ * Otherwise the macros expand to nothing, and the PerfStats class and the members which hold it are not declared.
+ */
+
+#pragma once
+
+#ifdef XFL_PERFSTATS
+
+#include <QVector>
+#include <QString>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+
+/**
+ * @class PerfStats
+ * The accumulated times and counts of the named sections of one analysis run.
+ *
+ * Each analysis object owns its instance, which is only written by the thread which runs the analysis;
+ * the instances of the worker threads are merged by their parent once they are done.
+ * The sections of an analysis do not overlap, so that their times add up to the run's wall time,
+ * less the untimed overhead.
+ * The names are expected to be string literals.
+ */
+class PerfStats
+{
+    public:
+        PerfStats();
+
+        void start();
+        void stop();
+        void clear();
+
+        void addTime(char const *section, qint64 ns);
+        void addCount(char const *counter, qint64 n);
+        void merge(PerfStats const &stats, bool bWallTime=false);
+
+        bool isEmpty() const {return m_Section.isEmpty() && m_Counter.isEmpty();}
+        double wallTime() const {return double(m_WallNs)/1.0e9;}
+
+        QString table() const;
+        QJsonObject toJson() const;
+        bool writeSidecar(QString const &analysis, QString const &objectName, QString const &polarName) const;
+
+        static QString sidecarPath();
+
+    private:
+        struct Section
+        {
+            char const *name=nullptr;
+            qint64 ns=0;
+            int nCalls=0;
+        };
+
+        struct Counter
+        {
+            char const *name=nullptr;
+            qint64 count=0;
+        };
+
+    private:
+        int sectionIndex(char const *name);
+        int counterIndex(char const *name);
+
+    private:
+        QVector<Section> m_Section;   /**< in the order of their first call */
+        QVector<Counter> m_Counter;
+        QElapsedTimer m_WallTimer;
+        qint64 m_WallNs;              /**< the wall time of the run, or 0 if it has not been measured */
+};
+
+
+/**
+ * @class PerfScope
+ * Adds the time elapsed between its construction and its destruction to a section of a PerfStats object.
+ */
+class PerfScope
+{
+    public:
+        PerfScope(PerfStats &stats, char const *section) : m_Stats(stats), m_Section(section) {m_Timer.start();}
+        ~PerfScope() {m_Stats.addTime(m_Section, m_Timer.nsecsElapsed());}
+
+    private:
+        PerfStats &m_Stats;
+        char const *m_Section;
+        QElapsedTimer m_Timer;
+};
+
+
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+
+/** Times the rest of the enclosing block in the section of the PerfStats object */
+#define PERF_SCOPE(stats, section) PerfScope PERF_CONCAT(perfScope_, __LINE__)(stats, section)
+
+/** Adds n to the counter of the PerfStats object */
+#define PERF_COUNT(stats, counter, n) (stats).addCount(counter, n)
+
+#else
+
+#define PERF_SCOPE(stats, section)
+#define PERF_COUNT(stats, counter, n)
+
+#endif
@@ -10,6 +10,7 @@ HEADERS += \
     xflcore/line_enums.h \
     xflcore/linestyle.h \
     xflcore/matrix.h \
+    xflcore/perfstats.h \
     xflcore/trace.h \
     xflcore/units.h \
     xflcore/xflcore.h \
@@ -20,6 +21,7 @@ SOURCES += \
     xflcore/mathelem.cpp \
     xflcore/displayoptions.cpp \
     xflcore/matrix.cpp \
+    xflcore/perfstats.cpp \
     xflcore/trace.cpp \
     xflcore/units.cpp \
     xflcore/xflcore.cpp \
@@ -23,6 +23,8 @@
 #include <QColor>
 #include <QRandomGenerator>
 
+#include <algorithm>
+
 #include "spline.h"
 
 /**
@@ -43,6 +45,7 @@ Spline::Spline()
     m_iSelect     = -10;
     m_iDegree     =  3;
     m_iRes        = 79;
+    m_bSortedOutput = false;
 }
 
 /**
@@ -88,11 +91,13 @@ void Spline::copySymetric(Spline *pSpline)
     m_iHighlight  = pSpline->m_iHighlight;
     m_iRes        = pSpline->m_iRes;
     m_iSelect     = pSpline->m_iSelect;
-    for(int i=0; i<m_iRes; i++)
+    m_Output.resize(pSpline->m_Output.size());
+    for(int i=0; i<m_Output.size(); i++)
     {
         m_Output[i].x =  pSpline->m_Output[i].x;
         m_Output[i].y = -pSpline->m_Output[i].y;
     }
+    m_bSortedOutput = pSpline->m_bSortedOutput;
 
     m_knot.clear();
     for(int i=0; i<pSpline->m_knot.size(); i++)
@@ -110,7 +115,21 @@ double Spline::getY(double const &x) const
 {
     if(x<=0.0 || x>=1.0) return 0.0;
 
-    for (int i=0; i<m_iRes-1; i++)
+    if(m_bSortedOutput)
+    {
+        // first output point strictly after x
+        QVector<Vector2d>::const_iterator it = std::upper_bound(m_Output.constBegin(), m_Output.constEnd(), x,
+                                                                [](double xp, Vector2d const &pt) {return xp<pt.x;});
+        int i = int(it-m_Output.constBegin())-1;
+        if(i<0 || i>=m_Output.size()-1)
+        {
+            if(m_Output.size()>0 && x==m_Output.last().x) return m_Output.last().y;
+            return 0.0;
+        }
+        return m_Output[i].y + (m_Output[i+1].y-m_Output[i].y)/(m_Output[i+1].x-m_Output[i].x)*(x-m_Output[i].x);
+    }
+
+    for (int i=0; i<m_Output.size()-1; i++)
     {
         if (m_Output[i].x <m_Output[i+1].x  && m_Output[i].x <= x && x<=m_Output[i+1].x )
         {
@@ -292,42 +311,163 @@ double Spline::splineBlend(int const &i,  int const &p, double const &t)
 
 
 /**
-* Calculates the spline's output points 
+* Calculates the spline's output points.
+* The points are evaluated with de Boor's algorithm, which only involves the m_iDegree+1 control points of each knot span.
 */
 void Spline::splineCurve()
 {
-    double t=0, increment=0, b=0, w=0;
-
     m_Output.resize(m_iRes);
 
     if (m_CtrlPt.size()>=3)
     {
-        t = 0;
-        increment = 1.0/double(m_iRes - 1);
-        
-        for (int j=0;j<m_iRes;j++)
+        if(!hasValidKnots())
         {
-            m_Output[j].x = 0;
-            m_Output[j].y = 0;
-            w=0.0;
-            for (int i=0; i<m_CtrlPt.size(); i++)
-            {
-                b = splineBlend(i, m_iDegree, t);
-                w +=b;
+            // fewer points than the degree requires, or the knots have not been updated
+            blendCurve();
+        }
+        else
+        {
+            double increment = 1.0/double(m_iRes - 1);
+            for (int j=0; j<m_iRes; j++)
+                m_Output[j] = deBoor(double(j)*increment);
 
-                m_Output[j].x += m_CtrlPt[i].x * b;
-                m_Output[j].y += m_CtrlPt[i].y * b;
-            }
-            m_Output[j] *= 1.0/w;
+            m_Output[m_iRes-1].x = m_CtrlPt.last().x;
+            m_Output[m_iRes-1].y = m_CtrlPt.last().y;
+        }
+    }
+    checkOutputOrder();
+}
+
+
+/**
+* Updates the output points after the displacement of a single control point.
+* Only the points in the control point's support, i.e. the parameter interval [t_i, t_i+p+1[, are recalculated.
+* @param iCtrlPt the index of the control point which has been moved
+*/
+void Spline::updateSplineCurve(int iCtrlPt)
+{
+    if(iCtrlPt<0 || iCtrlPt>=m_CtrlPt.size() || m_CtrlPt.size()<3 || m_Output.size()!=m_iRes || !hasValidKnots())
+    {
+        splineCurve();
+        return;
+    }
+
+    double increment = 1.0/double(m_iRes - 1);
+    // one sample margin on each side, against round-off on the interval bounds
+    int j0 = std::max(0,        int(m_knot.at(iCtrlPt)           /increment)-1);
+    int j1 = std::min(m_iRes-1, int(m_knot.at(iCtrlPt+m_iDegree+1)/increment)+1);
+    for (int j=j0; j<=j1; j++)
+        m_Output[j] = deBoor(double(j)*increment);
+
+    m_Output[m_iRes-1].x = m_CtrlPt.last().x;
+    m_Output[m_iRes-1].y = m_CtrlPt.last().y;
+
+    checkOutputOrder();
+}
+
+
+/** Returns true if the knot vector matches the control points for a spline of degree m_iDegree. */
+bool Spline::hasValidKnots() const
+{
+    return m_iDegree>=1 && m_CtrlPt.size()>m_iDegree && m_knot.size()==m_CtrlPt.size()+m_iDegree+1;
+}
+
+
+/** Returns the index k of the knot span such that t_k <= t < t_k+1, with k in [p, n-1] */
+int Spline::knotSpan(double t) const
+{
+    int n = m_CtrlPt.size();
+    QVector<double>::const_iterator it = std::upper_bound(m_knot.constBegin()+m_iDegree+1, m_knot.constBegin()+n, t);
+    int k = int(it-m_knot.constBegin())-1;
+    return std::max(m_iDegree, std::min(k, n-1));
+}
 
-            t += increment;
+
+/** Evaluates the spline at parameter t using de Boor's algorithm */
+Vector2d Spline::deBoor(double t) const
+{
+    int p = m_iDegree;
+    int k = knotSpan(t);
+
+    Vector2d d[8];
+    QVector<Vector2d> dv;
+    Vector2d *pd = d;
+    if(p+1>8)
+    {
+        dv.resize(p+1);
+        pd = dv.data();
+    }
+
+    for(int j=0; j<=p; j++)
+    {
+        Vector3d const &pt = m_CtrlPt.at(j+k-p);
+        pd[j].x = pt.x;
+        pd[j].y = pt.y;
+    }
+
+    for(int r=1; r<=p; r++)
+    {
+        for(int j=p; j>=r; j--)
+        {
+            double tl = m_knot.at(j+k-p);
+            double tr = m_knot.at(j+1+k-r);
+            double alpha = (tr-tl)>0.0 ? (t-tl)/(tr-tl) : 0.0;
+            pd[j].x = (1.0-alpha)*pd[j-1].x + alpha*pd[j].x;
+            pd[j].y = (1.0-alpha)*pd[j-1].y + alpha*pd[j].y;
         }
+    }
+    return pd[p];
+}
+
 
-        m_Output[m_iRes-1].x = m_CtrlPt.last().x;
-        m_Output[m_iRes-1].y = m_CtrlPt.last().y;
+/**
+* Calculates the output points by summing the blending functions of all control points.
+* Used when the spline does not have enough control points for its degree.
+*/
+void Spline::blendCurve()
+{
+    double t=0, increment=0, b=0, w=0;
+
+    t = 0;
+    increment = 1.0/double(m_iRes - 1);
+
+    for (int j=0;j<m_iRes;j++)
+    {
+        m_Output[j].x = 0;
+        m_Output[j].y = 0;
+        w=0.0;
+        for (int i=0; i<m_CtrlPt.size(); i++)
+        {
+            b = splineBlend(i, m_iDegree, t);
+            w +=b;
+
+            m_Output[j].x += m_CtrlPt[i].x * b;
+            m_Output[j].y += m_CtrlPt[i].y * b;
+        }
+        m_Output[j] *= 1.0/w;
+
+        t += increment;
     }
+
+    m_Output[m_iRes-1].x = m_CtrlPt.last().x;
+    m_Output[m_iRes-1].y = m_CtrlPt.last().y;
 }
 
+
+void Spline::checkOutputOrder()
+{
+    m_bSortedOutput = m_Output.size()>1;
+    for(int i=0; i<m_Output.size()-1; i++)
+    {
+        if(m_Output.at(i+1).x<=m_Output.at(i).x)
+        {
+            m_bSortedOutput = false;
+            break;
+        }
+    }
+}
+
+
 /**
 *Generates an array of standard knot values for this spline.
 */
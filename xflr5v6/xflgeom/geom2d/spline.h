@@ -81,6 +81,7 @@ class Spline : public XflObject
         void copy(Spline *pSpline);
         void copySymetric(Spline *pSpline);
         void splineCurve();
+        void updateSplineCurve(int iCtrlPt);
         void splineKnots();
 
 
@@ -100,6 +101,14 @@ class Spline : public XflObject
         QVector<Vector3d> m_CtrlPt;      /**< the array of the positions of the spline's control points */
         QVector<Vector2d> m_Output;          /**< the array of output points, size of which is m_iRes */
 
+    private:
+        bool hasValidKnots() const;
+        int knotSpan(double t) const;
+        Vector2d deBoor(double t) const;
+        void blendCurve();
+        void checkOutputOrder();
+
+        bool m_bSortedOutput;           /**< true if the output points have strictly increasing x-values, in which case getY() uses a binary search */
 
 };
 
@@ -94,6 +94,13 @@ void GraphWt::paintEvent(QPaintEvent *pEvent)
 
     m_pGraph->drawGraph(painter);
 
+    if(Graph::isHighLighting() && underMouse() && m_pGraph->isInDrawRect(m_LastPoint))
+    {
+        int nSel = -1;
+        Curve *pCurve = m_pGraph->getCurvePoint(m_LastPoint.x(), m_LastPoint.y(), nSel);
+        if(pCurve) m_pGraph->highlight(painter, pCurve, nSel);
+    }
+
     if(m_bOverlayRectangle)
     {
         painter.save();
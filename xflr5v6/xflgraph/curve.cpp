@@ -21,9 +21,17 @@
 
 
 
+#include <algorithm>
+#include <cmath>
+
 #include <xflgraph/curve.h>
 #include <xflgraph/graph.h>
 
+
+int Curve::s_DecimationRatio = 4;
+quint64 Curve::s_LastRevision = 0;
+
+
 /**
  * The public constructor
  */
@@ -35,6 +43,12 @@ Curve::Curve()
     m_theStyle.m_Width = 1;
     m_theStyle.m_Stipple = Line::SOLID;
     m_iSelected = -1;
+
+    m_bPolyDirty = true;
+    m_bDecimated = false;
+    m_PolyScaleX = m_PolyScaleY = 0.0;
+    m_PolyWidth = 0;
+    m_Revision = ++s_LastRevision;
 }
 
 
@@ -48,10 +62,101 @@ int Curve::appendPoint(double xn, double yn)
 {
     m_x.append(xn);
     m_y.append(yn);
+    dataChanged();
     return size();
 }
 
 
+/**
+ * Replaces the curve's data, unless it is identical to the existing data.
+ * The cached screen polyline is left valid if nothing has changed.
+ * @return true if the data has changed
+ */
+bool Curve::setPoints(QVector<double> const &xc, QVector<double> const&yc)
+{
+    if(xc==m_x && yc==m_y) return false;
+    m_x = xc;
+    m_y = yc;
+    dataChanged();
+    return true;
+}
+
+
+/**
+ * Returns the curve's points in screen coordinates.
+ * The polyline is cached and only rebuilt if the data, the scales or the offset have changed.
+ * If the curve has many more points than the client area has pixel columns, each run of consecutive points
+ * which fall in the same pixel column is reduced to its first, lowest, highest and last points.
+ * The drawn line is unchanged at screen resolution.
+ * @param scalex, scaley: the graph's scales
+ * @param offset: the graph's offset in screen coordinates
+ * @param pixelWidth: the width of the client area
+ */
+QPolygonF const &Curve::screenPolyline(double scalex, double scaley, QPoint const &offset, int pixelWidth)
+{
+    int n = std::min(m_x.size(), m_y.size());
+    bool bDecimate = pixelWidth>0 && n>s_DecimationRatio*pixelWidth;
+
+    if(!m_bPolyDirty && scalex==m_PolyScaleX && scaley==m_PolyScaleY && offset==m_PolyOffset
+       && (!bDecimate || pixelWidth==m_PolyWidth)
+       && bDecimate==m_bDecimated && (bDecimate || m_ScreenPoly.size()==n))
+        return m_ScreenPoly;
+
+    m_PolyScaleX = scalex;
+    m_PolyScaleY = scaley;
+    m_PolyOffset = offset;
+    m_PolyWidth  = pixelWidth;
+    m_bDecimated = bDecimate;
+    m_bPolyDirty = false;
+
+    if(!bDecimate)
+    {
+        m_ScreenPoly.resize(n);
+        for (int i=0; i<n; i++)
+            m_ScreenPoly[i] = {m_x.at(i)/scalex+offset.x(), m_y.at(i)/scaley+offset.y()};
+        return m_ScreenPoly;
+    }
+
+    m_ScreenPoly.clear();
+    m_ScreenPoly.reserve(4*pixelWidth+8);
+
+    int i0 = 0;
+    while(i0<n)
+    {
+        QPointF first(m_x.at(i0)/scalex+offset.x(), m_y.at(i0)/scaley+offset.y());
+        int column = int(std::floor(first.x()));
+        int iMin=i0, iMax=i0;
+        QPointF ptMin(first), ptMax(first), last(first);
+        int i1 = i0+1;
+        for(; i1<n; i1++)
+        {
+            QPointF pt(m_x.at(i1)/scalex+offset.x(), m_y.at(i1)/scaley+offset.y());
+            if(int(std::floor(pt.x()))!=column) break;
+            if(pt.y()<ptMin.y()) {ptMin=pt; iMin=i1;}
+            if(pt.y()>ptMax.y()) {ptMax=pt; iMax=i1;}
+            last = pt;
+        }
+
+        // keep the extrema in the order of the data so that the line does not fold back
+        m_ScreenPoly.append(first);
+        if(iMin<iMax)
+        {
+            if(iMin>i0)   m_ScreenPoly.append(ptMin);
+            if(iMax<i1-1) m_ScreenPoly.append(ptMax);
+        }
+        else if(iMax<iMin)
+        {
+            if(iMax>i0)   m_ScreenPoly.append(ptMax);
+            if(iMin<i1-1) m_ScreenPoly.append(ptMin);
+        }
+        if(i1-1>i0) m_ScreenPoly.append(last);
+
+        i0 = i1;
+    }
+    return m_ScreenPoly;
+}
+
+
 /**
  * Copies the data and settings from an existing curve
  * @param pCurve: a pointer to the input curve
@@ -77,6 +182,7 @@ void Curve::copyData(Curve const*pCurve)
     clear();
     m_x = pCurve->m_x;
     m_y = pCurve->m_y;
+    dataChanged();
 }
 
 
@@ -94,10 +200,11 @@ int Curve::closestPoint(double xs, double ys, double &dist) const
     ref = -1;
     dist = 1.e10;
     if (size()<1) return -1;
+    double sx2 = 1.0/m_pParentGraph->xScale()/m_pParentGraph->xScale();
+    double sy2 = 1.0/m_pParentGraph->yScale()/m_pParentGraph->yScale();
     for(int i=0; i<size(); i++)
     {
-        d2 =   (xs-m_x[i])*(xs-m_x[i])/m_pParentGraph->xScale()/m_pParentGraph->xScale()
-             + (ys-m_y[i])*(ys-m_y[i])/m_pParentGraph->yScale()/m_pParentGraph->yScale();
+        d2 = (xs-m_x[i])*(xs-m_x[i])*sx2 + (ys-m_y[i])*(ys-m_y[i])*sy2;
         if (d2<dist)
         {
             dist = d2;
@@ -121,10 +228,11 @@ void Curve::closestPoint(double xs, double ys, double &dist, int &n) const
 {
     dist = 1.e10;
     if (n<1) return;
+    double sx2 = 1.0/m_pParentGraph->xScale()/m_pParentGraph->xScale();
+    double sy2 = 1.0/m_pParentGraph->yScale()/m_pParentGraph->yScale();
     for(int i=0; i<n; i++)
     {
-        double d2 =   (xs-m_x[i])*(xs-m_x[i])/m_pParentGraph->xScale()/m_pParentGraph->xScale()
-                    + (ys-m_y[i])*(ys-m_y[i])/m_pParentGraph->yScale()/m_pParentGraph->yScale();
+        double d2 = (xs-m_x[i])*(xs-m_x[i])*sx2 + (ys-m_y[i])*(ys-m_y[i])*sy2;
         if (d2<dist)
         {
             dist = d2;
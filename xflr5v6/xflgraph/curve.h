@@ -24,6 +24,7 @@
 
 #include <QVector>
 #include <QColor>
+#include <QPolygonF>
 
 
 #include <xflcore/linestyle.h>
@@ -42,15 +43,22 @@ class Curve
         Curve();
 
         int  appendPoint(double xn, double yn);
-        void setPoint(int k, double xc, double yc) {if(k<0||k>m_x.size())return; m_x[k]=xc; m_y[k]=yc;}
-        void setPointStyle(QVector<double> const &xc, QVector<double> const&yc) {m_x=xc; m_y=yc;}
+        void setPoint(int k, double xc, double yc) {if(k<0||k>m_x.size())return; m_x[k]=xc; m_y[k]=yc; dataChanged();}
+        void setPointStyle(QVector<double> const &xc, QVector<double> const&yc) {m_x=xc; m_y=yc; dataChanged();}
+        bool setPoints(QVector<double> const &xc, QVector<double> const&yc);
 
         /**
          * Resets the content of the curve.
          */
-        void clear() {m_x.clear(); m_y.clear();}
+        void clear() {m_x.clear(); m_y.clear(); dataChanged();}
         void reset() {clear();}
-        void resizePoints(int n) {m_x.resize(n); m_y.resize(n);}
+        void resizePoints(int n) {m_x.resize(n); m_y.resize(n); dataChanged();}
+
+        /** Marks the data as modified; required after a direct write to m_x or m_y */
+        void invalidatePolyline() {dataChanged();}
+        QPolygonF const &screenPolyline(double scalex, double scaley, QPoint const &offset, int pixelWidth);
+        bool isDecimated() const {return m_bDecimated;}
+        quint64 revision() const {return m_Revision;}
 
         int     closestPoint(double xs, double ys, double &dist) const;
         void    closestPoint(double xs, double ys, double &dist, int &n) const;
@@ -152,10 +160,25 @@ class Curve
 
 
     private:
+        void dataChanged() {m_bPolyDirty=true; m_Revision=++s_LastRevision;}
+
         QString m_CurveName;                       /**< the curves's name */
         int m_iSelected;                           /**< the index of the curve's currently selected point, or -1 if none is selected */
         Graph *m_pParentGraph;                      /**< a pointer to the parent graph to which this curve belongs */
         LineStyle m_theStyle;
+
+        QPolygonF m_ScreenPoly;                    /**< the cached polyline in screen coordinates */
+        bool m_bPolyDirty;                         /**< true if the data has changed since the polyline was built */
+        bool m_bDecimated;                         /**< true if the cached polyline holds fewer points than the curve */
+        double m_PolyScaleX, m_PolyScaleY;         /**< the graph scales for which the polyline was built */
+        QPoint m_PolyOffset;                       /**< the graph offset for which the polyline was built */
+        int m_PolyWidth;                           /**< the client width in pixels for which the polyline was built */
+        quint64 m_Revision;                        /**< a stamp, unique among all curves, which changes with the data */
+
+        static quint64 s_LastRevision;
+
+    public:
+        static int s_DecimationRatio;              /**< the curve is decimated if it has more than this number of points per pixel column */
 };
 
 
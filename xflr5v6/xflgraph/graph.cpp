@@ -34,6 +34,7 @@
 
 
 bool Graph::s_bHighlightPoint = false;
+int Graph::s_IndexCellSize = 16;
 
 
 QColor Graph::s_CurveColors[] = {QColor(255,   0,   0), QColor(  0,   0, 255), QColor(  0, 255,   0), QColor(255, 255,   0),
@@ -91,6 +92,9 @@ Graph::Graph()
     m_h       = 0;
     m_w       = 0;
 
+    m_nCellX = m_nCellY = 0;
+    m_IndexScaleX = m_IndexScaleY = 0.0;
+
     setGraphDefaults();
 }
 
@@ -176,20 +180,20 @@ void Graph::drawCurve(int nIndex, QPainter &painter)
     rViewRect.setTopLeft(Min);
     rViewRect.setBottomRight(Max);
 
-    QPolygonF polycurve(pCurve->size());
     if(pCurve->size()>=1 && pCurve->isVisible())
     {
-        for (int i=0; i<pCurve->size();i++)
-        {
-            polycurve[i] = {pCurve->x(i)/m_scalex+m_ptoffset.x(), pCurve->y(i)/  scaley+m_ptoffset.y()};
-        }
+        QPolygonF const &polycurve = pCurve->screenPolyline(m_scalex, scaley, m_ptoffset, m_rCltRect.width());
         if(pCurve->width()>=1) painter.drawPolyline(polycurve);
 
-        CurvePen.setStyle(Qt::SolidLine);
-        painter.setPen(CurvePen);
-        for (int i=0; i<polycurve.size(); i++)
+        // the symbols would overlap into a solid band if the curve has been decimated
+        if(pCurve->pointsVisible() && !pCurve->isDecimated())
         {
-            xfl::drawSymbol(painter, pCurve->pointStyle(), m_BkColor, pCurve->color(), polycurve.at(i).x(), polycurve.at(i).y());
+            CurvePen.setStyle(Qt::SolidLine);
+            painter.setPen(CurvePen);
+            for (int i=0; i<polycurve.size(); i++)
+            {
+                xfl::drawSymbol(painter, pCurve->pointStyle(), m_BkColor, pCurve->color(), polycurve.at(i).x(), polycurve.at(i).y());
+            }
         }
     }
 
@@ -990,10 +994,21 @@ void Graph::deleteCurve(QString CurveTitle)
 
 void Graph::deleteCurves()
 {
-    for (int i=m_oaCurves.size()-1; i>=0;i--)
-        delete curve(i);
+    truncateCurves(0);
+}
+
 
-    m_oaCurves.clear();//removes the pointers
+/**
+ * Deletes the curves beyond the first nCurves and resets the automatic limits.
+ * Used to update the graph's curves in place rather than rebuilding them.
+ */
+void Graph::truncateCurves(int nCurves)
+{
+    for (int i=m_oaCurves.size()-1; i>=std::max(nCurves,0);i--)
+    {
+        delete m_oaCurves.at(i);
+        m_oaCurves.removeAt(i);
+    }
 
     if (m_bAutoX && !m_AutoScaleType)
     {
@@ -1624,55 +1639,192 @@ int Graph::yToClient(double y) const
 }
 
 
+/**
+ * Returns the curve point closest to the input graph coordinates, measured on screen.
+ * @param x, y: the graph coordinates
+ * @param xSel, ySel: the coordinates of the closest point
+ * @param nSel: the index of the closest point in its curve
+ * @return a pointer to the curve of the closest point, or nullptr if the graph has no point
+ */
 Curve*  Graph::getClosestPoint(const double &x, const double &y, double &xSel, double &ySel, int &nSel)
 {
-    int i, n1;
-    double dist, dmax, x1, y1;
-    dmax = 1.e40;
-    Curve *pOldCurve, *pCurveSel;
-    pCurveSel = nullptr;
+    QPointF ptClt(x/m_scalex+m_ptoffset.x(), y/m_scaley+m_ptoffset.y());
+    Curve *pCurveSel = nearestPoint(ptClt, 1.e10, nSel);
+    if(pCurveSel)
+    {
+        xSel = pCurveSel->x(nSel);
+        ySel = pCurveSel->y(nSel);
+    }
+    return pCurveSel;
+}
 
-    for(i=0; i<m_oaCurves.size(); i++)
+
+/**
+ * Returns the curve with a point within 4 pixels of the client position.
+ */
+Curve* Graph::getCurvePoint(const int &xClt, const int &yClt,int &nSel)
+{
+    return nearestPoint(QPointF(xClt, yClt), 4.0, nSel);
+}
+
+
+/**
+ * Returns the curve point closest on screen to the client position.
+ * The query uses the screen-space grid of the curve points, which is rebuilt
+ * only if the curves, their data, the scales or the client area have changed.
+ * @param ptClt: the position in client coordinates
+ * @param maxDist: the max distance in pixels
+ * @param nSel: the index of the point in its curve, or -1 if none was found
+ * @return a pointer to the point's curve, or nullptr if there is no point within maxDist
+ */
+Curve* Graph::nearestPoint(QPointF const &ptClt, double maxDist, int &nSel)
+{
+    nSel = -1;
+    if(!isPointIndexValid()) makePointIndex();
+    if(m_CellPt.isEmpty()) return nullptr;
+
+    double best = maxDist*maxDist;
+    int iBest = -1;
+
+    double cx = (ptClt.x()-m_IndexRect.left())/s_IndexCellSize;
+    double cy = (ptClt.y()-m_IndexRect.top()) /s_IndexCellSize;
+    if(cx<0.0 || cy<0.0 || cx>=m_nCellX || cy>=m_nCellY)
     {
-        pOldCurve = m_oaCurves.at(i);
-        pOldCurve->closestPoint(x, y, x1, y1, dist, n1);
-        if(dist<dmax)
+        // outside the grid; the distance bounds of the rings do not hold
+        for(int k=0; k<m_CellPt.size(); k++)
         {
-            dmax = dist;
-            xSel = x1;
-            ySel = y1;
-            pCurveSel = pOldCurve;
-            nSel = i;
+            double dx = m_CellPt.at(k).x()-ptClt.x();
+            double dy = m_CellPt.at(k).y()-ptClt.y();
+            if(dx*dx+dy*dy<best) {best = dx*dx+dy*dy; iBest = k;}
         }
     }
-    return pCurveSel;
+    else
+    {
+        int ic = int(cx);
+        int jc = int(cy);
+        int rMax = std::max(m_nCellX, m_nCellY);
+        for(int r=0; r<=rMax; r++)
+        {
+            // the points of ring r are at least r-1 cells away
+            double dmin = double((r-1)*s_IndexCellSize);
+            if(r>1 && dmin*dmin>best) break;
+
+            for(int j=jc-r; j<=jc+r; j++)
+            {
+                if(j<0 || j>=m_nCellY) continue;
+                bool bEdge = (j==jc-r || j==jc+r);
+                int step = (bEdge || r==0) ? 1 : 2*r;
+                for(int i=ic-r; i<=ic+r; i+=step)
+                {
+                    if(i<0 || i>=m_nCellX) continue;
+                    int cell = j*m_nCellX + i;
+                    for(int k=m_CellStart.at(cell); k<m_CellStart.at(cell+1); k++)
+                    {
+                        double dx = m_CellPt.at(k).x()-ptClt.x();
+                        double dy = m_CellPt.at(k).y()-ptClt.y();
+                        if(dx*dx+dy*dy<best) {best = dx*dx+dy*dy; iBest = k;}
+                    }
+                }
+            }
+        }
+    }
+
+    if(iBest<0) return nullptr;
+    nSel = m_CellPoint.at(iBest);
+    return m_oaCurves.at(m_CellCurve.at(iBest));
 }
 
 
-Curve* Graph::getCurvePoint(const int &xClt, const int &yClt,int &nSel)
+bool Graph::isPointIndexValid() const
 {
-    int i, n, xc, yc;
-    double dist, x1, y1, x,y;
-    Curve *pOldCurve;
+    if(m_IndexRect!=m_rCltRect || m_IndexOffset!=m_ptoffset) return false;
+    if(m_IndexScaleX!=m_scalex || m_IndexScaleY!=m_scaley)   return false;
+    if(m_IndexCurve.size()!=m_oaCurves.size())               return false;
+    for(int ic=0; ic<m_oaCurves.size(); ic++)
+    {
+        Curve const *pCurve = m_oaCurves.at(ic);
+        if(m_IndexCurve.at(ic).first!=pCurve || m_IndexCurve.at(ic).second!=pCurve->revision()) return false;
+        if(m_IndexVisible.at(ic)!=pCurve->isVisible()) return false;
+    }
+    return true;
+}
 
-    x= clientTox(xClt);
-    y= clientToy(yClt);
-    for(i=0; i<m_oaCurves.size(); i++)
+
+/**
+ * Sorts the curve points in a uniform grid of the client area.
+ * The points outside the client area are stored in the nearest border cell.
+ * The hidden curves are not indexed, so that their points cannot be hovered or selected.
+ */
+void Graph::makePointIndex()
+{
+    m_IndexRect   = m_rCltRect;
+    m_IndexOffset = m_ptoffset;
+    m_IndexScaleX = m_scalex;
+    m_IndexScaleY = m_scaley;
+    m_IndexCurve.resize(m_oaCurves.size());
+    m_IndexVisible.resize(m_oaCurves.size());
+
+    m_nCellX = std::max(1, (m_IndexRect.width() +s_IndexCellSize-1)/s_IndexCellSize);
+    m_nCellY = std::max(1, (m_IndexRect.height()+s_IndexCellSize-1)/s_IndexCellSize);
+
+    int nPts = 0;
+    for(int ic=0; ic<m_oaCurves.size(); ic++)
     {
-        pOldCurve = m_oaCurves.at(i);
-        pOldCurve->closestPoint(x, y, x1, y1, dist, n);
+        m_IndexCurve[ic] = {m_oaCurves.at(ic), m_oaCurves.at(ic)->revision()};
+        m_IndexVisible[ic] = m_oaCurves.at(ic)->isVisible();
+        if(m_IndexVisible.at(ic)) nPts += m_oaCurves.at(ic)->size();
+    }
 
-        xc = xToClient(x1);
-        yc = yToClient(y1);
+    QVector<QPointF> pts(nPts);
+    QVector<int> cellOf(nPts, -1);
+    m_CellStart.fill(0, m_nCellX*m_nCellY+1);
 
-        if((xClt-xc)*(xClt-xc) + (yClt-yc)*(yClt-yc) <16)//sqrt(16) pixels distance
+    int k=0;
+    for(int ic=0; ic<m_oaCurves.size(); ic++)
+    {
+        Curve const *pCurve = m_oaCurves.at(ic);
+        if(!m_IndexVisible.at(ic)) continue;
+        for(int i=0; i<pCurve->size(); i++)
         {
-            nSel = n;
-            return pOldCurve;
+            QPointF pt(pCurve->x(i)/m_scalex+m_ptoffset.x(), pCurve->y(i)/m_scaley+m_ptoffset.y());
+            pts[k] = pt;
+            if(std::isfinite(pt.x()) && std::isfinite(pt.y()))
+            {
+                double cx = (pt.x()-m_IndexRect.left())/s_IndexCellSize;
+                double cy = (pt.y()-m_IndexRect.top()) /s_IndexCellSize;
+                int i0 = cx<0.0 ? 0 : (cx>=m_nCellX ? m_nCellX-1 : int(cx));
+                int j0 = cy<0.0 ? 0 : (cy>=m_nCellY ? m_nCellY-1 : int(cy));
+                cellOf[k] = j0*m_nCellX + i0;
+                m_CellStart[cellOf[k]+1]++;
+            }
+            k++;
+        }
+    }
+
+    for(int c=0; c<m_nCellX*m_nCellY; c++) m_CellStart[c+1] += m_CellStart.at(c);
+
+    int nIndexed = m_CellStart.last();
+    m_CellPt.resize(nIndexed);
+    m_CellCurve.resize(nIndexed);
+    m_CellPoint.resize(nIndexed);
+
+    QVector<int> fill(m_CellStart);
+    k=0;
+    for(int ic=0; ic<m_oaCurves.size(); ic++)
+    {
+        if(!m_IndexVisible.at(ic)) continue;
+        for(int i=0; i<m_oaCurves.at(ic)->size(); i++)
+        {
+            if(cellOf.at(k)>=0)
+            {
+                int pos = fill[cellOf.at(k)]++;
+                m_CellPt[pos]    = pts.at(k);
+                m_CellCurve[pos] = ic;
+                m_CellPoint[pos] = i;
+            }
+            k++;
         }
     }
-    nSel = -1;
-    return  nullptr;
 }
 
 
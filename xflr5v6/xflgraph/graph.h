@@ -25,6 +25,8 @@
 #include <QSettings>
 #include <QFile>
 #include <QPoint>
+#include <QPointF>
+#include <QPair>
 #include <QRect>
 #include <QColor>
 #include <QVector>
@@ -129,6 +131,7 @@ class Graph
         void deselectPoint();
         Curve * getCurvePoint(const int &xClt, const int &yClt, int &nSel);
         Curve * getClosestPoint(double const &x, double const &y, double &xSel, double &ySel, int &nSel);
+        Curve * nearestPoint(QPointF const &ptClt, double maxDist, int &nSel);
         void resetLimits();
         void resetCurves();
         void scaleAxes(double zoom);
@@ -233,6 +236,7 @@ class Graph
         void deleteCurve(Curve *pCurve);
         void deleteCurve(QString CurveTitle);
         void deleteCurves();
+        void truncateCurves(int nCurves);
         void resetXLimits();
         void resetYLimits();
 
@@ -253,6 +257,11 @@ class Graph
         virtual ~Graph();
 
         static QColor s_CurveColors[10];
+        static int s_IndexCellSize;       /**< the size in pixels of the cells of the point picking grid */
+
+    private:
+        bool isPointIndexValid() const;
+        void makePointIndex();
 
     private:
 
@@ -294,6 +303,18 @@ class Graph
 
         int m_X, m_Y; //index of X and Y variables
 
+        // screen-space grid of the curve points, used for point picking
+        QVector<int> m_CellStart;          /**< the index in the entry arrays of the first point of each cell, in compressed row format */
+        QVector<QPointF> m_CellPt;         /**< the point's screen position */
+        QVector<int> m_CellCurve;          /**< the index of the point's curve */
+        QVector<int> m_CellPoint;          /**< the index of the point in its curve */
+        int m_nCellX, m_nCellY;
+        QRect m_IndexRect;                 /**< the client rectangle for which the grid was built */
+        double m_IndexScaleX, m_IndexScaleY;
+        QPoint m_IndexOffset;
+        QVector<QPair<Curve const*, quint64>> m_IndexCurve; /**< the curves and their revisions at the time the grid was built */
+        QVector<bool> m_IndexVisible;      /**< the visibility of the curves at the time the grid was built; hidden curves are not indexed */
+
 
     private:
         QFont m_TitleFont;
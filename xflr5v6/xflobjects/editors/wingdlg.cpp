@@ -552,13 +552,89 @@ void WingDlg::onDescriptionChanged()
 void WingDlg::onCellChanged(QWidget *)
 {
     m_bChanged = true;
-    m_pglWingView->resetglWing();
+    m_pglWingView->startEditTimer();
+
+    QVector<WingSection> oldSection = m_pWing->m_Section;
+    int nOldSurfaces = m_pWing->m_Surface.size();
+
     readParams();
     setWingData();
+
+    if(nOldSurfaces==m_pWing->m_Surface.size())
+        m_pglWingView->resetglWingSurfaces(modifiedSurfaces(oldSection));
+    else
+        m_pglWingView->resetglWing();
+
     m_pglWingView->update();
 }
 
 
+/**
+ * Returns the indexes of the surfaces whose geometry depends on the sections which differ from the previous ones.
+ * A change of chord, offset, twist or foil only affects the two surfaces adjacent to the section.
+ * A change of span position or dihedral moves all the surfaces outboard of the section.
+ * Changes of the panel numbers and distributions only affect the mesh.
+ * The texture coordinates are normalized by the extent of the whole wing, see Wing::getTextureUV(),
+ * so that all the surfaces are modified if the extent has changed.
+ */
+QVector<int> WingDlg::modifiedSurfaces(QVector<WingSection> const &oldSection) const
+{
+    QVector<int> surfaces;
+    int nSections = m_pWing->NWingSection();
+    if(oldSection.size()!=nSections || textureExtent(oldSection)!=textureExtent(m_pWing->m_Section))
+    {
+        for(int j=0; j<m_pWing->m_Surface.size(); j++) surfaces.append(j);
+        return surfaces;
+    }
+
+    QVector<bool> bLocal(nSections, false);
+    int iOutboard = nSections;
+    for(int is=0; is<nSections; is++)
+    {
+        WingSection const &oldWS = oldSection.at(is);
+        WingSection const &newWS = m_pWing->m_Section.at(is);
+
+        if(qAbs(oldWS.m_YPosition-newWS.m_YPosition)>0.0 || qAbs(oldWS.m_Dihedral-newWS.m_Dihedral)>0.0)
+            iOutboard = qMin(iOutboard, is);
+
+        if(qAbs(oldWS.m_Chord-newWS.m_Chord)>0.0 || qAbs(oldWS.m_Offset-newWS.m_Offset)>0.0 || qAbs(oldWS.m_Twist-newWS.m_Twist)>0.0 ||
+           oldWS.m_LeftFoilName!=newWS.m_LeftFoilName || oldWS.m_RightFoilName!=newWS.m_RightFoilName)
+            bLocal[is] = true;
+    }
+
+    for(int j=0; j<m_pWing->m_Surface.size(); j++)
+    {
+        Surface const &surf = m_pWing->m_Surface.at(j);
+        int inner = surf.innerSection();
+        int outer = surf.outerSection();
+        if(inner<0 || outer>=nSections || outer>=iOutboard || bLocal.at(inner) || bLocal.at(outer))
+            surfaces.append(j);
+    }
+    return surfaces;
+}
+
+
+/**
+ * Returns the extent of the sections used to normalize the texture coordinates: xMin, xMax, yMin and yMax.
+ */
+QVector<double> WingDlg::textureExtent(QVector<WingSection> const &section)
+{
+    QVector<double> extent(4, 0.0);
+    if(section.isEmpty()) return extent;
+
+    extent[0] = 100000.0;
+    extent[1] = -100000.0;
+    for(int is=0; is<section.size(); is++)
+    {
+        extent[0] = qMin(extent[0], section.at(is).m_Offset);
+        extent[1] = qMax(extent[1], section.at(is).m_Offset + section.at(is).m_Chord);
+    }
+    extent[2] = section.first().m_YPosition;
+    extent[3] = section.last().m_YPosition;
+    return extent;
+}
+
+
 void WingDlg::onDeleteSection()
 {
     if(m_iSection <0 || m_iSection>m_pWing->NWingSection()) return;
@@ -39,6 +39,7 @@
 #include <QDialogButtonBox>
 
 #include <xflgeom/geom3d/vector3d.h>
+#include <xflobjects/objects3d/wingsection.h>
 
 class gl3dWingView;
 class DoubleEdit;
@@ -119,6 +120,8 @@ class WingDlg: public QDialog
         bool checkWing();
         void createXPoints(int NXPanels, int XDist, Foil *pFoilA, Foil *pFoilB, double *xPointA, double *xPointB, int &NXLead, int &NXFlap);
         void computeGeometry();
+        QVector<int> modifiedSurfaces(QVector<WingSection> const &oldSection) const;
+        static QVector<double> textureExtent(QVector<WingSection> const &section);
 
         void setWingData();
         void fillDataTable();
@@ -20,12 +20,72 @@
 *****************************************************************************/
 
 #include <QStringList>
+#include <QMultiHash>
+#include <QThread>
+#include <QtConcurrent/QtConcurrent>
 
 
 #include "body.h"
 #include <xflobjects/objects_global.h>
 #include <xflcore/xflcore.h>
 
+
+int Body::s_MaxTessellations = 4;
+QMutex Body::s_TessellationMutex;
+
+
+namespace
+{
+    /**
+     * Finds the coincident nodes in constant time, with the same tolerance as Vector3d::isSame().
+     * The nodes are sorted in cubic cells of the size of the tolerance,
+     * so that the coincident nodes are in the same or in adjacent cells.
+     */
+    class NodeIndex
+    {
+        public:
+            NodeIndex(QVector<Vector3d> const &nodes) : m_Node(nodes)
+            {
+                for(int in=0; in<m_Node.size(); in++) insert(in);
+            }
+
+            void insert(int in)
+            {
+                Vector3d const &pt = m_Node.at(in);
+                m_Cell.insert(key(cell(pt.x), cell(pt.y), cell(pt.z)), in);
+            }
+
+            /** Returns the highest index of the nodes which coincide with the point, or -1 if none */
+            int find(Vector3d const &pt) const
+            {
+                qint64 ix=cell(pt.x), iy=cell(pt.y), iz=cell(pt.z);
+                int found = -1;
+                for(qint64 i=ix-1; i<=ix+1; i++)
+                {
+                    for(qint64 j=iy-1; j<=iy+1; j++)
+                    {
+                        for(qint64 k=iz-1; k<=iz+1; k++)
+                        {
+                            auto it = m_Cell.constFind(key(i,j,k));
+                            for(; it!=m_Cell.constEnd() && it.key()==key(i,j,k); ++it)
+                            {
+                                if(it.value()>found && m_Node.at(it.value()).isSame(pt)) found = it.value();
+                            }
+                        }
+                    }
+                }
+                return found;
+            }
+
+        private:
+            static qint64 cell(double c) {return qint64(std::floor(c/1.0e-6));}
+            static quint64 key(qint64 i, qint64 j, qint64 k) {return quint64(i)*73856093ULL ^ quint64(j)*19349663ULL ^ quint64(k)*83492791ULL;}
+
+            QVector<Vector3d> const &m_Node;
+            QMultiHash<quint64, int> m_Cell;
+    };
+}
+
 /**
  * The public constructor
  */
@@ -341,6 +401,124 @@ double Body::getu(double x) const
     return m_SplineSurface.getu(x,0.0);
 }
 
+
+/**
+ * Returns the tessellation of the NURBS surface at evenly spaced stations, i.e. u=k/nx and v=l/nh.
+ * @see tessellation(QVector<double> const &, int, bool)
+ */
+BodyTessellation Body::tessellation(int nx, int nh, bool bNormals) const
+{
+    QVector<double> uStations(nx+1);
+    for(int k=0; k<=nx; k++) uStations[k] = double(k)/double(nx);
+    return tessellation(uStations, nh, bNormals);
+}
+
+
+/**
+ * Returns the points of the right side of the NURBS surface at the u stations and at v=l/nh.
+ * The tessellations are cached and shared by the meshing, the inertia calculation, the exports and the display.
+ * They are evaluated again only if the frames, the degrees or the knots have changed.
+ * The rows of constant u are evaluated in parallel.
+ * The method may be called concurrently by the analysis threads and by the display.
+ * @param uStations the stations in the u direction
+ * @param nh the number of intervals in the hoop direction
+ * @param bNormals true if the normals are also required
+ * @return a shallow copy of the cached tessellation, which remains valid when the cache is updated
+ */
+BodyTessellation Body::tessellation(QVector<double> const &uStations, int nh, bool bNormals) const
+{
+    QVector<double> key;
+    surfaceKey(key);
+
+    QMutexLocker locker(&s_TessellationMutex);
+    if(key!=m_TessellationKey)
+    {
+        m_Tessellation.clear();
+        m_TessellationKey = key;
+    }
+
+    for(int it=m_Tessellation.size()-1; it>=0; it--)
+    {
+        BodyTessellation const &tess = m_Tessellation.at(it);
+        if(tess.m_nh==nh && tess.m_u==uStations && (tess.m_bNormals || !bNormals))
+        {
+            if(it<m_Tessellation.size()-1) m_Tessellation.append(m_Tessellation.takeAt(it));
+            return m_Tessellation.last();
+        }
+    }
+
+    if(m_Tessellation.size()>=s_MaxTessellations) m_Tessellation.removeFirst();
+
+    BodyTessellation tess;
+    tess.m_u = uStations;
+    tess.m_nh = nh;
+    tess.m_bNormals = bNormals;
+    tess.m_Pt.resize(uStations.size()*(nh+1));
+    if(bNormals) tess.m_N.resize(uStations.size()*(nh+1));
+
+    // evaluate blocks of rows in parallel
+    int nRows = uStations.size();
+    int nBlocks = std::max(1, std::min(nRows, QThread::idealThreadCount()));
+    QFutureSynchronizer<void> futureSync;
+    for(int ib=0; ib<nBlocks; ib++)
+    {
+        int k0 = (ib*nRows)/nBlocks;
+        int k1 = ((ib+1)*nRows)/nBlocks;
+        futureSync.addFuture(QtConcurrent::run(this, &Body::tessellateRows, &tess, k0, k1));
+    }
+    futureSync.waitForFinished();
+
+    m_Tessellation.append(tess);
+    return m_Tessellation.last();
+}
+
+
+void Body::clearTessellations() const
+{
+    QMutexLocker locker(&s_TessellationMutex);
+    m_Tessellation.clear();
+}
+
+
+/** Evaluates the rows k0 to k1-1 of the tessellation */
+void Body::tessellateRows(BodyTessellation *pTess, int k0, int k1) const
+{
+    int nh = pTess->m_nh;
+    for(int k=k0; k<k1; k++)
+    {
+        double u = pTess->m_u.at(k);
+        for(int l=0; l<=nh; l++)
+        {
+            double v = double(l)/double(nh);
+            m_SplineSurface.getPoint(u, v, pTess->m_Pt[k*(nh+1)+l]);
+            if(pTess->m_bNormals) m_SplineSurface.getNormal(u, v, pTess->m_N[k*(nh+1)+l]);
+        }
+    }
+}
+
+
+/**
+ * Builds the array of the values which define the NURBS surface: degrees, weights, knots and frames.
+ * Two surfaces with the same key have the same points.
+ */
+void Body::surfaceKey(QVector<double> &key) const
+{
+    NURBSSurface const &surf = m_SplineSurface;
+    key.clear();
+    key.reserve(8 + surf.m_nuKnots + surf.m_nvKnots + frameCount()*(1+3*framePointCount()));
+    key << surf.m_iuDegree << surf.m_ivDegree << surf.m_EdgeWeightu << surf.m_EdgeWeightv;
+    key << surf.m_nuKnots << surf.m_nvKnots << frameCount() << framePointCount();
+    for(int i=0; i<surf.m_nuKnots; i++) key << surf.m_uKnots[i];
+    for(int i=0; i<surf.m_nvKnots; i++) key << surf.m_vKnots[i];
+    for(int iFr=0; iFr<frameCount(); iFr++)
+    {
+        Frame const *pFrame = surf.m_pFrame.at(iFr);
+        key << pFrame->position().x << pFrame->position().y << pFrame->position().z;
+        for(int ip=0; ip<pFrame->m_CtrlPoint.size(); ip++)
+            key << pFrame->m_CtrlPoint.at(ip).x << pFrame->m_CtrlPoint.at(ip).y << pFrame->m_CtrlPoint.at(ip).z;
+    }
+}
+
 /**
  * For a NURBS surface: Given a value of the longitudinal parameter and a vector in the yz plane, returns the
  * value of the hoop parameter for the intersection of a ray originating on the x-axis
@@ -1115,7 +1293,7 @@ void Body::computeBodyAxisInertia()
  */
 void Body::computeVolumeInertia(Vector3d &CoG, double &CoGIxx, double &CoGIyy, double &CoGIzz, double &CoGIxz) const
 {
-    double ux(0), rho(0);
+    double rho(0);
     double dj(0), dj1(0);
     double BodyArea(0);
     double SectionArea(0);
@@ -1259,27 +1437,44 @@ void Body::computeVolumeInertia(Vector3d &CoG, double &CoGIxx, double &CoGIyy, d
     else if(m_LineType==xfl::BODYSPLINETYPE)
     {
         int NSections = 20;//why not ?
-        xpos = framePosition(0);
+        int NPoints = 10;// hoop intervals for the arc length
         dl = length()/double(NSections-1);
 
-        for (int j=0; j<NSections-1; j++)
+        // the sections and their mid-points are evaluated once on the shared tessellation
+        // even rows are the sections at xpos, odd rows are the mid-points at xpos+dl/2
+        QVector<double> uStations(2*NSections-1);
+        xpos = framePosition(0);
+        for (int j=0; j<uStations.size(); j++) uStations[j] = getu(xpos + double(j)*dl/2.0);
+
+        BodyTessellation const &tess = tessellation(uStations, NPoints);
+
+        QVector<double> ArcLength(NSections);
+        for (int j=0; j<NSections; j++)
         {
-            BodyArea += dl * (getSectionArcLength(xpos)+ getSectionArcLength(xpos+dl)) /2.0;
-            xpos += dl;
+            double arc = 0.0;
+            for(int l=1; l<=NPoints; l++)
+            {
+                Vector3d const &P0 = tess.point(2*j, l-1);
+                Vector3d const &P1 = tess.point(2*j, l);
+                arc += sqrt((P1.y-P0.y)*(P1.y-P0.y) + (P1.z-P0.z)*(P1.z-P0.z));
+            }
+            ArcLength[j] = arc*2.0; //to account for left side.
         }
 
+        for (int j=0; j<NSections-1; j++)
+            BodyArea += dl * (ArcLength.at(j)+ ArcLength.at(j+1)) /2.0;
+
         rho = m_VolumeMass / BodyArea;
 
         // First evaluate CoG, assuming each section is a point mass
         xpos = framePosition(0);
         for (int j=0; j<NSections-1; j++)
         {
-            SectionArea = dl * (getSectionArcLength(xpos)+ getSectionArcLength(xpos+dl))/2.0;
+            SectionArea = dl * (ArcLength.at(j)+ ArcLength.at(j+1))/2.0;
             Pt.x = xpos + dl/2.0;
             Pt.y = 0.0;
-            ux = getu(Pt.x);
-            getPoint(ux, 0.0, true, Top);
-            getPoint(ux, 1.0, true, Bot);
+            Top = tess.point(2*j+1, 0);
+            Bot = tess.point(2*j+1, NPoints);
             Pt.z = (Top.z + Bot.z)/2.0;
             xpos += dl;
 
@@ -1294,12 +1489,11 @@ void Body::computeVolumeInertia(Vector3d &CoG, double &CoGIxx, double &CoGIyy, d
         xpos = framePosition(0);
         for (int j=0; j<NSections-1; j++)
         {
-            SectionArea = dl * (getSectionArcLength(xpos)+ getSectionArcLength(xpos+dl))/2.0;
+            SectionArea = dl * (ArcLength.at(j)+ ArcLength.at(j+1))/2.0;
             Pt.x = xpos + dl/2.0;
             Pt.y = 0.0;
-            ux = getu(Pt.x);
-            getPoint(ux, 0.0, true, Top);
-            getPoint(ux, 1.0, true, Bot);
+            Top = tess.point(2*j+1, 0);
+            Bot = tess.point(2*j+1, NPoints);
             Pt.z = (Top.z + Bot.z)/2.0;
 
             CoGIxx += SectionArea*rho * ( (Pt.y-CoG.y)*(Pt.y-CoG.y) + (Pt.z-CoG.z)*(Pt.z-CoG.z) );
@@ -1396,8 +1590,8 @@ void Body::exportGeometry(QTextStream &outStream, int type, double mtoUnit, int
 {
     QString strong, LengthUnit,str;
     int k,l;
-    double u, v;
     Vector3d Point;
+    BodyTessellation const &tess = tessellation(nx-1, nh-1);
 
 
     if(type==1)    str="";
@@ -1416,12 +1610,9 @@ void Body::exportGeometry(QTextStream &outStream, int type, double mtoUnit, int
         strong = QString(("  Cross Section ")+str+"%1\n").arg(k+1,3);
         outStream  << (strong);
 
-        u = double(k) / double(nx-1);
-
         for (l=0; l<nh; l++)
         {
-            v = double(l) / double(nh-1);
-            getPoint(u,  v, true, Point);
+            Point = tess.point(k, l);
 
             //increased precision i.a.w. request #18
             /*            strong = QString("   %1"+str+"     %2"+str+"     %3\n")
@@ -1970,23 +2161,12 @@ void Body::exportSTLBinary(QDataStream &outStream, int nXPanels, int nHoopPanels
 void Body::exportSTLBinarySplines(QDataStream &outStream, int nXPanels, int nHoopPanels, double unitd) const
 {
     Vector3d N, Pt;
-    QVector<Vector3d> m_T((nXPanels+1)*(nHoopPanels+1)); //temporary points to save calculation times for body NURBS surfaces
+    QVector<Vector3d> const m_T = tessellation(nXPanels, nHoopPanels).m_Pt;
     Vector3d TALB, LATB;
 
     float unitf = float(unitd);
 
     int p = 0;
-    for (int k=0; k<=nXPanels; k++)
-    {
-        double u = double(k) / double(nXPanels);
-        for (int l=0; l<=nHoopPanels; l++)
-        {
-            double v = double(l) / double(nHoopPanels);
-            getPoint(u,  v, true, m_T[p]);
-
-            p++;
-        }
-    }
 
 
     //Number of triangles
@@ -2292,19 +2472,9 @@ void Body::exportSTLBinaryFlatPanels(QDataStream &outStream, double unitd) const
 }
 
 
-int Body::isNode(Vector3d &Pt, QVector<Vector3d> &m_Node)
-{
-    for (int in=m_Node.size()-1; in>=0; in--)
-    {
-        if(Pt.isSame(m_Node[in])) return in;
-    }
-    return -1;
-}
-
-
 int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QVector<Vector3d> &nodes)
 {
-    double uk(0), uk1(0), v(0), dj(0), dj1(0), dl1(0);
+    double dj(0), dj1(0), dl1(0);
     double dpx(0), dpz(0);
     Vector3d LATB, TALB;
     Vector3d LA, LB, TA, TB;
@@ -2317,6 +2487,8 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
 
     int p = 0;
 
+    NodeIndex nodeIndex(nodes);
+
     int FullSize = 0;
     int nPanels = 0;
     int nNodes = 0;
@@ -2373,10 +2545,10 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                         LA = PLB * (1.0- dl1) + PLA * dl1;
                         TA = PTB * (1.0- dl1) + PTA * dl1;
 
-                        n0 = isNode(LA, nodes);
-                        n1 = isNode(TA, nodes);
-                        n2 = isNode(LB, nodes);
-                        n3 = isNode(TB, nodes);
+                        n0 = nodeIndex.find(LA);
+                        n1 = nodeIndex.find(TA);
+                        n2 = nodeIndex.find(LB);
+                        n3 = nodeIndex.find(TB);
 
                         panels.append(Panel());
                         Panel &panel = panels.last();
@@ -2386,6 +2558,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                         else {
                             panel.m_iLA = nNodes;
                             nodes.push_back(LA);
+                            nodeIndex.insert(nodes.size()-1);
                             nNodes++;
                         }
 
@@ -2395,6 +2568,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                         else {
                             panel.m_iTA = nNodes;
                             nodes.push_back(TA);
+                            nodeIndex.insert(nodes.size()-1);
                             nNodes++;
                         }
 
@@ -2404,6 +2578,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                         else {
                             panel.m_iLB = nNodes;
                             nodes.push_back(LB);
+                            nodeIndex.insert(nodes.size()-1);
                             nNodes++;
                         }
 
@@ -2413,6 +2588,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                         else {
                             panel.m_iTB = nNodes;
                             nodes.push_back(TB);
+                            nodeIndex.insert(nodes.size()-1);
                             nNodes++;
                         }
 
@@ -2458,14 +2634,14 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
     else if(isSplineType())
     {
         FullSize = 2*nx*nh;
+        BodyTessellation const &tess = tessellation(m_XPanelPos, nh);
         //start with left side... same as for wings
         for (int k=0; k<nx; k++)
         {
-            uk  = m_XPanelPos.at(k);
-            uk1 = m_XPanelPos.at(k+1);
-
-            getPoint(uk,  0, false, LB);
-            getPoint(uk1, 0, false, TB);
+            LB = tess.point(k,   0);
+            TB = tess.point(k+1, 0);
+            LB.y = -LB.y;
+            TB.y = -TB.y;
 
             LB.x += dpx;
             LB.z += dpz;
@@ -2475,19 +2651,20 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
             for (int l=0; l<nh; l++)
             {
                 //start with left side... same as for wings
-                v = double(l+1) / double(nh);
-                getPoint(uk,  v, false, LA);
-                getPoint(uk1, v, false, TA);
+                LA = tess.point(k,   l+1);
+                TA = tess.point(k+1, l+1);
+                LA.y = -LA.y;
+                TA.y = -TA.y;
 
                 LA.x += dpx;
                 LA.z += dpz;
                 TA.x += dpx;
                 TA.z += dpz;
 
-                n0 = isNode(LA, nodes);
-                n1 = isNode(TA, nodes);
-                n2 = isNode(LB, nodes);
-                n3 = isNode(TB, nodes);
+                n0 = nodeIndex.find(LA);
+                n1 = nodeIndex.find(TA);
+                n2 = nodeIndex.find(LB);
+                n3 = nodeIndex.find(TB);
 
                 panels.append(Panel());
                 Panel &panel = panels.last();
@@ -2497,6 +2674,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                 else {
                     panel.m_iLA = nNodes;
                     nodes.push_back(LA);
+                    nodeIndex.insert(nodes.size()-1);
                     nNodes++;
                 }
 
@@ -2506,6 +2684,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                 else {
                     panel.m_iTA = nNodes;
                     nodes.push_back(TA);
+                    nodeIndex.insert(nodes.size()-1);
                     nNodes++;
                 }
 
@@ -2515,6 +2694,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                 else {
                     panel.m_iLB = nNodes;
                     nodes.push_back(LB);
+                    nodeIndex.insert(nodes.size()-1);
                     nNodes++;
                 }
 
@@ -2524,6 +2704,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
                 else {
                     panel.m_iTB = nNodes;
                     nodes.push_back(TB);
+                    nodeIndex.insert(nodes.size()-1);
                     nNodes++;
                 }
 
@@ -2581,10 +2762,10 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
             TA.y = -TA.y;
             TB.y = -TB.y;
 
-            n0 = isNode(LA, nodes);
-            n1 = isNode(TA, nodes);
-            n2 = isNode(LB, nodes);
-            n3 = isNode(TB, nodes);
+            n0 = nodeIndex.find(LA);
+            n1 = nodeIndex.find(TA);
+            n2 = nodeIndex.find(LB);
+            n3 = nodeIndex.find(TB);
 
             panels.append(Panel());
             Panel &panel = panels.last();
@@ -2594,6 +2775,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
             else {
                 panel.m_iLA = nNodes;
                 nodes.push_back(LA);
+                nodeIndex.insert(nodes.size()-1);
                 nNodes++;
             }
 
@@ -2603,6 +2785,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
             else {
                 panel.m_iTA = nNodes;
                 nodes.push_back(TA);
+                nodeIndex.insert(nodes.size()-1);
                 nNodes++;
             }
 
@@ -2612,6 +2795,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
             else {
                 panel.m_iLB = nNodes;
                 nodes.push_back(LB);
+                nodeIndex.insert(nodes.size()-1);
                 nNodes++;
             }
 
@@ -2621,6 +2805,7 @@ int Body::makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QV
             else {
                 panel.m_iTB = nNodes;
                 nodes.push_back(TB);
+                nodeIndex.insert(nodes.size()-1);
                 nNodes++;
             }
 
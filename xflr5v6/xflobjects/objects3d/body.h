@@ -29,6 +29,7 @@
 
 
 #include <QColor>
+#include <QMutex>
 #include <QTextStream>
 #include <QVarLengthArray>
 
@@ -44,6 +45,25 @@
 
 class Triangle3d;
 
+
+/**
+ * A grid of points evaluated on the right side of the NURBS surface,
+ * at a set of stations in u and at evenly spaced stations in v.
+ */
+struct BodyTessellation
+{
+    QVector<double> m_u;            /**< the stations in the u direction */
+    int m_nh = 0;                   /**< the number of intervals in the hoop direction, i.e. v=l/m_nh */
+    bool m_bNormals = false;        /**< true if the normals have been evaluated */
+    QVector<Vector3d> m_Pt;         /**< the points, by rows of constant u */
+    QVector<Vector3d> m_N;          /**< the normals at the points, if requested */
+
+    int nx() const {return m_u.size()-1;}
+    Vector3d const &point(int k, int l) const {return m_Pt.at(k*(m_nh+1)+l);}
+    Vector3d const &normal(int k, int l)  const {return m_N.at(k*(m_nh+1)+l);}
+};
+
+
 /**
  * This class :
  *     - defines the body object,
@@ -91,6 +111,10 @@ class Body
 
         NURBSSurface const &nurbs() const {return m_SplineSurface;}
 
+        BodyTessellation tessellation(int nx, int nh, bool bNormals=false) const;
+        BodyTessellation tessellation(QVector<double> const &uStations, int nh, bool bNormals=false) const;
+        void clearTessellations() const;
+
         Vector3d Point(double u, double v, bool bRight) const;
         void removeActiveFrame();
         void removeSideLine(int SideLine);
@@ -159,7 +183,6 @@ class Body
 
         void makeSplineTriangulation(int nx, int nh, QVector<Triangle3d> &triangles) const;
 
-        int isNode(Vector3d &Pt, QVector<Vector3d> &m_Node);
         int makePanels(int nFirst, Vector3d const &pos, QVector<Panel> &panels, QVector<Vector3d> &nodes);
         int nPanels() const {return m_NElements;}
 
@@ -204,6 +227,17 @@ class Body
 
 
 
+    private:
+        void surfaceKey(QVector<double> &key) const;
+        void tessellateRows(BodyTessellation *pTess, int k0, int k1) const;
+
+        mutable QVector<double> m_TessellationKey;          /**< the surface definition for which the tessellations were evaluated */
+        mutable QVector<BodyTessellation> m_Tessellation;   /**< the cached tessellations, the most recently used last */
+
+        static int s_MaxTessellations;
+        static QMutex s_TessellationMutex;                  /**< protects the caches, which are used by the analysis threads and by the display */
+
+    public:
         //allocate temporary variables to
         //avoid lengthy memory allocation times on the stack
         mutable double value, bs, cs;
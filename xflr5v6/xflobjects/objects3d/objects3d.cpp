@@ -20,6 +20,10 @@
 
 
 
+#include <QHash>
+#include <QMap>
+#include <QPair>
+
 #include "objects3d.h"
 #include <xflobjects/objects3d/surface.h>
 #include <xflobjects/objects3d/wpolar.h>
@@ -28,10 +32,206 @@
 
 QVector <Plane*>    Objects3d::s_oaPlane;
 QVector <WPolar*>   Objects3d::s_oaWPolar;
-QVector <PlaneOpp*> Objects3d::s_oaPOpp;
 QVector <Body*>     Objects3d::s_oaBody;
 
 
+/**
+ * The PlaneOpp objects are indexed by plane and polar names.
+ * Each group holds the operating points of one polar sorted by their key,
+ * i.e. alpha, QInf, beta or the control parameter depending on the polar type.
+ * The flat array used by the tree views and the legends is rebuilt from the groups only when it is requested,
+ * so that a batch of insertions costs one rebuild.
+ */
+namespace
+{
+    struct POppGroup
+    {
+        QString m_PlaneName;
+        QString m_PolarName;
+        QMultiMap<double, PlaneOpp*> m_POpp;  /**< the operating points, sorted by key */
+    };
+
+    typedef QPair<QString, QString> POppGroupKey;
+
+    QVector<POppGroup*> s_POppGroup;                   /**< the groups in the order of their first insertion */
+    QHash<POppGroupKey, POppGroup*> s_POppGroupMap;    /**< maps the plane and polar names to their group */
+    QVector<PlaneOpp*> s_oaPOpp;                       /**< the flat array of PlaneOpp objects, group by group */
+    bool s_bPOppListDirty = false;                     /**< true if the flat array needs to be rebuilt from the groups */
+
+
+    /** Returns the variable used to sort the operating points of the given type of polar */
+    double POppKey(PlaneOpp const *pPOpp)
+    {
+        switch(pPOpp->polarType())
+        {
+            case xfl::FIXEDAOAPOLAR:  return pPOpp->QInf();
+            case xfl::BETAPOLAR:      return pPOpp->beta();
+            case xfl::STABILITYPOLAR: return pPOpp->ctrl();
+            default:                  return pPOpp->alpha();
+        }
+    }
+
+
+    /** Returns the tolerance under which two operating points of the same polar are considered identical */
+    double POppKeyTolerance(PlaneOpp const *pPOpp)
+    {
+        switch(pPOpp->polarType())
+        {
+            case xfl::FIXEDAOAPOLAR:  return 0.1;
+            case xfl::BETAPOLAR:      return 0.01;
+            case xfl::STABILITYPOLAR: return 0.001;
+            default:                  return 0.005;
+        }
+    }
+
+
+    /** Returns the first operating point with a key within the tolerance of x, or end() if there is none */
+    QMultiMap<double, PlaneOpp*>::iterator findPOpp(QMultiMap<double, PlaneOpp*> &POppMap, double x, double tolerance)
+    {
+        QMultiMap<double, PlaneOpp*>::iterator it = POppMap.lowerBound(x-tolerance);
+        for(; it!=POppMap.end() && it.key()<x+tolerance; ++it)
+        {
+            if(qAbs(it.key()-x)<tolerance) return it;
+        }
+        return POppMap.end();
+    }
+
+
+    POppGroup *findPOppGroup(QString const &planeName, QString const &polarName)
+    {
+        return s_POppGroupMap.value(POppGroupKey(planeName, polarName), nullptr);
+    }
+
+
+    POppGroup *makePOppGroup(QString const &planeName, QString const &polarName)
+    {
+        POppGroup *pGroup = findPOppGroup(planeName, polarName);
+        if(pGroup) return pGroup;
+
+        pGroup = new POppGroup;
+        pGroup->m_PlaneName = planeName;
+        pGroup->m_PolarName = polarName;
+        s_POppGroup.append(pGroup);
+        s_POppGroupMap.insert(POppGroupKey(planeName, polarName), pGroup);
+        return pGroup;
+    }
+
+
+    /** Removes the group from the index and deletes it; the operating points are not deleted */
+    void removePOppGroup(POppGroup *pGroup)
+    {
+        s_POppGroupMap.remove(POppGroupKey(pGroup->m_PlaneName, pGroup->m_PolarName));
+        s_POppGroup.removeOne(pGroup);
+        delete pGroup;
+    }
+
+
+    /** Deletes the operating points of the group and removes it from the index */
+    void deletePOppGroup(POppGroup *pGroup)
+    {
+        qDeleteAll(pGroup->m_POpp);
+        removePOppGroup(pGroup);
+        s_bPOppListDirty = true;
+    }
+
+
+    /** Moves the groups of the given plane, and of the given polar if it is not empty, to the new names */
+    void renamePOppGroups(QString const &planeName, QString const &polarName, QString const &newPlaneName, QString const &newPolarName)
+    {
+        QVector<POppGroup*> renamed;
+        for(int ig=0; ig<s_POppGroup.size(); ig++)
+        {
+            POppGroup *pGroup = s_POppGroup.at(ig);
+            if(pGroup->m_PlaneName==planeName && (polarName.isEmpty() || pGroup->m_PolarName==polarName))
+                renamed.append(pGroup);
+        }
+
+        for(int ig=0; ig<renamed.size(); ig++)
+        {
+            POppGroup *pGroup = renamed.at(ig);
+            QString const newPolar = polarName.isEmpty() ? pGroup->m_PolarName : newPolarName;
+            s_POppGroupMap.remove(POppGroupKey(pGroup->m_PlaneName, pGroup->m_PolarName));
+
+            POppGroup *pTarget = findPOppGroup(newPlaneName, newPolar);
+            for(QMultiMap<double, PlaneOpp*>::iterator it=pGroup->m_POpp.begin(); it!=pGroup->m_POpp.end(); ++it)
+            {
+                it.value()->setPlaneName(newPlaneName);
+                it.value()->setPolarName(newPolar);
+                if(pTarget) pTarget->m_POpp.insert(it.key(), it.value());
+            }
+
+            if(pTarget)
+            {
+                // merge into the existing group
+                s_POppGroup.removeOne(pGroup);
+                delete pGroup;
+            }
+            else
+            {
+                pGroup->m_PlaneName = newPlaneName;
+                pGroup->m_PolarName = newPolar;
+                s_POppGroupMap.insert(POppGroupKey(newPlaneName, newPolar), pGroup);
+            }
+        }
+        s_bPOppListDirty = true;
+    }
+
+
+    /** Removes the operating point from the index without deleting it. */
+    void unindexPOpp(PlaneOpp *pPOpp)
+    {
+        POppGroup *pGroup = findPOppGroup(pPOpp->planeName(), pPOpp->polarName());
+        if(pGroup)
+        {
+            QMultiMap<double, PlaneOpp*>::iterator it = pGroup->m_POpp.find(POppKey(pPOpp));
+            for(; it!=pGroup->m_POpp.end() && it.key()==POppKey(pPOpp); ++it)
+            {
+                if(it.value()==pPOpp)
+                {
+                    pGroup->m_POpp.erase(it);
+                    if(pGroup->m_POpp.isEmpty()) removePOppGroup(pGroup);
+                    return;
+                }
+            }
+        }
+
+        // the names or the key have been modified outside of the index
+        for(int ig=0; ig<s_POppGroup.size(); ig++)
+        {
+            POppGroup *pOtherGroup = s_POppGroup.at(ig);
+            for(QMultiMap<double, PlaneOpp*>::iterator it=pOtherGroup->m_POpp.begin(); it!=pOtherGroup->m_POpp.end(); ++it)
+            {
+                if(it.value()==pPOpp)
+                {
+                    pOtherGroup->m_POpp.erase(it);
+                    if(pOtherGroup->m_POpp.isEmpty()) removePOppGroup(pOtherGroup);
+                    return;
+                }
+            }
+        }
+    }
+
+
+    void makePOppList()
+    {
+        if(!s_bPOppListDirty) return;
+
+        int nPOpps = 0;
+        for(int ig=0; ig<s_POppGroup.size(); ig++) nPOpps += s_POppGroup.at(ig)->m_POpp.size();
+
+        s_oaPOpp.clear();
+        s_oaPOpp.reserve(nPOpps);
+        for(int ig=0; ig<s_POppGroup.size(); ig++)
+        {
+            QMultiMap<double, PlaneOpp*> const &POppMap = s_POppGroup.at(ig)->m_POpp;
+            for(QMultiMap<double, PlaneOpp*>::const_iterator it=POppMap.constBegin(); it!=POppMap.constEnd(); ++it)
+                s_oaPOpp.append(it.value());
+        }
+        s_bPOppListDirty = false;
+    }
+}
+
+
 
 /**
  * If the body is associated to a plane, duplicates the body and attaches it to the Plane
@@ -143,98 +343,87 @@ Plane* Objects3d::duplicatePlane(Plane *pPlane)
 }
 
 
+/**
+ * Inserts the operating point in its plane and polar group, sorted by its key.
+ * An existing operating point with the same key within the tolerance is replaced and deleted.
+ * @param pPOpp a pointer to the PlaneOpp object to insert
+ */
 void Objects3d::insertPOpp(PlaneOpp *pPOpp)
 {
-    bool bIsInserted = false;
+    if(PlaneOpp::compactPOpps()) pPOpp->compactResults();
+
+    POppGroup *pGroup = makePOppGroup(pPOpp->planeName(), pPOpp->polarName());
 
-    for (int i=0; i<s_oaPOpp.size(); i++)
+    QMultiMap<double, PlaneOpp*>::iterator it = findPOpp(pGroup->m_POpp, POppKey(pPOpp), POppKeyTolerance(pPOpp));
+    if(it!=pGroup->m_POpp.end())
     {
-        PlaneOpp *pOldPOpp = s_oaPOpp.at(i);
-        if (pPOpp->planeName() == pOldPOpp->planeName())
-        {
-            if (pPOpp->polarName() == pOldPOpp->polarName())
-            {
-                if(pPOpp->polarType()<xfl::FIXEDAOAPOLAR)
-                {
-                    if(qAbs(pPOpp->alpha() - pOldPOpp->alpha())<0.005)
-                    {
-                        //replace existing point
-                        s_oaPOpp.removeAt(i);
-                        delete pOldPOpp;
-                        s_oaPOpp.insert(i, pPOpp);
-                        bIsInserted = true;
-                        break;
-                    }
-                    else if (pPOpp->alpha() < pOldPOpp->alpha())
-                    {
-                        //insert point
-                        s_oaPOpp.insert(i, pPOpp);
-                        bIsInserted = true;
-                        i = s_oaPOpp.size();// to break
-                    }
-                }
-                else if (pPOpp->polarType()==xfl::FIXEDAOAPOLAR)
-                {
-                    if(qAbs(pPOpp->m_QInf - pOldPOpp->m_QInf)<0.1)
-                    {
-                        //replace the existing point
-                        s_oaPOpp.removeAt(i);
-                        delete pOldPOpp;
-                        s_oaPOpp.insert(i, pPOpp);
-                        bIsInserted = true;
-                        i = s_oaPOpp.size();// to break
-                    }
-                    else if (pPOpp->m_QInf < pOldPOpp->m_QInf)
-                    {
-                        //insert point
-                        s_oaPOpp.insert(i, pPOpp);
-                        bIsInserted = true;
-                        i = s_oaPOpp.size();// to break
-                    }
-                }
-                else if (pPOpp->polarType()==xfl::BETAPOLAR)
-                {
-                    if(qAbs(pPOpp->beta() - pOldPOpp->beta())<0.01)
-                    {
-                        //replace existing point
-                        s_oaPOpp.removeAt(i);
-                        delete pOldPOpp;
-                        s_oaPOpp.insert(i, pPOpp);
-                        bIsInserted = true;
-                        i = s_oaPOpp.size();// to break
-                    }
-                    else if (pPOpp->beta() < pOldPOpp->beta())
-                    {
-                        //insert point
-                        s_oaPOpp.insert(i, pPOpp);
-                        bIsInserted = true;
-                        i = s_oaPOpp.size();// to break
-                    }
-                }
-                else if(pPOpp->polarType()==xfl::STABILITYPOLAR)
-                {
-                    if(qAbs(pPOpp->ctrl() - pOldPOpp->ctrl())<0.001)
-                    {
-                        //replace existing point
-                        s_oaPOpp.removeAt(i);
-                        delete pOldPOpp;
-                        s_oaPOpp.insert(i, pPOpp);
-                        bIsInserted = true;
-                        i = s_oaPOpp.size();// to break
-                    }
-                    else if (pPOpp->ctrl() < pOldPOpp->ctrl())
-                    {
-                        //insert point
-                        s_oaPOpp.insert(i, pPOpp);
-                        bIsInserted = true;
-                        i = s_oaPOpp.size();// to break
-                    }
-                }
-            }
-        }
+        //replace the existing point
+        PlaneOpp *pOldPOpp = it.value();
+        pGroup->m_POpp.erase(it);
+        if(pOldPOpp!=pPOpp) delete pOldPOpp;
     }
+    pGroup->m_POpp.insert(POppKey(pPOpp), pPOpp);
 
-    if (!bIsInserted)     s_oaPOpp.append(pPOpp);
+    s_bPOppListDirty = true;
+}
+
+
+/**
+ * Inserts a batch of operating points, typically the results of an analysis.
+ * The flat array is rebuilt once, the next time it is accessed.
+ */
+void Objects3d::insertPOpps(QVector<PlaneOpp*> const &POppList)
+{
+    for(int i=0; i<POppList.size(); i++) insertPOpp(POppList.at(i));
+}
+
+
+/**
+ * Appends the operating point to its group without checking for an existing point with the same key.
+ */
+void Objects3d::appendPlaneOpp(PlaneOpp *pPOpp)
+{
+    POppGroup *pGroup = makePOppGroup(pPOpp->planeName(), pPOpp->polarName());
+    pGroup->m_POpp.insert(POppKey(pPOpp), pPOpp);
+    s_bPOppListDirty = true;
+}
+
+
+/**
+ * Removes the operating point at the given position in the flat array, without deleting it.
+ */
+void Objects3d::removePOppAt(int i)
+{
+    makePOppList();
+    if(i<0 || i>=s_oaPOpp.size()) return;
+    unindexPOpp(s_oaPOpp.at(i));
+    s_oaPOpp.removeAt(i);
+}
+
+
+PlaneOpp* Objects3d::planeOppAt(int idx)
+{
+    makePOppList();
+    if(idx<0 || idx>=s_oaPOpp.size()) return nullptr;
+    return s_oaPOpp.at(idx);
+}
+
+
+int Objects3d::planeOppCount()
+{
+    makePOppList();
+    return s_oaPOpp.size();
+}
+
+
+/** Returns the number of operating points of the plane and polar, without building the flat list */
+int Objects3d::planeOppCount(Plane const *pPlane, WPolar const *pWPolar)
+{
+    if(!pPlane || !pWPolar) return 0;
+
+    POppGroup *pGroup = findPOppGroup(pPlane->name(), pWPolar->polarName());
+    if(!pGroup) return 0;
+    return pGroup->m_POpp.size();
 }
 
 
@@ -322,15 +511,8 @@ void Objects3d::deleteWPolar(WPolar *pWPolar)
     //remove and delete its children POpps from the array
     if(!pWPolar)return;
 
-    for (int l=s_oaPOpp.size()-1;l>=0; l--)
-    {
-        PlaneOpp *pPOpp = s_oaPOpp.at(l);
-        if (pPOpp->planeName()==pWPolar->planeName() && pPOpp->polarName()==pWPolar->polarName())
-        {
-            s_oaPOpp.removeAt(l);
-            delete pPOpp;
-        }
-    }
+    POppGroup *pGroup = findPOppGroup(pWPolar->planeName(), pWPolar->polarName());
+    if(pGroup) deletePOppGroup(pGroup);
 
     for(int ipb=0; ipb<s_oaWPolar.size(); ipb++)
     {
@@ -354,18 +536,13 @@ void Objects3d::deletePlaneResults(Plane *pPlane, bool bDeletePolars)
 {
     if(!pPlane || !pPlane->name().length()) return ;
     WPolar* pWPolar = nullptr;
-    PlaneOpp * pPOpp = nullptr;
 
 
     //first remove all POpps associated to the plane
-    for (int i=s_oaPOpp.size()-1; i>=0; i--)
+    for (int ig=s_POppGroup.size()-1; ig>=0; ig--)
     {
-        pPOpp = s_oaPOpp.at(i);
-        if(pPOpp->planeName() == pPlane->name())
-        {
-            s_oaPOpp.removeAt(i);
-            delete pPOpp;
-        }
+        POppGroup *pGroup = s_POppGroup.at(ig);
+        if(pGroup->m_PlaneName == pPlane->name()) deletePOppGroup(pGroup);
     }
 
     //next delete all WPolars associated to the plane
@@ -428,19 +605,26 @@ PlaneOpp * Objects3d::getPlaneOpp(Plane const*pPlane, WPolar const*pWPolar, doub
 {
     if(!pPlane || !pWPolar) return nullptr;
 
+    POppGroup *pGroup = findPOppGroup(pPlane->name(), pWPolar->polarName());
+    if(!pGroup) return nullptr;
 
-    for (int i=0; i<s_oaPOpp.size(); i++)
-    {
-        PlaneOpp*pPOpp = s_oaPOpp.at(i);
-        if ((pPOpp->planeName() == pPlane->name()) && (pPOpp->polarName() == pWPolar->polarName()))
-        {
-            if     (pWPolar->isT12Polar() && qAbs(pPOpp->alpha() - x)<0.005)   return pPOpp;
-            else if(pWPolar->isT4Polar()  && qAbs(pPOpp->QInf()  - x) <0.005)  return pPOpp;
-            else if(pWPolar->isT5Polar()  && qAbs(pPOpp->beta()  - x) <0.005)  return pPOpp;
-            else if(pWPolar->isT7Polar()  && qAbs(pPOpp->ctrl()  - x) <0.005)  return pPOpp;
-        }
-    }
-    return nullptr;
+    QMultiMap<double, PlaneOpp*>::iterator it = findPOpp(pGroup->m_POpp, x, 0.005);
+    if(it==pGroup->m_POpp.end()) return nullptr;
+    return it.value();
+}
+
+
+/**
+* Returns the operating points of the plane and polar, sorted by aoa, velocity, sideslip or control parameter
+*/
+QVector<PlaneOpp*> Objects3d::planeOpps(Plane const *pPlane, WPolar const *pWPolar)
+{
+    if(!pPlane || !pWPolar) return QVector<PlaneOpp*>();
+
+    POppGroup *pGroup = findPOppGroup(pPlane->name(), pWPolar->polarName());
+    if(!pGroup) return QVector<PlaneOpp*>();
+
+    return pGroup->m_POpp.values().toVector();
 }
 
 
@@ -712,15 +896,8 @@ WPolar* Objects3d::insertNewWPolar(WPolar *pNewWPolar, Plane *pCurPlane)
         if(pWPolar)
         {
             //remove and delete its children POpps from the array
-            for (l=s_oaPOpp.size()-1;l>=0; l--)
-            {
-                PlaneOpp *pPOpp = s_oaPOpp.at(l);
-                if (pPOpp->planeName()==pWPolar->planeName() && pPOpp->polarName()==pWPolar->polarName())
-                {
-                    s_oaPOpp.removeAt(l);
-                    delete pPOpp;
-                }
-            }
+            POppGroup *pGroup = findPOppGroup(pWPolar->planeName(), pWPolar->polarName());
+            if(pGroup) deletePOppGroup(pGroup);
 
             for(int ipb=0; ipb<s_oaWPolar.size(); ipb++)
             {
@@ -788,7 +965,6 @@ WPolar* Objects3d::insertNewWPolar(WPolar *pNewWPolar, Plane *pCurPlane)
 void Objects3d::renamePlane(const QString &PlaneName)
 {
     QString OldName;
-    PlaneOpp *pPOpp;
     int l;
     WPolar *pWPolar;
     Plane *pPlane = getPlane(PlaneName);
@@ -807,18 +983,21 @@ void Objects3d::renamePlane(const QString &PlaneName)
                 pWPolar->setPlaneName(pPlane->name());
             }
         }
-        for (l=s_oaPOpp.size()-1;l>=0; l--)
-        {
-            pPOpp = s_oaPOpp.at(l);
-            if (pPOpp->planeName() == OldName)
-            {
-                pPOpp->setPlaneName(pPlane->name());
-            }
-        }
+        renamePOppGroups(OldName, QString(), pPlane->name(), QString());
     }
 }
 
 
+/**
+ * Renames the polar of the operating points of a plane and moves them to the group of the new name.
+ */
+void Objects3d::renamePOppPolar(QString const &planeName, QString const &oldPolarName, QString const &newPolarName)
+{
+    if(oldPolarName.isEmpty() || oldPolarName==newPolarName) return;
+    renamePOppGroups(planeName, oldPolarName, planeName, newPolarName);
+}
+
+
 
 
 
@@ -837,12 +1016,12 @@ void Objects3d::deleteObjects()
         delete pObj;
     }
 
-    for (int i=s_oaPOpp.size()-1; i>=0; i--)
+    for (int ig=s_POppGroup.size()-1; ig>=0; ig--)
     {
-        PlaneOpp * pObj = s_oaPOpp.at(i);
-        s_oaPOpp.removeAt(i);
-        delete pObj;
+        deletePOppGroup(s_POppGroup.at(ig));
     }
+    s_oaPOpp.clear();
+    s_bPOppListDirty = false;
 
     for (int i=s_oaWPolar.size()-1; i>=0; i--)
     {
@@ -863,13 +1042,11 @@ void Objects3d::deleteObjects()
 void Objects3d::setWPolarChildrenStyle(WPolar *pWPolar)
 {
     if(!pWPolar) return;
-    for (int j=s_oaPOpp.size()-1; j>=0; j--)
+    POppGroup *pGroup = findPOppGroup(pWPolar->planeName(), pWPolar->polarName());
+    if(!pGroup) return;
+    for(QMultiMap<double, PlaneOpp*>::iterator it=pGroup->m_POpp.begin(); it!=pGroup->m_POpp.end(); ++it)
     {
-        PlaneOpp *pPOpp = s_oaPOpp.at(j);
-        if(pPOpp->planeName() == pWPolar->planeName() && pPOpp->polarName()==pWPolar->polarName())
-        {
-            pPOpp->setTheStyle(pWPolar->theStyle());
-        }
+        it.value()->setTheStyle(pWPolar->theStyle());
     }
 }
 
@@ -914,32 +1091,25 @@ void Objects3d::setWPolarStyle(WPolar *pWPolar, LineStyle const&ls, bool bStyle,
 void Objects3d::setWPolarPOppStyle(WPolar const* pWPolar, bool bStipple, bool bWidth, bool bColor, bool bPoints)
 {
     if(!pWPolar) return;
-    PlaneOpp *pLastPOpp = nullptr;
-    for(int ipp=0; ipp<s_oaPOpp.size(); ipp++)
-    {
-        PlaneOpp *pPOpp = s_oaPOpp.at(ipp);
-        if(pWPolar->hasPOpp(pPOpp)) pLastPOpp = pPOpp;
-    }
+    POppGroup *pGroup = findPOppGroup(pWPolar->planeName(), pWPolar->polarName());
+    if(!pGroup || pGroup->m_POpp.isEmpty()) return;
 
-    if(!pLastPOpp) return;
+    PlaneOpp *pLastPOpp = pGroup->m_POpp.last();
 
     if(bStipple)  pLastPOpp->setLineStipple(pWPolar->lineStipple());
     if(bWidth)    pLastPOpp->setLineWidth(pWPolar->lineWidth());
     if(bColor)    pLastPOpp->setLineColor(pWPolar->lineColor());
     if(bPoints)   pLastPOpp->setPointStyle(pWPolar->pointStyle());
 
-    for(int ipp=0; ipp<s_oaPOpp.size(); ipp++)
+    for(QMultiMap<double, PlaneOpp*>::iterator it=pGroup->m_POpp.begin(); it!=pGroup->m_POpp.end(); ++it)
     {
-        PlaneOpp *pPOpp = s_oaPOpp.at(ipp);
-        if(pWPolar->hasPOpp(pPOpp))
-        {
-            if(bStipple) pPOpp->setLineStipple(pWPolar->lineStipple());
-            if(bWidth)   pPOpp->setLineWidth(pWPolar->lineWidth());
-            if(bColor)   pPOpp->setLineColor(pLastPOpp->lineColor().darker(107));
-            if(bPoints)  pPOpp->setPointStyle(pWPolar->pointStyle());
+        PlaneOpp *pPOpp = it.value();
+        if(bStipple) pPOpp->setLineStipple(pWPolar->lineStipple());
+        if(bWidth)   pPOpp->setLineWidth(pWPolar->lineWidth());
+        if(bColor)   pPOpp->setLineColor(pLastPOpp->lineColor().darker(107));
+        if(bPoints)  pPOpp->setPointStyle(pWPolar->pointStyle());
 
-            pLastPOpp = pPOpp;
-        }
+        pLastPOpp = pPOpp;
     }
 }
 
@@ -988,11 +1158,14 @@ void Objects3d::setPlaneVisible(const Plane *pPlane, bool bVisible, bool bStabil
             pWPolar->setVisible(bVisible);
         }
     }
-    for(int ipp=0; ipp<s_oaPOpp.size(); ipp++)
+    for(int ig=0; ig<s_POppGroup.size(); ig++)
     {
-        PlaneOpp *pPOpp = s_oaPOpp.at(ipp);
-        if(pPOpp->planeName().compare(pPlane->name())==0)
+        POppGroup *pGroup = s_POppGroup.at(ig);
+        if(pGroup->m_PlaneName.compare(pPlane->name())!=0) continue;
+
+        for(QMultiMap<double, PlaneOpp*>::iterator it=pGroup->m_POpp.begin(); it!=pGroup->m_POpp.end(); ++it)
         {
+            PlaneOpp *pPOpp = it.value();
             if(bStabilityPolarsOnly)
             {
                 if(pPOpp->isT7Polar()) pPOpp->setVisible(bVisible);
@@ -1011,14 +1184,11 @@ void Objects3d::setWPolarVisible(WPolar *pWPolar, bool bVisible)
     Plane const*pPlane = plane(pWPolar->planeName());
     if(!pPlane) return;
 
-    for(int ipp=0; ipp<s_oaPOpp.size(); ipp++)
+    POppGroup *pGroup = findPOppGroup(pPlane->name(), pWPolar->polarName());
+    if(!pGroup) return;
+    for(QMultiMap<double, PlaneOpp*>::iterator it=pGroup->m_POpp.begin(); it!=pGroup->m_POpp.end(); ++it)
     {
-        PlaneOpp *pPOpp = s_oaPOpp.at(ipp);
-        if(pPOpp->planeName().compare(pPlane->name())==0)
-        {
-            if(pPOpp->polarName().compare(pWPolar->polarName())==0)
-                pPOpp->setVisible(bVisible);
-        }
+        it.value()->setVisible(bVisible);
     }
 }
 
@@ -39,7 +39,6 @@ namespace  Objects3d
     extern QVector <Plane*>    s_oaPlane;   /**< The array of void pointers to the Plane objects. */
     extern QVector <Body*>     s_oaBody;    /**< The array of void pointers to the Body objects. @todo deprecated, remove*/
     extern QVector <WPolar*>   s_oaWPolar;  /**< The array of void pointers to the WPolar objects. */
-    extern QVector <PlaneOpp*> s_oaPOpp;    /**< The array of void pointers to the PlaneOpp objects. */
 
     void      addBody(Body *pBody);
     Plane *   addPlane(Plane *pPlane);
@@ -56,14 +55,17 @@ namespace  Objects3d
     Body*     getBody(QString const &BodyName);
     Plane*    getPlane(QString const&PlaneName);
     PlaneOpp* getPlaneOpp(const Plane *pPlane, const WPolar *pWPolar, double x);
+    QVector<PlaneOpp*> planeOpps(Plane const *pPlane, WPolar const *pWPolar);
     Wing*     getWing(QString const &PlaneName);
     WPolar*   getWPolar(const Plane *pPlane, QString const &WPolarName);
     void      insertPOpp(PlaneOpp *pPOpp);
-    inline void appendPlaneOpp(PlaneOpp*pPOpp) {s_oaPOpp.append(pPOpp);}
-    inline void removePOppAt(int i)  {if(i<0 || i>=s_oaPOpp.size()) return; s_oaPOpp.removeAt(i);}
+    void      insertPOpps(QVector<PlaneOpp*> const &POppList);
+    void      appendPlaneOpp(PlaneOpp*pPOpp);
+    void      removePOppAt(int i);
     WPolar *  insertNewWPolar(WPolar *pModWPolar, Plane *pCurPlane);
     bool      planeExists(QString const &planeName);
     void      renamePlane(QString const &PlaneName);
+    void      renamePOppPolar(QString const &planeName, QString const &oldPolarName, QString const &newPolarName);
     Plane *   setModPlane(Plane *pModPlane);
     void      setWPolarChildrenStyle(WPolar *pWPolar);
 
@@ -80,11 +82,12 @@ namespace  Objects3d
 
     inline Plane*    planeAt(int idx)    {if(idx<0 || idx>=s_oaPlane.size())  return nullptr; else return s_oaPlane.at(idx);}
     inline WPolar*   polarAt(int idx)    {if(idx<0 || idx>=s_oaWPolar.size()) return nullptr; else return s_oaWPolar.at(idx);}
-    inline PlaneOpp* planeOppAt(int idx) {if(idx<0 || idx>=s_oaPOpp.size())   return nullptr; else return s_oaPOpp.at(idx);}
+    PlaneOpp* planeOppAt(int idx);
 
     inline int planeCount()    {return s_oaPlane.size();}
     inline int polarCount()    {return s_oaWPolar.size();}
-    inline int planeOppCount() {return s_oaPOpp.size();}
+    int planeOppCount();
+    int planeOppCount(Plane const *pPlane, WPolar const *pWPolar);
 
 };
 
@@ -21,6 +21,9 @@
 
 #include <QRandomGenerator>
 
+#include <algorithm>
+#include <cmath>
+
 #include "planeopp.h"
 #include <xflcore/units.h>
 #include <xflcore/xflcore.h>
@@ -31,6 +34,8 @@
 
 bool  PlaneOpp::s_bStoreOpps=true;
 bool  PlaneOpp::s_bKeepOutOpps=false;
+bool  PlaneOpp::s_bCompactOpps=false;
+PlaneOpp *PlaneOpp::s_pExpandedPOpp=nullptr;
 
 /**
 *The public constructor
@@ -100,6 +105,9 @@ PlaneOpp::PlaneOpp(Plane *pPlane, WPolar *pWPolar, int PanelArraySize)
 
     for (int iw=0; iw<MAXWINGS; iw++) m_pWOpp[iw] = nullptr;
 
+    m_bCompact = false;
+    m_CpMin = m_CpScale = 0.0;
+
     m_dCp = m_dG = m_dSigma = nullptr;
     allocateMemory(PanelArraySize);
 
@@ -155,6 +163,7 @@ void PlaneOpp::addWingOpp(int iw, int PanelArraySize)
  */
 PlaneOpp::~PlaneOpp()
 {
+    if(s_pExpandedPOpp==this) s_pExpandedPOpp = nullptr;
     releaseMemory();
 }
 
@@ -188,6 +197,11 @@ void PlaneOpp::releaseMemory()
     m_dSigma = nullptr;
     m_dG = nullptr;
 
+    m_bCompact = false;
+    m_qCp.clear();
+    m_fG.clear();
+    m_fSigma.clear();
+
     for (int iw=0; iw<MAXWINGS; iw++)
     {
         if(m_pWOpp[iw] != nullptr) delete m_pWOpp[iw];
@@ -196,6 +210,107 @@ void PlaneOpp::releaseMemory()
 }
 
 
+/**
+ * Encodes the panel results in compact form and releases the double precision arrays.
+ * The Cp coefficients are quantized on 16 bits with a scale specific to this operating point,
+ * the doublet strengths are held in single precision, and the source strengths are dropped if they are all null.
+ * The arrays are decoded on demand by expandResults().
+ */
+void PlaneOpp::compactResults()
+{
+    if(m_bCompact || !m_dCp || m_NPanels<=0) return;
+
+    double CpMax = m_dCp[0];
+    m_CpMin = m_dCp[0];
+    for(int k=1; k<m_NPanels; k++)
+    {
+        m_CpMin = std::min(m_CpMin, m_dCp[k]);
+        CpMax   = std::max(CpMax,   m_dCp[k]);
+    }
+    m_CpScale = (CpMax-m_CpMin)/65535.0;
+
+    m_qCp.resize(m_NPanels);
+    m_fG.resize(m_NPanels);
+    for(int k=0; k<m_NPanels; k++)
+    {
+        if(m_CpScale>0.0) m_qCp[k] = quint16(std::lround((m_dCp[k]-m_CpMin)/m_CpScale));
+        else              m_qCp[k] = 0;
+        m_fG[k] = float(m_dG[k]);
+    }
+
+    m_fSigma.clear();
+    for(int k=0; k<m_NPanels; k++)
+    {
+        if(qAbs(m_dSigma[k])>0.0)
+        {
+            m_fSigma.resize(m_NPanels);
+            for(int l=0; l<m_NPanels; l++) m_fSigma[l] = float(m_dSigma[l]);
+            break;
+        }
+    }
+
+    m_bCompact = true;
+    if(s_pExpandedPOpp!=this) releaseExpandedResults();
+}
+
+
+/**
+ * Decodes the compact panel results to the double precision arrays used by the views.
+ * Only one operating point is held decoded at a time, so the previous one is released.
+ */
+void PlaneOpp::expandResults()
+{
+    if(!m_bCompact || m_dCp) return;
+
+    if(s_pExpandedPOpp && s_pExpandedPOpp!=this) s_pExpandedPOpp->releaseExpandedResults();
+    s_pExpandedPOpp = this;
+
+    m_dCp    = new double[ulong(m_NPanels)];
+    m_dSigma = new double[ulong(m_NPanels)];
+    m_dG     = new double[ulong(m_NPanels)];
+    for(int k=0; k<m_NPanels; k++)
+    {
+        m_dCp[k]    = compactCp(k);
+        m_dG[k]     = double(m_fG.at(k));
+        m_dSigma[k] = m_fSigma.size() ? double(m_fSigma.at(k)) : 0.0;
+    }
+
+    setWingOppArrays();
+}
+
+
+/** Releases the decoded arrays of a compact operating point */
+void PlaneOpp::releaseExpandedResults()
+{
+    if(!m_bCompact) return;
+
+    delete [] m_dCp;
+    delete [] m_dSigma;
+    delete [] m_dG;
+    m_dCp = m_dSigma = m_dG = nullptr;
+    setWingOppArrays();
+
+    if(s_pExpandedPOpp==this) s_pExpandedPOpp = nullptr;
+}
+
+
+/** Points the WingOpp arrays to their part of the plane's arrays */
+void PlaneOpp::setWingOppArrays()
+{
+    int pos = 0;
+    for(int iw=0; iw<MAXWINGS; iw++)
+    {
+        if(m_pWOpp[iw])
+        {
+            m_pWOpp[iw]->m_dCp    = m_dCp    ? m_dCp    + pos : nullptr;
+            m_pWOpp[iw]->m_dG     = m_dG     ? m_dG     + pos : nullptr;
+            m_pWOpp[iw]->m_dSigma = m_dSigma ? m_dSigma + pos : nullptr;
+            pos +=m_pWOpp[iw]->m_NVLMPanels;
+        }
+    }
+}
+
+
 /**
  * Loads or saves the data of this operating point to a binary file.
  * This method serializes the data associated to the plane, then calls the serialization methods
@@ -446,17 +561,7 @@ bool PlaneOpp::serializePOppWPA(QDataStream &ar, bool bIsStoring)
         memcpy(m_EigenValue,  m_pWOpp[0]->m_oldEigenValue,  16*sizeof(double));
         memcpy(m_EigenVector, m_pWOpp[0]->m_oldEigenVector, 64*sizeof(double));
 
-        int pos = 0;
-        for(int iw=0; iw<MAXWINGS; iw++)
-        {
-            if(m_pWOpp[iw])
-            {
-                m_pWOpp[iw]->m_dCp    = m_dCp    + pos;
-                m_pWOpp[iw]->m_dG     = m_dG     + pos;
-                m_pWOpp[iw]->m_dSigma = m_dSigma + pos;
-                pos +=m_pWOpp[iw]->m_NVLMPanels;
-            }
-        }
+        setWingOppArrays();
 
         if(ArchiveFormat>=1020)
         {
@@ -589,7 +694,16 @@ bool PlaneOpp::serializePOppXFL(QDataStream &ar, bool bIsStoring)
 
         if(m_AnalysisMethod!=xfl::LLTMETHOD)
         {
-            for (k=0; k<m_NPanels; k++) ar<<float(m_dCp[k])<<float(m_dSigma[k])<<float(m_dG[k]);
+            if(m_dCp)
+            {
+                for (k=0; k<m_NPanels; k++) ar<<float(m_dCp[k])<<float(m_dSigma[k])<<float(m_dG[k]);
+            }
+            else
+            {
+                // compact and not decoded
+                for (k=0; k<m_NPanels; k++)
+                    ar<<float(compactCp(k))<<(m_fSigma.size() ? m_fSigma.at(k) : 0.0f)<<m_fG.at(k);
+            }
         }
 
         for(int iw=0; iw<MAXWINGS; iw++)
@@ -712,7 +826,6 @@ bool PlaneOpp::serializePOppXFL(QDataStream &ar, bool bIsStoring)
             }
         }
 
-        int pos = 0;
         for(int iw=0; iw<MAXWINGS; iw++)
         {
             ar >> n;
@@ -722,13 +835,9 @@ bool PlaneOpp::serializePOppXFL(QDataStream &ar, bool bIsStoring)
             if(m_pWOpp[iw])
             {
                 m_pWOpp[iw]->serializeWingOppXFL(ar, bIsStoring);
-
-                m_pWOpp[iw]->m_dCp    = m_dCp    + pos;
-                m_pWOpp[iw]->m_dG     = m_dG     + pos;
-                m_pWOpp[iw]->m_dSigma = m_dSigma + pos;
-                pos +=m_pWOpp[iw]->m_NVLMPanels;
             }
         }
+        setWingOppArrays();
 
 
         ar >> m_CL >> m_CX >> m_CY;
@@ -32,6 +32,7 @@
 
 
 #include <QDataStream>
+#include <QVector>
 
 #include <xflobjects/objects3d/wingopp.h>
 #include <xflobjects/xflobject.h>
@@ -71,6 +72,10 @@ class PlaneOpp : public XflObject
         void allocateMemory(int PanelArraySize);
         void releaseMemory();
 
+        void compactResults();
+        void expandResults();
+        bool isCompact() const {return m_bCompact;}
+
 
         double alpha() const {return m_Alpha;}
         double beta()  const {return m_Beta;}
@@ -113,8 +118,13 @@ class PlaneOpp : public XflObject
 
         static bool storePOpps() {return s_bStoreOpps;}
         static bool keepOutPOpps() {return s_bKeepOutOpps;}
+        static bool compactPOpps() {return s_bCompactOpps;}
 
     private:
+        void releaseExpandedResults();
+        void setWingOppArrays();
+        double compactCp(int k) const {return m_CpMin + double(m_qCp.at(k)) * m_CpScale;}
+
         xfl::enumAnalysisMethod m_AnalysisMethod;   /**< defines by which type of method (LLT, VLM, PANEL), this WingOpp was calculated */
 
         QString m_PlaneName;       /**< the pPane's name to which the PlaneOpp is attached */
@@ -135,6 +145,14 @@ class PlaneOpp : public XflObject
         bool m_bVLM1;              /**<  true if the PlaneOpp is the result of a horseshoe VLM analysis */
         bool m_bOut;               /**<  true if the interpolation of viscous properties was outside the Foil Polar mesh */
 
+        bool m_bCompact;                /**< true if the panel results are held in the compact arrays, and decoded to the double arrays only on demand */
+        QVector<quint16> m_qCp;         /**< the Cp coefficients quantized on 16 bits between m_CpMin and the max. value */
+        double m_CpMin, m_CpScale;      /**< the offset and the step of the quantized Cp values */
+        QVector<float> m_fG;            /**< the vortex or doublet strengths in single precision */
+        QVector<float> m_fSigma;        /**< the source strengths in single precision, empty if they are all null as is the case for thin surfaces */
+
+        static PlaneOpp *s_pExpandedPOpp; /**< the compact operating point which has been decoded last; only one is held in double precision at a time */
+
     public:
         xfl::enumPolarType m_WPolarType;   /**< defines the type of the parent WPolar */
         WingOpp *m_pWOpp[MAXWINGS];      /**< An array of pointers to the four WingOpp objects associated to the four wings */
@@ -190,5 +208,6 @@ class PlaneOpp : public XflObject
 
         static bool s_bStoreOpps;       /**< true if the OpPoints should be added to the array at the end of the analysis*/
         static bool s_bKeepOutOpps;     /**< true if points with viscous propertiesinterpolated out of the polar mesh should be kept */
+        static bool s_bCompactOpps;     /**< true if the panel results of the stored operating points should be held in compact form */
 
 };
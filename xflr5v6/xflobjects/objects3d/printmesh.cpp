@@ -0,0 +1,473 @@
+/****************************************************************************
+
+    PrintMesh Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include <QFile>
+#include <QIODevice>
+
+#include "printmesh.h"
+
+
+int PrintMesh::s_ChunkSize = 4*1024*1024;
+
+
+uint qHash(PrintMesh::weldKey const &k, uint seed)
+{
+    return qHash(k.ix, seed) ^ (qHash(k.iy, seed)*31u) ^ (qHash(k.iz, seed)*131u);
+}
+
+
+PrintMesh::PrintMesh(double weldTolerance)
+{
+    m_WeldTolerance = weldTolerance>0.0 ? weldTolerance : 1.e-6;
+    m_nDegenerate = 0;
+}
+
+
+void PrintMesh::clear()
+{
+    m_Vertex.clear();
+    m_Index.clear();
+    m_PartStart.clear();
+    m_PartName.clear();
+    m_WeldMap.clear();
+    m_nDegenerate = 0;
+}
+
+
+void PrintMesh::reserve(int nTriangles)
+{
+    m_Index.reserve(3*nTriangles);
+    m_Vertex.reserve(nTriangles/2+1);
+    m_WeldMap.reserve(nTriangles/2+1);
+}
+
+
+/**
+ * Starts a new group of triangles.
+ * The vertices are still shared with the previous parts if they coincide.
+ */
+void PrintMesh::beginPart(QString const &partName)
+{
+    m_PartStart.append(nTriangles());
+    if(partName.isEmpty()) m_PartName.append(QString::asprintf("part_%d", m_PartStart.size()));
+    else                   m_PartName.append(partName);
+}
+
+
+PrintMesh::weldKey PrintMesh::makeKey(Vector3d const &pt) const
+{
+    weldKey k;
+    k.ix = qint64(std::floor(pt.x/m_WeldTolerance+0.5));
+    k.iy = qint64(std::floor(pt.y/m_WeldTolerance+0.5));
+    k.iz = qint64(std::floor(pt.z/m_WeldTolerance+0.5));
+    return k;
+}
+
+
+/**
+ * Returns the index of the vertex at position pt, creating it if no vertex exists within the weld tolerance.
+ * Two points within the tolerance may be quantized to adjacent cells, so the neighbouring cells are searched
+ * as well when the point's own cell is empty.
+ */
+int PrintMesh::addVertex(Vector3d const &pt)
+{
+    weldKey k = makeKey(pt);
+    QHash<weldKey, int>::const_iterator it = m_WeldMap.constFind(k);
+    if(it!=m_WeldMap.constEnd()) return it.value();
+
+    for(int dx=-1; dx<=1; dx++)
+    {
+        for(int dy=-1; dy<=1; dy++)
+        {
+            for(int dz=-1; dz<=1; dz++)
+            {
+                if(dx==0 && dy==0 && dz==0) continue;
+                weldKey kn = {k.ix+dx, k.iy+dy, k.iz+dz};
+                it = m_WeldMap.constFind(kn);
+                if(it==m_WeldMap.constEnd()) continue;
+                Vector3d const &V = m_Vertex.at(it.value());
+                if(std::abs(V.x-pt.x)<=m_WeldTolerance && std::abs(V.y-pt.y)<=m_WeldTolerance && std::abs(V.z-pt.z)<=m_WeldTolerance)
+                    return it.value();
+            }
+        }
+    }
+
+    int idx = m_Vertex.size();
+    m_Vertex.append(pt);
+    m_WeldMap.insert(k, idx);
+    return idx;
+}
+
+
+/**
+ * Adds a triangle to the current part; the vertices are expected in the order which defines the outward normal.
+ * @return false if the triangle was discarded because two of its vertices were welded together.
+ */
+bool PrintMesh::addTriangle(Vector3d const &Pt0, Vector3d const &Pt1, Vector3d const &Pt2)
+{
+    if(m_PartStart.isEmpty()) beginPart();
+
+    int i0 = addVertex(Pt0);
+    int i1 = addVertex(Pt1);
+    int i2 = addVertex(Pt2);
+    if(i0==i1 || i1==i2 || i2==i0)
+    {
+        m_nDegenerate++;
+        return false;
+    }
+    m_Index.append(i0);
+    m_Index.append(i1);
+    m_Index.append(i2);
+    return true;
+}
+
+
+/**
+ * Appends the parts of another mesh to this one, welding the common vertices.
+ * The parts are appended in their original order, so that the merge is deterministic.
+ */
+void PrintMesh::append(PrintMesh const &mesh)
+{
+    QVector<int> newIndex(mesh.nVertices());
+    for(int iv=0; iv<mesh.nVertices(); iv++) newIndex[iv] = addVertex(mesh.m_Vertex.at(iv));
+
+    int firstTriangle = nTriangles();
+    for(int ip=0; ip<mesh.nParts(); ip++)
+    {
+        m_PartStart.append(firstTriangle + mesh.m_PartStart.at(ip));
+        m_PartName.append(mesh.m_PartName.at(ip));
+    }
+    for(int i=0; i<mesh.m_Index.size(); i++) m_Index.append(newIndex.at(mesh.m_Index.at(i)));
+    m_nDegenerate += mesh.m_nDegenerate;
+}
+
+
+Vector3d PrintMesh::triangleNormal(int it) const
+{
+    Vector3d const &P0 = m_Vertex.at(m_Index.at(3*it));
+    Vector3d const &P1 = m_Vertex.at(m_Index.at(3*it+1));
+    Vector3d const &P2 = m_Vertex.at(m_Index.at(3*it+2));
+    Vector3d N = (P1-P0) * (P2-P0);
+    N.normalize();
+    return N;
+}
+
+
+/** Returns the size in bytes of the output file; exact for the binary STL format, an estimate otherwise. */
+qint64 PrintMesh::exportedSize(enumFormat format) const
+{
+    switch(format)
+    {
+        case STLBINARY: return 84 + qint64(50)*nTriangles();
+        case STLTEXT:   return 64 + qint64(258)*nTriangles();
+        case OBJ:       return 64 + qint64(48)*nVertices() + qint64(32)*nTriangles() + qint64(16)*nParts();
+    }
+    return 0;
+}
+
+
+/**
+ * Writes the buffer to the device once it holds a full chunk, or unconditionally if bFinal is true.
+ * @return false if the output failed
+ */
+static bool flushChunk(QIODevice &device, QByteArray &buffer, bool bFinal=false)
+{
+    if(!bFinal && buffer.size()<PrintMesh::s_ChunkSize) return true;
+    bool bOK = device.write(buffer)==buffer.size();
+    buffer.resize(0); // keeps the capacity
+    return bOK;
+}
+
+
+/**
+ * Writes the mesh to the device in the requested format.
+ * The output is formatted in memory in fixed-size chunks, so that the size of the file is not limited by the size of a QByteArray.
+ */
+bool PrintMesh::write(QIODevice &device, enumFormat format, QString const &name) const
+{
+    QByteArray buffer;
+    buffer.reserve(s_ChunkSize + 1024);
+
+    bool bOK = false;
+    switch(format)
+    {
+        case STLBINARY: bOK = writeSTLBinary(device, buffer, name); break;
+        case STLTEXT:   bOK = writeSTLText(device, buffer, name);   break;
+        case OBJ:       bOK = writeOBJ(device, buffer, name);       break;
+    }
+
+    return bOK && flushChunk(device, buffer, true);
+}
+
+
+/**
+ * UINT8[80] header, UINT32 number of triangles, then for each triangle
+ * REAL32[3] normal, REAL32[3] x 3 vertices, UINT16 attribute byte count.
+ * The floats are written in the host's byte order, as in xfl::writeFloat.
+ */
+bool PrintMesh::writeSTLBinary(QIODevice &device, QByteArray &buffer, QString const &name) const
+{
+    // the header should not start with the word "solid"
+    QByteArray header = ("binary STL file " + name).toLatin1().left(80);
+    header.append(QByteArray(80-header.size(), ' '));
+    buffer.append(header);
+
+    quint32 nTri = quint32(nTriangles());
+    buffer.append(reinterpret_cast<char const*>(&nTri), 4);
+
+    char record[50];
+    float f[12];
+    quint16 attribute = 0;
+    for(int it=0; it<nTriangles(); it++)
+    {
+        Vector3d N = triangleNormal(it);
+        f[0] = N.xf();
+        f[1] = N.yf();
+        f[2] = N.zf();
+        for(int k=0; k<3; k++)
+        {
+            Vector3d const &V = m_Vertex.at(m_Index.at(3*it+k));
+            f[3+3*k]   = V.xf();
+            f[3+3*k+1] = V.yf();
+            f[3+3*k+2] = V.zf();
+        }
+        memcpy(record, f, 48);
+        memcpy(record+48, &attribute, 2);
+        buffer.append(record, 50);
+        if(!flushChunk(device, buffer)) return false;
+    }
+    return true;
+}
+
+
+bool PrintMesh::writeSTLText(QIODevice &device, QByteArray &buffer, QString const &name) const
+{
+    char line[128];
+    QByteArray solidName = name.toLatin1();
+    solidName.replace(' ', "");
+
+    buffer.append("solid ").append(solidName).append('\n');
+    for(int it=0; it<nTriangles(); it++)
+    {
+        Vector3d N = triangleNormal(it);
+        int n = snprintf(line, sizeof(line), "  facet normal %13.7f  %13.7f  %13.7f\n    outer loop\n", N.x, N.y, N.z);
+        buffer.append(line, n);
+        for(int k=0; k<3; k++)
+        {
+            Vector3d const &V = m_Vertex.at(m_Index.at(3*it+k));
+            n = snprintf(line, sizeof(line), "      vertex %13.7f  %13.7f  %13.7f\n", V.x, V.y, V.z);
+            buffer.append(line, n);
+        }
+        buffer.append("    endloop\n  endfacet\n");
+        if(!flushChunk(device, buffer)) return false;
+    }
+    buffer.append("endsolid ").append(solidName).append('\n');
+    return true;
+}
+
+
+/**
+ * Wavefront OBJ output; each part is written as a separate group, and the vertices are shared.
+ */
+bool PrintMesh::writeOBJ(QIODevice &device, QByteArray &buffer, QString const &name) const
+{
+    char line[128];
+    int n=0;
+
+    buffer.append("# ").append(name.toLatin1()).append('\n');
+    n = snprintf(line, sizeof(line), "# %d vertices, %d triangles\n", nVertices(), nTriangles());
+    buffer.append(line, n);
+    buffer.append("o ").append(name.toLatin1().replace(' ', '_')).append('\n');
+
+    for(int iv=0; iv<nVertices(); iv++)
+    {
+        Vector3d const &V = m_Vertex.at(iv);
+        n = snprintf(line, sizeof(line), "v %.7g %.7g %.7g\n", V.x, V.y, V.z);
+        buffer.append(line, n);
+        if(!flushChunk(device, buffer)) return false;
+    }
+
+    for(int ip=0; ip<nParts(); ip++)
+    {
+        int itStart = m_PartStart.at(ip);
+        int itEnd   = ip<nParts()-1 ? m_PartStart.at(ip+1) : nTriangles();
+        if(itEnd<=itStart) continue;
+
+        buffer.append("g ").append(m_PartName.at(ip).toLatin1().replace(' ', '_')).append('\n');
+        for(int it=itStart; it<itEnd; it++)
+        {
+            // OBJ indexes are 1-based
+            n = snprintf(line, sizeof(line), "f %d %d %d\n", m_Index.at(3*it)+1, m_Index.at(3*it+1)+1, m_Index.at(3*it+2)+1);
+            buffer.append(line, n);
+            if(!flushChunk(device, buffer)) return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * Reads a binary or text STL file into the mesh, welding the coincident vertices.
+ * The file is memory-mapped if the platform allows it, and read in one block otherwise.
+ * @param scale the factor applied to the coordinates read from the file
+ */
+bool PrintMesh::readSTL(QFile &file, double scale, QString &logMsg)
+{
+    clear();
+
+    qint64 size = file.size();
+    if(size<15)
+    {
+        logMsg += "The file is too small to be an STL file\n";
+        return false;
+    }
+
+    QByteArray fileData;
+    uchar *pMap = file.map(0, size);
+    uchar const *pData = pMap;
+    if(!pMap)
+    {
+        fileData = file.readAll();
+        pData = reinterpret_cast<uchar const*>(fileData.constData());
+        size = fileData.size();
+    }
+
+    // binary files may also start with "solid", so check the consistency of the size first
+    bool bBinary = false;
+    if(size>=84)
+    {
+        quint32 nTri=0;
+        memcpy(&nTri, pData+80, 4);
+        bBinary = (84+qint64(nTri)*50==size) || strncmp(reinterpret_cast<char const*>(pData), "solid", 5)!=0;
+    }
+
+    bool bRes = false;
+    if(bBinary) bRes = readSTLBinary(pData, size, scale, logMsg);
+    else        bRes = readSTLText(reinterpret_cast<char const*>(pData), size, scale, logMsg);
+
+    if(pMap) file.unmap(pMap);
+
+    logMsg += QString::asprintf("Read %d triangles and %d vertices", nTriangles(), nVertices());
+    if(m_nDegenerate) logMsg += QString::asprintf(", discarded %d degenerate triangles", m_nDegenerate);
+    logMsg += "\n";
+
+    return bRes;
+}
+
+
+/**
+ * UINT8[80] header, UINT32 number of triangles, then 50 bytes per triangle.
+ * The normals are not read, since the orientation is defined by the order of the vertices.
+ */
+bool PrintMesh::readSTLBinary(uchar const *pData, qint64 size, double scale, QString &logMsg)
+{
+    quint32 nTri = 0;
+    memcpy(&nTri, pData+80, 4);
+
+    qint64 nMax = (size-84)/50;
+    if(qint64(nTri)>nMax)
+    {
+        logMsg += QString::asprintf("The header announces %u triangles, but the file holds only %lld\n", nTri, nMax);
+        nTri = quint32(nMax);
+    }
+
+    reserve(int(nTri));
+    beginPart("stl");
+
+    float f[12];
+    uchar const *p = pData+84;
+    for(quint32 it=0; it<nTri; it++)
+    {
+        memcpy(f, p, 48);
+        p += 50;
+        addTriangle(Vector3d(double(f[3])*scale, double(f[4])*scale,  double(f[5])*scale),
+                    Vector3d(double(f[6])*scale, double(f[7])*scale,  double(f[8])*scale),
+                    Vector3d(double(f[9])*scale, double(f[10])*scale, double(f[11])*scale));
+    }
+    return nTri>0;
+}
+
+
+/** Reads the next number, without reading past the end of the buffer which is not null-terminated. */
+static bool readSTLNumber(char const *&p, char const *pEnd, double &d)
+{
+    while(p<pEnd && isspace(static_cast<unsigned char>(*p))) p++;
+
+    char number[64];
+    int n=0;
+    while(p<pEnd && n<63 && (isdigit(static_cast<unsigned char>(*p)) || *p=='.' || *p=='-' || *p=='+' || *p=='e' || *p=='E'))
+        number[n++] = *p++;
+    number[n] = 0;
+    if(!n) return false;
+
+    char *pNumEnd = nullptr;
+    d = strtod(number, &pNumEnd);
+    return pNumEnd==number+n;
+}
+
+
+/**
+ * Reads the vertices of each facet; the other keywords are skipped.
+ */
+bool PrintMesh::readSTLText(char const *pData, qint64 size, double scale, QString &logMsg)
+{
+    char const *pEnd = pData + size;
+    char const *p = pData;
+
+    // an estimate from the typical length of a facet block
+    reserve(int(size/250));
+    beginPart("stl");
+
+    Vector3d V[3];
+    int iv=0;
+    double x=0, y=0, z=0;
+    while(p<pEnd)
+    {
+        p = static_cast<char const*>(memchr(p, 'v', size_t(pEnd-p)));
+        if(!p) break;
+        if(pEnd-p<7 || strncmp(p, "vertex", 6)!=0 || !isspace(static_cast<unsigned char>(p[6])) || (p>pData && !isspace(static_cast<unsigned char>(p[-1]))))
+        {
+            p++;
+            continue;
+        }
+        p += 6;
+
+        if(!readSTLNumber(p, pEnd, x) || !readSTLNumber(p, pEnd, y) || !readSTLNumber(p, pEnd, z))
+        {
+            logMsg += QString::asprintf("Invalid vertex at offset %lld\n", qint64(p-pData));
+            return false;
+        }
+        V[iv].set(x*scale, y*scale, z*scale);
+        iv++;
+        if(iv==3)
+        {
+            addTriangle(V[0], V[1], V[2]);
+            iv=0;
+        }
+    }
+    return nTriangles()>0;
+}
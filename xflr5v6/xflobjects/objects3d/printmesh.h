@@ -0,0 +1,96 @@
+/****************************************************************************
+
+    PrintMesh Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+#pragma once
+
+#include <QVector>
+#include <QHash>
+#include <QString>
+
+#include <xflgeom/geom3d/vector3d.h>
+
+class QIODevice;
+class QFile;
+
+/**
+ * @brief An indexed triangle mesh used to build the 3d-printable geometry in memory before it is written to disk.
+ *
+ * Vertices which coincide within the weld tolerance are merged, so that the neighbouring triangles share their vertices.
+ * The triangles are grouped in consecutive parts, typically one per printed rib division.
+ * Since the whole mesh is known before the output, each format is written in a single pass, in fixed-size buffered chunks.
+ * The class is also used to hold the geometry of imported STL files, welded in the same way.
+ */
+class PrintMesh
+{
+    public:
+        enum enumFormat {STLBINARY, STLTEXT, OBJ};
+
+    public:
+        PrintMesh(double weldTolerance=1.e-6);
+
+        void clear();
+        void beginPart(QString const &partName=QString());
+        int addVertex(Vector3d const &pt);
+        bool addTriangle(Vector3d const &Pt0, Vector3d const &Pt1, Vector3d const &Pt2);
+        void append(PrintMesh const &mesh);
+        void reserve(int nTriangles);
+
+        int nVertices()  const {return m_Vertex.size();}
+        int nTriangles() const {return m_Index.size()/3;}
+        int nParts()     const {return m_PartStart.size();}
+        int nDegenerate() const {return m_nDegenerate;}
+
+        Vector3d const &vertex(int iv) const {return m_Vertex.at(iv);}
+        Vector3d const &triangleVertex(int it, int k) const {return m_Vertex.at(m_Index.at(3*it+k));}
+        Vector3d triangleNormal(int it) const;
+
+        qint64 exportedSize(enumFormat format) const;
+        bool write(QIODevice &device, enumFormat format, QString const &name) const;
+        bool readSTL(QFile &file, double scale, QString &logMsg);
+
+        static int s_ChunkSize;             /**< the size in bytes of the blocks in which the output is written to the device */
+
+    private:
+        struct weldKey
+        {
+            qint64 ix, iy, iz;
+            bool operator==(weldKey const &k) const {return ix==k.ix && iy==k.iy && iz==k.iz;}
+        };
+        friend uint qHash(weldKey const &k, uint seed);
+
+        weldKey makeKey(Vector3d const &pt) const;
+
+        bool writeSTLBinary(QIODevice &device, QByteArray &buffer, QString const &name) const;
+        bool writeSTLText(QIODevice &device, QByteArray &buffer, QString const &name) const;
+        bool writeOBJ(QIODevice &device, QByteArray &buffer, QString const &name) const;
+
+        bool readSTLBinary(uchar const *pData, qint64 size, double scale, QString &logMsg);
+        bool readSTLText(char const *pData, qint64 size, double scale, QString &logMsg);
+
+        QVector<Vector3d> m_Vertex;         /**< the welded vertices */
+        QVector<int> m_Index;               /**< three vertex indexes per triangle */
+        QVector<int> m_PartStart;           /**< the index of the first triangle of each part */
+        QVector<QString> m_PartName;        /**< the name of each part, used by the OBJ output */
+        QHash<weldKey, int> m_WeldMap;      /**< maps the quantized position to the vertex index */
+        double m_WeldTolerance;
+        int m_nDegenerate;                  /**< the number of triangles discarded because they collapsed to a line or a point after welding */
+};
+
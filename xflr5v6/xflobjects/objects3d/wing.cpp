@@ -21,7 +21,9 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QFutureSynchronizer>
 #include <QRandomGenerator>
+#include <QtConcurrent/QtConcurrent>
 
 #include <xflcore/xflcore.h>
 #include <xflobjects/objects3d/wing.h>
@@ -2834,17 +2836,16 @@ Vector3d crossProduct(Vector3d p1, Vector3d p2)
 }
 
 /**
- * Write the facet data to a file in STL Format.
- * bool binaryOut - whether the function stores binary or text data?
- * &outStreamData if binaryOut then required for output (else is ignored)
- * &outStreamText if not binaryOut then required for output (else is ignored)
+ * Adds a triangle of the printable geometry to the mesh.
+ * The points are moved by the offset, rotated so that the wing stands vertically, and scaled by unit.
  * reverse - flips the order of the 2nd and 3rd points - since points are clockwise
  *     looking at the outer face this flips the face over
+ * The normal N is unused; the mesh computes the normals from the vertex order when it is written.
  */
-void Wing::exportSTLTriangle3dPrintable(QDataStream &outStreamData, QTextStream &outStreamText, bool binaryOut,
-                                        Vector3d Pt0, Vector3d Pt1, Vector3d Pt2, Vector3d N, Vector3d offset, float unit, bool reverse, double forceFlat)
+void Wing::addTriangle3dPrintable(PrintMesh &mesh,
+                                  Vector3d Pt0, Vector3d Pt1, Vector3d Pt2, Vector3d N, Vector3d offset, float unit, bool reverse, double forceFlat)
 {
-
+    Q_UNUSED(N);
 
     if (forceFlat != __DBL_MAX__) {
         Pt0.y = forceFlat - offset.y;
@@ -2869,73 +2870,15 @@ void Wing::exportSTLTriangle3dPrintable(QDataStream &outStreamData, QTextStream
         tmp = offset;
         offset.y = offset.z;
         offset.z = tmp.y;
-
     }
 
+    // the output is in single precision, so weld the points as they will be written
+    Vector3d P0(double((Pt0.xf()+offset.xf())*unit), double((Pt0.yf()+offset.yf())*unit), double((Pt0.zf()+offset.zf())*unit));
+    Vector3d P1(double((Pt1.xf()+offset.xf())*unit), double((Pt1.yf()+offset.yf())*unit), double((Pt1.zf()+offset.zf())*unit));
+    Vector3d P2(double((Pt2.xf()+offset.xf())*unit), double((Pt2.yf()+offset.yf())*unit), double((Pt2.zf()+offset.zf())*unit));
 
-    // Recalculate the normal because after all the manipulations N is rarely accurate
-    N = crossProduct(Pt1-Pt0, Pt2-Pt0);
-    N.normalize();
-    if (reverse)
-        N.reverse();
-
-
-    if (binaryOut) {
-        //*  foreach triangle
-        //*     REAL32[3] – Normal vector
-        //*     REAL32[3] – Vertex 1
-        //*     REAL32[3] – Vertex 2
-        //*     REAL32[3] – Vertex 3
-        //*     UINT16 – Attribute byte count
-        //*  end
-        xfl::writeFloat(outStreamData, N.xf());
-        xfl::writeFloat(outStreamData, N.yf());
-        xfl::writeFloat(outStreamData, N.zf());
-        xfl::writeFloat(outStreamData, (Pt0.xf()+offset.xf())*unit);
-        xfl::writeFloat(outStreamData, (Pt0.yf()+offset.yf())*unit);
-        xfl::writeFloat(outStreamData, (Pt0.zf()+offset.zf())*unit);
-        if (! reverse) {
-            xfl::writeFloat(outStreamData, (Pt1.xf()+offset.xf())*unit);
-            xfl::writeFloat(outStreamData, (Pt1.yf()+offset.yf())*unit);
-            xfl::writeFloat(outStreamData, (Pt1.zf()+offset.zf())*unit);
-            xfl::writeFloat(outStreamData, (Pt2.xf()+offset.xf())*unit);
-            xfl::writeFloat(outStreamData, (Pt2.yf()+offset.yf())*unit);
-            xfl::writeFloat(outStreamData, (Pt2.zf()+offset.zf())*unit);
-        } else {
-            xfl::writeFloat(outStreamData, (Pt2.xf()+offset.xf())*unit);
-            xfl::writeFloat(outStreamData, (Pt2.yf()+offset.yf())*unit);
-            xfl::writeFloat(outStreamData, (Pt2.zf()+offset.zf())*unit);
-            xfl::writeFloat(outStreamData, (Pt1.xf()+offset.xf())*unit);
-            xfl::writeFloat(outStreamData, (Pt1.yf()+offset.yf())*unit);
-            xfl::writeFloat(outStreamData, (Pt1.zf()+offset.zf())*unit);
-        }
-        short zero = 0;
-        char buffer[12];
-        memcpy(buffer, &zero, sizeof(short));
-        outStreamData.writeRawData(buffer, 2);
-
-    } else {
-        //*  facet normal ni nj nk
-        //*     outer loop
-        //*       vertex v1x v1y v1z
-        //*       vertex v2x v2y v2z
-        //*       vertex v3x v3y v3z
-        //*     endloop
-        //*  endfacet
-        //qDebug() << "offy: " << offset.y << "," << Pt0.y << "," << Pt1.y << "," << Pt2.y;
-        //stream the triangle
-        outStreamText << QString::asprintf("  facet normal %13.7f  %13.7f  %13.7f\n",  N.x, N.y, N.z);
-        outStreamText << "    outer loop\n";
-        outStreamText << QString::asprintf("      vertex %13.7f  %13.7f  %13.7f\n",  (Pt0.x+offset.x)*unit, (Pt0.y+offset.y)*unit, (Pt0.z+offset.z)*unit);
-        if (! reverse) {
-            outStreamText << QString::asprintf("      vertex %13.7f  %13.7f  %13.7f\n",  (Pt1.x+offset.x)*unit, (Pt1.y+offset.y)*unit,( Pt1.z+offset.z)*unit);
-            outStreamText << QString::asprintf("      vertex %13.7f  %13.7f  %13.7f\n",  (Pt2.x+offset.x)*unit, (Pt2.y+offset.y)*unit, (Pt2.z+offset.z)*unit);
-        } else {
-            outStreamText << QString::asprintf("      vertex %13.7f  %13.7f  %13.7f\n",  (Pt2.x+offset.x)*unit, (Pt2.y+offset.y)*unit, (Pt2.z+offset.z)*unit);
-            outStreamText << QString::asprintf("      vertex %13.7f  %13.7f  %13.7f\n",  (Pt1.x+offset.x)*unit, (Pt1.y+offset.y)*unit, (Pt1.z+offset.z)*unit);
-        }
-        outStreamText << "    endloop\n  endfacet\n";
-    }
+    if (! reverse) mesh.addTriangle(P0, P1, P2);
+    else           mesh.addTriangle(P0, P2, P1);
 }
 
 /**
@@ -3296,7 +3239,7 @@ void qDebugVec(std::string name, Vector3d pt, Vector3d pt2) {
     qDebug() << name.c_str() << " { " << pt.x << "," << pt.y << ","  << pt.z << " } == { " << pt2.x << "," << pt2.y << ","  << pt2.z << " }" ;
 }
 
-uint32_t Wing::stitchWingSurface(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut,
+uint32_t Wing::stitchWingSurface(PrintMesh &mesh,
                          QVector<Vector3d> &PtLeft, QVector<Vector3d> &NormalA,
                          QVector<Vector3d> &PtRight, QVector<Vector3d> &NormalB,
                          double tau, double tauA, double tauB, Vector3d &offset, float& unit, bool reverse)
@@ -3320,14 +3263,14 @@ uint32_t Wing::stitchWingSurface(QDataStream &outStreamData, QTextStream &outStr
         Pt0 = PtLeft[ic]   * (1.0-tauA) + PtRight[ic]   * tauA;
         Pt1 = PtLeft[ic+1] * (1.0-tauA) + PtRight[ic+1] * tauA;
         Pt2 = PtLeft[ic]   * (1.0-tauB) + PtRight[ic]   * tauB;
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+        addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
 
         //2nd triangle
         Pt0 = PtLeft[ic]   * (1.0-tauB) + PtRight[ic]   * tauB;
         Pt1 = PtLeft[ic+1] * (1.0-tauA) + PtRight[ic+1] * tauA;
         Pt2 = PtLeft[ic+1] * (1.0-tauB) + PtRight[ic+1] * tauB;
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+        addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
         iTriangles +=2;
     }
@@ -3460,7 +3403,7 @@ void Wing::generateDrainageHoles(QVector<Vector3d> &PtLeftOuter, QVector<Vector3
 
 
 
-uint32_t Wing::stitchWingSurfaceDrained(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut,
+uint32_t Wing::stitchWingSurfaceDrained(PrintMesh &mesh,
                          QVector<Vector3d> &PtLeft, QVector<Vector3d> &NormalA,
                          QVector<Vector3d> &PtRight, QVector<Vector3d> &NormalB,
                          QVector<rdhStruct> &resinDrainageHoles, double resinDrainageHoleWH, faceType outer,
@@ -3491,14 +3434,14 @@ uint32_t Wing::stitchWingSurfaceDrained(QDataStream &outStreamData, QTextStream
             Pt0 = interpolate(PtLeft[ic], PtRight[ic], tauA);
             Pt1 = interpolate(PtLeft[ic+1], PtRight[ic+1], tauA);
             Pt2 = interpolate(PtLeft[ic], PtRight[ic], tauB);
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+            addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
 
             //2nd triangle
             Pt0 = interpolate(PtLeft[ic], PtRight[ic], tauB);
             Pt1 = interpolate(PtLeft[ic+1], PtRight[ic+1], tauA);
             Pt2 = interpolate(PtLeft[ic+1], PtRight[ic+1], tauB);
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+            addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
             iTriangles +=2;
 
@@ -3511,13 +3454,13 @@ uint32_t Wing::stitchWingSurfaceDrained(QDataStream &outStreamData, QTextStream
                 Pt0 = interpolate(PtLeft[ic], PtRight[ic], tauA);
                 Pt1 = resinDrainageHoles[iRDH].start[outer];
                 Pt2 = interpolate(PtLeft[ic], PtRight[ic], tauB);
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+                addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
                 // tri from foilR to DHtip to DHbase
                 Pt0 = interpolate(PtLeft[ic], PtRight[ic], tauB);
                 Pt1 = resinDrainageHoles[iRDH].start[outer];
                 Pt2 = resinDrainageHoles[iRDH].tip[outer];
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+                addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
                 iTriangles +=2;
 
@@ -3530,19 +3473,19 @@ uint32_t Wing::stitchWingSurfaceDrained(QDataStream &outStreamData, QTextStream
                     Pt0 = interpolate(PtLeft[ic], PtRight[ic], tauB);
                     Pt1 = resinDrainageHoles[iRDH].tip[outer];
                     Pt2 = interpolate(PtLeft[ic+1], PtRight[ic+1], tauB);
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+                    addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
                     // tri from foilR to DHbase to DHtip
                     Pt0 = interpolate(PtLeft[ic+1], PtRight[ic+1], tauB);
                     Pt1 = resinDrainageHoles[iRDH].tip[outer];
                     Pt2 = resinDrainageHoles[iRDH].end[outer];
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+                    addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
                     // tri from foilL to foilR to DHbase
                     Pt0 = interpolate(PtLeft[ic+1], PtRight[ic+1], tauA);
                     Pt1 = interpolate(PtLeft[ic+1], PtRight[ic+1], tauB);
                     Pt2 = resinDrainageHoles[iRDH].end[outer];
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+                    addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
                     iTriangles +=3;
                     iRDH++;                       // step to the next hole
@@ -3556,13 +3499,13 @@ uint32_t Wing::stitchWingSurfaceDrained(QDataStream &outStreamData, QTextStream
                 Pt0 = interpolate(PtLeft[ic], PtRight[ic], tauB);
                 Pt1 = resinDrainageHoles[iRDH].end[outer];
                 Pt2 = resinDrainageHoles[iRDH].tip[outer];
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+                addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
                 // tri from foilL to DHbase to foilR
                 Pt0 = interpolate(PtLeft[ic], PtRight[ic], tauA);
                 Pt1 = resinDrainageHoles[iRDH].end[outer];
                 Pt2 = interpolate(PtLeft[ic], PtRight[ic], tauB);
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+                addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
                 iTriangles +=2;
                 iRDH++;                       // step to the next hole
@@ -3575,7 +3518,7 @@ uint32_t Wing::stitchWingSurfaceDrained(QDataStream &outStreamData, QTextStream
                 Pt0 = interpolate(PtLeft[ic], PtRight[ic], tauB);
                 Pt1 = interpolate(PtLeft[ic+1], PtRight[ic+1], tauB);
                 Pt2 = resinDrainageHoles[iRDH].tip[outer];
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, reverse);
+                addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, reverse);
 
                 iTriangles ++;
 
@@ -3593,14 +3536,11 @@ uint32_t Wing::stitchWingSurfaceDrained(QDataStream &outStreamData, QTextStream
  * This efficiently caps a simple set of foils with matching top and bottom points
  * and no spar penetrations
  *
- * Write the facet data to a file in STL Format.
- * bool binaryOut - whether the function stores binary or text data?
- * &outStreamData if binaryOut then required for output (else is ignored)
- * &outStreamText if not binaryOut then required for output (else is ignored)
+ * Adds the facets to the printable mesh.
  *
  *  Returns: the number of triangles written from within this process
  */
-uint32_t Wing::stitchFoilFace(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut, bool bRightCap,
+uint32_t Wing::stitchFoilFace(PrintMesh &mesh, bool bRightCap,
                          QVector<Vector3d> &PtTopLeft, QVector<Vector3d> &PtBotLeft,
                          QVector<Vector3d> &PtTopRight, QVector<Vector3d> &PtBotRight,
                          double tau, Vector3d &offset, float& unit, double forceFlat)
@@ -3625,20 +3565,20 @@ uint32_t Wing::stitchFoilFace(QDataStream &outStreamData, QTextStream &outStream
     }
 
     //L.E. triangle
-    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[0], PtFoilTop[1], PtFoilBot[1], N, offset, unit, bRightCap, forceFlat);
+    addTriangle3dPrintable(mesh, PtFoilTop[0], PtFoilTop[1], PtFoilBot[1], N, offset, unit, bRightCap, forceFlat);
     iTriangles +=1;
 
     // intermediate points (stitched in pairs)
     for(int ic=1; ic<PtTopLeft.size()-2; ic++)
     {
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], PtFoilTop[ic], PtFoilTop[ic+1], N, offset, unit, bRightCap, forceFlat);
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], PtFoilTop[ic+1], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
+        addTriangle3dPrintable(mesh, PtFoilBot[ic], PtFoilTop[ic], PtFoilTop[ic+1], N, offset, unit, bRightCap, forceFlat);
+        addTriangle3dPrintable(mesh, PtFoilBot[ic], PtFoilTop[ic+1], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
         iTriangles +=2;
     }
 
     //T.E. triangle
     int ic = PtTopLeft.size()-2;
-    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], PtFoilTop[ic], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
+    addTriangle3dPrintable(mesh, PtFoilBot[ic], PtFoilTop[ic], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
     iTriangles +=1;
 
     //qDebug() << "iTriangles: " << iTriangles << "\n";
@@ -3801,14 +3741,11 @@ QVector<Vector3d> generateSparPointsQuad(Wing::sparStruct spar, double y, int qu
  * This efficiently caps a simple set of foils with matching top and bottom points
  * and no spar penetrations
  *
- * Write the facet data to a file in STL Format.
- * bool binaryOut - whether the function stores binary or text data?
- * &outStreamData if binaryOut then required for output (else is ignored)
- * &outStreamText if not binaryOut then required for output (else is ignored)
+ * Adds the facets to the printable mesh.
  *
  *  Returns: the number of triangles written from within this process
  */
-uint32_t Wing::stitchFoilFaceComplex(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut, bool bRightCap,
+uint32_t Wing::stitchFoilFaceComplex(PrintMesh &mesh, bool bRightCap,
                          QVector<Vector3d> &PtTopLeft, QVector<Vector3d> &PtBotLeft,
                          QVector<Vector3d> &PtTopRight, QVector<Vector3d> &PtBotRight,
                          QVector<sparStruct> spars, double y, double tau, Vector3d &offset, float& unit, double forceFlat)
@@ -3846,7 +3783,7 @@ uint32_t Wing::stitchFoilFaceComplex(QDataStream &outStreamData, QTextStream &ou
     sparPtsBot = generateSparPointsTB(spars[0], y, false);
 
     //L.E. triangle
-    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[0], PtFoilTop[1], PtFoilBot[1], N, offset, unit, bRightCap, forceFlat);
+    addTriangle3dPrintable(mesh, PtFoilTop[0], PtFoilTop[1], PtFoilBot[1], N, offset, unit, bRightCap, forceFlat);
     iTriangles +=1;
 
     // intermediate points (stitched in pairs)
@@ -3854,19 +3791,19 @@ uint32_t Wing::stitchFoilFaceComplex(QDataStream &outStreamData, QTextStream &ou
     {
         if (PtFoilTop[ic+1].x < sparPtsTop[0].x) {
             // stitch foil top and bottom until spar is reached
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], PtFoilTop[ic], PtFoilTop[ic+1], N, offset, unit, bRightCap, forceFlat);
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], PtFoilTop[ic+1], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
+            addTriangle3dPrintable(mesh, PtFoilBot[ic], PtFoilTop[ic], PtFoilTop[ic+1], N, offset, unit, bRightCap, forceFlat);
+            addTriangle3dPrintable(mesh, PtFoilBot[ic], PtFoilTop[ic+1], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
             iTriangles +=2;
         }
         else if (is == 0 && (PtFoilTop[ic+1].x > sparPtsTop[0].x || PtFoilBot[ic+1].x > sparPtsTop[0].x)) {
             // if spar has only just been reached then
             // add triangle to correctly stitch the LE of the spar
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic], sparPtsTop[0], PtFoilBot[ic], N, offset, unit, bRightCap, forceFlat);
+            addTriangle3dPrintable(mesh, PtFoilTop[ic], sparPtsTop[0], PtFoilBot[ic], N, offset, unit, bRightCap, forceFlat);
             iTriangles +=1;
 
             while (PtFoilTop[ic+1].x > sparPtsTop[is].x && is < sparPtsTop.size()-1) {
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic], sparPtsTop[is+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], sparPtsBot[is], sparPtsBot[is+1], N, offset, unit, bRightCap, forceFlat);
+                addTriangle3dPrintable(mesh, PtFoilTop[ic], sparPtsTop[is+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
+                addTriangle3dPrintable(mesh, PtFoilBot[ic], sparPtsBot[is], sparPtsBot[is+1], N, offset, unit, bRightCap, forceFlat);
                 iTriangles +=2;
                 is++;
             }
@@ -3878,30 +3815,30 @@ uint32_t Wing::stitchFoilFaceComplex(QDataStream &outStreamData, QTextStream &ou
                 // the next foil point is beyond the spar TE so stitch all remains points to that then finalise
                 if (PtFoilTop[ic-1].x < sparPtsTop[0].x) {
                     // if there is only one foil point within the margin of the spar then an extra top and bot tri is needed
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic-1], PtFoilTop[ic], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic-1], sparPtsBot[is], PtFoilBot[ic], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilTop[ic-1], PtFoilTop[ic], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilBot[ic-1], sparPtsBot[is], PtFoilBot[ic], N, offset, unit, bRightCap, forceFlat);
                     iTriangles +=2;
                 } else {
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic], sparPtsTop[is], sparPtsTop[is-1], N, offset, unit, bRightCap, forceFlat);
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], sparPtsBot[is-1], sparPtsBot[is], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilTop[ic], sparPtsTop[is], sparPtsTop[is-1], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilBot[ic], sparPtsBot[is-1], sparPtsBot[is], N, offset, unit, bRightCap, forceFlat);
                     iTriangles +=2;
                 }
 
                 // add tri linking last foil to next foil point
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic], PtFoilTop[ic+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], sparPtsBot[is], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
+                addTriangle3dPrintable(mesh, PtFoilTop[ic], PtFoilTop[ic+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
+                addTriangle3dPrintable(mesh, PtFoilBot[ic], sparPtsBot[is], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
                 iTriangles +=2;
 
                 while (is < sparPtsTop.size()-1) {
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic+1], sparPtsTop[is+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic+1], sparPtsBot[is], sparPtsBot[is+1], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilTop[ic+1], sparPtsTop[is+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilBot[ic+1], sparPtsBot[is], sparPtsBot[is+1], N, offset, unit, bRightCap, forceFlat);
                     iTriangles +=2;
                     is++;
                 }
             }
 
             // and the final tri to correctly stitch the spar TE to both top and bottom foils
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic+1], PtFoilBot[ic+1], sparPtsTop.back(), N, offset, unit, bRightCap, forceFlat);
+            addTriangle3dPrintable(mesh, PtFoilTop[ic+1], PtFoilBot[ic+1], sparPtsTop.back(), N, offset, unit, bRightCap, forceFlat);
             iTriangles +=1;
 
             // Generate next set of spar points
@@ -3922,23 +3859,23 @@ uint32_t Wing::stitchFoilFaceComplex(QDataStream &outStreamData, QTextStream &ou
             //TODO: need to figure out consequences of needing this check (ie in what circumstances does it fail and does it matter)
             if (is < sparPtsTop.size()) {
 
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic-1], PtFoilTop[ic], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
-                exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], PtFoilBot[ic-1], sparPtsBot[is], N, offset, unit, bRightCap, forceFlat);
+                addTriangle3dPrintable(mesh, PtFoilTop[ic-1], PtFoilTop[ic], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
+                addTriangle3dPrintable(mesh, PtFoilBot[ic], PtFoilBot[ic-1], sparPtsBot[is], N, offset, unit, bRightCap, forceFlat);
                 iTriangles +=2;
 
                 // we're somewhere over the top of the spar
                 // keep stitching to the same foil point until the spar point is beyond
                 while (PtFoilTop[ic+1].x > sparPtsTop[is].x && is < sparPtsTop.size()) {
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic], sparPtsTop[is+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], sparPtsBot[is], sparPtsBot[is+1], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilTop[ic], sparPtsTop[is+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilBot[ic], sparPtsBot[is], sparPtsBot[is+1], N, offset, unit, bRightCap, forceFlat);
                     iTriangles +=2;
 
                     is++;
                 }
 
                 if (PtFoilTop[ic+1].x <= sparPtsTop.back().x) {
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilTop[ic], PtFoilTop[ic+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
-                    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], sparPtsBot[is], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilTop[ic], PtFoilTop[ic+1], sparPtsTop[is], N, offset, unit, bRightCap, forceFlat);
+                    addTriangle3dPrintable(mesh, PtFoilBot[ic], sparPtsBot[is], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
                     iTriangles +=2;
 
                     is++;
@@ -3949,7 +3886,7 @@ uint32_t Wing::stitchFoilFaceComplex(QDataStream &outStreamData, QTextStream &ou
 
     //T.E. triangle
     int ic = PtTopLeft.size()-2;
-    exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, PtFoilBot[ic], PtFoilTop[ic], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
+    addTriangle3dPrintable(mesh, PtFoilBot[ic], PtFoilTop[ic], PtFoilBot[ic+1], N, offset, unit, bRightCap, forceFlat);
     iTriangles +=1;
 
     //qDebug() << "iTriangles: " << iTriangles << "\n";
@@ -3963,14 +3900,11 @@ uint32_t Wing::stitchFoilFaceComplex(QDataStream &outStreamData, QTextStream &ou
 /**
  * Cap the end of a surface "tube" at an arbitrary distance between two end foils
  *
- * Write the facet data to a file in STL Format.
- * bool binaryOut - whether the function stores binary or text data?
- * &outStreamData if binaryOut then required for output (else is ignored)
- * &outStreamText if not binaryOut then required for output (else is ignored)
+ * Adds the facets to the printable mesh.
  *
  *  Returns: the number of triangles written from within this process
  */
-uint32_t Wing::stitchSkinEdge(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut, bool bRightCap, int outputStyle,
+uint32_t Wing::stitchSkinEdge(PrintMesh &mesh, bool bRightCap, int outputStyle,
                          QVector<Vector3d> &PtPrimaryTopLeft, QVector<Vector3d> &PtPrimaryBotLeft,
                          QVector<Vector3d> &PtPrimaryTopRight, QVector<Vector3d> &PtPrimaryBotRight,
                          QVector<Vector3d> &PtSecondTopLeft, QVector<Vector3d> &PtSecondBotLeft,
@@ -4000,26 +3934,26 @@ uint32_t Wing::stitchSkinEdge(QDataStream &outStreamData, QTextStream &outStream
         Pt0 = PtSecondTopLeft[ic]   * (1.0-tau) + PtSecondTopRight[ic]   * tau;
         Pt1 = PtPrimaryTopLeft[ic] * (1.0-tau) + PtPrimaryTopRight[ic] * tau;
         Pt2 = PtPrimaryTopLeft[ic+1] * (1.0-tau) + PtPrimaryTopRight[ic+1] * tau;
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, !bRightCap);
+        addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, !bRightCap);
 
         //2nd triangle (joining top surfaces)
         Pt0 = PtSecondTopLeft[ic]   * (1.0-tau) + PtSecondTopRight[ic]   * tau;
         Pt1 = PtPrimaryTopLeft[ic+1] * (1.0-tau) + PtPrimaryTopRight[ic+1] * tau;
         Pt2 = PtSecondTopLeft[ic+1] * (1.0-tau) + PtSecondTopRight[ic+1] * tau;
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, !bRightCap);
+        addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, !bRightCap);
 
         //1st triangle (joining bottom surfaces)
         Pt0 = PtPrimaryBotLeft[ic]   * (1.0-tau) + PtPrimaryBotRight[ic]   * tau;
         Pt1 = PtSecondBotLeft[ic] * (1.0-tau) + PtSecondBotRight[ic] * tau;
         Pt2 = PtSecondBotLeft[ic+1] * (1.0-tau) + PtSecondBotRight[ic+1] * tau;
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, !bRightCap);
+        addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, !bRightCap);
 
 
         //2nd triangle (joining bottom surfaces)
         Pt0 = PtPrimaryBotLeft[ic]   * (1.0-tau) + PtPrimaryBotRight[ic]   * tau;
         Pt1 = PtSecondBotLeft[ic+1] * (1.0-tau) + PtSecondBotRight[ic+1] * tau;
         Pt2 = PtPrimaryBotLeft[ic+1] * (1.0-tau) + PtPrimaryBotRight[ic+1] * tau;
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, Pt0, Pt1, Pt2, N, offset, unit, !bRightCap);
+        addTriangle3dPrintable(mesh, Pt0, Pt1, Pt2, N, offset, unit, !bRightCap);
 
         iTriangles +=2;
     }
@@ -4138,7 +4072,7 @@ QVector<Vector3d> Wing::generateSparPointsTB(sparStruct spar, double y, bool top
 
 // add the internal faces for a bracing cylinder (spar) through the rib (ie generally oriented along the line of the wing - in the y direction)
 // This could be either a cutout (eg a carbon fibre spar added after the print has been completed), or a printed spar.
-uint32_t Wing::stitchSpar(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut,
+uint32_t Wing::stitchSpar(PrintMesh &mesh,
           sparStruct spar, double yLeft, double yRight,
           Vector3d &offset, float& unit)
 {
@@ -4180,19 +4114,19 @@ uint32_t Wing::stitchSpar(QDataStream &outStreamData, QTextStream &outStreamText
         if (spar.type == SPARCUTOUT) {
 
             // create the faces along the length of the cylinder
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, lSR[ic], lSR[ic+1], rSR[ic], NA, offset, unit, false);
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, lSR[ic+1], rSR[ic+1], rSR[ic], NB, offset, unit, false);
+            addTriangle3dPrintable(mesh, lSR[ic], lSR[ic+1], rSR[ic], NA, offset, unit, false);
+            addTriangle3dPrintable(mesh, lSR[ic+1], rSR[ic+1], rSR[ic], NB, offset, unit, false);
             iTriangles += 2;
 
         } else {
             // join the cylinder rim points to the appropriate centre point
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, cLeft, lSR[ic+1], lSR[ic], NA, offset, unit, true);
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, cRight, rSR[ic], rSR[ic+1], NB, offset, unit, true);
+            addTriangle3dPrintable(mesh, cLeft, lSR[ic+1], lSR[ic], NA, offset, unit, true);
+            addTriangle3dPrintable(mesh, cRight, rSR[ic], rSR[ic+1], NB, offset, unit, true);
             iTriangles += 2;
 
             // create the faces along the length of the cylinder
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, lSR[ic], lSR[ic+1], rSR[ic], NA, offset, unit, true);
-            exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, lSR[ic+1], rSR[ic+1], rSR[ic], NB, offset, unit, true);
+            addTriangle3dPrintable(mesh, lSR[ic], lSR[ic+1], rSR[ic], NA, offset, unit, true);
+            addTriangle3dPrintable(mesh, lSR[ic+1], rSR[ic+1], rSR[ic], NB, offset, unit, true);
             iTriangles += 2;
         }
     }
@@ -4202,17 +4136,17 @@ uint32_t Wing::stitchSpar(QDataStream &outStreamData, QTextStream &outStreamText
     if (spar.type == SPARCUTOUT) {
 
         // add the tube link
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, lSR[ic], lSR[0], rSR[ic], NA, offset, unit, false);
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, lSR[0], rSR[0], rSR[ic], NB, offset, unit, false);
+        addTriangle3dPrintable(mesh, lSR[ic], lSR[0], rSR[ic], NA, offset, unit, false);
+        addTriangle3dPrintable(mesh, lSR[0], rSR[0], rSR[ic], NB, offset, unit, false);
         iTriangles += 2;
 
     } else {
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, cLeft, lSR[0], lSR[ic], NA, offset, unit, true);
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, cRight, rSR[ic], rSR[0], NB, offset, unit, true);
+        addTriangle3dPrintable(mesh, cLeft, lSR[0], lSR[ic], NA, offset, unit, true);
+        addTriangle3dPrintable(mesh, cRight, rSR[ic], rSR[0], NB, offset, unit, true);
         iTriangles += 2;
 
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, lSR[ic], lSR[0], rSR[ic], NA, offset, unit, true);
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, lSR[0], rSR[0], rSR[ic], NB, offset, unit, true);
+        addTriangle3dPrintable(mesh, lSR[ic], lSR[0], rSR[ic], NA, offset, unit, true);
+        addTriangle3dPrintable(mesh, lSR[0], rSR[0], rSR[ic], NB, offset, unit, true);
         iTriangles += 2;
     }
 
@@ -4220,7 +4154,7 @@ uint32_t Wing::stitchSpar(QDataStream &outStreamData, QTextStream &outStreamText
 }
 
 // add the internal faces for a drainage hole just next to the rib (used for 3d resin printers)
-uint32_t Wing::stitchDrainageHole(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut,
+uint32_t Wing::stitchDrainageHole(PrintMesh &mesh,
           QVector<rdhStruct> &resinDrainageHoles,
           Vector3d &offset, float& unit, bool reverse)
 {
@@ -4232,14 +4166,15 @@ uint32_t Wing::stitchDrainageHole(QDataStream &outStreamData, QTextStream &outSt
     for (int h=0; h<resinDrainageHoles.size()-1; h++) {
         auto& rdh = resinDrainageHoles[h];
         //side1
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, rdh.tip[OUTERFACE], rdh.start[OUTERFACE], rdh.tip[INNERFACE], N, offset, unit, reverse);
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, rdh.start[INNERFACE], rdh.tip[INNERFACE], rdh.start[OUTERFACE], N, offset, unit, reverse);
+        addTriangle3dPrintable(mesh, rdh.tip[OUTERFACE], rdh.start[OUTERFACE], rdh.tip[INNERFACE], N, offset, unit, reverse);
+        addTriangle3dPrintable(mesh, rdh.start[INNERFACE], rdh.tip[INNERFACE], rdh.start[OUTERFACE], N, offset, unit, reverse);
         //side2
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, rdh.end[OUTERFACE], rdh.tip[OUTERFACE], rdh.end[INNERFACE], N, offset, unit, reverse);
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, rdh.tip[INNERFACE], rdh.end[INNERFACE], rdh.tip[OUTERFACE], N, offset, unit, reverse);
+        addTriangle3dPrintable(mesh, rdh.end[OUTERFACE], rdh.tip[OUTERFACE], rdh.end[INNERFACE], N, offset, unit, reverse);
+        addTriangle3dPrintable(mesh, rdh.tip[INNERFACE], rdh.end[INNERFACE], rdh.tip[OUTERFACE], N, offset, unit, reverse);
         //side3
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, rdh.start[OUTERFACE], rdh.end[OUTERFACE], rdh.start[INNERFACE], N, offset, unit, reverse);
-        exportSTLTriangle3dPrintable(outStreamData, outStreamText, binaryOut, rdh.end[INNERFACE], rdh.start[INNERFACE], rdh.end[OUTERFACE], N, offset, unit, reverse);
+        addTriangle3dPrintable(mesh, rdh.start[OUTERFACE], rdh.end[OUTERFACE], rdh.start[INNERFACE], N, offset, unit, reverse);
+        addTriangle3dPrintable(mesh, rdh.end[INNERFACE], rdh.start[INNERFACE], rdh.end[OUTERFACE], N, offset, unit, reverse);
+        iTriangles += 6;
     }
 
     return iTriangles;
@@ -4247,77 +4182,43 @@ uint32_t Wing::stitchDrainageHole(QDataStream &outStreamData, QTextStream &outSt
 
 
 /**
- * Export the wing geometry to a file in STL Format (either binary or text).
+ * Builds the 3d printable wing geometry in memory and writes it to the device in a single pass.
+ * @param device the open file to write to
+ * @param format binary STL, text STL or OBJ
+ * @return the number of triangles written, or 0 if the output failed
+ */
+uint32_t Wing::exportSTL3dPrintable(QIODevice &device, PrintMesh::enumFormat format,
+                                    int CHORDPANELS, int SPANPANELS,
+                                    printOutputStyle outputStyle, float unit)
+{
+    PrintMesh mesh;
+    makePrintableMesh(mesh, CHORDPANELS, SPANPANELS, outputStyle, unit);
+
+    if(!mesh.write(device, format, m_Name)) return 0;
+    return uint32_t(mesh.nTriangles());
+}
+
+
+/**
+ * Builds the wing geometry as an indexed mesh, for export to a 3d printer.
  * This is a 3d printable wing - ie with a skin on the inside
  * The version can also generate a mold - ie with the skin on the outside and no internal features
- * @param out the instance of the QTextStream to which the output will be directed
+ * Each span division, i.e. each printed part, is stored as a separate part of the mesh.
  * outputStyle:
  *   0 - standard 3d viewable mesh (not coded as already exists in xflr5)
  *   1 - generate a 3d printable wing with ribs and a skin
  *   2 - generate just the ribs
  *   3 - generate a mold (ie with the skin on the outside and no internal features) for casting
  *
- *   returns then number of faces saved to the stl
+ *   returns then number of faces in the mesh
  */
-uint32_t Wing::exportSTL3dPrintable(QDataStream &outStreamData, QTextStream &outStreamText, bool binaryOut,
-                                int CHORDPANELS, int SPANPANELS,
-                                printOutputStyle outputStyle, float unit)
+uint32_t Wing::makePrintableMesh(PrintMesh &mesh, int CHORDPANELS, int SPANPANELS,
+                                 printOutputStyle outputStyle, float unit)
 {
-
     // 3d printers expect measurements in mm, no the normal xflr5 SI units, so multiply output by 1000
     unit = 1000;
 
-
-    if (binaryOut) {
-        //Use STL Binary Format Output
-        /***
-         *  UINT8[80] – Header
-         *  UINT32 – Number of triangles
-         *
-         *  foreach triangle
-         *     REAL32[3] – Normal vector
-         *     REAL32[3] – Vertex 1
-         *     REAL32[3] – Vertex 2
-         *     REAL32[3] – Vertex 3
-         *     UINT16 – Attribute byte count
-         *  end
-        */
-
-        //    80 character header, avoid word "solid" (NB appears to be one character short as requires space for the trailing \0)
-        //                0123456789 123456789 123456789 123456789 123456789 123456789 123456789 123456789
-        QString strong = "binary STL file                                                                ";
-        xfl::writeCString(outStreamData, strong);
-
-        // TODO: Number of triangles is unknown at this point so
-        // we will need to seek back to this location and overwrite it after all the triangles have been counted
-        // this is done in miarex.cpp after the function returns
-        char buffer[4] = {'\0','\0','\0','\0'};
-        outStreamData.writeRawData(buffer, sizeof(uint32_t));
-
-
-    } else {
-
-        //Use STL Text Format Output
-        /***
-         * solid name
-         *
-         *       facet normal ni nj nk
-         *         outer loop
-         *           vertex v1x v1y v1z
-         *           vertex v2x v2y v2z
-         *           vertex v3x v3y v3z
-         *      endloop
-         *   endfacet
-         *
-         * endsolid name
-        */
-        QString name = m_Name;
-        name.replace(" ","");
-        outStreamText << "solid " + name + "\n";
-    }
-
-
-
+    mesh.clear();
 
     Vector3d N, Pt, Pt0, Pt1, Pt2, offset;
 
@@ -4519,7 +4420,7 @@ uint32_t Wing::exportSTL3dPrintable(QDataStream &outStreamData, QTextStream &out
     resinDrainageHolesBot[1].rdhLoc = 0.75;
 
     // print the entire spar - eg for testing
-    //iTriangles += stitchSpar(outStreamData, outStreamText, binaryOut, spars[0], spars[0].pL.y, spars[0].pR.y, offset, unit);
+    //iTriangles += stitchSpar(mesh, spars[0], spars[0].pL.y, spars[0].pR.y, offset, unit);
 
 
 //    double chordMin = m_Surface.at();
@@ -4548,6 +4449,8 @@ uint32_t Wing::exportSTL3dPrintable(QDataStream &outStreamData, QTextStream &out
     // this should be possible but use of offset and tracking of the distance from the root
 
 
+    QVector<printDivision> divisions;
+
     for (int j=1; j<m_Surface.size(); j++)  //
     {
 
@@ -4638,20 +4541,49 @@ uint32_t Wing::exportSTL3dPrintable(QDataStream &outStreamData, QTextStream &out
         qDebug() << "Wing Dimensions: " << wingSpan << "," << wingSectionLength << "," << surfaceLength;
         qDebug() << "Divisions: " << SPANPANELS << "," << spanDivisions << "," << panelsPerDivision << "," << sizePerPanel << "," << distanceFromSectionLeft << "\n";
 
+        // The position of each division depends only on the rib thickness and on the number of skin panels,
+        // so it is set beforehand, and the divisions are meshed independently of each other
         // TODO: this will need to be modified to allow transition across multiple sections
         for(int sd=0; sd<spanDivisions; sd++)
         {
+            double tauRR = distanceFromSectionLeft / surf.m_Length;
+            if ((ribThickness > 0.0) && (tauRR > 1.0))
+                break;
 
-            double dfslAtRibRoot = distanceFromSectionLeft;
-            double tauRR = dfslAtRibRoot / surf.m_Length;
-            double minX = PtPrimaryTopLeft[0].x * (1.0-tauRR) + PtPrimaryTopRight[0].x * tauRR;
-
-            // each part/division should be placed flat on the printer bed
-            //qDebug() << "offset y: " << sectionRootDistanceFromWingRoot << "," << distanceFromSectionLeft;
-            offset = { -minX, -sectionRootDistanceFromWingRoot-distanceFromSectionLeft, zDivisionOffset };
-
-
-            // calculate the z offset for the next printed part (since it keeps related calculations together rather than doing it later)
+            divisions.append(printDivision());
+            printDivision &div = divisions.last();
+            div.iSurf = j;
+            div.iDivision = sd;
+            div.isRHS = isRHS;
+            div.outputStyle = outputStyle;
+            div.unit = unit;
+            div.surfLength = surf.m_Length;
+            div.sectionRootDistanceFromWingRoot = sectionRootDistanceFromWingRoot;
+            div.distanceFromSectionLeft = distanceFromSectionLeft;
+            div.zDivisionOffset = zDivisionOffset;
+            div.panelsPerDivision = panelsPerDivision;
+            div.sizePerPanel = sizePerPanel;
+            div.PtPrimaryTopLeft  = PtPrimaryTopLeft;
+            div.PtPrimaryTopRight = PtPrimaryTopRight;
+            div.PtPrimaryBotLeft  = PtPrimaryBotLeft;
+            div.PtPrimaryBotRight = PtPrimaryBotRight;
+            div.PtSecondTopLeft   = PtSecondTopLeft;
+            div.PtSecondTopRight  = PtSecondTopRight;
+            div.PtSecondBotLeft   = PtSecondBotLeft;
+            div.PtSecondBotRight  = PtSecondBotRight;
+            div.NormalPrimaryTopA = NormalPrimaryTopA;
+            div.NormalPrimaryTopB = NormalPrimaryTopB;
+            div.NormalPrimaryBotA = NormalPrimaryBotA;
+            div.NormalPrimaryBotB = NormalPrimaryBotB;
+            div.NormalSecondTopA  = NormalSecondTopA;
+            div.NormalSecondTopB  = NormalSecondTopB;
+            div.NormalSecondBotA  = NormalSecondBotA;
+            div.NormalSecondBotB  = NormalSecondBotB;
+            div.resinDrainageHolesTop = resinDrainageHolesTop;
+            div.resinDrainageHolesBot = resinDrainageHolesBot;
+            div.resinDrainageHoleWH = resinDrainageHoleWH;
+
+            // calculate the z offset for the next printed part
             double maxZSpan = 0;
             for(int ic=0; ic<CHORDPANELS; ic++) {
                 double zTop = PtPrimaryTopLeft[ic].z * (1.0-tauRR) + PtPrimaryTopRight[ic].z * tauRR;
@@ -4662,238 +4594,331 @@ uint32_t Wing::exportSTL3dPrintable(QDataStream &outStreamData, QTextStream &out
             }
             zDivisionOffset += maxZSpan * partZSpacing;
 
+            double skinStart = 0;
+            int nSkinPanels = 0;
+            distanceFromSectionLeft = printableDivisionEnd(isRHS, distanceFromSectionLeft, surf.m_Length,
+                                                           panelsPerDivision, sizePerPanel, skinStart, nSkinPanels);
+        }
+    }
 
+    // mesh the divisions in parallel, each in its own buffer
+    QFutureSynchronizer<void> futureSync;
+    for(int id=0; id<divisions.size(); id++)
+    {
+        futureSync.addFuture(QtConcurrent::run(this, &Wing::makePrintableDivision, divisions.data()+id));
+    }
+    futureSync.waitForFinished();
 
+    // merge the buffers in the order of the surfaces and divisions, so that the output does not depend on the thread scheduling
+    for(int id=0; id<divisions.size(); id++)
+    {
+        mesh.append(divisions.at(id).mesh);
+        iTriangles += divisions.at(id).iTriangles;
+    }
 
-            if (ribThickness > 0.0) {
-                // Generate the rib
-
-                // tau is the proportional distance along the current span
-                // uses the same A/B logic as Normals (ie A is the left face, B is the right face
-                double tauA = distanceFromSectionLeft / surf.m_Length;
-                if (tauA > 1.0)
-                    break;
-                double tauC = (double)(distanceFromSectionLeft+ribThickness) / (double)(surf.m_Length);
-                //qDebug() << "tauC: " << tauC << "," << distanceFromSectionLeft << "," << ribThickness << "," << surf.m_Length;
-                if (tauC > 1.0)
-                    tauC = 1.0f;     // for the last division it can't be further than the full length of the span
-                double tau = (tauA+tauC)/2.0;
-
-                //rib top surface
-                iTriangles += stitchWingSurface(outStreamData, outStreamText, binaryOut,
-                        PtPrimaryTopLeft, NormalPrimaryTopA, PtPrimaryTopRight, NormalPrimaryTopB,
-                        tau, tauA, tauC, offset, unit, false);
-                //rib bottom surface
-                iTriangles += stitchWingSurface(outStreamData, outStreamText, binaryOut,
-                         PtPrimaryBotLeft, NormalPrimaryBotA, PtPrimaryBotRight, NormalPrimaryBotB,
-                         tau, tauA, tauC, offset, unit, true);
 
-                // now fill in the faces
-                if (isRHS) {
-                    // tau is the proportional distance along the current span
-                    // uses the same A/B logic as Normals (ie A is the left face, B is the right face
-                    double tauRibRoot = dfslAtRibRoot / surf.m_Length;
-                    double tauRibInner = (dfslAtRibRoot + ribThickness) / surf.m_Length;
 
-                    if (outputStyle == PRINTABLE)
-                    {
-                        // Generate spar cutouts if they penetrate this rib?
-                        int sparPenetrations = 0;
-                        for (auto& spar : spars) {
-                            //qDebug() << spar.pL.y << "," << dfslAtRibRoot << "," << ribThickness << "&" << spar.pR.y << "," << dfslAtRibRoot;
-                            // if the spar contacts the rib it will be treated as full penetration
-                            if ((spar.pL.y <= dfslAtRibRoot + ribThickness) && (spar.pR.y >= dfslAtRibRoot)) {
-                                sparPenetrations++;
-                                // TODO: eliminate any spars which are not encompassed by the foil boundary
-                                iTriangles += stitchSpar(outStreamData, outStreamText, binaryOut,
-                                          spar,
-                                          sectionRootDistanceFromWingRoot + dfslAtRibRoot,
-                                          sectionRootDistanceFromWingRoot + dfslAtRibRoot + ribThickness,
-                                          offset, unit);
-                            }
-                        }
+    // BRACING STRUTS - A cylindrical support
+    // STRUT CUTOUTS - A cylindrical hole - eg to add carbon fibre tubing for support
 
-                        if (sparPenetrations == 0) {
-                            // generate the rib face in contact with the printer buildplate
-                            iTriangles += stitchFoilFace(outStreamData, outStreamText, binaryOut, isRHS,
-                                           PtPrimaryTopLeft, PtPrimaryBotLeft, PtPrimaryTopRight, PtPrimaryBotRight,
-                                           tauRibRoot, offset, unit, 0.0);
 
-                            // generate the rib face linking the top and bottom surfaces of the inner skin
-                            iTriangles += stitchFoilFace(outStreamData, outStreamText, binaryOut, isRHS,
-                                           PtSecondTopLeft, PtSecondBotLeft, PtSecondTopRight, PtSecondBotRight,
-                                           tauRibInner, offset, unit);
-                        }
-                        else
-                        {
+    // TIPCAP
+    // This is half an icosagon with a radius equal to half the distance between top and bottom surfaces
 
 
-                            // generate the rib face in contact with the printer buildplate
-                            iTriangles += stitchFoilFaceComplex(outStreamData, outStreamText, binaryOut, isRHS,
-                                                     PtPrimaryTopLeft, PtPrimaryBotLeft, PtPrimaryTopRight, PtPrimaryBotRight,
-                                                     spars, sectionRootDistanceFromWingRoot + dfslAtRibRoot,
-                                                     tauRibRoot, offset, unit);
+    return uint32_t(mesh.nTriangles());
+}
 
-                            // generate the other rib face
-                            iTriangles += stitchFoilFaceComplex(outStreamData, outStreamText, binaryOut, !isRHS,
-                                                                PtSecondTopLeft, PtSecondBotLeft, PtSecondTopRight, PtSecondBotRight,
-                                                                spars, sectionRootDistanceFromWingRoot + dfslAtRibRoot + ribThickness,
-                                                                tauRibInner, offset, unit);
-                        }
-                    }
-                    else //if (outputStyle != PRINTABLE)
-                    {
 
-                        // at each end there should be caps, then at each rib the rib is outside and is squared off so the mold sits flat on a surface
-                        // there should also be a wall which goes up the outer edge - in case it needs filling with something cheap to support the mold
-                        // generate a skirt outside the wing
 
+/**
+ * Meshes one span division, i.e. one printed part, in the division's own buffer.
+ * The divisions are independent, so that this function may be run concurrently for all of them.
+ */
+void Wing::makePrintableDivision(printDivision *pDivision)
+{
+    printDivision &div = *pDivision;
+    PrintMesh &mesh = div.mesh;
+    mesh.clear();
+
+    bool isRHS = div.isRHS;
+    printOutputStyle outputStyle = div.outputStyle;
+    float unit = div.unit;
+    double sectionRootDistanceFromWingRoot = div.sectionRootDistanceFromWingRoot;
+    double distanceFromSectionLeft = div.distanceFromSectionLeft;
+    int panelsPerDivision = div.panelsPerDivision;
+    double sizePerPanel = div.sizePerPanel;
+    double zDivisionOffset = div.zDivisionOffset;
+    double resinDrainageHoleWH = div.resinDrainageHoleWH;
+    QVector<rdhStruct> &resinDrainageHolesTop = div.resinDrainageHolesTop;
+    QVector<rdhStruct> &resinDrainageHolesBot = div.resinDrainageHolesBot;
+
+    QVector<Vector3d> &PtPrimaryTopLeft  = div.PtPrimaryTopLeft;
+    QVector<Vector3d> &PtPrimaryTopRight = div.PtPrimaryTopRight;
+    QVector<Vector3d> &PtPrimaryBotLeft  = div.PtPrimaryBotLeft;
+    QVector<Vector3d> &PtPrimaryBotRight = div.PtPrimaryBotRight;
+    QVector<Vector3d> &PtSecondTopLeft   = div.PtSecondTopLeft;
+    QVector<Vector3d> &PtSecondTopRight  = div.PtSecondTopRight;
+    QVector<Vector3d> &PtSecondBotLeft   = div.PtSecondBotLeft;
+    QVector<Vector3d> &PtSecondBotRight  = div.PtSecondBotRight;
+    QVector<Vector3d> &NormalPrimaryTopA = div.NormalPrimaryTopA;
+    QVector<Vector3d> &NormalPrimaryTopB = div.NormalPrimaryTopB;
+    QVector<Vector3d> &NormalPrimaryBotA = div.NormalPrimaryBotA;
+    QVector<Vector3d> &NormalPrimaryBotB = div.NormalPrimaryBotB;
+    QVector<Vector3d> &NormalSecondTopA  = div.NormalSecondTopA;
+    QVector<Vector3d> &NormalSecondTopB  = div.NormalSecondTopB;
+    QVector<Vector3d> &NormalSecondBotA  = div.NormalSecondBotA;
+    QVector<Vector3d> &NormalSecondBotB  = div.NormalSecondBotB;
+
+    Vector3d offset;
+    uint32_t &iTriangles = div.iTriangles;
+    iTriangles = 0;
+
+    double skinStart = 0;
+    int nSkinPanels = 0;
+    printableDivisionEnd(isRHS, distanceFromSectionLeft, div.surfLength, panelsPerDivision, sizePerPanel, skinStart, nSkinPanels);
+
+    mesh.beginPart(QString::asprintf("surface%d_division%d", div.iSurf, div.iDivision));
+
+    double dfslAtRibRoot = distanceFromSectionLeft;
+    double tauRR = dfslAtRibRoot / div.surfLength;
+    double minX = PtPrimaryTopLeft[0].x * (1.0-tauRR) + PtPrimaryTopRight[0].x * tauRR;
+
+    // each part/division should be placed flat on the printer bed
+    //qDebug() << "offset y: " << sectionRootDistanceFromWingRoot << "," << distanceFromSectionLeft;
+    offset = { -minX, -sectionRootDistanceFromWingRoot-distanceFromSectionLeft, zDivisionOffset };
+
+
+    if (ribThickness > 0.0) {
+        // Generate the rib
+
+        // tau is the proportional distance along the current span
+        // uses the same A/B logic as Normals (ie A is the left face, B is the right face
+        double tauA = distanceFromSectionLeft / div.surfLength;
+        if (tauA > 1.0)
+            return;
+        double tauC = (double)(distanceFromSectionLeft+ribThickness) / (double)(div.surfLength);
+        //qDebug() << "tauC: " << tauC << "," << distanceFromSectionLeft << "," << ribThickness << "," << div.surfLength;
+        if (tauC > 1.0)
+            tauC = 1.0f;     // for the last division it can't be further than the full length of the span
+        double tau = (tauA+tauC)/2.0;
+
+        //rib top surface
+        iTriangles += stitchWingSurface(mesh,
+                PtPrimaryTopLeft, NormalPrimaryTopA, PtPrimaryTopRight, NormalPrimaryTopB,
+                tau, tauA, tauC, offset, unit, false);
+        //rib bottom surface
+        iTriangles += stitchWingSurface(mesh,
+                 PtPrimaryBotLeft, NormalPrimaryBotA, PtPrimaryBotRight, NormalPrimaryBotB,
+                 tau, tauA, tauC, offset, unit, true);
+
+        // now fill in the faces
+        if (isRHS) {
+            // tau is the proportional distance along the current span
+            // uses the same A/B logic as Normals (ie A is the left face, B is the right face
+            double tauRibRoot = dfslAtRibRoot / div.surfLength;
+            double tauRibInner = (dfslAtRibRoot + ribThickness) / div.surfLength;
+
+            if (outputStyle == PRINTABLE)
+            {
+                // Generate spar cutouts if they penetrate this rib?
+                int sparPenetrations = 0;
+                for (auto& spar : spars) {
+                    //qDebug() << spar.pL.y << "," << dfslAtRibRoot << "," << ribThickness << "&" << spar.pR.y << "," << dfslAtRibRoot;
+                    // if the spar contacts the rib it will be treated as full penetration
+                    if ((spar.pL.y <= dfslAtRibRoot + ribThickness) && (spar.pR.y >= dfslAtRibRoot)) {
+                        sparPenetrations++;
+                        // TODO: eliminate any spars which are not encompassed by the foil boundary
+                        iTriangles += stitchSpar(mesh,
+                                  spar,
+                                  sectionRootDistanceFromWingRoot + dfslAtRibRoot,
+                                  sectionRootDistanceFromWingRoot + dfslAtRibRoot + ribThickness,
+                                  offset, unit);
                     }
+                }
 
-                    distanceFromSectionLeft+=ribThickness; // (panelsPerDivision*sizePerPanel);
+                if (sparPenetrations == 0) {
+                    // generate the rib face in contact with the printer buildplate
+                    iTriangles += stitchFoilFace(mesh, isRHS,
+                                   PtPrimaryTopLeft, PtPrimaryBotLeft, PtPrimaryTopRight, PtPrimaryBotRight,
+                                   tauRibRoot, offset, unit, 0.0);
 
+                    // generate the rib face linking the top and bottom surfaces of the inner skin
+                    iTriangles += stitchFoilFace(mesh, isRHS,
+                                   PtSecondTopLeft, PtSecondBotLeft, PtSecondTopRight, PtSecondBotRight,
+                                   tauRibInner, offset, unit);
                 }
-                else    // if (!isRHS)
+                else
                 {
-                    //stitchTopToBottomLeft(outStreamData, outStreamText, binaryOut, PtPrimaryTopLeft, PtPrimaryBotLeft, N, offset, unit);
 
-                    distanceFromSectionLeft-=ribThickness;
 
+                    // generate the rib face in contact with the printer buildplate
+                    iTriangles += stitchFoilFaceComplex(mesh, isRHS,
+                                             PtPrimaryTopLeft, PtPrimaryBotLeft, PtPrimaryTopRight, PtPrimaryBotRight,
+                                             spars, sectionRootDistanceFromWingRoot + dfslAtRibRoot,
+                                             tauRibRoot, offset, unit);
+
+                    // generate the other rib face
+                    iTriangles += stitchFoilFaceComplex(mesh, !isRHS,
+                                                        PtSecondTopLeft, PtSecondBotLeft, PtSecondTopRight, PtSecondBotRight,
+                                                        spars, sectionRootDistanceFromWingRoot + dfslAtRibRoot + ribThickness,
+                                                        tauRibInner, offset, unit);
                 }
             }
+            else //if (outputStyle != PRINTABLE)
+            {
 
+                // at each end there should be caps, then at each rib the rib is outside and is squared off so the mold sits flat on a surface
+                // there should also be a wall which goes up the outer edge - in case it needs filling with something cheap to support the mold
+                // generate a skirt outside the wing
 
-            //TODO: add strain relief at the edge attaching to the skin
+            }
+        }
+        else    // if (!isRHS)
+        {
+            //stitchTopToBottomLeft(mesh, PtPrimaryTopLeft, PtPrimaryBotLeft, N, offset, unit);
+        }
+    }
 
-            if (skinThickness > 0.0) {
 
+    //TODO: add strain relief at the edge attaching to the skin
 
-                // generate the skin panels (ie both top and bottom surface panels for internal and external faces)
-                for(int ppd=0; ppd<panelsPerDivision; ppd++)
-                {
+    if (skinThickness > 0.0) {
 
-                    // tau is the proportional distance along the current span
-                    // uses the same A/B logic as Normals (ie A is the left face, B is the right face
-                    double tauA = distanceFromSectionLeft / surf.m_Length;
-                    if (tauA > 1.0)
-                        break;
-                    double tauB = double(distanceFromSectionLeft+sizePerPanel) / double(surf.m_Length);
-                    if (tauB > 1.0)
-                        tauB = 1.0f;     // for the last division it can't be further than the full length of the span
 
-                    double tau = (tauA+tauB)/2.0;
+        // generate the skin panels (ie both top and bottom surface panels for internal and external faces)
+        distanceFromSectionLeft = skinStart;
+        for(int ppd=0; ppd<nSkinPanels; ppd++)
+        {
 
+            // tau is the proportional distance along the current span
+            // uses the same A/B logic as Normals (ie A is the left face, B is the right face
+            double tauA = distanceFromSectionLeft / div.surfLength;
+            double tauB = double(distanceFromSectionLeft+sizePerPanel) / double(div.surfLength);
+            if (tauB > 1.0)
+                tauB = 1.0f;     // for the last division it can't be further than the full length of the span
 
-                    if ((ppd == 0) && (resinDrainageHoleWH > 0) && (resinDrainageHolesTop.size() > 0)) {
+            double tau = (tauA+tauB)/2.0;
 
-                        generateDrainageHoles(PtPrimaryTopLeft, PtPrimaryTopRight,
-                                           PtSecondTopLeft, PtSecondTopRight,
-                                           resinDrainageHolesTop, resinDrainageHoleWH,
-                                           tauA);
 
-                        //primary top surface
-                        iTriangles += stitchWingSurfaceDrained(outStreamData, outStreamText, binaryOut,
-                                 PtPrimaryTopLeft, NormalPrimaryTopA, PtPrimaryTopRight, NormalPrimaryTopB,
-                                 resinDrainageHolesTop, resinDrainageHoleWH, OUTERFACE,
-                                 tau, tauA, tauB, offset, unit, false);
-                        //secondary top surface
-                        iTriangles += stitchWingSurfaceDrained(outStreamData, outStreamText, binaryOut,
-                                 PtSecondTopLeft, NormalSecondTopA, PtSecondTopRight, NormalSecondTopB,
-                                 resinDrainageHolesTop, resinDrainageHoleWH, INNERFACE,
-                                 tau, tauA, tauB, offset, unit, true);
+            if ((ppd == 0) && (resinDrainageHoleWH > 0) && (resinDrainageHolesTop.size() > 0)) {
 
-                        iTriangles += stitchDrainageHole(outStreamData, outStreamText, binaryOut,
-                                  resinDrainageHolesTop, offset, unit, isRHS);
-                    }
-                    else
-                    {
-                        //primary top surface
-                        iTriangles += stitchWingSurface(outStreamData, outStreamText, binaryOut,
-                                 PtPrimaryTopLeft, NormalPrimaryTopA, PtPrimaryTopRight, NormalPrimaryTopB,
-                                 tau, tauA, tauB, offset, unit, false);
-                        //secondary top surface
-                        iTriangles += stitchWingSurface(outStreamData, outStreamText, binaryOut,
-                                 PtSecondTopLeft, NormalSecondTopA, PtSecondTopRight, NormalSecondTopB,
-                                 tau, tauA, tauB, offset, unit, true);
-                    }
+                generateDrainageHoles(PtPrimaryTopLeft, PtPrimaryTopRight,
+                                   PtSecondTopLeft, PtSecondTopRight,
+                                   resinDrainageHolesTop, resinDrainageHoleWH,
+                                   tauA);
 
-                    if ((ppd == 0) && (resinDrainageHoleWH > 0.0f) && (resinDrainageHolesBot.size() > 0)) {
-
-                        generateDrainageHoles(PtPrimaryBotLeft, PtPrimaryBotRight,
-                                           PtSecondBotLeft, PtSecondBotRight,
-                                           resinDrainageHolesBot, resinDrainageHoleWH,
-                                           tauA);
-
-                        //primary bottom surface
-                        iTriangles += stitchWingSurfaceDrained(outStreamData, outStreamText, binaryOut,
-                                 PtPrimaryBotLeft, NormalPrimaryBotA, PtPrimaryBotRight, NormalPrimaryBotB,
-                                 resinDrainageHolesBot, resinDrainageHoleWH, OUTERFACE,
-                                 tau, tauA, tauB, offset, unit, true);
-                        //secondary bottom surface
-                        iTriangles += stitchWingSurfaceDrained(outStreamData, outStreamText, binaryOut,
-                                 PtSecondBotLeft, NormalSecondBotA, PtSecondBotRight, NormalSecondBotB,
-                                 resinDrainageHolesBot, resinDrainageHoleWH, INNERFACE,
-                                 tau, tauA, tauB, offset, unit, false);
-
-                        iTriangles += stitchDrainageHole(outStreamData, outStreamText, binaryOut,
-                                  resinDrainageHolesBot, offset, unit, isRHS);
-
-                    } else {
-                        //primary bottom surface
-                        iTriangles += stitchWingSurface(outStreamData, outStreamText, binaryOut,
-                                 PtPrimaryBotLeft, NormalPrimaryBotA, PtPrimaryBotRight, NormalPrimaryBotB,
-                                 tau, tauA, tauB, offset, unit, true);
-
-                        //secondary bottom surface
-                        iTriangles += stitchWingSurface(outStreamData, outStreamText, binaryOut,
-                                 PtSecondBotLeft, NormalSecondBotA, PtSecondBotRight, NormalSecondBotB,
-                                 tau, tauA, tauB, offset, unit, false);
-                    }
+                //primary top surface
+                iTriangles += stitchWingSurfaceDrained(mesh,
+                         PtPrimaryTopLeft, NormalPrimaryTopA, PtPrimaryTopRight, NormalPrimaryTopB,
+                         resinDrainageHolesTop, resinDrainageHoleWH, OUTERFACE,
+                         tau, tauA, tauB, offset, unit, false);
+                //secondary top surface
+                iTriangles += stitchWingSurfaceDrained(mesh,
+                         PtSecondTopLeft, NormalSecondTopA, PtSecondTopRight, NormalSecondTopB,
+                         resinDrainageHolesTop, resinDrainageHoleWH, INNERFACE,
+                         tau, tauA, tauB, offset, unit, true);
 
-                    distanceFromSectionLeft+=sizePerPanel;
-                }
+                iTriangles += stitchDrainageHole(mesh,
+                          resinDrainageHolesTop, offset, unit, isRHS);
+            }
+            else
+            {
+                //primary top surface
+                iTriangles += stitchWingSurface(mesh,
+                         PtPrimaryTopLeft, NormalPrimaryTopA, PtPrimaryTopRight, NormalPrimaryTopB,
+                         tau, tauA, tauB, offset, unit, false);
+                //secondary top surface
+                iTriangles += stitchWingSurface(mesh,
+                         PtSecondTopLeft, NormalSecondTopA, PtSecondTopRight, NormalSecondTopB,
+                         tau, tauA, tauB, offset, unit, true);
+            }
+
+            if ((ppd == 0) && (resinDrainageHoleWH > 0.0f) && (resinDrainageHolesBot.size() > 0)) {
 
-                // cap the end of the skin with faces linking the outer and inner edges of the skin
-                double tauSkinCap = distanceFromSectionLeft / surf.m_Length;
-                if (tauSkinCap > 1.0)
-                    tauSkinCap = 1.0;
-                iTriangles += stitchSkinEdge(outStreamData, outStreamText, binaryOut, isRHS, outputStyle,
-                               PtPrimaryTopLeft, PtPrimaryBotLeft, PtPrimaryTopRight, PtPrimaryBotRight,
-                               PtSecondTopLeft, PtSecondBotLeft, PtSecondTopRight, PtSecondBotRight,
-                               tauSkinCap, offset, unit);
+                generateDrainageHoles(PtPrimaryBotLeft, PtPrimaryBotRight,
+                                   PtSecondBotLeft, PtSecondBotRight,
+                                   resinDrainageHolesBot, resinDrainageHoleWH,
+                                   tauA);
+
+                //primary bottom surface
+                iTriangles += stitchWingSurfaceDrained(mesh,
+                         PtPrimaryBotLeft, NormalPrimaryBotA, PtPrimaryBotRight, NormalPrimaryBotB,
+                         resinDrainageHolesBot, resinDrainageHoleWH, OUTERFACE,
+                         tau, tauA, tauB, offset, unit, true);
+                //secondary bottom surface
+                iTriangles += stitchWingSurfaceDrained(mesh,
+                         PtSecondBotLeft, NormalSecondBotA, PtSecondBotRight, NormalSecondBotB,
+                         resinDrainageHolesBot, resinDrainageHoleWH, INNERFACE,
+                         tau, tauA, tauB, offset, unit, false);
+
+                iTriangles += stitchDrainageHole(mesh,
+                          resinDrainageHolesBot, offset, unit, isRHS);
 
             } else {
-                distanceFromSectionLeft+=sizePerPanel*panelsPerDivision;
+                //primary bottom surface
+                iTriangles += stitchWingSurface(mesh,
+                         PtPrimaryBotLeft, NormalPrimaryBotA, PtPrimaryBotRight, NormalPrimaryBotB,
+                         tau, tauA, tauB, offset, unit, true);
+
+                //secondary bottom surface
+                iTriangles += stitchWingSurface(mesh,
+                         PtSecondBotLeft, NormalSecondBotA, PtSecondBotRight, NormalSecondBotB,
+                         tau, tauA, tauB, offset, unit, false);
             }
 
+            distanceFromSectionLeft+=sizePerPanel;
         }
-    }
-
 
+        // cap the end of the skin with faces linking the outer and inner edges of the skin
+        double tauSkinCap = distanceFromSectionLeft / div.surfLength;
+        if (tauSkinCap > 1.0)
+            tauSkinCap = 1.0;
+        iTriangles += stitchSkinEdge(mesh, isRHS, outputStyle,
+                       PtPrimaryTopLeft, PtPrimaryBotLeft, PtPrimaryTopRight, PtPrimaryBotRight,
+                       PtSecondTopLeft, PtSecondBotLeft, PtSecondTopRight, PtSecondBotRight,
+                       tauSkinCap, offset, unit);
 
-    // BRACING STRUTS - A cylindrical support
-    // STRUT CUTOUTS - A cylindrical hole - eg to add carbon fibre tubing for support
-
+    }
+}
 
-    // TIPCAP
-    // This is half an icosagon with a radius equal to half the distance between top and bottom surfaces
 
 
-    if (binaryOut) {
-        // stl binary format just ends
-    } else {
-        QString name = m_Name;
-        name.replace(" ","");
-        outStreamText <<  "endsolid " + name + "\n";
+/**
+ * Returns the span position at which the division starting at distanceFromSectionLeft ends, i.e. the start of the next division.
+ * The rib is placed towards the tip on the right surfaces, and towards the root on the left surfaces.
+ * @param skinStart the position of the first skin panel, i.e. past the rib
+ * @param nSkinPanels the number of skin panels of the division, which stop at the end of the surface
+ */
+double Wing::printableDivisionEnd(bool isRHS, double distanceFromSectionLeft, double surfLength,
+                                  int panelsPerDivision, double sizePerPanel,
+                                  double &skinStart, int &nSkinPanels) const
+{
+    if (ribThickness > 0.0)
+    {
+        if (isRHS) distanceFromSectionLeft += ribThickness;
+        else       distanceFromSectionLeft -= ribThickness;
     }
 
-    qDebug() << "Written " << iTriangles << " faces";
+    skinStart = distanceFromSectionLeft;
+    nSkinPanels = 0;
+    if (skinThickness > 0.0)
+    {
+        for(int ppd=0; ppd<panelsPerDivision; ppd++)
+        {
+            if (distanceFromSectionLeft / surfLength > 1.0)
+                break;
+            distanceFromSectionLeft += sizePerPanel;
+            nSkinPanels++;
+        }
+    }
+    else
+        distanceFromSectionLeft += sizePerPanel*panelsPerDivision;
 
-    return iTriangles;
+    return distanceFromSectionLeft;
 }
 
 
-
 /**
  * Returns a pointer to the foil with the corresponding name or NULL if not found.
  * @param strFoilName the name of the Foil to search for in the array
@@ -35,6 +35,7 @@
 #include <xflobjects/objects3d/surface.h>
 #include <xflobjects/objects3d/wingsection.h>
 #include <xflobjects/objects3d/pointmass.h>
+#include <xflobjects/objects3d/printmesh.h>
 
 /**
  * @class Wing
@@ -261,7 +262,7 @@ class Wing
         void exportSTLText(QTextStream &outStream, int CHORDPANELS, int SPANPANELS);
 
         // 3D Printing Functions
-        void exportSTLTriangle3dPrintable(QDataStream &outStreamData, QTextStream &outStreamText, bool binaryOut,
+        void addTriangle3dPrintable(PrintMesh &mesh,
                                           Vector3d Pt0, Vector3d Pt1, Vector3d Pt2, Vector3d N, Vector3d offset, float unit,
                                           bool reverse=false, double forceFlat = __DBL_MAX__);
 
@@ -287,6 +288,27 @@ class Wing
             int endIc[2]= {-1,-1};
             int tipIc[2]= {-1,-1};
         };
+        struct printDivision {  // the input and output of one printed part, meshed independently of the others
+            int iSurf = 0;
+            int iDivision = 0;
+            bool isRHS = true;
+            printOutputStyle outputStyle = PRINTABLE;
+            float unit = 1000;
+            double surfLength = 0;
+            double sectionRootDistanceFromWingRoot = 0;
+            double distanceFromSectionLeft = 0;     // at the root of the division
+            double zDivisionOffset = 0;
+            int panelsPerDivision = 0;
+            double sizePerPanel = 0;
+            QVector<Vector3d> PtPrimaryTopLeft, PtPrimaryTopRight, PtPrimaryBotLeft, PtPrimaryBotRight;
+            QVector<Vector3d> PtSecondTopLeft, PtSecondTopRight, PtSecondBotLeft, PtSecondBotRight;
+            QVector<Vector3d> NormalPrimaryTopA, NormalPrimaryTopB, NormalPrimaryBotA, NormalPrimaryBotB;
+            QVector<Vector3d> NormalSecondTopA, NormalSecondTopB, NormalSecondBotA, NormalSecondBotB;
+            QVector<rdhStruct> resinDrainageHolesTop, resinDrainageHolesBot;   // own copies, since the holes are relocated for each panel
+            double resinDrainageHoleWH = 0;
+            PrintMesh mesh;
+            uint32_t iTriangles = 0;
+        };
         Vector3d foilXZIntersection(Vector3d A, Vector3d B, Vector3d C, Vector3d D);
         void generateSecondSkinFoilPoints(QVector<Vector3d> &PtPrimaryTop, QVector<Vector3d> &NormalPrimaryTop,
                                           QVector<Vector3d> &PtPrimaryBot, QVector<Vector3d> &NormalPrimaryBot,
@@ -301,40 +323,46 @@ class Wing
                                                       QVector<rdhStruct> &resinDrainageHoles, double resinDrainageHoleWH,
                                                       double tau);
 
-        uint32_t stitchWingSurface(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut,
+        uint32_t stitchWingSurface(PrintMesh &mesh,
                                  QVector<Vector3d> &PtLeft, QVector<Vector3d> &NormalA,
                                  QVector<Vector3d> &PtRight, QVector<Vector3d> &NormalB,
                                  double tau, double tauA, double tauB, Vector3d &offset, float& unit, bool reverse);
-        uint32_t stitchWingSurfaceDrained(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut,
+        uint32_t stitchWingSurfaceDrained(PrintMesh &mesh,
                                  QVector<Vector3d> &PtLeft, QVector<Vector3d> &NormalA,
                                  QVector<Vector3d> &PtRight, QVector<Vector3d> &NormalB,
                                  QVector<rdhStruct> &resinDrainageHoles, double resinDrainageHoleWH, faceType outer,
                                  double tau, double tauA, double tauB, Vector3d &offset, float& unit, bool reverse);
 
-        uint32_t stitchFoilFace(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut, bool bRightCap,
+        uint32_t stitchFoilFace(PrintMesh &mesh, bool bRightCap,
                            QVector<Vector3d> &PtTopLeft, QVector<Vector3d> &PtBotLeft,
                            QVector<Vector3d> &PtTopRight, QVector<Vector3d> &PtBotRight,
                            double tau, Vector3d &offset, float& unit, double forceFlat = __DBL_MAX__);
-        uint32_t stitchFoilFaceComplex(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut, bool bRightCap,
+        uint32_t stitchFoilFaceComplex(PrintMesh &mesh, bool bRightCap,
                                  QVector<Vector3d> &PtTopLeft, QVector<Vector3d> &PtBotLeft,
                                  QVector<Vector3d> &PtTopRight, QVector<Vector3d> &PtBotRight,
                                  QVector<sparStruct> spars, double y, double tau, Vector3d &offset, float& unit, double forceFlat = __DBL_MAX__);
 
-        uint32_t stitchSkinEdge(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut, bool bRightCap, int outputStyle,
+        uint32_t stitchSkinEdge(PrintMesh &mesh, bool bRightCap, int outputStyle,
                                  QVector<Vector3d> &PtPrimaryTopLeft, QVector<Vector3d> &PtPrimaryBotLeft,
                                  QVector<Vector3d> &PtPrimaryTopRight, QVector<Vector3d> &PtPrimaryBotRight,
                                  QVector<Vector3d> &PtSecondTopLeft, QVector<Vector3d> &PtSecondBotLeft,
                                  QVector<Vector3d> &PtSecondTopRight, QVector<Vector3d> &PtSecondBotRight,
                                  double tau, Vector3d &offset, float& unit);
 
-        uint32_t stitchSpar(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut,
+        uint32_t stitchSpar(PrintMesh &mesh,
                   sparStruct spars, double yLeft, double yRight, Vector3d &offset, float& unit);
-        uint32_t stitchDrainageHole(QDataStream &outStreamData, QTextStream &outStreamText, bool &binaryOut,
+        uint32_t stitchDrainageHole(PrintMesh &mesh,
                   QVector<rdhStruct> &resinDrainageHoles,
                   Vector3d &offset, float& unit, bool reverse);
-        uint32_t exportSTL3dPrintable(QDataStream &outStreamData, QTextStream &outStreamText, bool binaryOut,
-                                  int CHORDPANELS, int SPANPANELS,
-                                  printOutputStyle outputStyle, float unit);
+        uint32_t makePrintableMesh(PrintMesh &mesh, int CHORDPANELS, int SPANPANELS,
+                                   printOutputStyle outputStyle, float unit);
+        void makePrintableDivision(printDivision *pDivision);
+        double printableDivisionEnd(bool isRHS, double distanceFromSectionLeft, double surfLength,
+                                    int panelsPerDivision, double sizePerPanel,
+                                    double &skinStart, int &nSkinPanels) const;
+        uint32_t exportSTL3dPrintable(QIODevice &device, PrintMesh::enumFormat format,
+                                      int CHORDPANELS, int SPANPANELS,
+                                      printOutputStyle outputStyle, float unit);
 
 
         Foil* foil(const QString &strFoilName);
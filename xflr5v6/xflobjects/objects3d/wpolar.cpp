@@ -19,6 +19,8 @@
 
 *****************************************************************************/
 
+#include <algorithm>
+
 #include <QRandomGenerator>
 
 #include "wpolar.h"
@@ -93,10 +95,55 @@ WPolar::WPolar()
 }
 
 
-void WPolar::replacePOppDataAt(int pos, PlaneOpp *pPOpp)
+/**
+ * Returns the list of the result arrays, i.e. the arrays which hold one value per operating point.
+ * The arrays are listed in the order of the variable index used by getWPlrVariable().
+ */
+QVector<QVector<double>*> WPolar::resultColumns()
 {
-    if(pos<0 || pos>= dataSize()) return;
+    return {&m_Alpha, &m_Beta, &m_CL, &m_TCd, &m_PCd, &m_ICd, &m_CY, &m_GCm, &m_VCm, &m_ICm,
+            &m_GRm, &m_GYm, &m_VYm, &m_IYm, &m_ClCd, &m_Cl32Cd, &m_1Cl, &m_FX, &m_FY, &m_FZ,
+            &m_Vx, &m_Vz, &m_QInfinite, &m_Gamma, &m_Rm, &m_Pm, &m_Ym, &m_XCP, &m_YCP, &m_ZCP,
+            &m_MaxBending, &m_VertPower, &m_Oswald, &m_XCpCl, &m_SM, &m_Ctrl, &m_XNP,
+            &m_PhugoidFrequency, &m_PhugoidDamping, &m_ShortPeriodFrequency, &m_ShortPeriodDamping,
+            &m_DutchRollFrequency, &m_DutchRollDamping, &m_RollDampingT2, &m_SpiralDampingT2,
+            &m_HorizontalPower, &m_ExtraDrag, &m_Mass_var, &m_CoG_x, &m_CoG_z};
+}
+
+
+/**
+ * Returns the value used to sort the operating points, depending on the polar type.
+ */
+double WPolar::sortValue(PlaneOpp const *pPOpp) const
+{
+    switch(m_WPolarType)
+    {
+        case xfl::FIXEDAOAPOLAR:  return pPOpp->m_QInf;
+        case xfl::BETAPOLAR:      return pPOpp->m_Beta;
+        case xfl::STABILITYPOLAR: return pPOpp->m_Ctrl;
+        default:                  return pPOpp->alpha();
+    }
+}
+
 
+/** Returns the value used to sort the operating points for the i-th point of the arrays. */
+double WPolar::sortValue(int i) const
+{
+    switch(m_WPolarType)
+    {
+        case xfl::FIXEDAOAPOLAR:  return m_QInfinite.at(i);
+        case xfl::BETAPOLAR:      return m_Beta.at(i);
+        case xfl::STABILITYPOLAR: return m_Ctrl.at(i);
+        default:                  return m_Alpha.at(i);
+    }
+}
+
+
+/**
+ * Copies the operating point's results to the existing position pos of the arrays; the derived values are not calculated.
+ */
+void WPolar::setPOppData(int pos, PlaneOpp const *pPOpp)
+{
     m_Alpha[pos]      =  pPOpp->alpha();
     m_Beta[pos]       =  pPOpp->m_Beta;
     m_QInfinite[pos]  =  pPOpp->m_QInf;
@@ -114,15 +161,23 @@ void WPolar::replacePOppDataAt(int pos, PlaneOpp *pPOpp)
     m_IYm[pos]        =  pPOpp->m_IYm;
 
     m_XCP[pos]        =  pPOpp->m_CP.x;
-    m_YCP[pos]        =  pPOpp->m_CP.x;
+    m_YCP[pos]        =  pPOpp->m_CP.y;
     m_ZCP[pos]        =  pPOpp->m_CP.z;
-    m_MaxBending[pos] =  pPOpp->m_pWOpp[0]->m_MaxBending;
+    if(pPOpp->m_pWOpp[0]) m_MaxBending[pos] = pPOpp->m_pWOpp[0]->m_MaxBending;
+    else                  m_MaxBending[pos] = 0.0;
     m_Ctrl[pos]       =  pPOpp->m_Ctrl;
     m_XNP[pos]        =  pPOpp->m_XNP;
 
     //store the eigenthings
     for(int l=0; l<8; l++) m_EigenValue[l][pos] = pPOpp->m_EigenValue[l];
+}
+
+
+void WPolar::replacePOppDataAt(int pos, PlaneOpp *pPOpp)
+{
+    if(pos<0 || pos>= dataSize()) return;
 
+    setPOppData(pos, pPOpp);
     calculatePoint(pos);
 }
 
@@ -131,72 +186,16 @@ void WPolar::insertPOppDataAt(int pos, PlaneOpp *pPOpp)
 {
     if(pos<0 || pos> dataSize()) return; // if(pos==size), then the data is appended
 
-    m_Alpha.insert(pos, pPOpp->alpha());
-    m_Beta.insert(pos, pPOpp->m_Beta);
-    m_QInfinite.insert(pos, pPOpp->m_QInf);
-    m_CL.insert( pos,  pPOpp->m_CL);
-    m_CY.insert( pos,  pPOpp->m_CY);
-    m_ICd.insert(pos,  pPOpp->m_ICD);
-    m_PCd.insert(pos,  pPOpp->m_VCD);
-    m_TCd.insert(pos,  pPOpp->m_ICD + pPOpp->m_VCD);
-
-    m_GCm.insert(pos,  pPOpp->m_GCm);
-    m_VCm.insert(pos,  pPOpp->m_VCm);
-    m_ICm.insert(pos,  pPOpp->m_ICm);
-    m_GRm.insert(pos,  pPOpp->m_GRm);
-    m_GYm.insert(pos,  pPOpp->m_GYm);
-    m_VYm.insert(pos,  pPOpp->m_VYm);
-    m_IYm.insert(pos,  pPOpp->m_IYm);
-
-    m_XCP.insert(pos,  pPOpp->m_CP.x);
-    m_YCP.insert(pos,  pPOpp->m_CP.y);
-    m_ZCP.insert(pos,  pPOpp->m_CP.z);
-    if(pPOpp->m_pWOpp[0])    m_MaxBending.insert(pos, pPOpp->m_pWOpp[0]->m_MaxBending);
-    else                        m_MaxBending.insert(pos, 0.0);
-    m_Ctrl.insert(pos, pPOpp->m_Ctrl);
-    m_XNP.insert(pos,  pPOpp->m_XNP);
-
-    m_ShortPeriodDamping.insert(pos,0.0);
-    m_ShortPeriodFrequency.insert(pos,0.0);
-    m_PhugoidDamping.insert(pos,0.0);
-    m_PhugoidFrequency.insert(pos,0.0);
-    m_DutchRollDamping.insert(pos,0.0);
-    m_DutchRollFrequency.insert(pos,0.0);
-    m_RollDampingT2.insert(pos,0.0);
-    m_SpiralDampingT2.insert(pos,0.0);
-
-    //make room for computed values
-    m_1Cl.insert(pos,0.0);
-    m_ClCd.insert(pos,0.0);
-    m_Cl32Cd.insert(pos,0.0);
-    m_ExtraDrag.insert(pos,0.0);
-    m_Vx.insert(pos,0.0);
-    m_Vz.insert(pos,0.0);
-    m_FZ.insert(pos,0.0);
-    m_FY.insert(pos,0.0);
-    m_FX.insert(pos,0.0);
-    m_Gamma.insert(pos,0.0);
-    m_Rm.insert(pos, 0.0);
-    m_Pm.insert(pos, 0.0);
-    m_Ym.insert(pos, 0.0);
-    m_VertPower.insert(pos, 0.0);
-    m_HorizontalPower.insert(pos, 0.0);
-    m_Oswald.insert(pos, 0.0);
-    m_XCpCl.insert(pos, 0.0);
-    m_SM.insert(pos, 0.0);
-    m_Mass_var.insert(pos, 0.0);
-    m_CoG_x.insert(pos, 0.0);
-    m_CoG_z.insert(pos, 0.0);
+    QVector<QVector<double>*> columns = resultColumns();
+    for(int ic=0; ic<columns.size(); ic++) columns[ic]->insert(pos, 0.0);
 
     for(int l=0; l<8; l++)
-        for(int j=dataSize(); j>pos; j--)
+        for(int j=dataSize()-1; j>pos; j--)
         {
             m_EigenValue[l][j] = m_EigenValue[l][j-1];
         }
 
-    //store the eigenthings
-    for(int l=0; l<8; l++)    m_EigenValue[l][pos] = pPOpp->m_EigenValue[l];
-
+    setPOppData(pos, pPOpp);
     calculatePoint(pos);
 }
 
@@ -208,63 +207,32 @@ void WPolar::insertDataAt(int pos, double Alpha, double Beta, double QInf, doubl
 {
     if(pos<0 || pos>dataSize()) return;
 
-    m_Alpha.insert(pos, Alpha);
-    m_Beta.insert(pos, Beta);
-    m_CL.insert(pos, Cl);
-    m_CY.insert(pos, CY);
-    m_ICd.insert(pos, ICd);
-    m_PCd.insert(pos, PCd);
-
-    m_GCm.insert(pos, GCm);
-    m_VCm.insert(pos, VCm);
-    m_ICm.insert(pos, ICm);
-    m_GRm.insert(pos, GRm);
-    m_GYm.insert(pos, GYm);
-    m_VYm.insert(pos, VYm);
-    m_IYm.insert(pos, IYm);
-
-    m_QInfinite.insert(pos, QInf);
-
-    m_XCP.insert(pos, XCP);
-    m_YCP.insert(pos, YCP);
-    m_ZCP.insert(pos, ZCP);
-    m_MaxBending.insert(pos, Cb);
-    m_Ctrl.insert(pos, Ctrl);
-    if(isStabilityPolar()) m_XNP.insert(pos, XNP);
-    else                   m_XNP.insert(pos, 0.0);
-
-    m_TCd.insert(pos, 0.0);
-    m_PhugoidDamping.insert(pos, 0.0);
-    m_PhugoidFrequency.insert(pos, 0.0);
-    m_ShortPeriodDamping.insert(pos, 0.0);
-    m_ShortPeriodFrequency.insert(pos, 0.0);
-    m_DutchRollDamping.insert(pos, 0.0);
-    m_DutchRollFrequency.insert(pos, 0.0);
-    m_RollDampingT2.insert(pos, 0.0);
-    m_SpiralDampingT2.insert(pos, 0.0);
-
-    m_1Cl.insert(pos, 0.0);
-    m_ClCd.insert(pos, 0.0);
-    m_Cl32Cd.insert(pos, 0.0);
-    m_ExtraDrag.insert(pos,0.0);
-    m_Vx.insert(pos, 0.0);
-    m_Vz.insert(pos, 0.0);
-    m_FZ.insert(pos, 0.0);
-    m_FY.insert(pos, 0.0);
-    m_FX.insert(pos, 0.0);
-    m_Gamma.insert(pos, 0.0);
-    m_Rm.insert(pos, 0.0);
-    m_Pm.insert(pos, 0.0);
-    m_Ym.insert(pos, 0.0);
-    m_VertPower.insert(pos, 0.0);
-    m_HorizontalPower.insert(pos, 0.0);
-    m_Oswald.insert(pos, 0.0);
-    m_XCpCl.insert(pos, 0.0);
-    m_SM.insert(pos, 0.0);
-    m_Mass_var.insert(pos, 0.0);
-    m_CoG_x.insert(pos, 0.0);
-    m_CoG_z.insert(pos, 0.0);
-
+    QVector<QVector<double>*> columns = resultColumns();
+    for(int ic=0; ic<columns.size(); ic++) columns[ic]->insert(pos, 0.0);
+
+    m_Alpha[pos] = Alpha;
+    m_Beta[pos]  = Beta;
+    m_CL[pos]    = Cl;
+    m_CY[pos]    = CY;
+    m_ICd[pos]   = ICd;
+    m_PCd[pos]   = PCd;
+
+    m_GCm[pos]   = GCm;
+    m_VCm[pos]   = VCm;
+    m_ICm[pos]   = ICm;
+    m_GRm[pos]   = GRm;
+    m_GYm[pos]   = GYm;
+    m_VYm[pos]   = VYm;
+    m_IYm[pos]   = IYm;
+
+    m_QInfinite[pos] = QInf;
+
+    m_XCP[pos]   = XCP;
+    m_YCP[pos]   = YCP;
+    m_ZCP[pos]   = ZCP;
+    m_MaxBending[pos] = Cb;
+    m_Ctrl[pos]  = Ctrl;
+    if(isStabilityPolar()) m_XNP[pos] = XNP;
 }
 
 
@@ -369,6 +337,81 @@ void WPolar::addPlaneOpPoint(PlaneOpp *pPOpp)
 
 
 
+/**
+ * Adds a batch of operating points to the polar, with the same sorting and replacement rules as addPlaneOpPoint().
+ * The new points are merged with the existing data in a single pass,
+ * and the derived values are calculated once for the whole arrays.
+ * If two points of the batch have the same sorting value, the last one is kept.
+ *
+ * @param POppList the plane operating points from which the data is to be extracted
+ */
+void WPolar::addPlaneOpPoints(QVector<PlaneOpp*> const &POppList)
+{
+    if(POppList.isEmpty()) return;
+
+    QVector<PlaneOpp*> newPOpps = POppList;
+    std::stable_sort(newPOpps.begin(), newPOpps.end(),
+                     [this](PlaneOpp const *pA, PlaneOpp const *pB) {return sortValue(pA)<sortValue(pB);});
+
+    // the merged order; a positive index refers to an existing point, a negative index -(k+1) to the new point k
+    int nOld = dataSize();
+    QVector<int> order;
+    order.reserve(nOld + newPOpps.size());
+    int i=0, k=0;
+    while(i<nOld || k<newPOpps.size())
+    {
+        // skip the new points which are replaced by a later point of the batch
+        if(k<newPOpps.size()-1 && qAbs(sortValue(newPOpps.at(k+1))-sortValue(newPOpps.at(k)))<0.001)
+        {
+            k++;
+            continue;
+        }
+
+        if(k>=newPOpps.size())
+            order.append(i++);
+        else if(i>=nOld)
+            order.append(-(k++)-1);
+        else
+        {
+            double newValue = sortValue(newPOpps.at(k));
+            double oldValue = sortValue(i);
+            if(qAbs(newValue-oldValue)<0.001)
+            {
+                order.append(-(k++)-1);
+                i++;
+            }
+            else if(newValue<oldValue) order.append(-(k++)-1);
+            else                       order.append(i++);
+        }
+    }
+
+    // rebuild each array from the merged order
+    int nTotal = order.size();
+    QVector<QVector<double>*> columns = resultColumns();
+    for(int ic=0; ic<columns.size(); ic++)
+    {
+        QVector<double> const &oldColumn = *columns.at(ic);
+        QVector<double> column(nTotal);
+        for(int j=0; j<nTotal; j++) column[j] = order.at(j)>=0 ? oldColumn.at(order.at(j)) : 0.0;
+        columns[ic]->swap(column);
+    }
+
+    QVector<std::complex<double>> eigen(nTotal);
+    for(int l=0; l<8; l++)
+    {
+        for(int j=0; j<nTotal; j++) eigen[j] = order.at(j)>=0 ? m_EigenValue[l][order.at(j)] : std::complex<double>(0.0, 0.0);
+        for(int j=0; j<nTotal; j++) m_EigenValue[l][j] = eigen.at(j);
+    }
+
+    for(int j=0; j<nTotal; j++)
+    {
+        if(order.at(j)<0) setPOppData(j, newPOpps.at(-order.at(j)-1));
+    }
+
+    calculatePoints(0, nTotal);
+}
+
+
 /**
  * Calculates aerodynamic values for the i-th point in the array : glide ratio, power factor, forces and moments, power
  * for horizontal flight, efficiency coefficient, mode frequencies and amping factors.
@@ -376,61 +419,118 @@ void WPolar::addPlaneOpPoint(PlaneOpp *pPOpp)
  */
 void WPolar::calculatePoint(int iPt)
 {
-    //dynamic pressure
-    double q =  0.5 * m_Density * m_QInfinite[iPt]*m_QInfinite[iPt];
+    calculatePoints(iPt, iPt+1);
+}
 
-    double mass = m_Mass;
-    if(qAbs(m_inertiaGain[0])>PRECISION)
+
+/**
+ * Calculates the derived values for the points in the range [iStart, iEnd[ of the arrays.
+ * Each group of values is calculated in a loop over the range, using the raw arrays.
+ */
+void WPolar::calculatePoints(int iStart, int iEnd)
+{
+    iEnd = std::min(iEnd, m_CL.size());
+    if(iStart<0 || iStart>=iEnd) return;
+
+    double const *QInf = m_QInfinite.constData();
+    double const *CL   = m_CL.constData();
+    double const *CY   = m_CY.constData();
+    double const *ICd  = m_ICd.constData();
+    double const *PCd  = m_PCd.constData();
+    double const *GRm  = m_GRm.constData();
+    double const *GYm  = m_GYm.constData();
+    double const *GCm  = m_GCm.constData();
+    double const *XCP  = m_XCP.constData();
+    double const *Ctrl = m_Ctrl.constData();
+
+    double *FX  = m_FX.data();
+    double *FY  = m_FY.data();
+    double *FZ  = m_FZ.data();
+    double *TCd = m_TCd.data();
+    double *ExtraDrag = m_ExtraDrag.data();
+    double *Rm  = m_Rm.data();
+    double *Ym  = m_Ym.data();
+    double *Pm  = m_Pm.data();
+
+    double extraDragArea = 0.0;
+    for(int iExtra=0; iExtra<MAXEXTRADRAG; iExtra++) extraDragArea += m_ExtraDragArea[iExtra] * m_ExtraDragCoef[iExtra];
+
+    // forces and moments
+    for(int i=iStart; i<iEnd; i++)
     {
-        mass += m_Ctrl[iPt]*m_inertiaGain[0];
+        //dynamic pressure
+        double q =  0.5 * m_Density * QInf[i]*QInf[i];
+
+        FZ[i] = q * CL[i]*m_RefArea;
+        FY[i] = q * CY[i]*m_RefArea;
+        ExtraDrag[i] = extraDragArea * q;
+        FX[i] = q * (ICd[i]+PCd[i])*m_RefArea + ExtraDrag[i];
+        TCd[i] = FX[i]/q/m_RefArea;
+
+        Rm[i] = q * m_RefArea * GRm[i] * m_RefSpan;// in N.m
+        Ym[i] = q * m_RefArea * GYm[i] * m_RefSpan;// in N.m
+        Pm[i] = q * m_RefArea * GCm[i] * m_RefChord;// in N.m
     }
 
-    if(iPt>=m_CL.count()) return;
+    // aerodynamic coefficients
+    double *OneCl  = m_1Cl.data();
+    double *Cl32Cd = m_Cl32Cd.data();
+    double *ClCd   = m_ClCd.data();
+    double *Gamma  = m_Gamma.data();
+    double *Oswald = m_Oswald.data();
+    double *XCpCl  = m_XCpCl.data();
+    double *SM     = m_SM.data();
 
-    m_FZ[iPt]  = q * m_CL[iPt]*m_RefArea;
-    m_FY[iPt]  = q * m_CY[iPt]*m_RefArea;
-    m_FX[iPt]  = q * (m_ICd[iPt]+m_PCd[iPt])*m_RefArea;
+    double AR      = m_RefSpan*m_RefSpan/m_RefArea;
 
-    m_ExtraDrag[iPt] = 0.0;
-    for(int iExtra=0; iExtra<MAXEXTRADRAG; iExtra++)
+    for(int i=iStart; i<iEnd; i++)
     {
-        m_FX[iPt]        += m_ExtraDragArea[iExtra] * m_ExtraDragCoef[iExtra] *q;
-        m_ExtraDrag[iPt] += m_ExtraDragArea[iExtra] * m_ExtraDragCoef[iExtra] *q;
-    }
-
-    m_TCd[iPt] = m_FX[iPt]/q/m_RefArea;
-
-    if(m_CL[iPt]>0.0) {
-        m_1Cl[iPt]    = (1./sqrt(m_CL[iPt]));
-        m_Cl32Cd[iPt] = sqrt(m_CL[iPt]*m_CL[iPt]*m_CL[iPt])/m_TCd[iPt];
-    }
-    else {
-        m_1Cl[iPt]    = -1.0;//will not be plotted
-        m_Cl32Cd[iPt] = -sqrt(-m_CL[iPt]*m_CL[iPt]*m_CL[iPt])/m_TCd[iPt];
-    }
+        if(CL[i]>0.0) {
+            OneCl[i]  = (1./sqrt(CL[i]));
+            Cl32Cd[i] = sqrt(CL[i]*CL[i]*CL[i])/TCd[i];
+        }
+        else {
+            OneCl[i]  = -1.0;//will not be plotted
+            Cl32Cd[i] = -sqrt(-CL[i]*CL[i]*CL[i])/TCd[i];
+        }
 
-    if(fabs(m_CL[iPt])>0.) m_Gamma[iPt] = atan(m_TCd[iPt]/m_CL[iPt]) * 180.0/PI;
-    else                   m_Gamma[iPt] = 90.0;
+        if(fabs(CL[i])>0.) Gamma[i] = atan(TCd[i]/CL[i]) * 180.0/PI;
+        else               Gamma[i] = 90.0;
 
-    m_Vz[iPt] = sqrt(2*mass*9.81/m_Density/m_RefArea)/m_Cl32Cd[iPt];
-    m_Vx[iPt] = m_QInfinite[iPt] * cos(m_Gamma[iPt]*PI/180.0);
+        ClCd[i] = CL[i]/TCd[i];
 
-    m_ClCd[iPt]   =  m_CL[iPt]/m_TCd[iPt];
+        if(ICd[i]==0.0) Oswald[i] = 0.0;
+        else            Oswald[i] = CL[i]*CL[i]/PI/ICd[i]/AR;
 
-    m_Rm[iPt] = q * m_RefArea * m_GRm[iPt] * m_RefSpan;// in N.m
-    m_Ym[iPt] = q * m_RefArea * m_GYm[iPt] * m_RefSpan;// in N.m
-    m_Pm[iPt] = q * m_RefArea * m_GCm[iPt] * m_RefChord;// in N.m
+        XCpCl[i] = XCP[i] * CL[i];
+        SM[i]    = (XCP[i]-m_CoG.x)/m_RefChord *100.00;
+    }
 
-    //power for horizontal flight
-    m_VertPower[iPt] = mass * 9.81 * m_Vz[iPt];
-    m_HorizontalPower[iPt] = m_FX[iPt] * m_Vx[iPt];
+    // flight speeds and power for horizontal flight
+    double *Vx = m_Vx.data();
+    double *Vz = m_Vz.data();
+    double *VertPower = m_VertPower.data();
+    double *HorizontalPower = m_HorizontalPower.data();
+    double *Mass_var = m_Mass_var.data();
+    double *CoG_x = m_CoG_x.data();
+    double *CoG_z = m_CoG_z.data();
+
+    bool bMassGain = qAbs(m_inertiaGain[0])>PRECISION;
+    for(int i=iStart; i<iEnd; i++)
+    {
+        double mass = m_Mass;
+        if(bMassGain) mass += Ctrl[i]*m_inertiaGain[0];
 
-    double AR      = m_RefSpan*m_RefSpan/m_RefArea;
+        Vz[i] = sqrt(2*mass*9.81/m_Density/m_RefArea)/Cl32Cd[i];
+        Vx[i] = QInf[i] * cos(Gamma[i]*PI/180.0);
 
-    if(m_ICd[iPt]==0.0)    m_Oswald[iPt] = 0.0;
-    else                m_Oswald[iPt] = m_CL[iPt]*m_CL[iPt]/PI/m_ICd[iPt]/AR;
+        VertPower[i] = mass * 9.81 * Vz[i];
+        HorizontalPower[i] = FX[i] * Vx[i];
 
-    m_XCpCl[iPt]     = m_XCP[iPt] * m_CL[iPt];
+        Mass_var[i] = m_Mass    + Ctrl[i] * m_inertiaGain[0];
+        CoG_x[i]    = m_CoG.x + Ctrl[i] * m_inertiaGain[1];
+        CoG_z[i]    = m_CoG.z + Ctrl[i] * m_inertiaGain[2];
+    }
 
     if(m_XCpCl.count()>1 && !isStabilityPolar())
     {
@@ -438,38 +538,47 @@ void WPolar::calculatePoint(int iPt)
     }
     else m_XNeutralPoint = 0.0;
 
+    // stability modes
+    double *PhugoidDamping       = m_PhugoidDamping.data();
+    double *PhugoidFrequency     = m_PhugoidFrequency.data();
+    double *ShortPeriodDamping   = m_ShortPeriodDamping.data();
+    double *ShortPeriodFrequency = m_ShortPeriodFrequency.data();
+    double *DutchRollDamping     = m_DutchRollDamping.data();
+    double *DutchRollFrequency   = m_DutchRollFrequency.data();
+    double *RollDampingT2        = m_RollDampingT2.data();
+    double *SpiralDampingT2      = m_SpiralDampingT2.data();
 
-    m_SM[iPt]        = (m_XCP[iPt]-m_CoG.x)/m_RefChord *100.00;
-    m_Mass_var[iPt]  = m_Mass + m_Ctrl[iPt] * m_inertiaGain[0];
-    m_CoG_x[iPt]  = m_CoG.x + m_Ctrl[iPt] * m_inertiaGain[1];
-    m_CoG_z[iPt]  = m_CoG.z + m_Ctrl[iPt] * m_inertiaGain[2];
-
-    double OmegaN, Omega1, Dsi;
     if(isStabilityPolar())
     {
-        modeProperties(m_EigenValue[2][iPt], Omega1, OmegaN, Dsi);
-        m_PhugoidDamping[iPt]   = Dsi;
-        m_PhugoidFrequency[iPt] = Omega1/2.0/PI;
+        double OmegaN, Omega1, Dsi;
+        for(int i=iStart; i<iEnd; i++)
+        {
+            modeProperties(m_EigenValue[2][i], Omega1, OmegaN, Dsi);
+            PhugoidDamping[i]   = Dsi;
+            PhugoidFrequency[i] = Omega1/2.0/PI;
 
-        modeProperties(m_EigenValue[0][iPt], Omega1, OmegaN, Dsi);
-        m_ShortPeriodFrequency[iPt] = Omega1/2.0/PI;
-        m_ShortPeriodDamping[iPt]   = Dsi;
+            modeProperties(m_EigenValue[0][i], Omega1, OmegaN, Dsi);
+            ShortPeriodFrequency[i] = Omega1/2.0/PI;
+            ShortPeriodDamping[i]   = Dsi;
 
-        modeProperties(m_EigenValue[5][iPt], Omega1, OmegaN, Dsi);
-        m_DutchRollFrequency[iPt] = Omega1/2.0/PI;
-        m_DutchRollDamping[iPt]   = Dsi;
+            modeProperties(m_EigenValue[5][i], Omega1, OmegaN, Dsi);
+            DutchRollFrequency[i] = Omega1/2.0/PI;
+            DutchRollDamping[i]   = Dsi;
 
-        m_RollDampingT2[iPt]    = log(2.0)/fabs(m_EigenValue[4][iPt].real());
-        m_SpiralDampingT2[iPt]  = log(2.0)/fabs(m_EigenValue[7][iPt].real());
+            RollDampingT2[i]    = log(2.0)/fabs(m_EigenValue[4][i].real());
+            SpiralDampingT2[i]  = log(2.0)/fabs(m_EigenValue[7][i].real());
+        }
     }
     else
     {
-        m_PhugoidDamping[iPt] = m_PhugoidFrequency[iPt] = 0.0;
-        m_ShortPeriodFrequency[iPt] = m_ShortPeriodDamping[iPt] = 0.0;
-        m_DutchRollFrequency[iPt] = m_DutchRollDamping[iPt] = 0.0;
-        m_RollDampingT2[iPt] = m_SpiralDampingT2[iPt] = 0.0;
+        for(int i=iStart; i<iEnd; i++)
+        {
+            PhugoidDamping[i] = PhugoidFrequency[i] = 0.0;
+            ShortPeriodFrequency[i] = ShortPeriodDamping[i] = 0.0;
+            DutchRollFrequency[i] = DutchRollDamping[i] = 0.0;
+            RollDampingT2[i] = SpiralDampingT2[i] = 0.0;
+        }
     }
-    //qDebug()<<    m_EigenValue[4][iPt].real()<<m_EigenValue[7][iPt].real();
 }
 
 
@@ -745,65 +854,12 @@ void WPolar::remove(double alpha)
 void WPolar::remove(int i)
 {
     int size = dataSize();
-    m_Alpha.removeAt(i);
-    m_Beta.removeAt(i);
-    m_CL.removeAt(i);
-    m_CY.removeAt(i);
-    m_ICd.removeAt(i);
-    m_PCd.removeAt(i);
-    m_TCd.removeAt(i);
-
-    m_GCm.removeAt(i);
-    m_VCm.removeAt(i);
-    m_ICm.removeAt(i);
-    m_GRm.removeAt(i);
-    m_GYm.removeAt(i);
-    m_VYm.removeAt(i);
-    m_IYm.removeAt(i);
-
-    m_XCP.removeAt(i);
-    m_YCP.removeAt(i);
-    m_ZCP.removeAt(i);
-    m_MaxBending.removeAt(i);
-    m_VertPower.removeAt(i);
-    m_HorizontalPower.removeAt(i);
-
-    m_Oswald.removeAt(i);
-    m_XCpCl.removeAt(i);
-    m_SM.removeAt(i);
-    m_Mass_var.removeAt(i);
-    m_CoG_x.removeAt(i);
-    m_CoG_z.removeAt(i);
-    m_Ctrl.removeAt(i);
-    m_XNP.removeAt(i);
-    m_ShortPeriodDamping.removeAt(i);
-    m_ShortPeriodFrequency.removeAt(i);
-    m_PhugoidFrequency.removeAt(i);
-    m_PhugoidDamping.removeAt(i);
-
-    m_DutchRollDamping.removeAt(i);
-    m_DutchRollFrequency.removeAt(i);
-    m_RollDampingT2.removeAt(i);
-    m_SpiralDampingT2.removeAt(i);
-
-    m_ClCd.removeAt(i);
-    m_1Cl.removeAt(i);
-    m_Cl32Cd.removeAt(i);
-    m_ExtraDrag.removeAt(i);
-
-    m_QInfinite.removeAt(i);
-    m_Gamma.removeAt(i);
-    m_FZ.removeAt(i);
-    m_FY.removeAt(i);
-    m_FX.removeAt(i);
-    m_Vx.removeAt(i);
-
-    m_Vz.removeAt(i);
-    m_Pm.removeAt(i);
-    m_Ym.removeAt(i);
-    m_Rm.removeAt(i);
-
-    for(int j=i; j<size; j++)
+    if(i<0 || i>=size) return;
+
+    QVector<QVector<double>*> columns = resultColumns();
+    for(int ic=0; ic<columns.size(); ic++) columns[ic]->removeAt(i);
+
+    for(int j=i; j<size-1; j++)
     {
         for(int l=0; l<8; l++)
             m_EigenValue[l][j] = m_EigenValue[l][j+1];
@@ -817,63 +873,9 @@ void WPolar::remove(int i)
 void WPolar::clearData()
 {
     int size = dataSize();
-    m_Alpha.clear();
-    m_Beta.clear();
-    m_CL.clear();
-    m_CY.clear();
-    m_ICd.clear();
-    m_PCd.clear();
-    m_TCd.clear();
-
-    m_GCm.clear();
-    m_VCm.clear();
-    m_ICm.clear();
-    m_GRm.clear();
-    m_GYm.clear();
-    m_VYm.clear();
-    m_IYm.clear();
-
-    m_XCP.clear();
-    m_YCP.clear();
-    m_ZCP.clear();
-    m_MaxBending.clear();
-    m_VertPower.clear();
-    m_HorizontalPower.clear();
-
-    m_Oswald.clear();
-    m_XCpCl.clear();
-    m_SM.clear();
-    m_Mass_var.clear();
-    m_CoG_x.clear();
-    m_CoG_z.clear();
-    m_Ctrl.clear();
-    m_XNP.clear();
-    m_ShortPeriodDamping.clear();
-    m_ShortPeriodFrequency.clear();
-    m_PhugoidDamping.clear();
-    m_PhugoidFrequency.clear();
-
-    m_DutchRollDamping.clear();
-    m_DutchRollFrequency.clear();
-    m_RollDampingT2.clear();
-    m_SpiralDampingT2.clear();
-
-    m_ClCd.clear();
-    m_1Cl.clear();
-    m_Cl32Cd.clear();
-    m_ExtraDrag.clear();
-
-    m_QInfinite.clear();
-    m_Gamma.clear();
-    m_FZ.clear();
-    m_FY.clear();
-    m_FX.clear();
-    m_Vx.clear();
-
-    m_Vz.clear();
-    m_Pm.clear();
-    m_Ym.clear();
-    m_Rm.clear();
+
+    QVector<QVector<double>*> columns = resultColumns();
+    for(int ic=0; ic<columns.size(); ic++) columns[ic]->clear();
 
     for(int l=0; l<8; l++)
         for(int j=0; j<size; j++)
@@ -1643,7 +1645,7 @@ bool WPolar::serializeWPlrXFL(QDataStream &ar, bool bIsStoring)
         if(m_inertiaGain[i]>42 && m_inertiaGain[i]<51) m_inertiaGain[i] = 0.0; //correcting some former bad programming
     }
 
-    for(int iPt=0; iPt<dataSize(); iPt++)    calculatePoint(iPt);
+    calculatePoints(0, dataSize());
 
     return true;
 }
@@ -1950,4 +1952,110 @@ QString WPolar::getProperties(QString &PolarProps, const Plane *pPlane,
 }
 
 
+/**
+ * Exports the data of the polar to a text stream
+ * @param out the instance of output QTextStream
+ * @param versionName the program version written in the header
+ * @param bCSV true for a comma separator, false if the data is separated by spaces
+ * @param speedunit the conversion factor from m/s to the user's speed unit
+ * @param speedlab the label of the user's speed unit
+ * @param bDataOnly true if the analysis parameters should not be output
+ */
+void WPolar::exportWPolar(QTextStream &out, QString const &versionName, bool bCSV, double speedunit, QString const &speedlab, bool bDataOnly) const
+{
+    QString Header, strong;
+
+    if (!bCSV)
+    {
+        if(!bDataOnly)
+        {
+            strong = versionName;
+            strong += "\n\n";
+            out << strong;
+
+            strong ="Plane name :        "+ planeName() + "\n";
+            out << strong;
 
+            strong ="Polar name :        "+ polarName()+ "\n";
+            out << strong;
+
+            if(polarType()==xfl::FIXEDSPEEDPOLAR)
+            {
+                strong = QString("Freestream speed : %1 ").arg(velocity()*speedunit,7,'f',3);
+                strong += speedlab + "\n\n\n";
+            }
+            else if(polarType()==xfl::FIXEDAOAPOLAR)
+            {
+                strong = QString("Alpha = %1").arg(Alpha()) + QChar(0260) + "\n";
+            }
+            else strong = "\n";
+
+            out << strong;
+        }
+
+        Header = "   alpha      Beta       CL          CDi        CDv        CD         CY         Cl         Cm         Cn        Cni       QInf        XCP\n";
+        out << Header;
+        for (int j=0; j<dataSize(); j++)
+        {
+            strong = QString(" %1  %2  %3  %4  %5  %6  %7  %8  %9  %10  %11  %12  %13\n")
+                    .arg(m_Alpha[j],8,'f',3)
+                    .arg(m_Beta[j], 8,'f',3)
+                    .arg(m_CL[j],   9,'f',6)
+                    .arg(m_ICd[j],  9,'f',6)
+                    .arg(m_PCd[j],  9,'f',6)
+                    .arg(m_TCd[j],  9,'f',6)
+                    .arg(m_CY[j] ,  9,'f',6)
+                    .arg(m_GRm[j],  9,'f',6)
+                    .arg(m_GCm[j],  9,'f',6)
+                    .arg(m_GYm[j],  9,'f',6)
+                    .arg(m_IYm[j],  9,'f',6)
+                    .arg(m_QInfinite[j],8,'f',4)
+                    .arg(m_XCP[j],  9,'f',4);
+
+            out << strong;
+        }
+    }
+    else
+    {
+        if(!bDataOnly)
+        {
+            strong = versionName;
+            strong += "\n\n";
+            out << strong;
+
+            strong ="Plane name :, "+ planeName() + "\n";
+            out << strong;
+
+            strong ="Polar name :, "+ polarName() + "\n";
+            out << strong;
+
+            strong = QString("Freestream speed :, %1 ").arg(velocity()*speedunit,3,'f',1);
+            strong += speedlab + "\n\n";
+            out << strong;
+        }
+
+        Header = "alpha, Beta, CL, CDi, CDv, CD, CY, Cl, Cm, Cn, Cni, QInf, XCP\n";
+        out << Header;
+        for (int j=0; j<dataSize(); j++)
+        {
+            //            strong.Format(" %8.3f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %9.6f,  %8.4f,  %9.4f\n",
+            strong = QString(" %1,  %2,  %3,  %4,  %5,  %6,  %7,  %8,  %9,  %10,  %11,  %12, %13\n")
+                    .arg(m_Alpha[j],8,'f',3)
+                    .arg(m_Beta[j], 8,'f',3)
+                    .arg(m_CL[j],   9,'f',6)
+                    .arg(m_ICd[j],  9,'f',6)
+                    .arg(m_PCd[j],  9,'f',6)
+                    .arg(m_TCd[j],  9,'f',6)
+                    .arg(m_CY[j] ,  9,'f',6)
+                    .arg(m_GRm[j],  9,'f',6)
+                    .arg(m_GCm[j],  9,'f',6)
+                    .arg(m_GYm[j],  9,'f',6)
+                    .arg(m_IYm[j],  9,'f',6)
+                    .arg(m_QInfinite[j],8,'f',4)
+                    .arg(m_XCP[j],  9,'f',4);
+
+            out << strong;
+        }
+    }
+    out << "\n\n";
+}
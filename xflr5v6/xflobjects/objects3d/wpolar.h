@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <QTextStream>
 
 #include <xflobjects/objects3d/plane.h>
 
@@ -60,12 +61,14 @@ class WPolar : public XflObject
         WPolar();
 
         void addPlaneOpPoint(PlaneOpp* pPOpp);
+        void addPlaneOpPoints(QVector<PlaneOpp*> const &POppList);
         void replacePOppDataAt(int pos, PlaneOpp *pPOpp);
         void insertPOppDataAt(int pos, PlaneOpp *pPOpp);
         void insertDataAt(int pos, double Alpha, double Beta, double QInf, double Ctrl, double Cl, double CY, double ICd, double PCd, double GCm,
                           double ICm, double VCm, double GRm, double GYm, double IYm, double VYm, double XCP, double YCP,
                           double ZCP, double Cb, double XNP);
         void calculatePoint(int iPt);
+        void calculatePoints(int iStart, int iEnd);
         void copy(WPolar const *pWPolar);
         void duplicateSpec(WPolar const *pWPolar);
         QVector<double> const *getWPlrVariable(int iVar) const;
@@ -186,6 +189,14 @@ class WPolar : public XflObject
                            double lenunit, double massunit, double speedunit, double areaunit,
                            QString const &lenlab, const QString &masslab, QString const &speedlab, QString const &arealab) const;
 
+        void exportWPolar(QTextStream &out, QString const &versionName, bool bCSV, double speedunit, QString const &speedlab, bool bDataOnly=false) const;
+
+    private:
+        QVector<QVector<double>*> resultColumns();
+        double sortValue(PlaneOpp const *pPOpp) const;
+        double sortValue(int i) const;
+        void setPOppData(int pos, PlaneOpp const *pPOpp);
+
     private:
 
         bool     m_bVLM1;              /**< true if the analysis is performed with horseshoe vortices, flase if quad rings */
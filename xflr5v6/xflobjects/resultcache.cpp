@@ -0,0 +1,324 @@
+/****************************************************************************
+
+    ResultCache Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QStandardPaths>
+#include <QFile>
+#include <QDir>
+
+#include "resultcache.h"
+#include <xflobjects/objects2d/oppoint.h>
+#include <xflobjects/objects3d/planeopp.h>
+
+
+#define RESULTCACHEFORMAT 0x58524331   /**< the identifier of the cache files; changed when the format or the solvers' results change */
+
+
+bool ResultCache::s_bEnabled = false;
+QString ResultCache::s_DirPath;
+QMutex ResultCache::s_Mutex;
+QHash<QByteArray, QHash<qint64, qint64>> ResultCache::s_Index;
+QAtomicInt ResultCache::s_nHits[2];
+QAtomicInt ResultCache::s_nMisses[2];
+
+
+/**
+ * Returns the directory of the cache files; defaults to the application's cache location.
+ */
+QString ResultCache::dirPath()
+{
+    QMutexLocker locker(&s_Mutex);
+    if(s_DirPath.isEmpty())
+        s_DirPath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + "results";
+    return s_DirPath;
+}
+
+
+void ResultCache::setDirPath(QString const &path)
+{
+    QMutexLocker locker(&s_Mutex);
+    if(path==s_DirPath) return;
+    s_DirPath = path;
+    s_Index.clear();
+}
+
+
+/**
+ * Returns the key of a cache entry, i.e. the hexadecimal SHA-1 hash of the serialized specification of the analysis.
+ * The specification should contain everything which determines the results, and nothing else.
+ */
+QByteArray ResultCache::makeKey(QByteArray const &spec)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    int format = RESULTCACHEFORMAT;
+    hash.addData(reinterpret_cast<char const*>(&format), sizeof(format));
+    hash.addData(spec);
+    return hash.result().toHex();
+}
+
+
+/**
+ * The records are identified by the sequence's parameter, rounded to 1.e-6 so that the values
+ * computed by the different loops of the analyses match.
+ */
+qint64 ResultCache::paramKey(double param)
+{
+    return qRound64(param*1.0e6);
+}
+
+
+QString ResultCache::fileName(QByteArray const &key)
+{
+    return s_DirPath + QDir::separator() + QString::fromLatin1(key) + ".xrc";
+}
+
+
+/**
+ * Returns the index of the records of a key, reading it from the file the first time.
+ * A record which has been truncated, e.g. by a crash during the writing, is removed from the file.
+ * Must be called with the mutex locked.
+ */
+QHash<qint64, qint64> &ResultCache::index(QByteArray const &key)
+{
+    QHash<QByteArray, QHash<qint64, qint64>>::iterator it = s_Index.find(key);
+    if(it!=s_Index.end()) return it.value();
+
+    QHash<qint64, qint64> &records = s_Index[key];
+
+    QFile file(fileName(key));
+    if(!file.exists() || !file.open(QIODevice::ReadWrite)) return records;
+
+    QDataStream ar(&file);
+    ar.setVersion(QDataStream::Qt_4_5);
+    ar.setByteOrder(QDataStream::LittleEndian);
+
+    qint32 format = 0;
+    ar >> format;
+    if(ar.status()!=QDataStream::Ok || format!=RESULTCACHEFORMAT)
+    {
+        // empty, or written in another format
+        file.resize(0);
+        ar.resetStatus();
+        ar << qint32(RESULTCACHEFORMAT);
+        return records;
+    }
+
+    qint64 lastPos = file.pos();
+    while(!ar.atEnd())
+    {
+        qint64 ip = 0;
+        quint32 length = 0;
+        ar >> ip >> length;
+        if(ar.status()!=QDataStream::Ok || ar.skipRawData(int(length))!=int(length)) break;
+        records.insert(ip, lastPos);
+        lastPos = file.pos();
+    }
+    if(lastPos<file.size()) file.resize(lastPos);
+
+    return records;
+}
+
+
+bool ResultCache::readRecord(QByteArray const &key, double param, QByteArray &data)
+{
+    QMutexLocker locker(&s_Mutex);
+    if(s_DirPath.isEmpty()) return false;
+
+    QHash<qint64, qint64> const &records = index(key);
+    QHash<qint64, qint64>::const_iterator it = records.find(paramKey(param));
+    if(it==records.end()) return false;
+
+    QFile file(fileName(key));
+    if(!file.open(QIODevice::ReadOnly) || !file.seek(it.value())) return false;
+
+    QDataStream ar(&file);
+    ar.setVersion(QDataStream::Qt_4_5);
+    ar.setByteOrder(QDataStream::LittleEndian);
+
+    qint64 ip = 0;
+    quint32 length = 0;
+    ar >> ip >> length;
+    if(ar.status()!=QDataStream::Ok || ip!=it.key()) return false;
+
+    data.resize(int(length));
+    return ar.readRawData(data.data(), int(length))==int(length);
+}
+
+
+void ResultCache::writeRecord(QByteArray const &key, double param, QByteArray const &data)
+{
+    QMutexLocker locker(&s_Mutex);
+    if(s_DirPath.isEmpty()) return;
+
+    QDir().mkpath(s_DirPath);
+
+    QHash<qint64, qint64> &records = index(key);
+    qint64 ip = paramKey(param);
+    if(records.contains(ip)) return; // another task has computed the same point
+
+    QFile file(fileName(key));
+    if(!file.open(QIODevice::ReadWrite)) return;
+
+    QDataStream ar(&file);
+    ar.setVersion(QDataStream::Qt_4_5);
+    ar.setByteOrder(QDataStream::LittleEndian);
+
+    if(file.size()==0) ar << qint32(RESULTCACHEFORMAT);
+    file.seek(file.size());
+
+    qint64 pos = file.pos();
+    ar << ip;
+    ar.writeBytes(data.constData(), uint(data.size()));
+    if(ar.status()==QDataStream::Ok) records.insert(ip, pos);
+    else                             file.resize(pos);
+}
+
+
+/**
+ * Returns a new instance of the cached OpPoint, or nullptr if the point is not in the cache.
+ * The names and the style are those of the analysis which has computed the point; they should be set by the caller.
+ */
+OpPoint *ResultCache::loadOpp(QByteArray const &key, double param)
+{
+    dirPath(); // make sure the default is set
+
+    QByteArray data;
+    if(readRecord(key, param, data))
+    {
+        QDataStream ar(data);
+        ar.setVersion(QDataStream::Qt_4_5);
+        ar.setByteOrder(QDataStream::LittleEndian);
+
+        OpPoint *pOpp = new OpPoint;
+        if(pOpp->serializeOppXFL(ar, false))
+        {
+            s_nHits[FOILOPP].ref();
+            return pOpp;
+        }
+        delete pOpp;
+    }
+    s_nMisses[FOILOPP].ref();
+    return nullptr;
+}
+
+
+void ResultCache::storeOpp(QByteArray const &key, double param, OpPoint *pOpp)
+{
+    QByteArray data;
+    QDataStream ar(&data, QIODevice::WriteOnly);
+    ar.setVersion(QDataStream::Qt_4_5);
+    ar.setByteOrder(QDataStream::LittleEndian);
+    pOpp->serializeOppXFL(ar, true);
+
+    dirPath();
+    writeRecord(key, param, data);
+}
+
+
+/**
+ * Returns a new instance of the cached PlaneOpp, or nullptr if the point is not in the cache.
+ * The names and the style are those of the analysis which has computed the point; they should be set by the caller.
+ */
+PlaneOpp *ResultCache::loadPOpp(QByteArray const &key, double param)
+{
+    dirPath();
+
+    QByteArray data;
+    if(readRecord(key, param, data))
+    {
+        QDataStream ar(data);
+        ar.setVersion(QDataStream::Qt_4_5);
+        ar.setByteOrder(QDataStream::LittleEndian);
+
+        PlaneOpp *pPOpp = new PlaneOpp;
+        if(pPOpp->serializePOppXFL(ar, false))
+        {
+            s_nHits[PLANEOPP].ref();
+            return pPOpp;
+        }
+        delete pPOpp;
+    }
+    s_nMisses[PLANEOPP].ref();
+    return nullptr;
+}
+
+
+void ResultCache::storePOpp(QByteArray const &key, double param, PlaneOpp *pPOpp)
+{
+    QByteArray data;
+    QDataStream ar(&data, QIODevice::WriteOnly);
+    ar.setVersion(QDataStream::Qt_4_5);
+    ar.setByteOrder(QDataStream::LittleEndian);
+    pPOpp->serializePOppXFL(ar, true);
+
+    dirPath();
+    writeRecord(key, param, data);
+}
+
+
+/**
+ * Counts as misses the points which have been loaded from the cache but which are discarded and recomputed by the analysis.
+ */
+void ResultCache::countRecomputed(enumResult type, int nPoints)
+{
+    s_nHits[type].fetchAndAddOrdered(-nPoints);
+    s_nMisses[type].fetchAndAddOrdered(nPoints);
+}
+
+
+void ResultCache::resetStatistics()
+{
+    for(int i=0; i<2; i++)
+    {
+        s_nHits[i].storeRelease(0);
+        s_nMisses[i].storeRelease(0);
+    }
+}
+
+
+/**
+ * Returns a one-line summary of the cache's hit rate since the last reset.
+ */
+QString ResultCache::statistics(enumResult type)
+{
+    int nHits   = hits(type);
+    int nMisses = misses(type);
+    double rate = nHits+nMisses>0 ? 100.0*double(nHits)/double(nHits+nMisses) : 0.0;
+    return QString::asprintf("Result cache: %d points read, %d computed, hit rate %.1f%%\n", nHits, nMisses, rate);
+}
+
+
+/**
+ * Deletes all the cache files.
+ */
+void ResultCache::clear()
+{
+    QString path = dirPath();
+
+    QMutexLocker locker(&s_Mutex);
+    s_Index.clear();
+
+    QDir dir(path);
+    QStringList files = dir.entryList(QStringList("*.xrc"), QDir::Files);
+    for(int i=0; i<files.size(); i++) dir.remove(files.at(i));
+}
+
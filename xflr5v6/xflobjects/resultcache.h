@@ -0,0 +1,87 @@
+/****************************************************************************
+
+    ResultCache Class
+    Copyright (C) André Deperrois
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+*****************************************************************************/
+
+/** @file This file implements the on-disk cache of the converged operating points. */
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QString>
+
+class OpPoint;
+class PlaneOpp;
+
+/**
+ * @class ResultCache
+ * A content-addressed store of the converged operating points, shared by all projects.
+ *
+ * The key is a hash of everything which determines the result of an analysis, i.e. the geometry and the polar's specification,
+ * but not the names of the objects, so that renamed or duplicated objects hit the same entries.
+ * Each key is stored in its own file, in which the operating points are appended as they are computed,
+ * and are identified by the value of the sequence's parameter: aoa, Cl, Re, velocity, sideslip or control value.
+ * Only the index of the records is held in memory.
+ * The cache has no size limit; it is disabled by default, and it is enabled and cleared in the save options of the preferences.
+ */
+class ResultCache
+{
+    public:
+        enum enumResult {FOILOPP, PLANEOPP};
+
+    public:
+        static bool isEnabled() {return s_bEnabled;}
+        static void setEnabled(bool bEnabled) {s_bEnabled=bEnabled;}
+        static QString dirPath();
+        static void setDirPath(QString const &path);
+
+        static QByteArray makeKey(QByteArray const &spec);
+
+        static OpPoint *loadOpp(QByteArray const &key, double param);
+        static void storeOpp(QByteArray const &key, double param, OpPoint *pOpp);
+        static PlaneOpp *loadPOpp(QByteArray const &key, double param);
+        static void storePOpp(QByteArray const &key, double param, PlaneOpp *pPOpp);
+
+        static int hits(enumResult type)   {return s_nHits[type].loadAcquire();}
+        static int misses(enumResult type) {return s_nMisses[type].loadAcquire();}
+        static void countRecomputed(enumResult type, int nPoints);
+        static void resetStatistics();
+        static QString statistics(enumResult type);
+
+        static void clear();
+
+    private:
+        static bool readRecord(QByteArray const &key, double param, QByteArray &data);
+        static void writeRecord(QByteArray const &key, double param, QByteArray const &data);
+        static QHash<qint64, qint64> &index(QByteArray const &key);
+        static QString fileName(QByteArray const &key);
+        static qint64 paramKey(double param);
+
+    private:
+        static bool s_bEnabled;
+        static QString s_DirPath;
+        static QMutex s_Mutex;                                /**< protects the index and the files */
+        static QHash<QByteArray, QHash<qint64, qint64>> s_Index;  /**< for each key, the position of each record in the file */
+        static QAtomicInt s_nHits[2];
+        static QAtomicInt s_nMisses[2];
+};
+
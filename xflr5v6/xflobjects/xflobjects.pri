@@ -28,12 +28,14 @@ HEADERS += \
     xflobjects/objects3d/plane.h \
     xflobjects/objects3d/planeopp.h \
     xflobjects/objects3d/pointmass.h \
+    xflobjects/objects3d/printmesh.h \
     xflobjects/objects3d/surface.h \
     xflobjects/objects3d/wing.h \
     xflobjects/objects3d/wingopp.h \
     xflobjects/objects3d/wingsection.h \
     xflobjects/objects3d/wpolar.h \
     xflobjects/objects_global.h \
+    xflobjects/resultcache.h \
     xflobjects/xflobject.h \
     xflobjects/xml/xmlplanereader.h \
     xflobjects/xml/xmlplanewriter.h \
@@ -69,11 +71,13 @@ SOURCES += \
     xflobjects/objects3d/panel.cpp \
     xflobjects/objects3d/plane.cpp \
     xflobjects/objects3d/planeopp.cpp \
+    xflobjects/objects3d/printmesh.cpp \
     xflobjects/objects3d/surface.cpp \
     xflobjects/objects3d/wing.cpp \
     xflobjects/objects3d/wingopp.cpp \
     xflobjects/objects3d/wpolar.cpp \
     xflobjects/objects_global.cpp \
+    xflobjects/resultcache.cpp \
     xflobjects/xml/xmlplanereader.cpp \
     xflobjects/xml/xmlplanewriter.cpp \
     xflobjects/xml/xmlwpolarreader.cpp \
@@ -0,0 +1,79 @@
+# -------------------------------------------------
+# Headless executable which runs the reference cases of the solvers
+# and writes their timings in JSON format
+# -------------------------------------------------
+
+lessThan(QT_MAJOR_VERSION, 5) {
+  error("Qt5.4 or greater is required for xflr5 v6")
+}
+else
+{
+    lessThan(QT_MINOR_VERSION, 4) {
+      error("Qt5.4 or greater is required for xflr5 v6")
+    }
+}
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# The timers and counters of the solvers' hot paths, output in the analysis logs.
+# Comment out the following line to compile them out.
+DEFINES += XFL_PERFSTATS
+
+VERSION = 6.49
+
+# the solvers are intertwined with the GUI classes, so the bench links with the same modules as the application
+CONFIG += qt console
+CONFIG -= app_bundle
+QT += widgets opengl network xml
+
+TEMPLATE = app
+TARGET = xflr5-bench
+
+
+INCLUDEPATH += $$PWD/../XFoil-lib/
+DEPENDPATH += $$PWD/../XFoil-lib/
+
+
+OBJECTS_DIR = ./objects-bench
+MOC_DIR     = ./moc-bench
+RCC_DIR     = ./rcc-bench
+DESTDIR     = .
+
+
+win32 {
+    CONFIG -= debug_and_release debug_and_release_target
+    LIBS += -lKernel32 -lUser32
+    LIBS += -lopenGL32
+    # GetProcessMemoryInfo
+    LIBS += -lpsapi
+}
+
+macx{
+    LIBS += -L$$OUT_PWD/../XFoil-lib -lXFoil
+    QMAKE_RPATHDIR = $$OUT_PWD/../XFoil-lib
+    LIBS += -framework CoreFoundation
+}
+
+LIBS += -L../XFoil-lib -lXFoil
+
+
+include(xflr5v6.pri)
+include(xfl3d/xfl3d.pri)
+include(xflcore/xflcore.pri)
+include(xflgeom/xflgeom.pri)
+include(xflgraph/xflgraph.pri)
+include(xflobjects/xflobjects.pri)
+include(xflscript/xflscript.pri)
+include(xflwidgets/xflwidgets.pri)
+include(xflanalysis/xflanalysis.pri)
+
+# the application's entry point is replaced by the bench's
+SOURCES -= globals/main.cpp
+
+SOURCES += \
+    xflbench/benchmain.cpp \
+    xflbench/xflbench.cpp
+
+HEADERS += \
+    xflbench/xflbench.h
+
@@ -46,6 +46,7 @@ SOURCES += \
     xdirect/analysis/relistdlg.cpp \
     xdirect/analysis/xfoiladvanceddlg.cpp \
     xdirect/analysis/xfoilanalysisdlg.cpp \
+    xdirect/analysis/xfoilbatch.cpp \
     xdirect/analysis/xfoiltask.cpp \
     xdirect/foiltreeview.cpp \
     xdirect/geometry/cadddlg.cpp \
@@ -121,6 +122,7 @@ HEADERS += \
     xdirect/analysis/relistdlg.h \
     xdirect/analysis/xfoiladvanceddlg.h \
     xdirect/analysis/xfoilanalysisdlg.h \
+    xdirect/analysis/xfoilbatch.h \
     xdirect/analysis/xfoiltask.h \
     xdirect/foiltreeview.h \
     xdirect/geometry/cadddlg.h \
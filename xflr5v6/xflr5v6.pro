@@ -27,6 +27,10 @@ DEFINES += QT_DEPRECATED_WARNINGS
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# The timers and counters of the solvers' hot paths, output in the analysis logs.
+# Comment out the following line to compile them out.
+DEFINES += XFL_PERFSTATS
+
 #   Uncomment the following line to print the name of the variable OUT_PWD in the console
 #message($$OUT_PWD)
 
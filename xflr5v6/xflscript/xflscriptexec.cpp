@@ -26,20 +26,27 @@
 #include <QMessageBox>
 #include <QDateTime>
 #include <QThreadPool>
+#include <QElapsedTimer>
 #include <QDebug>
 
 #include "xflscriptexec.h"
 #include <xflobjects/xml/xmlplanereader.h>
 #include <xflobjects/xml/xmlwpolarreader.h>
 
-#include <xdirect/analysis/xfoiltask.h>
+#include <xdirect/analysis/xfoilbatch.h>
 #include <xflobjects/objects2d/objects2d.h>
+#include <xflobjects/objects3d/objects3d.h>
+#include <xflobjects/objects3d/plane.h>
+#include <xflobjects/objects3d/planeopp.h>
+#include <xflobjects/objects3d/wpolar.h>
 #include <xdirect/xml/xmlpolarreader.h>
 #include <xflanalysis/plane_analysis/planetask.h>
 #include <xflcore/gui_params.h>
 #include <xflcore/xflcore.h>
 #include <xflcore/xflevents.h>
+#include <xflcore/units.h>
 #include <xflobjects/objects_global.h>
+#include <xflobjects/resultcache.h>
 
 QString XflScriptExec::s_VersionName;
 
@@ -65,6 +72,14 @@ XflScriptExec::~XflScriptExec()
         delete m_pXFile;
     }
     m_FoilExecList.clear();
+    for(int ij=0; ij<m_PlaneExecList.size(); ij++)
+    {
+        PlaneScriptJob *pJob = m_PlaneExecList.at(ij);
+        for(int ip=0; ip<pJob->POppList.size(); ip++) delete pJob->POppList.at(ip);
+        delete pJob->analysis.pPlane;
+        delete pJob;
+    }
+    m_PlaneExecList.clear();
 }
 
 
@@ -344,6 +359,8 @@ void XflScriptExec::onCancel()
 {
     m_bCancel=true;
     XFoilTask::cancelTask();
+    PlaneTask::cancelTask();
+    PanelAnalysis::s_bCancel = true;
 
     traceLog("\n_____________Analysis cancellation request received_____________\n\n");
     emit cancelTask();
@@ -392,6 +409,21 @@ bool XflScriptExec::makeExportDirectories()
         }
     }
 
+    if(m_Reader.m_PlaneList.size())
+    {
+        QString PlanePolarsPath = m_Reader.planePolarDirPath();
+        if(PlanePolarsPath.isEmpty()) PlanePolarsPath = m_OutputPath;
+        QDir exportPlanePolarsDir(PlanePolarsPath);
+        if(!exportPlanePolarsDir.exists())
+        {
+            if(!exportPlanePolarsDir.mkpath(PlanePolarsPath))
+            {
+                traceLog("Could not make the directory: "+PlanePolarsPath+"\n");
+                bOK = false;
+            }
+        }
+    }
+
     return bOK;
 }
 
@@ -422,6 +454,23 @@ bool XflScriptExec::runScript()
     }
     else traceLog("No Foil analysis requested\n\n");
 
+    // the plane analyses run after the foil analyses, so that the viscous
+    // interpolations can use the polars which have just been calculated
+    if(m_bCancel) return false;
+
+    makePlanes();
+    if(m_bCancel) return false;
+
+    makePlaneAnalysisList();
+    if(m_bCancel) return false;
+
+    if(m_PlaneExecList.size())
+    {
+        runPlaneAnalyses();
+        exportPlaneResults();
+    }
+    else traceLog("No plane analysis requested\n\n");
+
 
     traceLog("Finished script successfully\n");
     return true;
@@ -439,11 +488,9 @@ void XflScriptExec::runFoilAnalyses()
     traceLog(strong);
 
     m_nThreads = m_Reader.m_nMaxThreads;
-    QThreadPool::globalInstance()->setMaxThreadCount(m_nThreads);
     strong = QString::asprintf("Running with %d thread(s)\n", m_Reader.m_nMaxThreads);
     traceLog(strong+"\n");
 
-    //build an array of all analysis pairs to run
     m_nTaskDone = 0;
     m_nTaskStarted = 0;
 
@@ -451,34 +498,25 @@ void XflScriptExec::runFoilAnalyses()
     traceLog(strong+"\n");
 
     XFoilTask::s_bCancel = false;
+    XFoilTask::s_bSkipOpp = XFoilTask::s_bSkipPolar = false;
+    XFoil::setCancel(false);
+    ResultCache::resetStatistics();
 
+    // the batch splits the polars' ranges into chunks and balances them on the threads
+    XFoilBatch batch(this);
+    batch.setSequenceType(true, true, false);
     for(int i=0; i<m_FoilExecList.size(); i++)
     {
-        XFoilTask *pXFoilTask = new XFoilTask(this);
-
-        //take the last analysis in the array
-         FoilAnalysis &Analysis = m_FoilExecList[i];
-
-        //initiate the task
-        pXFoilTask->initializeTask(Analysis, true, true, false);
-        if(Analysis.pPolar->polarType()<xfl::FIXEDAOAPOLAR)
-            pXFoilTask->setSequence(true, Analysis.vMin, Analysis.vMax, Analysis.vInc);
-        else if(Analysis.pPolar->isFixedaoaPolar())
-            pXFoilTask->setReRange(Analysis.vMin, Analysis.vMax, Analysis.vInc);
-
-        //launch it
-        m_nTaskStarted++;
-        strong = "Starting "+Analysis.pFoil->name()+" / "+Analysis.pPolar->polarName()+"\n";
-        traceLog(strong);
-
-        QThreadPool::globalInstance()->start(pXFoilTask);
+        batch.addAnalysis(m_FoilExecList.at(i));
     }
+    batch.run(m_nThreads);
+    m_nTaskStarted = batch.nStarted();
 
-    QThreadPool::globalInstance()->waitForDone();
+    traceLog("\n"+batch.utilisationReport());
+    if(ResultCache::isEnabled()) traceLog(ResultCache::statistics(ResultCache::FOILOPP));
 
     // leave things as they were
     XFoil::s_bCancel = false;
-    QThreadPool::globalInstance()->setMaxThreadCount(QThread::idealThreadCount());
 
     if(m_bCancel) strong = "\n_____Foil analysis cancelled_____\n";
     else          strong = "\n_____Foil analysis completed_____\n";
@@ -486,6 +524,386 @@ void XflScriptExec::runFoilAnalyses()
 }
 
 
+/**
+ * Loads the planes listed in the script.
+ * xml files are read as full plane definitions; any other file is read as a wing definition
+ * which is used as the main wing of a new plane without tail or fin.
+ */
+bool XflScriptExec::makePlanes()
+{
+    if(!m_Reader.m_PlaneList.size()) return true;
+
+    traceLog("Reading plane files\n");
+    QStringList filters = {"*.xml", "*.xwimp", "*.txt"};
+    bool bOK = true;
+    for(int ipl=0; ipl<m_Reader.m_PlaneList.count(); ipl++)
+    {
+        QString planePathName;
+        if (!xfl::findFile(m_Reader.m_PlaneList.at(ipl), m_Reader.planeDirPath(), filters, true, planePathName))
+        {
+            traceLog("   ...failed to find the file "+m_Reader.m_PlaneList.at(ipl)+"\n");
+            bOK = false;
+            continue;
+        }
+
+        Plane *pPlane = new Plane;
+        if(planePathName.endsWith(".xml", Qt::CaseInsensitive))
+        {
+            QFile xmlFile(planePathName);
+            if (!xmlFile.open(QIODevice::ReadOnly))
+            {
+                traceLog("   ...could not open the file "+planePathName+"\n");
+                delete pPlane;
+                bOK = false;
+                continue;
+            }
+            XMLPlaneReader planeReader(xmlFile, pPlane);
+            planeReader.readXMLPlaneFile();
+            if(planeReader.hasError())
+            {
+                QString strange = QString::asprintf(" at line %d column %d\n", int(planeReader.lineNumber()), int(planeReader.columnNumber()));
+                traceLog("   ...error reading "+planePathName+": "+planeReader.errorString()+strange);
+                delete pPlane;
+                bOK = false;
+                continue;
+            }
+        }
+        else
+        {
+            QString errorMsg;
+            if(!pPlane->mainWing()->importDefinition(planePathName, errorMsg))
+            {
+                traceLog("   ...failed to read the wing definition "+planePathName+"\n");
+                delete pPlane;
+                bOK = false;
+                continue;
+            }
+            pPlane->setWings(false, false, false);
+            pPlane->setBody(false);
+            pPlane->setName(pPlane->mainWing()->name());
+            pPlane->computePlane();
+        }
+
+        pPlane = Objects3d::addPlane(pPlane);
+        m_oaPlane.append(pPlane);
+        traceLog("   added plane: "+pPlane->name()+"\n");
+    }
+    traceLog("\n");
+
+    return bOK;
+}
+
+
+WPolar* XflScriptExec::makeWPolarFromXml(QString const &fileName)
+{
+    QString pathName = m_Reader.xmlPlaneAnalysisDirPath()+QDir::separator()+fileName;
+    QFile xmlFile(pathName);
+    if (!xmlFile.open(QIODevice::ReadOnly))
+    {
+        traceLog("Could not read the file "+pathName+"\n");
+        return nullptr;
+    }
+
+    WPolar *pWPolar = new WPolar;
+    XmlWPolarReader wpReader(xmlFile, pWPolar);
+    wpReader.readXMLPolarFile();
+    if(wpReader.hasError())
+    {
+        QString strange = QString::asprintf(" at line %d column %d\n", int(wpReader.lineNumber()), int(wpReader.columnNumber()));
+        traceLog("   ...error reading "+pathName+": "+wpReader.errorString()+strange);
+        delete pWPolar;
+        return nullptr;
+    }
+    return pWPolar;
+}
+
+
+/**
+ * Checks that the foils referenced by the plane's wings have been loaded.
+ */
+bool XflScriptExec::checkPlaneFoils(Plane const *pPlane)
+{
+    for(int iw=0; iw<MAXWINGS; iw++)
+    {
+        Wing const *pWing = pPlane->wingAt(iw);
+        if(!pWing) continue;
+        for (int l=0; l<pWing->NWingSection(); l++)
+        {
+            if (!Objects2d::foil(pWing->rightFoilName(l)))
+            {
+                traceLog("   "+pWing->name() + ": could not find the foil "+ pWing->rightFoilName(l)+"\n");
+                return false;
+            }
+            if (!Objects2d::foil(pWing->leftFoilName(l)))
+            {
+                traceLog("   "+pWing->name() + ": could not find the foil "+ pWing->leftFoilName(l)+"\n");
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+/**
+ * Builds the list of (plane, polar) pairs to analyze.
+ * Each job is given a private copy of its plane, since the task builds the surfaces
+ * and the panels in the plane's wings.
+ */
+void XflScriptExec::makePlaneAnalysisList()
+{
+    if(!m_oaPlane.size()) return;
+
+    QStringList filters = {"*.xml"};
+    QStringList xmlanalyseslist = m_Reader.m_XmlPlaneAnalysisList;
+    if(m_Reader.bRunAllPlaneAnalyses())
+    {
+        xmlanalyseslist = xfl::findFiles(m_Reader.xmlPlaneAnalysisDirPath(), filters, false);
+    }
+
+    for(int ipl=0; ipl<m_oaPlane.count(); ipl++)
+    {
+        Plane *pPlane = m_oaPlane.at(ipl);
+        if(!checkPlaneFoils(pPlane))
+        {
+            traceLog("   skipping the analyses of plane "+pPlane->name()+"\n");
+            continue;
+        }
+
+        for(int ia=0; ia<xmlanalyseslist.count(); ia++)
+        {
+            WPolar *pWPolar = makeWPolarFromXml(xmlanalyseslist.at(ia));
+            if(!pWPolar) continue;
+
+            pWPolar->setPlaneName(pPlane->name());
+            pWPolar->setVisible(true);
+
+            PlaneScriptJob *pJob = new PlaneScriptJob;
+            pJob->pRefPlane = pPlane;
+            pJob->analysis.pPlane = new Plane;
+            pJob->analysis.pPlane->duplicate(pPlane);
+            pJob->analysis.pWPolar = pWPolar;
+
+            switch(pWPolar->polarType())
+            {
+                case xfl::FIXEDSPEEDPOLAR:
+                case xfl::FIXEDLIFTPOLAR:
+                {
+                    pJob->analysis.vMin = m_Reader.m_PlaneAlphaMin;
+                    pJob->analysis.vMax = m_Reader.m_PlaneAlphaMax;
+                    pJob->analysis.vInc = m_Reader.m_PlaneAlphaInc;
+                    break;
+                }
+                case xfl::FIXEDAOAPOLAR:
+                {
+                    pJob->analysis.vMin = m_Reader.m_QInfMin;
+                    pJob->analysis.vMax = m_Reader.m_QInfMax;
+                    pJob->analysis.vInc = m_Reader.m_QInfInc;
+                    break;
+                }
+                case xfl::BETAPOLAR:
+                {
+                    pJob->analysis.vMin = m_Reader.m_BetaMin;
+                    pJob->analysis.vMax = m_Reader.m_BetaMax;
+                    pJob->analysis.vInc = m_Reader.m_BetaInc;
+                    break;
+                }
+                default:
+                {
+                    pJob->analysis.vMin = m_Reader.m_CtrlMin;
+                    pJob->analysis.vMax = m_Reader.m_CtrlMax;
+                    pJob->analysis.vInc = m_Reader.m_CtrlInc;
+                    break;
+                }
+            }
+
+            m_PlaneExecList.append(pJob);
+            traceLog("   added analysis for plane "+pPlane->name()+" and "+pWPolar->polarName() +"\n");
+        }
+    }
+    traceLog("\n");
+}
+
+
+/**
+ * Runs the plane analyses one after the other.
+ * The panel and surface classes reference the current task's node arrays through static pointers,
+ * so that two plane tasks cannot run concurrently.
+ */
+void XflScriptExec::runPlaneAnalyses()
+{
+    QString strong;
+
+    traceLog("\n_____Starting plane analyses_____\n\n");
+
+    strong = QString::asprintf("Running %d (plane, polar) pair(s)\n\n", m_PlaneExecList.size());
+    traceLog(strong);
+
+    PlaneTask::setCancelled(false);
+    PanelAnalysis::s_bCancel = false;
+    PanelAnalysis::s_bWarning = false;
+    ResultCache::resetStatistics();
+
+    for(int ij=0; ij<m_PlaneExecList.size(); ij++)
+    {
+        if(m_bCancel) break;
+        PlaneScriptJob *pJob = m_PlaneExecList.at(ij);
+        traceLog("Starting "+pJob->pRefPlane->name()+" / "+pJob->analysis.pWPolar->polarName()+"\n");
+        runPlaneAnalysis(pJob);
+    }
+
+    if(ResultCache::isEnabled()) traceLog("\n"+ResultCache::statistics(ResultCache::PLANEOPP));
+
+    PlaneTask::setCancelled(false);
+    PanelAnalysis::s_bCancel = false;
+
+    if(m_bCancel) strong = "\n_____Plane analysis cancelled_____\n";
+    else          strong = "\n_____Plane analysis completed_____\n";
+    traceLog(strong);
+}
+
+
+/** Runs one plane analysis. */
+void XflScriptExec::runPlaneAnalysis(PlaneScriptJob *pJob)
+{
+    QElapsedTimer t;
+    t.start();
+
+    LLTAnalysis lltAnalysis;
+    lltAnalysis.m_poaPolar = Objects2d::pOAPolar();
+    PanelAnalysis panelAnalysis;
+
+    PlaneTask task;
+    task.setLLTAnalysis(lltAnalysis);
+    task.setPanelAnalysis(panelAnalysis);
+
+    Plane *pPlane = pJob->analysis.pPlane;
+    WPolar *pWPolar = pJob->analysis.pWPolar;
+
+    task.setPlaneObject(pPlane);
+    if(!task.setWPolarObject(pPlane, pWPolar))
+    {
+        pJob->bError = true;
+        pJob->msElapsed = t.elapsed();
+        return;
+    }
+
+    if(pWPolar->isLLTMethod()) pJob->nPanels = LLTAnalysis::nSpanStations();
+    else                       pJob->nPanels = task.matSize();
+
+    task.initializeTask(&pJob->analysis);
+    task.run();
+
+    // take ownership of the operating points before the analysis objects go out of scope
+    if(pWPolar->isLLTMethod())
+    {
+        pJob->POppList = lltAnalysis.m_PlaneOppList;
+        lltAnalysis.m_PlaneOppList.clear();
+        pJob->bError = lltAnalysis.m_bError;
+    }
+    else
+    {
+        pJob->POppList = panelAnalysis.m_PlaneOppList;
+        panelAnalysis.m_PlaneOppList.clear();
+        pJob->bError = panelAnalysis.m_bPointOut;
+    }
+
+    pJob->msElapsed = t.elapsed();
+}
+
+
+/**
+ * Stores the polars and operating points of the completed plane analyses,
+ * and writes the polars' text files and the timing summary.
+ */
+void XflScriptExec::exportPlaneResults()
+{
+    QString strong;
+    QString PlanePolarsPath = m_Reader.planePolarDirPath();
+    if(PlanePolarsPath.isEmpty()) PlanePolarsPath = m_OutputPath;
+
+    bool bCSV = m_Reader.m_bcsvPolarOutput;
+    QString speedlabel;
+    Units::getSpeedUnitLabel(speedlabel);
+
+    QFile timingFile(PlanePolarsPath + QDir::separator() + "plane_analysis_timing.csv");
+    QTextStream timingStream;
+    if(timingFile.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        timingStream.setDevice(&timingFile);
+        timingStream << "Plane, Polar, Method, Panels, Points, Time(s)\n";
+    }
+
+    traceLog("\nPlane analysis timings:\n");
+    qint64 msTotal = 0;
+    for(int ij=0; ij<m_PlaneExecList.size(); ij++)
+    {
+        PlaneScriptJob *pJob = m_PlaneExecList.at(ij);
+        WPolar *pWPolar = pJob->analysis.pWPolar;
+
+        QString method;
+        if     (pWPolar->isLLTMethod())    method = "LLT";
+        else if(pWPolar->isVLMMethod())    method = "VLM";
+        else if(pWPolar->isPanel4Method()) method = "Panel";
+        else                               method = "Other";
+
+        strong = QString::asprintf("   %-7s  %6d panels  %4d points  %9.3f s", method.toStdString().c_str(),
+                                   pJob->nPanels, pWPolar->dataSize(), double(pJob->msElapsed)/1000.0);
+        strong += "   "+pJob->pRefPlane->name()+" / "+pWPolar->polarName();
+        if(pJob->bError) strong += "   ...some points are unconverged or outside the flight envelope";
+        traceLog(strong+"\n");
+        msTotal += pJob->msElapsed;
+
+        if(timingStream.device())
+        {
+            timingStream << pJob->pRefPlane->name() << ", " << pWPolar->polarName() << ", " << method << ", "
+                         << pJob->nPanels << ", " << pWPolar->dataSize() << ", "
+                         << QString::asprintf("%.3f", double(pJob->msElapsed)/1000.0) << "\n";
+        }
+
+        if(m_Reader.m_bOutputPlanePolarsText)
+        {
+            QString fileName = pJob->pRefPlane->name()+"_"+pWPolar->polarName();
+            fileName.replace("/", "_");
+            fileName.replace(" ", "_");
+            fileName += bCSV ? ".csv" : ".txt";
+            QFile polarFile(PlanePolarsPath + QDir::separator() + fileName);
+            if(polarFile.open(QIODevice::WriteOnly | QIODevice::Text))
+            {
+                QTextStream out(&polarFile);
+                pWPolar->exportWPolar(out, VERSIONNAME, bCSV, Units::mstoUnit(), speedlabel);
+                polarFile.close();
+            }
+            else traceLog("   ...could not write the file "+polarFile.fileName()+"\n");
+        }
+
+        // hand the results over to the project
+        Objects3d::addWPolar(pWPolar);
+        pJob->analysis.pWPolar = nullptr;
+
+        for(int ip=0; ip<pJob->POppList.size(); ip++)
+        {
+            PlaneOpp *pPOpp = pJob->POppList.at(ip);
+            if(m_Reader.bMakePlaneOpps() && PlaneOpp::storePOpps())
+            {
+                pPOpp->setVisible(true);
+                Objects3d::insertPOpp(pPOpp);
+            }
+            else delete pPOpp;
+        }
+        pJob->POppList.clear();
+    }
+    strong = QString::asprintf("   Total analysis time: %.3f s\n\n", double(msTotal)/1000.0);
+    traceLog(strong);
+
+    if(timingStream.device())
+    {
+        timingStream.flush();
+        timingFile.close();
+    }
+}
+
+
 /** Useless: thread does not exit the runFoilAnalyses() method until all tasks are done*/
 void XflScriptExec::customEvent(QEvent *pEvent)
 {
@@ -507,6 +925,11 @@ void XflScriptExec::customEvent(QEvent *pEvent)
         if(OpPoint::bStoreOpp()) Objects2d::insertOpPoint(pOppEvent->theOpPoint()); // OpPoint data is added to the polar data on the fly in the XFoilTask
         else                      delete pOppEvent->theOpPoint();
     }
+    else if(pEvent->type() == MESSAGE_EVENT)
+    {
+        MessageEvent *pMsgEvent = dynamic_cast<MessageEvent*>(pEvent);
+        traceLog(pMsgEvent->msg());
+    }
 }
 
 
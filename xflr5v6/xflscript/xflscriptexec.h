@@ -24,17 +24,35 @@
 #include <QTextStream>
 
 #include <xflscript/xflscriptreader.h>
+#include <xflanalysis/plane_analysis/planetask.h>
 
 
 
 class Foil;
+class Plane;
 class PlaneOpp;
 class Polar;
+class WPolar;
 class XFoilTask;
 class MainFrame;
 
 struct FoilAnalysis;
 
+
+/**
+ * @struct A plane analysis run by the script.
+ * The plane is a private copy so that the analysis does not modify the plane registered in the project.
+ */
+struct PlaneScriptJob
+{
+    PlaneAnalysis analysis;           /**< the private copy of the plane, the polar and the range */
+    Plane *pRefPlane=nullptr;         /**< the plane registered in the project */
+    int nPanels=0;                    /**< the number of panels, or of LLT stations */
+    qint64 msElapsed=0;               /**< the wall time of the analysis */
+    bool bError=false;
+    QVector<PlaneOpp*> POppList;      /**< the operating points computed by the task */
+};
+
 class XflScriptExec : public QObject
 {
         Q_OBJECT
@@ -55,6 +73,7 @@ class XflScriptExec : public QObject
         QString const &outputDirPath()               const {return m_OutputPath;}
         QString const &foilPolarBinOutputDirPath()   const {return m_Reader.binPolarDirPath();}
         QString const &xfoilPolarOutputDirPath()     const {return m_Reader.xfoilPolarDirPath();}
+        QString const &planePolarOutputDirPath()     const {return m_Reader.planePolarDirPath();}
 
         QString projectFilePathName() const;
 
@@ -72,6 +91,13 @@ class XflScriptExec : public QObject
         bool makeFoils();
         void makeFoilAnalysisList();
         void runFoilAnalyses();
+        bool makePlanes();
+        WPolar* makeWPolarFromXml(QString const &fileName);
+        void makePlaneAnalysisList();
+        void runPlaneAnalyses();
+        void runPlaneAnalysis(PlaneScriptJob *pJob);
+        bool checkPlaneFoils(Plane const *pPlane);
+        void exportPlaneResults();
 
     signals:
         void msgUpdate(const QString &msg) const;
@@ -88,6 +114,7 @@ class XflScriptExec : public QObject
         QString m_OutputPath;
 
         QVector<FoilAnalysis> m_FoilExecList;
+        QVector<PlaneScriptJob*> m_PlaneExecList;
 
         MainFrame *m_pMainFrame;
 
@@ -98,6 +125,7 @@ class XflScriptExec : public QObject
         int m_nThreads;
 
         QVector <Foil*>  m_oaFoil;
+        QVector <Plane*> m_oaPlane;
 
         static QString s_VersionName;
 };
@@ -50,6 +50,18 @@ XFLScriptReader::XFLScriptReader()
     m_bFromZero  = true;
     m_bRunAllFoilAnalyses = true;
 
+    m_PlaneAlphaMin = m_PlaneAlphaMax = 0.0;
+    m_PlaneAlphaInc = 0.5;
+    m_QInfMin = m_QInfMax = 10.0;
+    m_QInfInc = 1.0;
+    m_BetaMin = m_BetaMax = 0.0;
+    m_BetaInc = 1.0;
+    m_CtrlMin = m_CtrlMax = 0.0;
+    m_CtrlInc = 0.1;
+    m_bRunAllPlaneAnalyses = true;
+    m_bOutputPlanePolarsText = true;
+    m_bMakePlaneOpps = false;
+
     m_bOutputPolarsBin = m_bOutputPolarsText = m_bMakeProjectFile = false;
     m_bRecursiveDirScan = true;
     m_bMakeXfl = m_bMakePOpps = m_bMultiThreading = false;
@@ -81,6 +93,10 @@ bool XFLScriptReader::readScript()
         {
             readFoilData();
         }
+        else if (name().compare(QString("plane_analysis"), Qt::CaseInsensitive)==0)
+        {
+            readPlaneData();
+        }
         else
             skipCurrentElement();
     }
@@ -151,6 +167,21 @@ bool XFLScriptReader::readDirectoryData()
             m_XFoilPolarsDir = readElementText().trimmed();
             if(m_XFoilPolarsDir.endsWith(QDir::separator())) m_XFoilPolarsDir.remove(m_XFoilPolarsDir.lastIndexOf(QDir::separator()), 1);
         }
+        else if(name().compare(QString("plane_files_dir"), Qt::CaseInsensitive)==0)
+        {
+            m_PlaneDirPath = readElementText().trimmed();
+            if(m_PlaneDirPath.endsWith(QDir::separator())) m_PlaneDirPath.remove(m_PlaneDirPath.lastIndexOf(QDir::separator()), 1);
+        }
+        else if(name().compare(QString("plane_analysis_xml_dir"), Qt::CaseInsensitive)==0)
+        {
+            m_xmlPlaneAnalysisDirPath = readElementText().trimmed();
+            if(m_xmlPlaneAnalysisDirPath.endsWith(QDir::separator())) m_xmlPlaneAnalysisDirPath.remove(m_xmlPlaneAnalysisDirPath.lastIndexOf(QDir::separator()), 1);
+        }
+        else if(name().compare(QString("plane_polars_dir"), Qt::CaseInsensitive)==0)
+        {
+            m_PlanePolarsDir = readElementText().trimmed();
+            if(m_PlanePolarsDir.endsWith(QDir::separator())) m_PlanePolarsDir.remove(m_PlanePolarsDir.lastIndexOf(QDir::separator()), 1);
+        }
         else if(name().compare(QString("recursive_scan"), Qt::CaseInsensitive)==0)
         {
             m_bRecursiveDirScan = xfl::stringToBool(readElementText().trimmed());
@@ -440,5 +471,122 @@ bool XFLScriptReader::readFoilBatchRange()
 }
 
 
+bool XFLScriptReader::readPlaneData()
+{
+    while(!atEnd() && !hasError() && readNextStartElement() )
+    {
+        //level 2
+        if(name().compare(QString("Plane_Files"), Qt::CaseInsensitive)==0)
+        {
+            readPlanes();
+        }
+        else if(name().compare(QString("Analysis_Files"), Qt::CaseInsensitive)==0)
+        {
+            readPlaneAnalysisFiles();
+        }
+        else if(name().compare(QString("OpPoint_Range"), Qt::CaseInsensitive)==0)
+        {
+            readPlaneAnalysisRange();
+        }
+        else if(name().compare(QString("Output"), Qt::CaseInsensitive)==0)
+        {
+            readPlaneAnalysisOutput();
+        }
+        else
+            skipCurrentElement();
+    }
+    return(!hasError());
+}
+
+
+bool XFLScriptReader::readPlanes()
+{
+    while(!atEnd() && !hasError() && readNextStartElement() )
+    {
+        if (name().compare(QString("Plane_File_Name"), Qt::CaseInsensitive)==0)
+        {
+            m_PlaneList.append(readElementText().trimmed());
+        }
+        else
+            skipCurrentElement();
+    }
 
+    return true;
+}
 
+
+bool XFLScriptReader::readPlaneAnalysisFiles()
+{
+    while(!atEnd() && !hasError() && readNextStartElement() )
+    {
+        if(name().compare(QString("Process_All_Files"), Qt::CaseInsensitive)==0)
+        {
+            m_bRunAllPlaneAnalyses = xfl::stringToBool(readElementText().trimmed());
+        }
+        else if(name().compare(QString("Analysis_File_Name"), Qt::CaseInsensitive)==0)
+        {
+            m_XmlPlaneAnalysisList.push_back(readElementText().trimmed());
+        }
+        else
+            skipCurrentElement();
+    }
+    return(!hasError());
+}
+
+
+bool XFLScriptReader::readPlaneAnalysisRange()
+{
+    while(!atEnd() && !hasError() && readNextStartElement() )
+    {
+        if(name().compare(QString("Alpha"), Qt::CaseInsensitive)==0)
+        {
+            QStringList alphaList = readElementText().simplified().split(",");
+            if(alphaList.length()>0) m_PlaneAlphaMin = alphaList.at(0).toDouble();
+            if(alphaList.length()>1) m_PlaneAlphaMax = alphaList.at(1).toDouble();
+            if(alphaList.length()>2) m_PlaneAlphaInc = alphaList.at(2).toDouble();
+        }
+        else if(name().compare(QString("Velocity"), Qt::CaseInsensitive)==0)
+        {
+            QStringList qinfList = readElementText().simplified().split(",");
+            if(qinfList.length()>0) m_QInfMin = qinfList.at(0).toDouble();
+            if(qinfList.length()>1) m_QInfMax = qinfList.at(1).toDouble();
+            if(qinfList.length()>2) m_QInfInc = qinfList.at(2).toDouble();
+        }
+        else if(name().compare(QString("Beta"), Qt::CaseInsensitive)==0)
+        {
+            QStringList betaList = readElementText().simplified().split(",");
+            if(betaList.length()>0) m_BetaMin = betaList.at(0).toDouble();
+            if(betaList.length()>1) m_BetaMax = betaList.at(1).toDouble();
+            if(betaList.length()>2) m_BetaInc = betaList.at(2).toDouble();
+        }
+        else if(name().compare(QString("Control"), Qt::CaseInsensitive)==0)
+        {
+            QStringList ctrlList = readElementText().simplified().split(",");
+            if(ctrlList.length()>0) m_CtrlMin = ctrlList.at(0).toDouble();
+            if(ctrlList.length()>1) m_CtrlMax = ctrlList.at(1).toDouble();
+            if(ctrlList.length()>2) m_CtrlInc = ctrlList.at(2).toDouble();
+        }
+        else
+            skipCurrentElement();
+    }
+    return(!hasError());
+}
+
+
+bool XFLScriptReader::readPlaneAnalysisOutput()
+{
+    while(!atEnd() && !hasError() && readNextStartElement() )
+    {
+        if(name().compare(QString("make_polars_text_file"), Qt::CaseInsensitive)==0)
+        {
+            m_bOutputPlanePolarsText = xfl::stringToBool(readElementText());
+        }
+        else if(name().compare(QString("make_oppoints"), Qt::CaseInsensitive)==0)
+        {
+            m_bMakePlaneOpps = xfl::stringToBool(readElementText());
+        }
+        else
+            skipCurrentElement();
+    }
+    return !hasError();
+}
@@ -48,15 +48,25 @@ public:
     bool readFoils();
     bool readMetaData();
     bool readThreadingOptions();
+    bool readPlaneData();
+    bool readPlanes();
+    bool readPlaneAnalysisFiles();
+    bool readPlaneAnalysisRange();
+    bool readPlaneAnalysisOutput();
 
     bool bMakeFoilOpps() const {return m_bMakeOpps;}
     bool bRunAllAnalyses() const {return m_bRunAllFoilAnalyses;}
+    bool bRunAllPlaneAnalyses() const {return m_bRunAllPlaneAnalyses;}
+    bool bMakePlaneOpps() const {return m_bMakePlaneOpps;}
 
     QString const &datFoilDirPath()     const {return m_datFoilDirPath;}
     QString const &binPolarDirPath()    const {return m_PolarBinDirPath;}
     QString const &xfoilPolarDirPath()  const {return m_XFoilPolarsDir;}
     QString const &xmlAnalysisDirPath() const {return m_xmlAnalysisDirPath;}
     QString const &outputDirPath()      const {return m_OutputDirPath;}
+    QString const &planeDirPath()            const {return m_PlaneDirPath;}
+    QString const &xmlPlaneAnalysisDirPath() const {return m_xmlPlaneAnalysisDirPath;}
+    QString const &planePolarDirPath()       const {return m_PlanePolarsDir;}
 
 private:
     QString const &projectFileName()   const {return m_ProjectFileName;}
@@ -81,6 +91,17 @@ private:
     QString m_OutputDirPath;
     QStringList m_XmlFoilAnalysisList;         /**< The list of xml foil analysis files to load */
 
+    QStringList m_PlaneList;                   /**< The list of xml plane files or of wing definition files to load */
+    QStringList m_XmlPlaneAnalysisList;        /**< The list of xml plane analysis files to load */
+    QString m_PlaneDirPath, m_xmlPlaneAnalysisDirPath, m_PlanePolarsDir;
+    double m_PlaneAlphaMin, m_PlaneAlphaMax, m_PlaneAlphaInc;   /**< T1, T2 and T3 polars */
+    double m_QInfMin, m_QInfMax, m_QInfInc;                     /**< T4 polars */
+    double m_BetaMin, m_BetaMax, m_BetaInc;                     /**< T5 polars */
+    double m_CtrlMin, m_CtrlMax, m_CtrlInc;                     /**< T6 and T7 polars */
+    bool m_bRunAllPlaneAnalyses;
+    bool m_bOutputPlanePolarsText;
+    bool m_bMakePlaneOpps;
+
     bool m_bOutputPolarsBin;
     bool m_bOutputPolarsText;
     bool m_bMakeProjectFile;
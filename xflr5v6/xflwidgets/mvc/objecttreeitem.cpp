@@ -22,6 +22,7 @@ ObjectTreeItem::ObjectTreeItem(QString const &name, LineStyle const &ls, Qt::Che
     m_Name = name;
     m_LS = ls;
     m_CheckState = state;
+    m_bFetched = true;
 }
 
 
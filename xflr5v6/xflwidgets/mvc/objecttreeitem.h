@@ -39,6 +39,8 @@ class ObjectTreeItem
         bool isObjectLevel() const {return m_Level==1;}
         bool isPolarLevel()  const {return m_Level==2;}
         bool isOppLevel()    const {return m_Level==3;}
+        void setFetched(bool bFetched) {m_bFetched=bFetched;}
+        bool isFetched() const {return m_bFetched;}
 
     private:
         // these methods should only be accessed through the model so as to call begin/end removeRows()
@@ -56,6 +58,7 @@ class ObjectTreeItem
         LineStyle m_LS;
         Qt::CheckState m_CheckState;
         int m_Level; /// 0 is root, 1 is plane/foil, 2 is polar, 3 is Opp,  4 is mode
+        bool m_bFetched; /// false until the children have been built, on the first expansion of the item
 };
 
 
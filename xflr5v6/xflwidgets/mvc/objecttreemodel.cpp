@@ -157,6 +157,43 @@ int ObjectTreeModel::rowCount(const QModelIndex &parent) const
 }
 
 
+/** Items which have not been fetched yet are shown as expandable, without building their children. */
+bool ObjectTreeModel::hasChildren(const QModelIndex &parent) const
+{
+    if (parent.column()>0) return false;
+    if (parent.isValid())
+    {
+        ObjectTreeItem const *pItem = static_cast<ObjectTreeItem*>(parent.internalPointer());
+        if(!pItem->isFetched()) return true;
+    }
+    return QAbstractItemModel::hasChildren(parent);
+}
+
+
+bool ObjectTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (!parent.isValid()) return false;
+    ObjectTreeItem const *pItem = static_cast<ObjectTreeItem*>(parent.internalPointer());
+    return !pItem->isFetched();
+}
+
+
+/** Called by the view when the item is expanded; the owner of the model builds the children on the fetchChildren() signal. */
+void ObjectTreeModel::fetchMore(const QModelIndex &parent)
+{
+    fetch(itemFromIndex(parent));
+}
+
+
+/** Builds the children of the item now, e.g. before one of them is selected. */
+void ObjectTreeModel::fetch(ObjectTreeItem *pItem)
+{
+    if(!pItem || pItem->isFetched()) return;
+    pItem->setFetched(true);
+    emit fetchChildren(pItem);
+}
+
+
 bool ObjectTreeModel::removeRows(int row, int count, const QModelIndex &parentindex)
 {
     if(count<=0) return true;
@@ -223,6 +260,21 @@ ObjectTreeItem* ObjectTreeModel::appendRow(ObjectTreeItem*pParentItem, QString c
 }
 
 
+/**
+ * Inserts a run of new items with a single notification to the views.
+ * The model takes ownership of the items, which should have been created without a parent.
+ */
+void ObjectTreeModel::insertItems(ObjectTreeItem*pParentItem, int row, QList<ObjectTreeItem*> const &items)
+{
+    if(!pParentItem || items.isEmpty()) return;
+    QModelIndex parentindex = index(pParentItem->parentItem(), pParentItem);
+    beginInsertRows(parentindex, row, row+items.size()-1);
+    for(int i=0; i<items.size(); i++)
+        pParentItem->insertRow(row+i, items.at(i));
+    endInsertRows();
+}
+
+
 /** custom method to update the ObjectTreeView if the underlying object has changed */
 void ObjectTreeModel::updateData()
 {
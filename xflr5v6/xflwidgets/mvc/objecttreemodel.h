@@ -30,6 +30,10 @@ class ObjectTreeModel : public QAbstractItemModel
         QModelIndex parent(const QModelIndex &index) const override;
         int rowCount(const QModelIndex &parent = QModelIndex()) const override;
         int columnCount(const QModelIndex &ind= QModelIndex()) const override;
+        bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+        bool canFetchMore(const QModelIndex &parent) const override;
+        void fetchMore(const QModelIndex &parent) override;
+        void fetch(ObjectTreeItem *pItem);
 
         ObjectTreeItem *rootItem() {return m_pRootItem;}
         ObjectTreeItem *item(int iRow);
@@ -40,10 +44,14 @@ class ObjectTreeModel : public QAbstractItemModel
 
         ObjectTreeItem* insertRow(ObjectTreeItem*pParentItem, int row, QString const &name, LineStyle const &ls, Qt::CheckState state);
         ObjectTreeItem* appendRow(ObjectTreeItem*pParentItem, QString const &name, LineStyle const &ls, Qt::CheckState state);
+        void insertItems(ObjectTreeItem*pParentItem, int row, QList<ObjectTreeItem*> const &items);
 
         void updateData();
         void updateData(QModelIndex idx);
 
+    signals:
+        void fetchChildren(ObjectTreeItem *pItem);
+
     private:
 
         ObjectTreeItem *m_pRootItem;
@@ -19,10 +19,12 @@
 
 *****************************************************************************/
 
+#include <QComboBox>
 #include <QDialogButtonBox>
 #include <QGridLayout>
 
 #include <xflcore/xflcore.h>
+#include <xfoil.h>
 
 #include "xinverse.h"
 #include "inverseoptionsdlg.h"
@@ -33,7 +35,7 @@
 
 InverseOptionsDlg::InverseOptionsDlg(QWidget *pParent) : QDialog(pParent)
 {
-    setWindowTitle(tr("XInverse Style"));
+    setWindowTitle(tr("XInverse Options"));
     m_pXInverse = nullptr;
     setupLayout();
 }
@@ -66,11 +68,22 @@ void InverseOptionsDlg::setupLayout()
         pStyleLayout->addWidget(m_plbModFoil,2,2);
         pStyleLayout->addWidget(m_plbSpline,3,2);
         pStyleLayout->addWidget(m_plbReflected,4,2);
+
+        QLabel *plab5 = new QLabel(tr("Circle plane points"));
+        plab5->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        m_pcbCirclePoints = new QComboBox(this);
+        for(int np=65; np<=ICXMAX; np=2*(np-1)+1)
+            m_pcbCirclePoints->addItem(QString::asprintf("%d", np), np);
+        m_pcbCirclePoints->setToolTip(tr("Number of points used for the full-inverse conformal mapping.\n"
+                                         "The change applies the next time a foil is loaded in full-inverse mode."));
+
+        pStyleLayout->addWidget(plab5,5,1);
+        pStyleLayout->addWidget(m_pcbCirclePoints,5,2);
     }
 
     QDialogButtonBox *pButtonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
     {
-        connect(pButtonBox, &QDialogButtonBox::accepted, this, &InverseOptionsDlg::accept);
+        connect(pButtonBox, &QDialogButtonBox::accepted, this, &InverseOptionsDlg::onOK);
         connect(pButtonBox, &QDialogButtonBox::rejected, this, &InverseOptionsDlg::reject);
     }
 
@@ -95,6 +108,16 @@ void InverseOptionsDlg::initDialog()
     m_plbModFoil->setTheStyle(m_pXInverse->m_pModFoil->theStyle());
     m_plbSpline->setTheStyle(m_pXInverse->m_Spline.theStyle());
     m_plbReflected->setTheStyle(m_pXInverse->m_ReflectedStyle);
+
+    int idx = m_pcbCirclePoints->findData(XFoil::circlePoints());
+    m_pcbCirclePoints->setCurrentIndex(idx>=0 ? idx : 0);
+}
+
+
+void InverseOptionsDlg::onOK()
+{
+    XFoil::setCirclePoints(m_pcbCirclePoints->currentData().toInt());
+    accept();
 }
 
 
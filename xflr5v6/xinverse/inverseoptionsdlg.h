@@ -25,6 +25,7 @@
 
 class XInverse;
 class LineBtn;
+class QComboBox;
 
 class InverseOptionsDlg:public QDialog
 {
@@ -40,12 +41,14 @@ class InverseOptionsDlg:public QDialog
         void onModStyle();
         void onSplineStyle();
         void onReflectedStyle();
+        void onOK();
 
     private:
         void setupLayout();
         void initDialog();
 
         LineBtn *m_plbRefFoil, *m_plbModFoil, *m_plbSpline, *m_plbReflected;
+        QComboBox *m_pcbCirclePoints;
 
         XInverse * m_pXInverse;
 };
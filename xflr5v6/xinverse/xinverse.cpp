@@ -395,18 +395,18 @@ void XInverse::execMDES()
     }
     m_pXFoil->ExecMDES();
 
-    for(int i=1; i<=m_pXFoil->nsp; i++)
+    for(int i=1; i<=m_pXFoil->nb; i++)
     {
         m_pModFoil->m_x[i-1] = m_pXFoil->xb[i];
         m_pModFoil->m_y[i-1] = m_pXFoil->yb[i];
     }
-    for(int i=1; i<=m_pXFoil->nsp; i++)
+    for(int i=1; i<=m_pXFoil->nb; i++)
     {
         m_pModFoil->m_xb[i-1] = m_pXFoil->xb[i];
         m_pModFoil->m_yb[i-1] = m_pXFoil->yb[i];
     }
-    m_pModFoil->m_n  = m_pXFoil->nsp;
-    m_pModFoil->m_nb = m_pXFoil->nsp;
+    m_pModFoil->m_n  = m_pXFoil->nb;
+    m_pModFoil->m_nb = m_pXFoil->nb;
     m_pModFoil->initFoil();
 
     m_bModFoil = true;
@@ -698,6 +698,7 @@ void XInverse::loadSettings(QSettings &settings)
     settings.beginGroup("XInverse");
     {
         m_bFullInverse = settings.value("FullInverse").toBool();
+        XFoil::setCirclePoints(settings.value("CirclePoints", XFoil::circlePoints()).toInt());
 
         m_Spline.theStyle().loadSettings(settings, "InverseSpline");
 
@@ -718,6 +719,7 @@ void XInverse::saveSettings(QSettings &settings)
     settings.beginGroup("XInverse");
     {
         settings.setValue("FullInverse", m_bFullInverse);
+        settings.setValue("CirclePoints", XFoil::circlePoints());
         m_Spline.theStyle().saveSettings(settings, "InverseSpline");
         m_pRefFoil->theStyle().saveSettings(settings, "BaseFoilStyle");
         m_pModFoil->theStyle().saveSettings(settings, "ModFoilStyle");
@@ -1331,6 +1333,8 @@ void XInverse::onApplySpline()
         {
             m_pReflectedCurve->m_y[i] = -m_pMCurve->m_y[i];
         }
+        m_pMCurve->invalidatePolyline();
+        m_pReflectedCurve->invalidatePolyline();
 
         m_bSplined = true;
         for (i=1; i<= m_pXFoil->nsp; i++)
@@ -1622,17 +1626,17 @@ void XInverse::onPertubate()
 
     PertDlg PerturbDlg(s_pMainFrame);
 
-    for (m=0; m<=qMin(32, m_pXFoil->nc); m++)
+    for (m=0; m<=qMin(32, m_pXFoil->mc); m++)
     {
         PerturbDlg.m_cnr[m] = real(m_pXFoil->cn[m]);
         PerturbDlg.m_cni[m] = imag(m_pXFoil->cn[m]);
     }
-    PerturbDlg.m_nc = qMin(32, m_pXFoil->nc);
+    PerturbDlg.m_nc = qMin(32, m_pXFoil->mc);
     PerturbDlg.initDialog();
 
     if(PerturbDlg.exec() == QDialog::Accepted)
     {
-        for (m=0; m<=qMin(32, m_pXFoil->nc); m++)
+        for (m=0; m<=qMin(32, m_pXFoil->mc); m++)
         {
             m_pXFoil->cn[m] = complex<double>(PerturbDlg.m_cnr[m], PerturbDlg.m_cni[m]);
         }
@@ -2174,7 +2178,7 @@ void XInverse::resetMixedQ()
  */
 void XInverse::resetQ()
 {
-    m_pXFoil->cncalc(m_pXFoil->qgamm,false);
+    m_pXFoil->cncalc(m_pXFoil->qgamm.data(),false);
     m_pXFoil->qspcir();
     createMCurve();
     updateView();
@@ -2786,7 +2790,7 @@ void XInverse::smooth(int Pos1, int Pos2)
     if(m_bFullInverse)
     {
         m_pXFoil->smooq(Pos1,Pos2,1);
-        m_pXFoil->cncalc(m_pXFoil->qspec[1], false);
+        m_pXFoil->cncalc(m_pXFoil->qspec[1].data(), false);
         m_pXFoil->qspcir();
         m_pXFoil->lqspec = true;
     }